@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+离线测量 /upload 的回复耗时：用 openai_stub.py 模拟 OpenAI 的延迟（OPENAI_STUB=1，延迟见该文件），
+分别以整段回复（无 X-Stream）、流式文字（X-Stream: 1）和分句流水线（X-Stream: 2）请求，
+打印设备能开始播放（收到第一段音频）的时间和收完整个回复的时间。
+  python3 backend_bench.py [-n 次数] [--json out.json]
+"""
+import argparse
+import json
+import os
+import statistics
+import sys
+import time
+
+os.environ["OPENAI_STUB"] = "1"
+os.environ.setdefault("GLYPH_FONT_PATH", "")  # 不生成字体片段，只测 STT/LLM/TTS
+
+import backend_server  # noqa: E402  必须在设置 OPENAI_STUB 之后导入
+
+MODES = (("whole", None), ("stream_text", "1"), ("pipeline", "2"))
+
+
+def _first_audio_whole(buf: bytes):
+    """整段回复（及 X-Stream: 1）：事件行之后的 JSON 头收齐且后面已有 PCM 时即可播放"""
+    while buf.startswith(b'{"event":'):
+        nl = buf.find(b"\n")
+        if nl < 0:
+            return False
+        buf = buf[nl + 1:]
+    nl = buf.find(b"\n")
+    if nl < 0:
+        return False
+    head = json.loads(buf[:nl])
+    return len(buf) > nl + 1 + head.get("font_size", 0)
+
+
+def _first_audio_pipeline(buf: bytes):
+    """分句流水线：收齐第一段 audio 帧即可播放"""
+    while buf.startswith(b'{"event":'):
+        nl = buf.find(b"\n")
+        if nl < 0:
+            return False
+        head = json.loads(buf[:nl])
+        size = head.get("size", 0)
+        if len(buf) < nl + 1 + size:
+            return False
+        if head["event"] == "audio":
+            return True
+        buf = buf[nl + 1 + size:]
+    return False
+
+
+def run_once(client, stream_mode):
+    headers = {"X-Sample-Rate": "24000", "X-Channels": "1", "X-Format": "pcm16"}
+    if stream_mode:
+        headers["X-Stream"] = stream_mode
+    first_audio = _first_audio_pipeline if stream_mode == "2" else _first_audio_whole
+    pcm = b"\x00\x00" * 24000  # 1s 静音
+    start = time.monotonic()
+    resp = client.post("/upload", data=pcm, headers=headers, buffered=False)
+    buf = b""
+    first_audio_ms = None
+    for chunk in resp.response:
+        buf += chunk
+        if first_audio_ms is None and first_audio(buf):
+            first_audio_ms = (time.monotonic() - start) * 1000
+    total_ms = (time.monotonic() - start) * 1000
+    resp.close()
+    return first_audio_ms, total_ms
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-n", type=int, default=3, help="每种方式请求几次（取中位数）")
+    ap.add_argument("--json", help="结果另存为 JSON")
+    args = ap.parse_args()
+
+    client = backend_server.app.test_client()
+    results = {}
+    for name, stream_mode in MODES:
+        runs = [run_once(client, stream_mode) for _ in range(args.n)]
+        results[name] = {
+            "first_audio_ms": statistics.median(r[0] or r[1] for r in runs),
+            "total_ms": statistics.median(r[1] for r in runs),
+        }
+
+    print(f"\n{'mode':<12} {'first audio (ms)':>17} {'total (ms)':>11}", file=sys.stderr)
+    for name, r in results.items():
+        print(f"{name:<12} {r['first_audio_ms']:>17.0f} {r['total_ms']:>11.0f}", file=sys.stderr)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -6,10 +6,19 @@
 """
 import json
 import os
+import queue
+import shlex
 import struct
+import subprocess
+import tempfile
+import threading
+import time
 import uuid
+from collections import OrderedDict
+from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
 from flask import Flask, request, jsonify, Response
+from werkzeug.serving import WSGIRequestHandler
 from dotenv import load_dotenv
 
 # 加载 .env 文件中的环境变量
@@ -20,6 +29,23 @@ app = Flask(__name__)
 PORT = 5001
 UPLOAD_DIR = "uploads"
 
+# OPENAI_STUB=1：用 openai_stub.py 的离线替身代替 OpenAI（固定结果 + 模拟延迟，不联网、不需要 API Key），
+# 用于离线测量流水线耗时（见 backend_bench.py）
+OPENAI_STUB = os.environ.get("OPENAI_STUB", "").strip() == "1"
+
+
+def _has_api_key() -> bool:
+    return OPENAI_STUB or bool(os.environ.get("OPENAI_API_KEY", "").strip())
+
+
+def _openai_client():
+    """OpenAI 客户端；OPENAI_STUB=1 时换成离线替身"""
+    if OPENAI_STUB:
+        import openai_stub
+        return openai_stub.OpenAI()
+    from openai import OpenAI
+    return OpenAI(api_key=os.environ.get("OPENAI_API_KEY", "").strip())
+
 
 def make_wav_header(sample_rate: int, channels: int, num_samples: int) -> bytes:
     """16bit PCM, mono or stereo."""
@@ -49,22 +75,25 @@ def chat():
 # 可选扩展：JSON body { "sample_rate", "channels", "format", "data": base64 }
 
 
-# 回复结构（与 ESP32 约定）：HTTP body = 纯 JSON，含 ok, user_text, reply_text，无音频
+# 回复结构（与 ESP32 约定）：HTTP body = 一行 JSON（ok, user_text, reply_text, sample_rate, font_size）
+# + "\n" + font_size 字节的 LVGL binfont 字形片段 + TTS PCM
+#
+# 流式回复（请求头 X-Stream: 1）：上面的 body 之前先边生成边逐行下发事件（NDJSON，每行一个 JSON），
+# 设备收到即处理，不必等 LLM/TTS 完成：
+#   {"event":"user_text","text":"..."}   STT 结果
+#   {"event":"token","text":"..."}       LLM 输出的文本增量，设备追加到回复标签
+# 事件行都以 {"event": 开头，第一行不是事件的即为最终的 JSON 头。
+#
+# 分句流水线（请求头 X-Stream: 2）：LLM 边生成边按句切分，各句并发 TTS，按句子顺序下发音频，
+# 设备收到第一句就开始播放，后面的句子同时在合成。响应为 chunked，由若干段组成，
+# 每段 = 一行 JSON 头（同样以 {"event": 开头）+ 头中 size 字节的负载（没有 size 即没有负载）：
+#   {"event":"user_text","text":"..."}、{"event":"token","text":"..."}   同上
+#   {"event":"font","size":N}                         N 字节 binfont 片段（该句的非 ASCII 字符，先于该句音频）
+#   {"event":"audio","sample_rate":24000,"size":N}    N 字节 PCM，一句分成若干帧，每帧不超过 PCM_FRAME_MAX
+# 最后是与上面相同的 JSON 头（font_size 为 0），其后没有 PCM：音频都已经在帧里下发。
 
 
-def _llm_reply(user_text: str) -> str:
-    """用 OpenAI Chat 根据 user_text 生成回复，只返回 reply_text。失败返回空串。"""
-    api_key = os.environ.get("OPENAI_API_KEY", "").strip()
-    if not api_key:
-        print("[backend] LLM: OPENAI_API_KEY not set, skip")
-        return ""
-    try:
-        from openai import OpenAI
-        client = OpenAI(api_key=api_key)
-        r = client.chat.completions.create(
-            model="gpt-4o-mini",
-            messages=[
-                {"role": "system", "content": """You are Dada, a Pomsky.
+LLM_SYSTEM_PROMPT = """You are Dada, a Pomsky.
 
 You are playful, mischievous, energetic, slightly dramatic.
 You are a real dog.
@@ -105,17 +134,38 @@ A little chaotic.
 
 Cute but not human.
 
-You ARE Dada."""},
+You ARE Dada."""
+
+
+def _llm_reply_stream(user_text: str):
+    """用 OpenAI Chat 流式生成回复，逐段 yield LLM 输出的文本增量。失败时提前结束。"""
+    if not _has_api_key():
+        print("[backend] LLM: OPENAI_API_KEY not set, skip")
+        return
+    try:
+        client = _openai_client()
+        stream = client.chat.completions.create(
+            model="gpt-4o-mini",
+            messages=[
+                {"role": "system", "content": LLM_SYSTEM_PROMPT},
                 {"role": "user", "content": user_text or "(no input)"},
             ],
             max_tokens=150,
+            stream=True,
         )
-        reply_text = (r.choices[0].message.content or "").strip()
-        print(f"[backend] LLM reply: {reply_text}")
-        return reply_text
+        for chunk in stream:
+            if chunk.choices and chunk.choices[0].delta.content:
+                yield chunk.choices[0].delta.content
     except Exception as e:
         print(f"[backend] LLM error: {e}")
-        return ""
+
+
+def _llm_reply(user_text: str) -> str:
+    """用 OpenAI Chat 根据 user_text 生成回复，只返回 reply_text。失败返回空串。"""
+    reply_text = "".join(_llm_reply_stream(user_text)).strip()
+    if reply_text:
+        print(f"[backend] LLM reply: {reply_text}")
+    return reply_text
 
 
 def _tts_to_pcm(text: str) -> bytes:
@@ -123,15 +173,11 @@ def _tts_to_pcm(text: str) -> bytes:
     if not text:
         print("[backend] TTS: empty text, skip")
         return b""
-    api_key = os.environ.get("OPENAI_API_KEY", "").strip()
-    if not api_key:
+    if not _has_api_key():
         print("[backend] TTS: OPENAI_API_KEY not set, skip")
         return b""
     try:
-        from openai import OpenAI
-        import io
-        import wave
-        client = OpenAI(api_key=api_key)
+        client = _openai_client()
         
         # 调用 TTS API，使用 tts-1 模型（更快）和 alloy 语音
         response = client.audio.speech.create(
@@ -150,6 +196,52 @@ def _tts_to_pcm(text: str) -> bytes:
         return b""
 
 
+# 动态字体：设备固件只内置 ASCII 字体（Montserrat 14），reply_text 中的其他字符（中文、标点、emoji 等）
+# 由 lv_font_conv 生成 LVGL binfont 片段随回复下发，设备合并进 PSRAM 字形库作为 reply_label 的 fallback。
+#   GLYPH_FONT_PATH：TTF/OTF 字体路径（如 SourceHanSansSC-Normal.otf），不设置则不下发字体
+#   GLYPH_FONT_SIZE：字号，需与设备 reply_label 的字体一致（默认 14）
+#   LV_FONT_CONV：lv_font_conv 命令（默认 "lv_font_conv"，也可以是 "npx lv_font_conv"）
+GLYPH_FONT_PATH = os.environ.get("GLYPH_FONT_PATH", "").strip()
+GLYPH_FONT_SIZE = int(os.environ.get("GLYPH_FONT_SIZE", "14"))
+LV_FONT_CONV = os.environ.get("LV_FONT_CONV", "lv_font_conv")
+GLYPH_FONT_CACHE_MAX = 64
+_glyph_font_cache: "OrderedDict[str, bytes]" = OrderedDict()
+
+
+def _glyph_subset_font(text: str) -> bytes:
+    """把 text 中的非 ASCII 字符生成 LVGL binfont 片段（4bpp、不压缩、无字距）。无需下发或失败返回空字节。"""
+    symbols = "".join(sorted({c for c in text if ord(c) > 0x7E}))
+    if not symbols:
+        return b""
+    if not GLYPH_FONT_PATH:
+        print("[backend] font: GLYPH_FONT_PATH not set, skip")
+        return b""
+    cached = _glyph_font_cache.get(symbols)
+    if cached is not None:
+        _glyph_font_cache.move_to_end(symbols)
+        return cached
+    try:
+        with tempfile.TemporaryDirectory() as tmp:
+            out = os.path.join(tmp, "glyphs.bin")
+            # 设备端直接按 PLAIN 格式拷贝位图，必须 --no-compress；bpp 与设备 reply_font.c 一致
+            cmd = shlex.split(LV_FONT_CONV) + [
+                "--font", GLYPH_FONT_PATH, "--symbols", symbols,
+                "--size", str(GLYPH_FONT_SIZE), "--bpp", "4",
+                "--format", "bin", "--no-compress", "--no-kerning", "-o", out,
+            ]
+            subprocess.run(cmd, check=True, capture_output=True, timeout=30)
+            with open(out, "rb") as f:
+                data = f.read()
+    except (OSError, subprocess.SubprocessError) as e:
+        print(f"[backend] font error: {e}")
+        return b""
+    _glyph_font_cache[symbols] = data
+    if len(_glyph_font_cache) > GLYPH_FONT_CACHE_MAX:
+        _glyph_font_cache.popitem(last=False)
+    print(f"[backend] font: {len(symbols)} glyphs -> {len(data)} bytes")
+    return data
+
+
 # Whisper 在听不清/短音频时常见幻觉，视为无效（小写匹配）
 STT_HALLUCINATION_PHRASES = (
     "subs by",
@@ -166,13 +258,11 @@ STT_HALLUCINATION_PHRASES = (
 
 def _stt_whisper(wav_path: str, duration_sec: float = 0) -> str:
     """调用 OpenAI Whisper API 转写 wav 文件，返回 text。失败返回空串或提示。"""
-    api_key = os.environ.get("OPENAI_API_KEY", "").strip()
-    if not api_key:
+    if not _has_api_key():
         print("[backend] STT: OPENAI_API_KEY not set, skip Whisper")
         return ""
     try:
-        from openai import OpenAI
-        client = OpenAI(api_key=api_key)
+        client = _openai_client()
         with open(wav_path, "rb") as f:
             transcription = client.audio.transcriptions.create(
                 model="whisper-1",
@@ -198,7 +288,8 @@ def _stt_whisper(wav_path: str, duration_sec: float = 0) -> str:
 
 @app.route("/upload", methods=["POST"])
 def upload():
-    """接收 raw PCM，存 WAV，STT+LLM 后只返回 JSON（ok, user_text, reply_text），无音频。"""
+    """接收 raw PCM，存 WAV，STT+LLM+TTS 后返回 JSON + 字体片段 + PCM；X-Stream: 1 时先流式下发事件行，
+    X-Stream: 2 时按句流水线合成并分帧下发音频。"""
     raw = request.get_data()
     sample_rate = int(request.headers.get("X-Sample-Rate", "48000"))
     channels = int(request.headers.get("X-Channels", "1"))
@@ -224,29 +315,192 @@ def upload():
     duration_sec = num_samples / (sample_rate * channels)
     print(f"[backend] /upload id={req_id}: samples={num_samples}, duration={duration_sec:.3f}s -> {filename}")
 
+    stream_mode = request.headers.get("X-Stream", "").strip()
+    if stream_mode == "2":
+        # 生成器在请求结束后才执行，只使用局部变量
+        return Response(_upload_pipeline(req_id, filename, duration_sec), mimetype="application/octet-stream")
+    if stream_mode == "1":
+        return Response(_upload_stream(req_id, filename, duration_sec), mimetype="application/octet-stream")
+
     # PCM → Whisper → user_text → LLM → reply_text → TTS → reply_audio
     user_text = _stt_whisper(filename, duration_sec)
     reply_text = _llm_reply(user_text)
+    body = _reply_body(req_id, user_text, reply_text)
+    resp = Response(body, mimetype="application/octet-stream")
+    resp.headers["Content-Length"] = str(len(body))
+    return resp
+
+
+def _event_line(event: str, text: str) -> bytes:
+    """流式回复的一行事件（NDJSON）"""
+    line = json.dumps({"event": event, "text": text}, separators=(",", ":"), ensure_ascii=False)
+    return line.encode("utf-8") + b"\n"
+
+
+def _event_segment(event: str, payload: bytes, **fields) -> bytes:
+    """分句流水线带负载的一段：JSON 头（size 为负载字节数）+ 负载"""
+    head = {"event": event, **fields, "size": len(payload)}
+    return json.dumps(head, separators=(",", ":")).encode("utf-8") + b"\n" + payload
+
+
+def _upload_stream(req_id: str, filename: str, duration_sec: float):
+    """流式回复：STT 结果和 LLM 增量先作为事件行下发，最后是与非流式相同的 body。"""
+    user_text = _stt_whisper(filename, duration_sec)
+    yield _event_line("user_text", user_text)
+    parts = []
+    for token in _llm_reply_stream(user_text):
+        if not parts:
+            token = token.lstrip()  # 与非流式的 strip() 一致，回复不以空白开头
+            if not token:
+                continue
+        parts.append(token)
+        yield _event_line("token", token)
+    reply_text = "".join(parts).strip()
+    print(f"[backend] LLM reply: {reply_text}")
+    yield _reply_body(req_id, user_text, reply_text)
+
+
+# 分句流水线：TTS 并发数与每帧 PCM 的最大字节数（设备按帧收齐后再交给播放，帧不宜太大）
+TTS_WORKERS = int(os.environ.get("TTS_WORKERS", "3"))
+PCM_FRAME_MAX = 16 * 1024
+_tts_pool = ThreadPoolExecutor(max_workers=TTS_WORKERS, thread_name_prefix="tts")
+
+# 句末标点：全角的直接断句；ASCII 的后面跟空白才断句（避免把 3.14、e.g. 切开）
+SENTENCE_END_WIDE = "。！？；…\n"
+SENTENCE_END_ASCII = ".!?;"
+SENTENCE_CLOSERS = "\"'”’)）」』"
+
+
+def _split_sentences(text: str):
+    """从 text 开头切出已完整的句子，返回 (句子列表, 剩余还没结束的部分)。"""
+    sentences = []
+    start = 0
+    i = 0
+    n = len(text)
+    while i < n:
+        c = text[i]
+        if c not in SENTENCE_END_WIDE and c not in SENTENCE_END_ASCII:
+            i += 1
+            continue
+        # 连续的标点和右引号、右括号并入这一句
+        end = i + 1
+        wide = c in SENTENCE_END_WIDE
+        while end < n and (text[end] in SENTENCE_END_WIDE or text[end] in SENTENCE_END_ASCII
+                           or text[end] in SENTENCE_CLOSERS):
+            wide = wide or text[end] in SENTENCE_END_WIDE
+            end += 1
+        if not wide:
+            if end == n:
+                break  # 还不知道后面是不是空白，等下一段
+            if not text[end].isspace():
+                i = end
+                continue
+        sentence = text[start:end].strip()
+        if sentence:
+            sentences.append(sentence)
+        start = end
+        i = end
+    return sentences, text[start:]
+
+
+def _tts_sentence(text: str):
+    """一句的字体片段和 TTS PCM，在 _tts_pool 中并发执行"""
+    return _glyph_subset_font(text), _tts_to_pcm(text)
+
+
+def _llm_worker(user_text: str, events: queue.Queue):
+    """在后台线程中读取 LLM 流，把文本增量放进 events，结束时放 ("end", None)"""
+    try:
+        for token in _llm_reply_stream(user_text):
+            events.put(("token", token))
+    finally:
+        events.put(("end", None))
+
+
+def _upload_pipeline(req_id: str, filename: str, duration_sec: float):
+    """分句流水线：LLM 增量照常作为事件下发，每凑满一句就提交 TTS，合成好的句子按顺序以音频帧下发。"""
+    start = time.monotonic()
+    user_text = _stt_whisper(filename, duration_sec)
+    yield _event_line("user_text", user_text)
+
+    # LLM 线程和 TTS 完成回调都往 events 里放消息，这里是唯一的消费者，按句子顺序输出
+    events = queue.Queue()
+    threading.Thread(target=_llm_worker, args=(user_text, events), daemon=True).start()
+    tts_jobs = []
+    sent = 0
+    parts = []
+    pending = ""
+    llm_done = False
+    first_audio_ms = None
+
+    def submit(sentence):
+        job = _tts_pool.submit(_tts_sentence, sentence)
+        job.add_done_callback(lambda _job: events.put(("tts", None)))
+        tts_jobs.append(job)
+
+    while not llm_done or sent < len(tts_jobs):
+        kind, token = events.get()
+        if kind == "token":
+            if not parts:
+                token = token.lstrip()  # 与非流式的 strip() 一致，回复不以空白开头
+                if not token:
+                    continue
+            parts.append(token)
+            yield _event_line("token", token)
+            sentences, pending = _split_sentences(pending + token)
+            for sentence in sentences:
+                submit(sentence)
+        elif kind == "end":
+            llm_done = True
+            if pending.strip():
+                submit(pending.strip())
+        # kind == "tts"：有句子合成完成；前面的句子都好了才能下发
+        while sent < len(tts_jobs) and tts_jobs[sent].done():
+            font, pcm = tts_jobs[sent].result()
+            sent += 1
+            if font:
+                yield _event_segment("font", font)
+            pcm = pcm[:len(pcm) & ~1]
+            for ofs in range(0, len(pcm), PCM_FRAME_MAX):
+                if first_audio_ms is None:
+                    first_audio_ms = (time.monotonic() - start) * 1000
+                yield _event_segment("audio", pcm[ofs:ofs + PCM_FRAME_MAX], sample_rate=24000)
+
+    reply_text = "".join(parts).strip()
+    print(f"[backend] LLM reply: {reply_text}")
+    print(f"[backend] /upload id={req_id} pipeline: {len(tts_jobs)} sentences, first audio at "
+          f"{first_audio_ms or 0:.0f}ms, total {(time.monotonic() - start) * 1000:.0f}ms")
+    yield _reply_json(req_id, user_text, reply_text, b"", b"")
+
+
+def _reply_body(req_id: str, user_text: str, reply_text: str) -> bytes:
+    """reply_text → TTS、字体片段，组合成 JSON + "\n" + 字体片段（可选）+ PCM 音频"""
     reply_audio_pcm = _tts_to_pcm(reply_text)
+    reply_font = _glyph_subset_font(reply_text)
+    return _reply_json(req_id, user_text, reply_text, reply_font, reply_audio_pcm)
+
 
-    # 返回格式：JSON + "\n" + PCM 音频
-    # JSON 包含：ok, user_text, reply_text, sample_rate (TTS 音频采样率为 24kHz)
+def _reply_json(req_id: str, user_text: str, reply_text: str, reply_font: bytes, reply_audio_pcm: bytes) -> bytes:
+    """组合回复：JSON + "\n" + 字体片段（可选）+ PCM 音频"""
+    # JSON 包含：ok, user_text, reply_text, sample_rate (TTS 音频采样率为 24kHz), font_size（字体片段字节数，0 表示没有）
     reply = {
         "ok": True,
         "user_text": user_text,
         "reply_text": reply_text,
         "sample_rate": 24000,  # OpenAI TTS PCM 格式固定为 24kHz
+        "font_size": len(reply_font),
     }
     json_str = json.dumps(reply, separators=(",", ":"), ensure_ascii=False)
     json_bytes = json_str.encode("utf-8")
-    
-    # 组合：JSON + "\n" + PCM
-    body = json_bytes + b"\n" + reply_audio_pcm
-    resp = Response(body, mimetype="application/octet-stream")
-    resp.headers["Content-Length"] = str(len(body))
-    print(f"[backend] /upload response: JSON={len(json_bytes)}B, PCM={len(reply_audio_pcm)}B, total={len(body)}B")
-    return resp
+
+    # 组合：JSON + "\n" + 字体片段 + PCM
+    body = json_bytes + b"\n" + reply_font + reply_audio_pcm
+    print(f"[backend] /upload id={req_id} response: JSON={len(json_bytes)}B, font={len(reply_font)}B, "
+          f"PCM={len(reply_audio_pcm)}B, total={len(body)}B")
+    return body
 
 
 if __name__ == "__main__":
+    # HTTP/1.1 才能用 chunked 边生成边下发（X-Stream）
+    WSGIRequestHandler.protocol_version = "HTTP/1.1"
     app.run(host="0.0.0.0", port=PORT, debug=False)
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+比较两次 desk_ai_perf 的 JSON 结果（例如两个提交），打印各场景指标的变化。
+
+重绘像素、帧数和堆高水位是确定性的，任何增加都视为回归；
+渲染耗时受主机负载影响，只有均值或 p95 增加超过阈值（默认 10%）才视为回归。
+存在回归时返回 1，可直接用于 CI。
+
+用法：python3 host_perf/compare.py base.json new.json [--threshold 10]
+"""
+import argparse
+import json
+import sys
+
+# (指标名, 取值函数, 是否确定性)
+METRICS = [
+    ('frames', lambda s: s['frames'], True),
+    ('px_rendered', lambda s: s['px_rendered'], True),
+    ('px_flushed', lambda s: s['px_flushed'], True),
+    ('px_blended', lambda s: s.get('px_blended', 0), True),
+    ('heap_max_used', lambda s: s['heap_max_used'], True),
+    ('style_prop_lookup', lambda s: s.get('style_prop_lookup', 0), True),
+    ('heap_free_biggest_min', lambda s: s.get('heap_free_biggest_min', 0), None),
+    ('render_mean_us', lambda s: s['render_us']['mean'], False),
+    ('render_p95_us', lambda s: s['render_us']['p95'], False),
+    ('render_max_us', lambda s: s['render_us']['max'], None),
+]
+
+
+def get_arg():
+    parser = argparse.ArgumentParser(description='Compare two desk_ai_perf results.')
+    parser.add_argument('base', help='Baseline JSON')
+    parser.add_argument('new', help='New JSON')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='Allowed render time increase in percent (default: 10)')
+    return parser.parse_args()
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data, {s['name']: s for s in data['scenarios']}
+
+
+def main():
+    args = get_arg()
+    base, base_sc = load(args.base)
+    new, new_sc = load(args.new)
+
+    print('base: %s  new: %s' % (base.get('label') or args.base, new.get('label') or args.new))
+    regressions = []
+    for name, n in new_sc.items():
+        b = base_sc.get(name)
+        print('\n[%s]' % name)
+        if b is None:
+            print('  (not in base)')
+            continue
+        for metric, get, exact in METRICS:
+            bv, nv = get(b), get(n)
+            delta = (nv - bv) * 100.0 / bv if bv else 0.0
+            mark = ''
+            if exact is True and nv > bv:
+                mark = '  <-- regression'
+            elif exact is False and delta > args.threshold:
+                mark = '  <-- regression'
+            if mark:
+                regressions.append('%s.%s' % (name, metric))
+            print('  %-21s %12d %12d %+8.1f%%%s' % (metric, bv, nv, delta, mark))
+
+    if regressions:
+        print('\nRegressions: ' + ', '.join(regressions))
+        return 1
+    print('\nNo regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
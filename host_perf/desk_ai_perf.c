@@ -0,0 +1,785 @@
+/*
+ * desk_ai 主机端性能回归测试
+ *
+ * 在 Linux 上构建 main/ui.c 的真实界面（360x360 RGB565、字节交换、40 行部分刷新缓冲，
+ * 与 display.c 中 esp_lvgl_port 的配置一致），通过 lv_test_indev 回放录制的交互脚本，
+ * 记录每帧的渲染耗时、重绘/刷新/混合像素数、各类绘制任务耗时以及 LVGL 堆使用量、高水位、
+ * 最大空闲块与碎片率，以 JSON 输出，便于用 compare.py 比较不同提交。
+ *
+ * 每个场景在 fork 出的子进程中从 lv_init() 开始运行，互不影响（包括 LVGL 堆高水位）。
+ *
+ * 用法：desk_ai_perf [-o out.json] [-l label] [-s scenario] [-f font.ttf] [-r repeat] [-t trace.bin]
+ *   -f：回复文字的 TTF，代替设备上的字体分区（flash_font.c 用 mmap 映射）
+ *   -r：每个场景的脚本连续回放 repeat 次（压力测试，观察长时间运行后的堆碎片）
+ *   -t：把 -s 指定场景的 LVGL 堆分配轨迹写入文件（格式见 mem_trace.h），用 mem_replay 回放
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "lvgl.h"
+#include "src/core/lv_global.h"
+#include "src/core/lv_obj_private.h"
+#include "src/core/lv_obj_style_private.h"
+#include "ui.h"
+#include "state.h"
+#include "audio.h"
+#include "mem_trace.h"
+
+/* ---------------- state.c / audio.c 的主机替代实现 ---------------- */
+
+#define LAST_REPLY_TEXT_MAX 192   /* 与 state.c 一致，回复超长时同样被截断 */
+
+static device_state_t current_state = STATE_IDLE;
+static char last_reply_text[LAST_REPLY_TEXT_MAX];
+
+void set_state(device_state_t new_state)
+{
+    if (current_state == new_state) return;
+    current_state = new_state;
+    ui_update(new_state);
+}
+
+device_state_t get_state(void)
+{
+    return current_state;
+}
+
+const char *state_get_last_user_text(void)
+{
+    return "";
+}
+
+const char *state_get_last_reply_text(void)
+{
+    return last_reply_text;
+}
+
+void audio_stop_listening(void)
+{
+}
+
+bool audio_wait_record_done(uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return true;
+}
+
+/* ---------------- 模拟屏 ---------------- */
+
+/* 与 display.c 相同的单缓冲部分刷新，RGB565 */
+static uint16_t draw_buf_mem[LCD_H_RES * LCD_BUF_LINES];
+
+/* 对应 display.c 放在 PSRAM 的 LV_MEM_HINT_BULK 内存池 */
+static uint64_t bulk_pool_mem[LVGL_BULK_POOL_SIZE / sizeof(uint64_t)];
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    /* 与 esp_lvgl_port 的 swap_bytes 相同：发送前交换 RGB565 字节序 */
+    lv_draw_sw_rgb565_swap(px_map, lv_area_get_size(area));
+    lv_display_flush_ready(disp);
+}
+
+static uint32_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/* ---------------- 分配轨迹（-t） ---------------- */
+
+/*
+ * CMakeLists.txt 用 -Wl,--wrap 把其他目标文件对 lv_malloc 等函数的调用接到 __wrap_*，
+ * lv_mem.c 内部的相互调用不经过这里，所以每次分配只记录一次。
+ */
+void *__real_lv_malloc(size_t size);
+void *__real_lv_malloc_zeroed(size_t size);
+void *__real_lv_malloc_hint(size_t size, lv_mem_hint_t hint);
+void *__real_lv_calloc(size_t num, size_t size);
+void *__real_lv_zalloc(size_t size);
+void *__real_lv_realloc(void *data, size_t size);
+void *__real_lv_reallocf(void *data, size_t size);
+void __real_lv_free(void *data);
+
+static FILE *trace_file;
+static uint32_t trace_next_id;
+
+/* 地址到分配编号的开放寻址表，容量为 2 的幂，远大于同时存在的分配数 */
+#define TRACE_MAP_SIZE 16384
+static struct {
+    void *p;
+    uint32_t id;
+} trace_map[TRACE_MAP_SIZE];
+
+static uint32_t trace_map_slot(const void *p)
+{
+    return (uint32_t)(((uintptr_t)p >> 3) * 2654435761u) & (TRACE_MAP_SIZE - 1);
+}
+
+static void trace_map_put(void *p, uint32_t id)
+{
+    uint32_t i = trace_map_slot(p);
+    while (trace_map[i].p != NULL) i = (i + 1) & (TRACE_MAP_SIZE - 1);
+    trace_map[i].p = p;
+    trace_map[i].id = id;
+}
+
+/* 取出并删除 p 的编号；p 不是记录过的分配（NULL、zero_mem）时返回 false */
+static bool trace_map_take(void *p, uint32_t *id)
+{
+    if (p == NULL) return false;
+    uint32_t i = trace_map_slot(p);
+    while (trace_map[i].p != p) {
+        if (trace_map[i].p == NULL) return false;
+        i = (i + 1) & (TRACE_MAP_SIZE - 1);
+    }
+    *id = trace_map[i].id;
+
+    /* 后移删除：把后面的项移到空位，直到遇到空槽，保证其他地址仍能被找到 */
+    uint32_t j = i;
+    while (true) {
+        j = (j + 1) & (TRACE_MAP_SIZE - 1);
+        if (trace_map[j].p == NULL) break;
+        uint32_t k = trace_map_slot(trace_map[j].p);
+        bool stays = i <= j ? (k > i && k <= j) : (k > i || k <= j);
+        if (!stays) {
+            trace_map[i] = trace_map[j];
+            i = j;
+        }
+    }
+    trace_map[i].p = NULL;
+    return true;
+}
+
+static void trace_write(mem_trace_op_t op, uint32_t id, size_t size, uint32_t hint)
+{
+    mem_trace_rec_t rec = {op, id, (uint32_t)size, hint};
+    fwrite(&rec, sizeof(rec), 1, trace_file);
+}
+
+static void trace_alloc(mem_trace_op_t op, void *p, size_t size, uint32_t hint)
+{
+    if (trace_file == NULL || size == 0) return;
+    uint32_t id = trace_next_id++;
+    trace_write(op, id, size, hint);
+    if (p != NULL) trace_map_put(p, id);
+}
+
+/* freed_on_fail：失败时原内存是否已被释放（lv_reallocf） */
+static void trace_realloc(void *data, void *p, size_t size, bool freed_on_fail)
+{
+    if (trace_file == NULL) return;
+    uint32_t id;
+    if (!trace_map_take(data, &id)) {
+        /* NULL 或 zero_mem 上的 realloc 相当于 malloc */
+        trace_alloc(MEM_TRACE_MALLOC, p, size, 0);
+        return;
+    }
+    if (size == 0 || (p == NULL && freed_on_fail)) {
+        trace_write(MEM_TRACE_FREE, id, 0, 0);
+        return;
+    }
+    trace_write(MEM_TRACE_REALLOC, id, size, 0);
+    trace_map_put(p != NULL ? p : data, id);
+}
+
+void *__wrap_lv_malloc(size_t size)
+{
+    void *p = __real_lv_malloc(size);
+    trace_alloc(MEM_TRACE_MALLOC, p, size, 0);
+    return p;
+}
+
+void *__wrap_lv_malloc_zeroed(size_t size)
+{
+    void *p = __real_lv_malloc_zeroed(size);
+    trace_alloc(MEM_TRACE_MALLOC_ZEROED, p, size, 0);
+    return p;
+}
+
+void *__wrap_lv_malloc_hint(size_t size, lv_mem_hint_t hint)
+{
+    void *p = __real_lv_malloc_hint(size, hint);
+    trace_alloc(MEM_TRACE_MALLOC_HINT, p, size, hint);
+    return p;
+}
+
+void *__wrap_lv_calloc(size_t num, size_t size)
+{
+    void *p = __real_lv_calloc(num, size);
+    trace_alloc(MEM_TRACE_MALLOC_ZEROED, p, num * size, 0);
+    return p;
+}
+
+void *__wrap_lv_zalloc(size_t size)
+{
+    void *p = __real_lv_zalloc(size);
+    trace_alloc(MEM_TRACE_MALLOC_ZEROED, p, size, 0);
+    return p;
+}
+
+void *__wrap_lv_realloc(void *data, size_t size)
+{
+    void *p = __real_lv_realloc(data, size);
+    trace_realloc(data, p, size, false);
+    return p;
+}
+
+void *__wrap_lv_reallocf(void *data, size_t size)
+{
+    void *p = __real_lv_reallocf(data, size);
+    trace_realloc(data, p, size, true);
+    return p;
+}
+
+void __wrap_lv_free(void *data)
+{
+    uint32_t id;
+    if (trace_file != NULL && trace_map_take(data, &id)) trace_write(MEM_TRACE_FREE, id, 0, 0);
+    __real_lv_free(data);
+}
+
+/* ---------------- 交互脚本 ---------------- */
+
+typedef enum {
+    STEP_END,
+    STEP_WAIT,      /* 推进 ms 毫秒模拟时间 */
+    STEP_PRESS,     /* 在 (x, y) 按下 */
+    STEP_DRAG,      /* 按住状态下 ms 毫秒内匀速滑到 (x, y) */
+    STEP_RELEASE,
+    STEP_CLICK,     /* 在 (x, y) 单击（约 150ms） */
+    STEP_STATE,     /* 模拟后端/音频驱动的状态切换 */
+    STEP_REPLY,     /* 设置下一次 SPEAKING 显示的回复文本 */
+    STEP_TOKEN,     /* 模拟流式回复收到一段文本：追加到回复文本并交给 ui_reply_append */
+    STEP_REDRAW,    /* ms 毫秒内每个刷新周期都重绘整个屏幕 */
+} step_op_t;
+
+typedef struct {
+    step_op_t op;
+    int32_t x;
+    int32_t y;
+    uint32_t ms;
+    device_state_t state;
+    const char *text;
+} step_t;
+
+#define WAIT(t)         { .op = STEP_WAIT, .ms = (t) }
+#define PRESS(px, py)   { .op = STEP_PRESS, .x = (px), .y = (py) }
+#define DRAG(px, py, t) { .op = STEP_DRAG, .x = (px), .y = (py), .ms = (t) }
+#define RELEASE()       { .op = STEP_RELEASE }
+#define CLICK(px, py)   { .op = STEP_CLICK, .x = (px), .y = (py) }
+#define STATE(s)        { .op = STEP_STATE, .state = (s) }
+#define REPLY(txt)      { .op = STEP_REPLY, .text = (txt) }
+#define TOKEN(txt)      { .op = STEP_TOKEN, .text = (txt) }
+#define REDRAW(t)       { .op = STEP_REDRAW, .ms = (t) }
+#define END()           { .op = STEP_END }
+
+/* 触屏上报间隔（CST816 约 10ms 一个点） */
+#define DRAG_STEP_MS  10
+
+/* 完整对话：双击唤醒 → 录音 → 单击结束 → 等待后端 → 播放中单击打断 → 回到 IDLE */
+static const step_t state_cycle_steps[] = {
+    REPLY("Hello! I'm your desk buddy. Ask me anything."),
+    WAIT(500),
+    CLICK(180, 260),
+    CLICK(180, 260),
+    WAIT(1000),
+    CLICK(180, 260),
+    WAIT(800),
+    STATE(STATE_SPEAKING),
+    WAIT(1500),
+    CLICK(180, 260),
+    WAIT(1200),
+    END(),
+};
+
+/* 抚摸：IDLE 下按住来回滑动，手指和爱心跟随，松开后笑脸保持 1s */
+static const step_t petting_drag_steps[] = {
+    WAIT(300),
+    PRESS(80, 180),
+    DRAG(280, 180, 400),
+    DRAG(80, 200, 400),
+    DRAG(280, 220, 400),
+    DRAG(180, 120, 300),
+    RELEASE(),
+    WAIT(1200),
+    END(),
+};
+
+/* 长回复：接近 state.c 上限的多行回复，随后换一条较短的回复 */
+static const step_t long_reply_steps[] = {
+    WAIT(300),
+    REPLY("Sure! Here is a quick plan for today: finish the report before lunch, "
+          "take a short walk at three, water the plants, and call mom in the evening. "
+          "Don't forget to drink water!"),
+    STATE(STATE_THINKING),
+    WAIT(300),
+    STATE(STATE_SPEAKING),
+    WAIT(1000),
+    STATE(STATE_IDLE),
+    WAIT(300),
+    REPLY("It is 23 degrees and sunny, a good day to go outside."),
+    STATE(STATE_THINKING),
+    WAIT(300),
+    STATE(STATE_SPEAKING),
+    WAIT(1000),
+    STATE(STATE_IDLE),
+    WAIT(300),
+    END(),
+};
+
+/* 流式回复：THINKING 期间逐段收到 LLM 输出（约 30ms 一段），随后切到 SPEAKING */
+static const step_t stream_reply_steps[] = {
+    REPLY(""),
+    WAIT(300),
+    STATE(STATE_THINKING),
+    WAIT(500),
+    TOKEN("Sure"), WAIT(30), TOKEN("!"), WAIT(30), TOKEN(" Here"), WAIT(30), TOKEN(" is"), WAIT(30),
+    TOKEN(" a"), WAIT(30), TOKEN(" quick"), WAIT(30), TOKEN(" plan"), WAIT(30), TOKEN(" for"), WAIT(30),
+    TOKEN(" today"), WAIT(30), TOKEN(":"), WAIT(30), TOKEN(" finish"), WAIT(30), TOKEN(" the"), WAIT(30),
+    TOKEN(" report"), WAIT(30), TOKEN(" before"), WAIT(30), TOKEN(" lunch"), WAIT(30), TOKEN(","), WAIT(30),
+    TOKEN(" take"), WAIT(30), TOKEN(" a"), WAIT(30), TOKEN(" short"), WAIT(30), TOKEN(" walk"), WAIT(30),
+    TOKEN(" at"), WAIT(30), TOKEN(" three"), WAIT(30), TOKEN(","), WAIT(30), TOKEN(" water"), WAIT(30),
+    TOKEN(" the"), WAIT(30), TOKEN(" plants"), WAIT(30), TOKEN(","), WAIT(30), TOKEN(" and"), WAIT(30),
+    TOKEN(" call"), WAIT(30), TOKEN(" mom"), WAIT(30), TOKEN(" in"), WAIT(30), TOKEN(" the"), WAIT(30),
+    TOKEN(" evening"), WAIT(30), TOKEN("."), WAIT(300),
+    STATE(STATE_SPEAKING),
+    WAIT(1000),
+    STATE(STATE_IDLE),
+    WAIT(300),
+    END(),
+};
+
+/* 中文回复（174 字节、58 个字、47 个不同的字）：用 -f 指定字体分区的 TTF 时，
+ * ttf_cache_max_used 即显示一条回复需要的字形位图缓存 */
+static const step_t cjk_reply_steps[] = {
+    WAIT(300),
+    REPLY("好的！今天的安排是这样的：午饭前把报告写完，下午三点出去散散步，给花浇浇水，"
+          "晚上记得给妈妈打个电话。别忘了多喝水哦！"),
+    STATE(STATE_THINKING),
+    WAIT(300),
+    STATE(STATE_SPEAKING),
+    WAIT(1500),
+    STATE(STATE_IDLE),
+    WAIT(300),
+    END(),
+};
+
+/* 全屏重绘压力测试：各状态下每帧重绘整屏，背景图上叠放的图片和文字最多，
+ * 用于比较遮挡剔除开关前后每帧混合的像素数与绘制任务内存 */
+static const step_t full_redraw_steps[] = {
+    REPLY("Sure! Here is a quick plan for today: finish the report before lunch, "
+          "take a short walk at three, water the plants, and call mom in the evening."),
+    WAIT(300),
+    REDRAW(1000),
+    STATE(STATE_LISTENING),
+    REDRAW(1000),
+    STATE(STATE_THINKING),
+    REDRAW(1000),
+    STATE(STATE_SPEAKING),
+    REDRAW(1000),
+    STATE(STATE_IDLE),
+    REDRAW(1000),
+    END(),
+};
+
+typedef struct {
+    const char *name;
+    const step_t *steps;
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    { "state_cycle", state_cycle_steps },
+    { "petting_drag", petting_drag_steps },
+    { "long_reply", long_reply_steps },
+    { "stream_reply", stream_reply_steps },
+    { "cjk_reply", cjk_reply_steps },
+    { "full_redraw", full_redraw_steps },
+};
+
+#define SCENARIO_CNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+static int32_t mouse_x;
+static int32_t mouse_y;
+
+static void mouse_move_to(int32_t x, int32_t y)
+{
+    mouse_x = x;
+    mouse_y = y;
+    lv_test_mouse_move_to(x, y);
+}
+
+static void run_step(const step_t *s)
+{
+    switch (s->op) {
+    case STEP_WAIT:
+        lv_test_wait(s->ms);
+        break;
+    case STEP_PRESS:
+        mouse_move_to(s->x, s->y);
+        lv_test_mouse_press();
+        lv_test_wait(DRAG_STEP_MS);
+        break;
+    case STEP_DRAG: {
+        int32_t x0 = mouse_x;
+        int32_t y0 = mouse_y;
+        int32_t n = s->ms / DRAG_STEP_MS;
+        for (int32_t i = 1; i <= n; i++) {
+            mouse_move_to(x0 + (s->x - x0) * i / n, y0 + (s->y - y0) * i / n);
+            lv_test_wait(DRAG_STEP_MS);
+        }
+        break;
+    }
+    case STEP_RELEASE:
+        lv_test_mouse_release();
+        lv_test_wait(DRAG_STEP_MS);
+        break;
+    case STEP_CLICK:
+        mouse_x = s->x;
+        mouse_y = s->y;
+        lv_test_mouse_click_at(s->x, s->y);
+        break;
+    case STEP_STATE:
+        set_state(s->state);
+        break;
+    case STEP_REPLY:
+        /* 与 state.c 一样截断到缓冲区大小 */
+        snprintf(last_reply_text, sizeof(last_reply_text), "%s", s->text);
+        break;
+    case STEP_TOKEN: {
+        /* 与 backend.c 一样，回复文本满了就不再追加 */
+        size_t len = strlen(last_reply_text);
+        if (len + strlen(s->text) < sizeof(last_reply_text)) {
+            memcpy(last_reply_text + len, s->text, strlen(s->text) + 1);
+            ui_reply_append(s->text);
+        }
+        break;
+    }
+    case STEP_REDRAW:
+        for (uint32_t t = 0; t < s->ms; t += LV_DEF_REFR_PERIOD) {
+            lv_obj_invalidate(lv_screen_active());
+            lv_test_wait(LV_DEF_REFR_PERIOD);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* ---------------- 每帧统计 ---------------- */
+
+typedef struct {
+    lv_sysmon_frame_t frame;
+    uint32_t heap_used;
+    uint32_t heap_max_used;
+    uint32_t heap_free_biggest;
+    uint8_t heap_frag_pct;
+} frame_rec_t;
+
+static uint32_t repeat_cnt = 1;
+static const char *trace_path;   /* -t */
+
+static frame_rec_t *frames;
+static uint32_t frame_cnt;
+static uint32_t frame_cap;
+static uint32_t next_frame_id;
+static size_t ttf_cache_max_used;   /* tiny_ttf 共享字形位图缓存的最大占用 */
+
+/* 按 lv_draw_task_type_t 的顺序 */
+static const char *const task_names[] = {
+    "none", "fill", "border", "box_shadow", "letter", "label", "image", "layer",
+    "line", "arc", "triangle", "mask_rect", "mask_bitmap", "vector", "3d",
+};
+
+static void refr_ready_cb(lv_event_t *e)
+{
+    lv_display_t *disp = lv_event_get_target(e);
+    const lv_sysmon_frame_t *f = lv_sysmon_frame_log_get_frame(disp, 0);
+    /* 没有需要重绘的区域时不会产生新帧 */
+    if (f == NULL || f->id < next_frame_id) return;
+    next_frame_id = f->id + 1;
+
+    if (frame_cnt == frame_cap) {
+        frame_cap = frame_cap ? frame_cap * 2 : 256;
+        frames = realloc(frames, frame_cap * sizeof(frame_rec_t));
+        if (frames == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    frame_rec_t *r = &frames[frame_cnt++];
+    r->frame = *f;
+    r->heap_used = (uint32_t)(mon.total_size - mon.free_size);
+    r->heap_max_used = (uint32_t)mon.max_used;
+    r->heap_free_biggest = (uint32_t)mon.free_biggest_size;
+    r->heap_frag_pct = mon.frag_pct;
+
+#if LV_USE_TINY_TTF && LV_TINY_TTF_BITMAP_CACHE_SIZE
+    lv_cache_t *ttf_cache = LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache;
+    if (ttf_cache != NULL && lv_cache_get_size(ttf_cache, NULL) > ttf_cache_max_used) {
+        ttf_cache_max_used = lv_cache_get_size(ttf_cache, NULL);
+    }
+#endif
+}
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+static lv_obj_tree_walk_res_t count_prop_caches_cb(lv_obj_t *obj, void *user_data)
+{
+    uint32_t *cnt = user_data;
+    if (obj->style_prop_cache != NULL) (*cnt)++;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+#endif
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return va < vb ? -1 : va > vb;
+}
+
+static void write_scenario_json(FILE *out, const char *name)
+{
+    uint32_t *render = malloc((frame_cnt ? frame_cnt : 1) * sizeof(uint32_t));
+    uint64_t render_sum = 0;
+    uint64_t px_rendered = 0;
+    uint64_t px_flushed = 0;
+    uint64_t px_blended = 0;
+    uint32_t heap_max_used = 0;
+    uint32_t heap_free_biggest_min = UINT32_MAX;
+    uint8_t heap_frag_pct_max = 0;
+    for (uint32_t i = 0; i < frame_cnt; i++) {
+        render[i] = frames[i].frame.render_time;
+        render_sum += render[i];
+        px_rendered += frames[i].frame.px_rendered;
+        px_flushed += frames[i].frame.px_flushed;
+        px_blended += frames[i].frame.px_blended;
+        if (frames[i].heap_max_used > heap_max_used) heap_max_used = frames[i].heap_max_used;
+        if (frames[i].heap_free_biggest < heap_free_biggest_min) heap_free_biggest_min = frames[i].heap_free_biggest;
+        if (frames[i].heap_frag_pct > heap_frag_pct_max) heap_frag_pct_max = frames[i].heap_frag_pct;
+    }
+    if (frame_cnt == 0) heap_free_biggest_min = 0;
+
+    /* 结束时的空闲块大小分布 */
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_mem_monitor_t bulk_mon;
+    lv_mem_monitor_hint(&bulk_mon, LV_MEM_HINT_BULK);
+    qsort(render, frame_cnt, sizeof(uint32_t), cmp_u32);
+
+    uint32_t mean = frame_cnt ? (uint32_t)(render_sum / frame_cnt) : 0;
+    uint32_t p50 = frame_cnt ? render[(frame_cnt - 1) / 2] : 0;
+    uint32_t p95 = frame_cnt ? render[(frame_cnt - 1) * 95 / 100] : 0;
+    uint32_t max = frame_cnt ? render[frame_cnt - 1] : 0;
+
+    fprintf(out, "    {\n      \"name\": \"%s\",\n      \"frames\": %" PRIu32 ",\n", name, frame_cnt);
+    fprintf(out, "      \"render_us\": {\"total\": %" PRIu64 ", \"mean\": %" PRIu32 ", \"p50\": %" PRIu32
+            ", \"p95\": %" PRIu32 ", \"max\": %" PRIu32 "},\n", render_sum, mean, p50, p95, max);
+    fprintf(out, "      \"px_rendered\": %" PRIu64 ",\n      \"px_flushed\": %" PRIu64 ",\n", px_rendered, px_flushed);
+    fprintf(out, "      \"px_blended\": %" PRIu64 ",\n", px_blended);
+    fprintf(out, "      \"heap_max_used\": %" PRIu32 ",\n", heap_max_used);
+    fprintf(out, "      \"heap_free_biggest_min\": %" PRIu32 ",\n      \"heap_frag_pct_max\": %u,\n",
+            heap_free_biggest_min, (unsigned)heap_frag_pct_max);
+    fprintf(out, "      \"heap_free_hist\": [");
+    for (uint32_t i = 0; i < LV_MEM_MONITOR_FREE_HIST_CNT; i++) {
+        fprintf(out, "%s%zu", i ? ", " : "", mon.free_hist[i]);
+    }
+    fprintf(out, "],\n      \"bulk_max_used\": %zu,\n", bulk_mon.max_used);
+#if LV_USE_TINY_TTF && LV_TINY_TTF_BITMAP_CACHE_SIZE
+    /* -f 指定字体时 TTF 字形位图缓存的最大占用与命中率，用于确定 LV_TINY_TTF_BITMAP_CACHE_SIZE */
+    lv_cache_t *ttf_cache = LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache;
+    fprintf(out, "      \"ttf_cache_max_used\": %zu,\n      \"ttf_cache_hit_pct\": %d,\n", ttf_cache_max_used,
+            ttf_cache ? (int)lv_cache_get_hit_rate(ttf_cache) : 0);
+#endif
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    /* 绘制任务内存：arena 高水位，以及 arena 放不下、改从堆分配的任务数 */
+    fprintf(out, "      \"task_arena_max_used\": %" PRIu32 ",\n      \"task_arena_miss\": %" PRIu32 ",\n",
+            LV_GLOBAL_DEFAULT()->draw_info.task_arena_max_used, LV_GLOBAL_DEFAULT()->draw_info.task_arena_miss_cnt);
+#endif
+    /* 样式属性查询：lv_obj_get_style_prop 调用数与实际遍历样式列表（get_prop_core）的次数，
+     * 以及分配了属性缓存的对象数，用于确定 LV_OBJ_STYLE_PROP_CACHE_CNT */
+    uint32_t prop_cache_cnt = 0;
+    uint32_t prop_cache_size = 0;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_obj_tree_walk(NULL, count_prop_caches_cb, &prop_cache_cnt);
+    prop_cache_size = sizeof(lv_obj_style_prop_cache_t);
+#endif
+    fprintf(out, "      \"style_prop_get\": %" PRIu32 ",\n      \"style_prop_lookup\": %" PRIu32 ",\n",
+            LV_GLOBAL_DEFAULT()->style_prop_get_cnt, LV_GLOBAL_DEFAULT()->style_prop_lookup_cnt);
+    fprintf(out, "      \"style_prop_caches\": %" PRIu32 ",\n      \"style_prop_cache_bytes\": %" PRIu32 ",\n",
+            prop_cache_cnt, prop_cache_cnt * prop_cache_size);
+    fprintf(out, "      \"frame_log\": [");
+
+    for (uint32_t i = 0; i < frame_cnt; i++) {
+        const frame_rec_t *r = &frames[i];
+        fprintf(out, "%s\n        {\"t_ms\": %" PRIu32 ", \"render_us\": %" PRIu32 ", \"px_rendered\": %" PRIu32
+                ", \"px_flushed\": %" PRIu32 ", \"px_blended\": %" PRIu32 ", \"areas\": %u, \"heap_used\": %" PRIu32 ", \"heap_max_used\": %" PRIu32
+                ", \"heap_free_biggest\": %" PRIu32 ", \"heap_frag_pct\": %u, \"tasks\": {",
+                i ? "," : "", r->frame.timestamp, r->frame.render_time, r->frame.px_rendered,
+                r->frame.px_flushed, r->frame.px_blended, (unsigned)r->frame.area_cnt, r->heap_used, r->heap_max_used,
+                r->heap_free_biggest, (unsigned)r->heap_frag_pct);
+        bool first = true;
+        for (uint32_t t = 0; t < LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT; t++) {
+            if (r->frame.task_cnt[t] == 0) continue;
+            const char *tname = t < sizeof(task_names) / sizeof(task_names[0]) ? task_names[t] : "other";
+            fprintf(out, "%s\"%s\": [%u, %" PRIu32 "]", first ? "" : ", ", tname,
+                    (unsigned)r->frame.task_cnt[t], r->frame.task_time[t]);
+            first = false;
+        }
+        fprintf(out, "}}");
+    }
+    fprintf(out, "\n      ]\n    }");
+
+    fprintf(stderr, "%-14s %6" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %12" PRIu64 " %12" PRIu64 " %10" PRIu32
+            " %10" PRIu32 " %6u\n", name, frame_cnt, mean, p95, max, px_rendered, px_blended, heap_max_used,
+            heap_free_biggest_min, (unsigned)heap_frag_pct_max);
+    free(render);
+}
+
+/* ---------------- 场景运行 ---------------- */
+
+static void run_scenario(const scenario_t *sc, FILE *out)
+{
+    if (trace_path != NULL) {
+        trace_file = fopen(trace_path, "wb");
+        if (trace_file == NULL) {
+            perror(trace_path);
+            _exit(1);
+        }
+    }
+
+    lv_init();
+    lv_mem_add_pool_hint(bulk_pool_mem, sizeof(bulk_pool_mem), LV_MEM_HINT_BULK);
+
+    lv_display_t *disp = lv_display_create(LCD_H_RES, LCD_V_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(disp, draw_buf_mem, NULL, sizeof(draw_buf_mem), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_test_indev_create_all();
+
+    lv_sysmon_frame_log_start(disp);
+    lv_sysmon_frame_log_set_time_cb(disp, time_us);
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+    ui_init();
+
+    for (uint32_t i = 0; i < repeat_cnt; i++) {
+        for (const step_t *s = sc->steps; s->op != STEP_END; s++) {
+            run_step(s);
+        }
+    }
+
+    write_scenario_json(out, sc->name);
+
+    if (trace_file != NULL) {
+        fclose(trace_file);
+        fprintf(stderr, "%s: %" PRIu32 " allocations traced to %s\n", sc->name, trace_next_id, trace_path);
+    }
+}
+
+/* 在子进程中运行，保证每个场景都从全新的 LVGL 堆和 ui.c 静态状态开始 */
+static bool run_isolated(const scenario_t *sc, FILE *out)
+{
+    fflush(out);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        run_scenario(sc, out);
+        fflush(out);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "scenario %s failed (status %d)\n", sc->name, status);
+        return false;
+    }
+    return true;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-o out.json] [-l label] [-s scenario] [-f font.ttf] [-r repeat] [-t trace.bin]\nscenarios:", prog);
+    for (size_t i = 0; i < SCENARIO_CNT; i++) fprintf(stderr, " %s", scenarios[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = NULL;
+    const char *label = "";
+    const char *only = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:l:s:f:r:t:h")) != -1) {
+        switch (opt) {
+        case 'o': out_path = optarg; break;
+        case 'l': label = optarg; break;
+        case 's': only = optarg; break;
+        case 'f': setenv("DESK_AI_FONT_TTF", optarg, 1); break;
+        case 'r': repeat_cnt = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 't': trace_path = optarg; break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    if (trace_path != NULL && only == NULL) {
+        fprintf(stderr, "-t needs a single scenario (-s)\n");
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (only != NULL) {
+        size_t i;
+        for (i = 0; i < SCENARIO_CNT && strcmp(only, scenarios[i].name) != 0; i++) {}
+        if (i == SCENARIO_CNT) {
+            fprintf(stderr, "unknown scenario: %s\n", only);
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *out = stdout;
+    if (out_path != NULL) {
+        out = fopen(out_path, "w");
+        if (out == NULL) {
+            perror(out_path);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n  \"version\": 1,\n  \"label\": \"%s\",\n  \"repeat\": %" PRIu32 ",\n", label, repeat_cnt);
+    fprintf(out, "  \"display\": {\"hor_res\": %d, \"ver_res\": %d, \"color_format\": \"RGB565_SWAPPED\", "
+            "\"buf_lines\": %d, \"lv_mem_size\": %d, \"occlusion_culling\": %d},\n", LCD_H_RES, LCD_V_RES, LCD_BUF_LINES,
+            (int)LV_MEM_SIZE, LV_DRAW_OCCLUSION_CULLING);
+    fprintf(out, "  \"scenarios\": [\n");
+
+    fprintf(stderr, "%-14s %6s %10s %10s %10s %12s %12s %10s %10s %6s\n",
+            "scenario", "frames", "mean [us]", "p95 [us]", "max [us]", "px rendered", "px blended", "heap max",
+            "min biggest", "frag");
+
+    bool ok = true;
+    bool first = true;
+    for (size_t i = 0; i < SCENARIO_CNT; i++) {
+        if (only != NULL && strcmp(only, scenarios[i].name) != 0) continue;
+        if (!first) fprintf(out, ",\n");
+        first = false;
+        if (!run_isolated(&scenarios[i], out)) ok = false;
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+    return ok ? 0 : 1;
+}
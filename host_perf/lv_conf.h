@@ -0,0 +1,46 @@
+/**
+ * 主机性能测试用的 LVGL 配置。
+ * 设备端由 sdkconfig（Kconfig）配置 LVGL，这里只列出与 lv_conf_internal.h 默认值不同的选项，
+ * 修改 sdkconfig 中的 LVGL 选项时请同步修改本文件，否则测试结果与设备不可比。
+ */
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+/* 与设备一致：RGB565、64KB 内置堆、33ms 刷新周期 */
+#define LV_COLOR_DEPTH              16
+#define LV_MEM_SIZE                 (64 * 1024U)
+#define LV_DEF_REFR_PERIOD          33
+/* cmake -DDESK_AI_OCCLUSION_CULLING=OFF 可关闭遮挡剔除，用 full_redraw 场景比较开关前后 */
+#ifndef LV_DRAW_OCCLUSION_CULLING
+#define LV_DRAW_OCCLUSION_CULLING   1
+#endif
+#define LV_REFR_RENDER_LIST         1
+#define LV_DRAW_TASK_ARENA_SIZE     4096
+/* reply_font.c 用 lv_binfont_create_from_buffer 解析后端下发的字体片段 */
+#define LV_USE_FS_MEMFS             1
+#define LV_FS_MEMFS_LETTER          'M'
+#define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE 8192
+#define LV_LABEL_LINE_CACHE         1
+/* cmake -DDESK_AI_STYLE_PROP_CACHE_CNT=N 可比较不同的属性缓存大小（0 为关闭） */
+#ifndef LV_OBJ_STYLE_PROP_CACHE_CNT
+#define LV_OBJ_STYLE_PROP_CACHE_CNT 32
+#endif
+#define LV_TEXT_GLYPH_RUN_CACHE_SIZE 4096
+/* flash_font.c：tiny_ttf 渲染 mmap 的 TTF（主机端为 -f 指定的字体文件） */
+#define LV_USE_TINY_TTF             1
+#define LV_TINY_TTF_BITMAP_CACHE_SIZE 16384
+/* ui.c：状态 subject 在 lv_timer_handler() 中统一通知 */
+#define LV_OBSERVER_DEFERRED_NOTIFY 1
+
+/* 测试专用：模拟输入设备与每帧统计（设备端默认关闭） */
+#define LV_USE_TEST                 1
+#define LV_USE_SYSMON               1
+#define LV_USE_PERF_MONITOR         0
+#define LV_USE_MEM_MONITOR          0
+#define LV_USE_SYSMON_FRAME_LOG     1
+#define LV_SYSMON_FRAME_LOG_CNT     4
+
+#define LV_BUILD_EXAMPLES           0
+#define LV_BUILD_DEMOS              0
+
+#endif /*LV_CONF_H*/
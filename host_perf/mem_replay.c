@@ -0,0 +1,202 @@
+/*
+ * 回放 desk_ai_perf -t 记录的 LVGL 堆分配轨迹，比较不同分配器实现或配置（例如 LV_MEM_SIZE）
+ * 的速度与碎片。与 desk_ai_perf 使用同一个 lv_conf.h 和 LV_MEM_HINT_BULK 内存池大小。
+ *
+ * 用法：mem_replay trace.bin [repeat] [timeline.csv]
+ *   轨迹连续回放 repeat 次（默认 20），每次结束后释放剩余的分配；
+ *   耗时取最快一次，最大空闲块与碎片率在第一次回放中每 1024 次调用采样一次，
+ *   给出 timeline.csv 时把这些采样写成 call,used,free_biggest,frag_pct 时间线。
+ *   最后再单独回放一次，逐次计时得到 malloc/realloc/free 的延迟分布（p50/p99/p99.9/max），
+ *   这一次不计入上面的耗时；clock_gettime 本身的开销另外给出，未从延迟中扣除。
+ *
+ *   cmake -S host_perf -B build_perf && cmake --build build_perf -j
+ *   ./build_perf/desk_ai_perf -s stream_reply -r 265 -t trace.bin -o /dev/null
+ *   ./build_perf/mem_replay trace.bin    # 修改分配器后用同一个 trace.bin 再跑一次比较
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+#include "lvgl.h"
+#include "display.h"
+#include "mem_trace.h"
+
+static uint64_t bulk_pool_mem[LVGL_BULK_POOL_SIZE / sizeof(uint64_t)];
+
+enum {
+    LAT_MALLOC,
+    LAT_REALLOC,
+    LAT_FREE,
+    LAT_CNT,
+};
+
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* 回放一条记录，返回它属于哪一类延迟；失败的分配计入 *fail_cnt（可为 NULL） */
+static int replay_rec(const mem_trace_rec_t *e, void **ptrs, uint32_t *fail_cnt)
+{
+    void *p;
+    switch (e->op) {
+    case MEM_TRACE_MALLOC:
+        ptrs[e->id] = lv_malloc(e->size);
+        break;
+    case MEM_TRACE_MALLOC_ZEROED:
+        ptrs[e->id] = lv_malloc_zeroed(e->size);
+        break;
+    case MEM_TRACE_MALLOC_HINT:
+        ptrs[e->id] = lv_malloc_hint(e->size, (lv_mem_hint_t)e->hint);
+        break;
+    case MEM_TRACE_REALLOC:
+        if (ptrs[e->id] == NULL) return LAT_REALLOC;   /* 录制时也失败了的分配 */
+        p = lv_realloc(ptrs[e->id], e->size);
+        if (p != NULL) ptrs[e->id] = p;
+        else if (fail_cnt) (*fail_cnt)++;
+        return LAT_REALLOC;
+    case MEM_TRACE_FREE:
+    default:
+        lv_free(ptrs[e->id]);
+        ptrs[e->id] = NULL;
+        return LAT_FREE;
+    }
+    if (fail_cnt && ptrs[e->id] == NULL) (*fail_cnt)++;
+    return LAT_MALLOC;
+}
+
+static void free_all(void **ptrs, uint32_t id_cnt)
+{
+    for (uint32_t k = 0; k < id_cnt; k++) {
+        lv_free(ptrs[k]);
+        ptrs[k] = NULL;
+    }
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void print_latency(const char *name, uint32_t *lat, size_t cnt)
+{
+    if (cnt == 0) {
+        printf("%-8s      0 calls\n", name);
+        return;
+    }
+    qsort(lat, cnt, sizeof(uint32_t), cmp_u32);
+    printf("%-8s %6zu calls, p50 %" PRIu32 " ns, p99 %" PRIu32 " ns, p99.9 %" PRIu32 " ns, max %" PRIu32 " ns\n",
+           name, cnt, lat[cnt / 2], lat[cnt * 99 / 100], lat[cnt * 999 / 1000], lat[cnt - 1]);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s trace.bin [repeat] [timeline.csv]\n", argv[0]);
+        return 2;
+    }
+    uint32_t repeat_cnt = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 20;
+    if (repeat_cnt == 0) repeat_cnt = 1;
+    FILE *timeline = NULL;
+    if (argc > 3) {
+        timeline = fopen(argv[3], "w");
+        if (timeline == NULL) {
+            perror(argv[3]);
+            return 1;
+        }
+        fprintf(timeline, "call,used,free_biggest,frag_pct\n");
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    size_t rec_cnt = (size_t)ftell(f) / sizeof(mem_trace_rec_t);
+    fseek(f, 0, SEEK_SET);
+    mem_trace_rec_t *recs = malloc(rec_cnt * sizeof(mem_trace_rec_t));
+    if (recs == NULL || fread(recs, sizeof(mem_trace_rec_t), rec_cnt, f) != rec_cnt) {
+        fprintf(stderr, "can't read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+    uint32_t id_cnt = 0;
+    for (size_t i = 0; i < rec_cnt; i++) {
+        if (recs[i].id >= id_cnt) id_cnt = recs[i].id + 1;
+    }
+    void **ptrs = calloc(id_cnt ? id_cnt : 1, sizeof(void *));
+
+    lv_init();
+    lv_mem_add_pool_hint(bulk_pool_mem, sizeof(bulk_pool_mem), LV_MEM_HINT_BULK);
+
+    uint64_t best_ns = UINT64_MAX;
+    uint32_t fail_cnt = 0;
+    size_t free_biggest_min = SIZE_MAX;
+    uint8_t frag_pct_max = 0;
+    lv_mem_monitor_t end_mon;
+
+    for (uint32_t r = 0; r < repeat_cnt; r++) {
+        uint64_t t0 = time_ns();
+        for (size_t i = 0; i < rec_cnt; i++) {
+            replay_rec(&recs[i], ptrs, r == 0 ? &fail_cnt : NULL);
+
+            if (r == 0 && (i & 1023) == 0) {
+                lv_mem_monitor_t mon;
+                lv_mem_monitor(&mon);
+                if (mon.free_biggest_size < free_biggest_min) free_biggest_min = mon.free_biggest_size;
+                if (mon.frag_pct > frag_pct_max) frag_pct_max = mon.frag_pct;
+                if (timeline) {
+                    fprintf(timeline, "%zu,%zu,%zu,%u\n", i, mon.total_size - mon.free_size,
+                            mon.free_biggest_size, (unsigned)mon.frag_pct);
+                }
+            }
+        }
+        uint64_t dt = time_ns() - t0;
+        if (dt < best_ns) best_ns = dt;
+
+        if (r == 0) lv_mem_monitor(&end_mon);
+        free_all(ptrs, id_cnt);
+    }
+    if (timeline) fclose(timeline);
+
+    /* 逐次计时的一次回放，单独进行以免计时开销混进上面的耗时 */
+    uint32_t *lat[LAT_CNT];
+    size_t lat_cnt[LAT_CNT] = {0};
+    for (int k = 0; k < LAT_CNT; k++) lat[k] = malloc((rec_cnt ? rec_cnt : 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < rec_cnt; i++) {
+        uint64_t t0 = time_ns();
+        int k = replay_rec(&recs[i], ptrs, NULL);
+        uint64_t dt = time_ns() - t0;
+        lat[k][lat_cnt[k]++] = dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt;
+    }
+    free_all(ptrs, id_cnt);
+
+    uint64_t clock_ns = UINT64_MAX;
+    for (int k = 0; k < 1000; k++) {
+        uint64_t t0 = time_ns();
+        uint64_t dt = time_ns() - t0;
+        if (dt < clock_ns) clock_ns = dt;
+    }
+
+    printf("calls %zu, failed %" PRIu32 ", best %.1f ns/call\n", rec_cnt, fail_cnt,
+           rec_cnt ? (double)best_ns / rec_cnt : 0.0);
+    printf("min biggest free %zu B, max frag %u%%\n", free_biggest_min, (unsigned)frag_pct_max);
+    printf("free block histogram at the end:");
+    for (uint32_t i = 0; i < LV_MEM_MONITOR_FREE_HIST_CNT; i++) printf(" %zu", end_mon.free_hist[i]);
+    printf("\n");
+    printf("latency (clock overhead %" PRIu64 " ns included):\n", clock_ns);
+    print_latency("malloc", lat[LAT_MALLOC], lat_cnt[LAT_MALLOC]);
+    print_latency("realloc", lat[LAT_REALLOC], lat_cnt[LAT_REALLOC]);
+    print_latency("free", lat[LAT_FREE], lat_cnt[LAT_FREE]);
+
+    for (int k = 0; k < LAT_CNT; k++) free(lat[k]);
+    free(ptrs);
+    free(recs);
+    return 0;
+}
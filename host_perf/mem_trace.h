@@ -0,0 +1,28 @@
+/*
+ * desk_ai_perf -t 记录、mem_replay 回放的 LVGL 堆分配轨迹格式。
+ *
+ * 文件由连续的 mem_trace_rec_t 组成（主机字节序）。每次分配得到一个新的编号，
+ * realloc 与 free 用编号指代之前的分配，回放时不依赖录制时的地址。
+ * 零长度分配（返回 LVGL 内部的 zero_mem）不占用堆，不记录。
+ */
+#ifndef MEM_TRACE_H
+#define MEM_TRACE_H
+
+#include <stdint.h>
+
+typedef enum {
+    MEM_TRACE_MALLOC,
+    MEM_TRACE_MALLOC_ZEROED,
+    MEM_TRACE_MALLOC_HINT,   /* hint 字段为 lv_mem_hint_t */
+    MEM_TRACE_REALLOC,
+    MEM_TRACE_FREE,
+} mem_trace_op_t;
+
+typedef struct {
+    uint32_t op;    /* mem_trace_op_t */
+    uint32_t id;    /* 分配编号，从 0 开始递增 */
+    uint32_t size;  /* 申请的字节数，FREE 时为 0 */
+    uint32_t hint;
+} mem_trace_rec_t;
+
+#endif /* MEM_TRACE_H */
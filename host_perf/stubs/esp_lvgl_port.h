@@ -0,0 +1,15 @@
+#pragma once
+/* 主机性能测试：单线程运行，LVGL port 锁为空操作 */
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+static inline bool lvgl_port_lock(uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return true;
+}
+
+static inline void lvgl_port_unlock(void)
+{
+}
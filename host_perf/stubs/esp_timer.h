@@ -0,0 +1,9 @@
+#pragma once
+/* 主机性能测试：时间取 LVGL 模拟时钟（lv_test_wait 推进），双击判断等逻辑与回放脚本同步 */
+#include <stdint.h>
+#include "lvgl.h"
+
+static inline int64_t esp_timer_get_time(void)
+{
+    return (int64_t)lv_tick_get() * 1000;
+}
@@ -5,6 +5,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "freertos/stream_buffer.h"
 #include "driver/i2s_std.h"
 #include "driver/gpio.h"
 
@@ -27,6 +28,12 @@ static const char *TAG = "AUDIO";
 #define CHUNK_SAMPLES        1024
 #define CHUNK_BYTES          (CHUNK_SAMPLES * sizeof(int16_t))
 
+/* 流式播放缓冲（PSRAM）：24kHz 约 1.3s，写满时 audio_stream_write 阻塞，网络接收随之放慢 */
+#define STREAM_BUF_BYTES     (64 * 1024)
+#define STREAM_RECV_WAIT_MS  100
+/* audio_stream_stop 之后 play_stream_task 最迟在一次 I2S 写入后退出，start 最多等这么久 */
+#define STREAM_STOP_WAIT_MS  1500
+
 #define RECORD_DONE_BIT      (1u << 0)
 #define RECORD_WAIT_MS       4000
 
@@ -144,22 +151,9 @@ static void record_task(void *arg)
     vTaskDelete(NULL);
 }
 
-static void play_task(void *arg)
+/** 打开扬声器 I2S 通道（16bit 单声道，rate 采样率）并使能，失败返回 NULL */
+static i2s_chan_handle_t spk_channel_open(uint32_t rate)
 {
-    (void)arg;
-    EventBits_t u = xEventGroupWaitBits(s_ev, RECORD_DONE_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(RECORD_WAIT_MS));
-    if (!(u & RECORD_DONE_BIT)) {
-        ESP_LOGW(TAG, "play: no record done, skip");
-        vTaskDelete(NULL);
-        return;
-    }
-    uint32_t n = s_recorded_samples;
-    if (n == 0) {
-        ESP_LOGW(TAG, "play: 0 samples, skip");
-        vTaskDelete(NULL);
-        return;
-    }
-
     i2s_chan_handle_t tx_handle = NULL;
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
     chan_cfg.dma_frame_num = 240;
@@ -167,13 +161,12 @@ static void play_task(void *arg)
 
     esp_err_t ret = i2s_new_channel(&chan_cfg, &tx_handle, NULL);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "i2s_new_channel tx failed %s", esp_err_to_name(ret));
-        vTaskDelete(NULL);
-        return;
+        ESP_LOGE(TAG, "spk: i2s_new_channel failed %s", esp_err_to_name(ret));
+        return NULL;
     }
 
     i2s_std_config_t std_cfg = {
-        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(SAMPLE_RATE_HZ),
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(rate),
         .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO),
         .gpio_cfg = {
             .mclk = I2S_GPIO_UNUSED,
@@ -187,16 +180,38 @@ static void play_task(void *arg)
 
     ret = i2s_channel_init_std_mode(tx_handle, &std_cfg);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "i2s_channel_init_std_mode tx failed %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "spk: i2s_channel_init_std_mode failed %s", esp_err_to_name(ret));
         i2s_del_channel(tx_handle);
-        vTaskDelete(NULL);
-        return;
+        return NULL;
     }
 
     ret = i2s_channel_enable(tx_handle);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "i2s_channel_enable tx failed %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "spk: i2s_channel_enable failed %s", esp_err_to_name(ret));
         i2s_del_channel(tx_handle);
+        return NULL;
+    }
+    return tx_handle;
+}
+
+static void play_task(void *arg)
+{
+    (void)arg;
+    EventBits_t u = xEventGroupWaitBits(s_ev, RECORD_DONE_BIT, pdFALSE, pdTRUE, pdMS_TO_TICKS(RECORD_WAIT_MS));
+    if (!(u & RECORD_DONE_BIT)) {
+        ESP_LOGW(TAG, "play: no record done, skip");
+        vTaskDelete(NULL);
+        return;
+    }
+    uint32_t n = s_recorded_samples;
+    if (n == 0) {
+        ESP_LOGW(TAG, "play: 0 samples, skip");
+        vTaskDelete(NULL);
+        return;
+    }
+
+    i2s_chan_handle_t tx_handle = spk_channel_open(SAMPLE_RATE_HZ);
+    if (tx_handle == NULL) {
         vTaskDelete(NULL);
         return;
     }
@@ -210,7 +225,7 @@ static void play_task(void *arg)
             w = chunk;
         }
         size_t written = 0;
-        ret = i2s_channel_write(tx_handle, (const char *)s_record_buf + total_written, w, &written, pdMS_TO_TICKS(1000));
+        esp_err_t ret = i2s_channel_write(tx_handle, (const char *)s_record_buf + total_written, w, &written, pdMS_TO_TICKS(1000));
         if (ret != ESP_OK) {
             break;
         }
@@ -248,51 +263,8 @@ static void play_pcm_task(void *arg)
         return;
     }
 
-    i2s_chan_handle_t tx_handle = NULL;
-    i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
-    chan_cfg.dma_frame_num = 240;
-    chan_cfg.auto_clear_after_cb = true;
-
-    esp_err_t ret = i2s_new_channel(&chan_cfg, &tx_handle, NULL);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "play_pcm: i2s_new_channel failed %s", esp_err_to_name(ret));
-        if (done_cb != NULL) {
-            done_cb(0, 0);
-        }
-        vTaskDelete(NULL);
-        return;
-    }
-
-    i2s_std_clk_config_t clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(rate);
-    i2s_std_slot_config_t slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO);
-    i2s_std_config_t std_cfg = {
-        .clk_cfg = clk_cfg,
-        .slot_cfg = slot_cfg,
-        .gpio_cfg = {
-            .mclk = I2S_GPIO_UNUSED,
-            .bclk = I2S_SPK_BCK_IO,
-            .ws = I2S_SPK_WS_IO,
-            .dout = I2S_SPK_DATA_IO,
-            .din = I2S_GPIO_UNUSED,
-            .invert_flags = { 0 },
-        },
-    };
-
-    ret = i2s_channel_init_std_mode(tx_handle, &std_cfg);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "play_pcm: i2s_channel_init_std_mode failed %s", esp_err_to_name(ret));
-        i2s_del_channel(tx_handle);
-        if (done_cb != NULL) {
-            done_cb(0, 0);
-        }
-        vTaskDelete(NULL);
-        return;
-    }
-
-    ret = i2s_channel_enable(tx_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "play_pcm: i2s_channel_enable failed %s", esp_err_to_name(ret));
-        i2s_del_channel(tx_handle);
+    i2s_chan_handle_t tx_handle = spk_channel_open(rate);
+    if (tx_handle == NULL) {
         if (done_cb != NULL) {
             done_cb(0, 0);
         }
@@ -309,7 +281,7 @@ static void play_pcm_task(void *arg)
             w = chunk;
         }
         size_t written = 0;
-        ret = i2s_channel_write(tx_handle, (const char *)pcm + total_written, w, &written, pdMS_TO_TICKS(1000));
+        esp_err_t ret = i2s_channel_write(tx_handle, (const char *)pcm + total_written, w, &written, pdMS_TO_TICKS(1000));
         if (ret != ESP_OK) {
             break;
         }
@@ -350,6 +322,137 @@ void audio_play_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate_h
     }
 }
 
+/* 流式播放：audio_stream_start 时设置，play_stream_task 读取 */
+static StreamBufferHandle_t s_stream_buf;   /* 首次使用时分配（PSRAM） */
+static volatile bool s_stream_busy;         /* play_stream_task 运行中 */
+static volatile bool s_stream_ended;        /* 不再有新的 PCM，播完缓冲区即结束 */
+static volatile uint32_t s_stream_gen;      /* 每次 start/stop 加一，play_stream_task 发现变化即停止播放 */
+static int16_t s_stream_chunk[CHUNK_SAMPLES];
+static struct {
+    uint32_t sample_rate_hz;
+    audio_play_done_cb_t done_cb;
+    uint32_t gen;
+} s_play_stream_arg;
+
+static void play_stream_task(void *arg)
+{
+    (void)arg;
+    uint32_t rate = s_play_stream_arg.sample_rate_hz;
+    audio_play_done_cb_t done_cb = s_play_stream_arg.done_cb;
+    const uint32_t gen = s_play_stream_arg.gen;
+
+    /* 打开失败也要读空缓冲区，避免写入方一直阻塞 */
+    i2s_chan_handle_t tx_handle = spk_channel_open(rate);
+    uint32_t played = 0;
+    while (gen == s_stream_gen) {
+        size_t n = xStreamBufferReceive(s_stream_buf, s_stream_chunk, CHUNK_BYTES, pdMS_TO_TICKS(STREAM_RECV_WAIT_MS));
+        if (gen != s_stream_gen) {
+            break;
+        }
+        if (n == 0) {
+            if (s_stream_ended && xStreamBufferIsEmpty(s_stream_buf)) {
+                break;
+            }
+            continue;
+        }
+        if (tx_handle != NULL) {
+            size_t written = 0;
+            (void)i2s_channel_write(tx_handle, s_stream_chunk, n, &written, pdMS_TO_TICKS(1000));
+        }
+        played += (uint32_t)(n / sizeof(int16_t));
+    }
+
+    if (tx_handle != NULL) {
+        i2s_channel_disable(tx_handle);
+        i2s_del_channel(tx_handle);
+    }
+    bool stopped = (gen != s_stream_gen);
+    ESP_LOGI(TAG, "play_stream: played %lu samples @ %lu Hz%s", (unsigned long)played, (unsigned long)rate,
+             stopped ? " (stopped)" : "");
+    s_stream_busy = false;
+    /* 被 audio_stream_stop 中断的流不再回调，调用方已经离开了这一轮播放 */
+    if (done_cb != NULL && !stopped) {
+        done_cb(tx_handle != NULL ? played : 0, tx_handle != NULL ? rate : 0);
+    }
+    vTaskDelete(NULL);
+}
+
+bool audio_stream_start(uint32_t sample_rate_hz, audio_play_done_cb_t done_cb)
+{
+    if (sample_rate_hz == 0) {
+        ESP_LOGW(TAG, "play_stream: skip invalid");
+        return false;
+    }
+    /* 上一路已被 audio_stream_stop 中断时，等它的任务退出（最多一次 I2S 写入） */
+    for (uint32_t waited_ms = 0; s_stream_busy && s_stream_ended && waited_ms < STREAM_STOP_WAIT_MS; waited_ms += 10) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    if (s_stream_busy) {
+        ESP_LOGW(TAG, "play_stream: previous stream still playing");
+        return false;
+    }
+    if (s_stream_buf == NULL) {
+        s_stream_buf = xStreamBufferCreateWithCaps(STREAM_BUF_BYTES, 1, MALLOC_CAP_SPIRAM);
+        if (s_stream_buf == NULL) {
+            ESP_LOGE(TAG, "play_stream: stream buffer alloc failed");
+            return false;
+        }
+    }
+    /* 被中断的写入方可能还阻塞在一次 xStreamBufferSend 中（最多 STREAM_RECV_WAIT_MS），此时 reset 会失败 */
+    for (uint32_t waited_ms = 0; xStreamBufferReset(s_stream_buf) != pdPASS && waited_ms < 2 * STREAM_RECV_WAIT_MS;
+         waited_ms += 10) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    s_stream_gen++;
+    s_stream_ended = false;
+    s_stream_busy = true;
+    s_play_stream_arg.sample_rate_hz = sample_rate_hz;
+    s_play_stream_arg.done_cb = done_cb;
+    s_play_stream_arg.gen = s_stream_gen;
+    BaseType_t ok = xTaskCreate(play_stream_task, "play_stream", 4096, NULL, 5, NULL);
+    if (ok != pdPASS) {
+        ESP_LOGE(TAG, "xTaskCreate play_stream failed");
+        s_stream_busy = false;
+        return false;
+    }
+    return true;
+}
+
+uint32_t audio_stream_write(const int16_t *pcm, uint32_t samples, uint32_t timeout_ms)
+{
+    if (!s_stream_busy || s_stream_ended || pcm == NULL) {
+        return 0;
+    }
+    /* 分小段等待，流被 audio_stream_stop 中断时不必等到超时 */
+    const uint32_t gen = s_stream_gen;
+    const size_t bytes = (size_t)samples * sizeof(int16_t);
+    size_t sent = 0;
+    uint32_t waited_ms = 0;
+    while (sent < bytes && gen == s_stream_gen && !s_stream_ended) {
+        sent += xStreamBufferSend(s_stream_buf, (const uint8_t *)pcm + sent, bytes - sent, pdMS_TO_TICKS(STREAM_RECV_WAIT_MS));
+        waited_ms += STREAM_RECV_WAIT_MS;
+        if (waited_ms >= timeout_ms) {
+            break;
+        }
+    }
+    return (uint32_t)(sent / sizeof(int16_t));
+}
+
+void audio_stream_end(void)
+{
+    s_stream_ended = true;
+}
+
+void audio_stream_stop(void)
+{
+    if (!s_stream_busy) {
+        return;
+    }
+    ESP_LOGI(TAG, "play_stream: stop");
+    s_stream_ended = true;
+    s_stream_gen++;
+}
+
 void audio_stop_listening(void)
 {
     s_stop_requested = true;
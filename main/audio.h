@@ -36,6 +36,28 @@ typedef void (*audio_play_done_cb_t)(uint32_t samples, uint32_t sample_rate_hz);
  */
 void audio_play_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate_hz, audio_play_done_cb_t done_cb);
 
+/**
+ * 流式播放（分句回复）：audio_stream_start 之后用 audio_stream_write 逐段追加 PCM（int16 单声道），边收边播；
+ * audio_stream_end 表示不再追加，缓冲区播完后调用 done_cb。同一时间只有一路流，上一路没播完（且未被
+ * audio_stream_stop 中断）时 start 返回 false。
+ */
+bool audio_stream_start(uint32_t sample_rate_hz, audio_play_done_cb_t done_cb);
+
+/**
+ * 追加 PCM 到流式播放缓冲区（拷贝，pcm 调用后即可释放），缓冲区满时最多阻塞 timeout_ms。
+ * 返回实际写入的采样数；没有进行中的流时返回 0。
+ */
+uint32_t audio_stream_write(const int16_t *pcm, uint32_t samples, uint32_t timeout_ms);
+
+/** 结束流式播放的输入；已写入的 PCM 会继续播完。 */
+void audio_stream_end(void);
+
+/**
+ * 中断流式播放：丢弃缓冲区中未播的 PCM，最迟在当前一块写完 I2S 后停止，不再调用 done_cb。
+ * 之后的 audio_stream_write 返回 0；下一次 audio_stream_start 会等这一路的任务退出。
+ */
+void audio_stream_stop(void);
+
 /**
  * 获取最近一次录音的 PCM 缓冲区与采样数（只读，下次 LISTENING 前有效）。
  * 返回采样率固定为 AUDIO_SAMPLE_RATE_HZ，单声道 16bit。
@@ -83,8 +83,9 @@ bool backend_send_fake_data(void)
     return ok;
 }
 
-/* 用于 /upload 响应：body = 纯 JSON（ok, user_text, reply_text），无音频 */
+/* 用于 /upload 响应：事件行（流式）+ JSON（ok, user_text, reply_text, ...）+ 字体片段 + PCM */
 #define REPLY_TEXT_MAX 192
+#define STREAM_SEGMENT_HEAD_MAX 96   /* 带负载的段（font/audio）的 JSON 头最大长度 */
 static bool s_upload_response_ok;
 static uint8_t *s_upload_body_buf = NULL;  /* 动态分配（PSRAM），首次使用时分配 */
 static size_t s_upload_body_len;
@@ -93,6 +94,228 @@ static uint32_t s_reply_pcm_samples;
 static uint32_t s_reply_sample_rate_hz;
 static char s_reply_text[REPLY_TEXT_MAX];       /* user_text（STT）*/
 static char s_reply_reply_text[REPLY_TEXT_MAX]; /* reply_text（LLM），供 UI 显示 */
+static const uint8_t *s_reply_font;   /* reply_text 用到的字形（LVGL binfont 片段），无则为 NULL */
+static uint32_t s_reply_font_size;
+static backend_reply_token_cb_t s_reply_token_cb;
+static backend_reply_audio_cb_t s_reply_audio_cb;
+static backend_reply_font_cb_t s_reply_font_cb;
+static size_t s_reply_reply_len;      /* 流式回复已收到的 reply_text 字节数 */
+static bool s_stream_events_done;     /* 已收到最终的 JSON 头，后面不再有事件行 */
+static volatile bool s_upload_cancelled; /* backend_cancel_reply：本轮已放弃，不再回调、尽快结束接收 */
+
+/** 解析 4 位十六进制数（JSON 的 \\uXXXX），不足 4 位返回 false */
+static bool parse_hex4(const char *s, uint32_t *out)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') {
+            v |= (uint32_t)(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            v |= (uint32_t)(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            v |= (uint32_t)(c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    *out = v;
+    return true;
+}
+
+/**
+ * 取出 JSON 中 "key":"..." 的字符串值（UTF-8），处理常见转义和 \\uXXXX。
+ * 最多写 out_size-1 字节并加 \\0；放不下时在完整字符处截断。找不到 key 返回 -1，否则返回长度。
+ */
+static int json_get_string(const char *json, const char *key, char *out, size_t out_size)
+{
+    char pattern[24];
+    snprintf(pattern, sizeof(pattern), "\"%s\":\"", key);
+    const char *q = strstr(json, pattern);
+    if (q == NULL || out_size == 0) {
+        return -1;
+    }
+    q += strlen(pattern);
+    size_t n = 0;
+    while (*q != '\0' && *q != '"') {
+        char utf8[4];
+        size_t len = 1;
+        uint32_t cp;
+        if (*q != '\\') {
+            /* 原样拷贝一个 UTF-8 字符 */
+            utf8[0] = *q++;
+            while (len < sizeof(utf8) && ((uint8_t)*q & 0xC0) == 0x80) {
+                utf8[len++] = *q++;
+            }
+        } else {
+            q++;
+            switch (*q) {
+            case 'n': cp = '\n'; break;
+            case 'r': cp = '\r'; break;
+            case 't': cp = '\t'; break;
+            case 'b': cp = '\b'; break;
+            case 'f': cp = '\f'; break;
+            case 'u': {
+                uint32_t lo;
+                if (!parse_hex4(q + 1, &cp)) {
+                    cp = 0;
+                    break;
+                }
+                q += 4;
+                /* UTF-16 代理对（BMP 以外的字符，如 emoji） */
+                if (cp >= 0xD800 && cp < 0xDC00 && q[1] == '\\' && q[2] == 'u' && parse_hex4(q + 3, &lo)
+                    && lo >= 0xDC00 && lo < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    q += 6;
+                }
+                break;
+            }
+            case '\0': cp = 0; break;
+            default: cp = (uint8_t)*q; break;  /* 引号、反斜杠、斜杠 */
+            }
+            if (cp == 0) {
+                break;
+            }
+            q++;
+            if (cp < 0x80) {
+                utf8[0] = (char)cp;
+            } else if (cp < 0x800) {
+                utf8[0] = (char)(0xC0 | (cp >> 6));
+                utf8[1] = (char)(0x80 | (cp & 0x3F));
+                len = 2;
+            } else if (cp < 0x10000) {
+                utf8[0] = (char)(0xE0 | (cp >> 12));
+                utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                utf8[2] = (char)(0x80 | (cp & 0x3F));
+                len = 3;
+            } else {
+                utf8[0] = (char)(0xF0 | (cp >> 18));
+                utf8[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+                utf8[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                utf8[3] = (char)(0x80 | (cp & 0x3F));
+                len = 4;
+            }
+        }
+        if (n + len > out_size - 1) {
+            break;
+        }
+        memcpy(out + n, utf8, len);
+        n += len;
+    }
+    out[n] = '\0';
+    return (int)n;
+}
+
+void backend_set_reply_token_cb(backend_reply_token_cb_t cb)
+{
+    s_reply_token_cb = cb;
+}
+
+void backend_set_reply_segment_cbs(backend_reply_font_cb_t font_cb, backend_reply_audio_cb_t audio_cb)
+{
+    s_reply_font_cb = font_cb;
+    s_reply_audio_cb = audio_cb;
+}
+
+void backend_cancel_reply(void)
+{
+    s_upload_cancelled = true;
+}
+
+/** 取出 JSON 中 "key":<无符号整数>，找不到返回 def */
+static uint32_t json_get_uint(const char *json, const char *key, uint32_t def)
+{
+    char pattern[24];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *q = strstr(json, pattern);
+    unsigned int v = 0;
+    if (q == NULL || sscanf(q + strlen(pattern), "%u", &v) != 1) {
+        return def;
+    }
+    return (uint32_t)v;
+}
+
+/** 处理一行流式事件（已去掉换行） */
+static void handle_stream_event(const char *line)
+{
+    if (strstr(line, "\"event\":\"token\"") != NULL) {
+        /* 追加到 reply_text，超出 REPLY_TEXT_MAX 的部分丢弃 */
+        char *dst = s_reply_reply_text + s_reply_reply_len;
+        int n = json_get_string(line, "text", dst, sizeof(s_reply_reply_text) - s_reply_reply_len);
+        if (n > 0) {
+            s_reply_reply_len += (size_t)n;
+            if (s_reply_token_cb != NULL) {
+                s_reply_token_cb(dst);
+            }
+        }
+    } else if (strstr(line, "\"event\":\"user_text\"") != NULL) {
+        if (json_get_string(line, "text", s_reply_text, sizeof(s_reply_text)) > 0) {
+            ESP_LOGI(TAG, "user_text: %s", s_reply_text);
+        }
+    }
+}
+
+/** 处理分句流水线带负载的一段（payload 在缓冲区开头，按 2 字节对齐） */
+static void handle_stream_segment(const char *head, const uint8_t *payload, size_t size)
+{
+    if (strstr(head, "\"event\":\"audio\"") != NULL) {
+        if (s_reply_audio_cb != NULL && size >= sizeof(int16_t)) {
+            uint32_t rate = json_get_uint(head, "sample_rate", 24000);
+            s_reply_audio_cb((const int16_t *)payload, (uint32_t)(size / sizeof(int16_t)), rate);
+        }
+    } else if (strstr(head, "\"event\":\"font\"") != NULL) {
+        if (s_reply_font_cb != NULL) {
+            s_reply_font_cb(payload, (uint32_t)size);
+        }
+    }
+}
+
+/**
+ * 流式回复：处理缓冲区开头已收齐的事件行（以 {"event": 开头），处理完的行从缓冲区移除，
+ * 带 size 的段（分句流水线的 font/audio）等负载也收齐后再处理；
+ * 遇到最终的 JSON 头后停止，剩余数据留给 parse_upload_response_body。
+ */
+static void parse_stream_events(void)
+{
+    static const char event_prefix[] = "{\"event\":";
+    while (!s_stream_events_done && !s_upload_cancelled) {
+        uint8_t *nl = memchr(s_upload_body_buf, '\n', s_upload_body_len);
+        if (nl == NULL) {
+            return;  /* 这一行还没收齐 */
+        }
+        size_t line_len = (size_t)(nl - s_upload_body_buf);
+        if (line_len < sizeof(event_prefix) - 1 || memcmp(s_upload_body_buf, event_prefix, sizeof(event_prefix) - 1) != 0) {
+            s_stream_events_done = true;
+            return;
+        }
+        *nl = '\0';
+        size_t size = json_get_uint((const char *)s_upload_body_buf, "size", 0);
+        if (size == 0) {
+            handle_stream_event((const char *)s_upload_body_buf);
+            s_upload_body_len -= line_len + 1;
+            memmove(s_upload_body_buf, nl + 1, s_upload_body_len);
+            continue;
+        }
+        char head[STREAM_SEGMENT_HEAD_MAX];
+        if (line_len + 1 + size > UPLOAD_BODY_BUF_SIZE || line_len >= sizeof(head)) {
+            ESP_LOGE(TAG, "stream segment too large: head=%u size=%u", (unsigned)line_len, (unsigned)size);
+            s_stream_events_done = true;
+            return;
+        }
+        if (line_len + 1 + size > s_upload_body_len) {
+            *nl = '\n';
+            return;  /* 负载还没收齐 */
+        }
+        /* 先移走头部，负载落在缓冲区开头（对齐），处理完再移走负载 */
+        memcpy(head, s_upload_body_buf, line_len + 1);
+        s_upload_body_len -= line_len + 1;
+        memmove(s_upload_body_buf, nl + 1, s_upload_body_len);
+        handle_stream_segment(head, s_upload_body_buf, size);
+        s_upload_body_len -= size;
+        memmove(s_upload_body_buf, s_upload_body_buf + size, s_upload_body_len);
+    }
+}
 
 /** 解析已收到的 response body（纯 JSON 或 JSON+\\n+PCM），设置 s_upload_response_ok 等 */
 static void parse_upload_response_body(void)
@@ -129,78 +352,25 @@ static void parse_upload_response_body(void)
         ESP_LOGI(TAG, "upload response: %s", (const char *)p);
         return;
     }
+    /* 可选的字体片段：JSON 中 font_size > 0 时紧跟在换行之后，PCM 在其后 */
+    uint32_t font_size = json_get_uint((const char *)p, "font_size", 0);
+    if (font_size > 0 && pcm_start + font_size <= s_upload_body_len) {
+        s_reply_font = p + pcm_start;
+        s_reply_font_size = font_size;
+        pcm_start += font_size;
+    }
     s_reply_pcm = (pcm_start < s_upload_body_len) ? (int16_t *)(p + pcm_start) : NULL;
     s_reply_pcm_samples = (pcm_start < s_upload_body_len) ? (uint32_t)((s_upload_body_len - pcm_start) / 2) : 0;
-    s_reply_sample_rate_hz = 16000;
-    if (s_reply_pcm != NULL) {
-        const char *sr = strstr((const char *)p, "\"sample_rate\":");
-        if (sr != NULL) {
-            unsigned int v = 0;
-            if (sscanf(sr + 14, "%u", &v) == 1) {
-                s_reply_sample_rate_hz = (uint32_t)v;
-            }
-        }
+    s_reply_sample_rate_hz = (s_reply_pcm != NULL) ? json_get_uint((const char *)p, "sample_rate", 16000) : 16000;
+    if (json_get_string((const char *)p, "user_text", s_reply_text, sizeof(s_reply_text)) < 0) {
+        (void)json_get_string((const char *)p, "text", s_reply_text, sizeof(s_reply_text));
     }
-    const char *tv = strstr((const char *)p, "\"user_text\":\"");
-    if (tv != NULL) {
-        const char *q = tv + 14;
-        size_t n = 0;
-        while (n < REPLY_TEXT_MAX - 1 && *q != '\0') {
-            if (*q == '\\' && *(q + 1) == '"') {
-                s_reply_text[n++] = '"';
-                q += 2;
-                continue;
-            }
-            if (*q == '"') {
-                break;
-            }
-            s_reply_text[n++] = *q;
-            q++;
-        }
-        s_reply_text[n] = '\0';
-    } else {
-        tv = strstr((const char *)p, "\"text\":\"");
-        if (tv != NULL) {
-            const char *q = tv + 9;
-            size_t n = 0;
-            while (n < REPLY_TEXT_MAX - 1 && *q != '\0') {
-                if (*q == '\\' && *(q + 1) == '"') {
-                    s_reply_text[n++] = '"';
-                    q += 2;
-                    continue;
-                }
-                if (*q == '"') {
-                    break;
-                }
-                s_reply_text[n++] = *q;
-                q++;
-            }
-            s_reply_text[n] = '\0';
-        }
-    }
-    const char *rv = strstr((const char *)p, "\"reply_text\":\"");
-    if (rv != NULL) {
-        const char *q = rv + 15;
-        size_t n = 0;
-        while (n < REPLY_TEXT_MAX - 1 && *q != '\0') {
-            if (*q == '\\' && *(q + 1) == '"') {
-                s_reply_reply_text[n++] = '"';
-                q += 2;
-                continue;
-            }
-            if (*q == '"') {
-                break;
-            }
-            s_reply_reply_text[n++] = *q;
-            q++;
-        }
-        s_reply_reply_text[n] = '\0';
-        if (n > 0) {
-            ESP_LOGI(TAG, "reply_text: %s", s_reply_reply_text);
-        }
+    if (json_get_string((const char *)p, "reply_text", s_reply_reply_text, sizeof(s_reply_reply_text)) > 0) {
+        ESP_LOGI(TAG, "reply_text: %s", s_reply_reply_text);
     }
-    ESP_LOGI(TAG, "upload response ok, pcm_samples=%lu rate=%lu",
-             (unsigned long)s_reply_pcm_samples, (unsigned long)s_reply_sample_rate_hz);
+    ESP_LOGI(TAG, "upload response ok, pcm_samples=%lu rate=%lu font=%luB",
+             (unsigned long)s_reply_pcm_samples, (unsigned long)s_reply_sample_rate_hz,
+             (unsigned long)s_reply_font_size);
 }
 
 void backend_get_reply_audio(const int16_t **out_pcm, uint32_t *out_samples, uint32_t *out_sample_rate_hz)
@@ -216,6 +386,16 @@ void backend_get_reply_audio(const int16_t **out_pcm, uint32_t *out_samples, uin
     }
 }
 
+void backend_get_reply_font(const uint8_t **out_data, uint32_t *out_size)
+{
+    if (out_data) {
+        *out_data = s_reply_font;
+    }
+    if (out_size) {
+        *out_size = s_reply_font_size;
+    }
+}
+
 void backend_get_reply_text(char *buf, size_t buf_size)
 {
     if (buf == NULL || buf_size == 0) {
@@ -294,6 +474,11 @@ bool backend_send_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate
     s_reply_sample_rate_hz = 0;
     s_reply_text[0] = '\0';
     s_reply_reply_text[0] = '\0';
+    s_reply_font = NULL;
+    s_reply_font_size = 0;
+    s_reply_reply_len = 0;
+    s_stream_events_done = false;
+    s_upload_cancelled = false;
     s_upload_response_ok = false;
     s_upload_body_len = 0;
 
@@ -315,6 +500,7 @@ bool backend_send_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate
     esp_http_client_set_header(client, "X-Sample-Rate", rate_buf);
     esp_http_client_set_header(client, "X-Channels", "1");
     esp_http_client_set_header(client, "X-Format", "pcm16");
+    esp_http_client_set_header(client, "X-Stream", "2");
     esp_http_client_set_post_field(client, (const char *)pcm, (int)body_bytes);
 
     esp_err_t err = esp_http_client_open(client, (int)body_bytes);
@@ -345,23 +531,32 @@ bool backend_send_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate
         esp_http_client_set_timeout_ms(client, UPLOAD_TIMEOUT_MS);
         int r;
         int retries = 0;
-        while (s_upload_body_len < UPLOAD_BODY_BUF_SIZE) {
+        size_t received = 0;
+        while (!s_upload_cancelled && s_upload_body_len < UPLOAD_BODY_BUF_SIZE) {
             size_t space = UPLOAD_BODY_BUF_SIZE - s_upload_body_len;
             r = esp_http_client_read(client, (char *)(s_upload_body_buf + s_upload_body_len), (int)space);
             if (r > 0) {
                 s_upload_body_len += (size_t)r;
+                received += (size_t)r;
                 retries = 0;
+                /* 流式事件边收边处理（回复文字逐段显示、分句音频边收边播），处理完的事件移出缓冲区 */
+                parse_stream_events();
                 continue;
             }
-            if (r == 0 && s_upload_body_len > 0 && s_upload_body_len < 512 && retries < 5) {
+            /* 只收到 JSON（还没有音频）或仍在事件行阶段时，稍等再读 */
+            if (r == 0 && received > 0 && (received < 512 || !s_stream_events_done) && retries < 5) {
                 retries++;
                 vTaskDelay(pdMS_TO_TICKS(100));
                 continue;
             }
             break;
         }
-        ESP_LOGI(TAG, "upload ON_FINISH body_len=%u", (unsigned)s_upload_body_len);
-        parse_upload_response_body();
+        if (s_upload_cancelled) {
+            ESP_LOGI(TAG, "upload cancelled, received=%u", (unsigned)received);
+        } else {
+            ESP_LOGI(TAG, "upload ON_FINISH body_len=%u received=%u", (unsigned)s_upload_body_len, (unsigned)received);
+            parse_upload_response_body();
+        }
     }
     int http_status = esp_http_client_get_status_code(client);
     esp_http_client_close(client);
@@ -12,8 +12,37 @@
 bool backend_send_fake_data(void);
 
 /**
- * 向后端 POST /upload 发送 raw PCM（int16 单声道）。
- * 后端返回 body = 一行 JSON + "\\n" + raw PCM；成功则解析并保存 PCM 供播放。
+ * 流式回复回调：每收到一段 LLM 输出（UTF-8，已追加到 reply_text）调用一次。
+ * 在调用 backend_send_pcm 的任务中执行。
+ */
+typedef void (*backend_reply_token_cb_t)(const char *text);
+
+/** 设置流式回复回调，NULL 表示不需要。 */
+void backend_set_reply_token_cb(backend_reply_token_cb_t cb);
+
+/**
+ * 分句回复回调：后端按句合成的字体片段（LVGL binfont）和音频帧（int16 单声道）每收齐一段调用一次。
+ * 在调用 backend_send_pcm 的任务中执行；数据指向 backend 内部缓冲，只在回调期间有效。
+ * 回调阻塞时接收也随之暂停。
+ */
+typedef void (*backend_reply_font_cb_t)(const uint8_t *data, uint32_t size);
+typedef void (*backend_reply_audio_cb_t)(const int16_t *pcm, uint32_t samples, uint32_t sample_rate_hz);
+
+/** 设置分句回复回调，NULL 表示不需要（丢弃该类数据）。 */
+void backend_set_reply_segment_cbs(backend_reply_font_cb_t font_cb, backend_reply_audio_cb_t audio_cb);
+
+/**
+ * 放弃进行中的 backend_send_pcm（如用户在 SPEAKING 时点击结束本轮）：之后不再调用上面的回调，
+ * 当前一次读取返回后即停止接收，backend_send_pcm 返回 false。下一次 backend_send_pcm 开始时清除。
+ */
+void backend_cancel_reply(void);
+
+/**
+ * 向后端 POST /upload 发送 raw PCM（int16 单声道），请求分句流水线回复（X-Stream: 2）。
+ * 后端边生成边下发事件（{"event":"user_text"|"token","text":...}）和按句合成的字体/音频段
+ * （{"event":"font"|"audio",...,"size":N} + N 字节），边收边交给上面的回调；
+ * 最后是一行 JSON（reply_text 等）。老后端忽略 X-Stream 时 body = 一行 JSON + "\\n" +
+ * [字体片段（font_size 字节）] + raw PCM，成功则解析并保存 PCM 供播放。
  * 需先连上 Wi-Fi。阻塞执行。成功返回 true，失败返回 false。
  */
 bool backend_send_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate_hz);
@@ -24,6 +53,12 @@ bool backend_send_pcm(const int16_t *pcm, uint32_t samples, uint32_t sample_rate
  */
 void backend_get_reply_audio(const int16_t **out_pcm, uint32_t *out_samples, uint32_t *out_sample_rate_hz);
 
+/**
+ * 获取最近一次 /upload 成功返回的字体片段（LVGL binfont，含 reply_text 中的非 ASCII 字符）。
+ * 指向 backend 内部缓冲，下次 upload 前有效；后端未下发时 *out_data 为 NULL、*out_size 为 0。
+ */
+void backend_get_reply_font(const uint8_t **out_data, uint32_t *out_size);
+
 /**
  * 获取最近一次 /upload 成功返回的 STT 文本（user_text）。
  * 拷贝到 buf，最多 buf_size-1 字符并加 \\0 结尾；buf_size 可为 0。
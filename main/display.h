@@ -0,0 +1,14 @@
+#pragma once
+
+/* 屏幕分辨率（ST77916 圆屏，360x360） */
+#define LCD_H_RES  360
+#define LCD_V_RES  360
+
+/* LVGL 绘制缓冲行数（单缓冲，部分刷新，放内部 RAM） */
+#define LCD_BUF_LINES  40
+
+/* LVGL 大块内存池（PSRAM）：字形位图、图片缓存等走 LV_MEM_HINT_BULK，减轻内部 RAM 压力 */
+#define LVGL_BULK_POOL_SIZE  (64 * 1024)
+
+/** 初始化 QSPI 屏幕、触屏与 LVGL port，必须在 ui_init 之前调用 */
+void display_init(void);
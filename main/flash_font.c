@@ -0,0 +1,130 @@
+#include "flash_font.h"
+#include "esp_log.h"
+#include <string.h>
+
+#ifdef UI_HOST_PERF
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include "esp_partition.h"
+#endif
+
+static const char *TAG = "FLASH_FONT";
+
+#define FLASH_FONT_PARTITION          "font"
+#define FLASH_FONT_PARTITION_SUBTYPE  0x40      /* 与 partitions.csv 一致 */
+#define FLASH_FONT_MAX_SIZES          4
+/* 每个字号缓存的字形描述数（字形位图在 tiny_ttf 的共享缓存中） */
+#define FLASH_FONT_GLYPH_CACHE_CNT    64
+
+typedef struct {
+    int32_t px;
+    lv_font_t *font;
+} flash_font_size_t;
+
+static const uint8_t *s_data;
+static size_t s_data_size;
+static bool s_mapped;       /* 已尝试过映射（失败后不再重试） */
+static flash_font_size_t s_sizes[FLASH_FONT_MAX_SIZES];
+
+#ifdef UI_HOST_PERF
+
+/** 主机端：mmap 字体文件代替字体分区 */
+static const uint8_t *map_font(size_t *size)
+{
+    const char *path = getenv("DESK_AI_FONT_TTF");
+    if (path == NULL || path[0] == '\0') return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ESP_LOGW(TAG, "cannot open %s", path);
+        return NULL;
+    }
+    struct stat st;
+    void *p = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);      /* 映射在关闭文件后仍然有效 */
+    if (p == MAP_FAILED) {
+        ESP_LOGW(TAG, "mmap %s failed", path);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    return p;
+}
+
+#else
+
+/** 把字体分区整个映射到数据地址空间（经 flash cache 读取，不占内存）；映射常驻，不再释放 */
+static const uint8_t *map_font(size_t *size)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, FLASH_FONT_PARTITION_SUBTYPE,
+                                                           FLASH_FONT_PARTITION);
+    if (part == NULL) {
+        ESP_LOGI(TAG, "no \"%s\" partition", FLASH_FONT_PARTITION);
+        return NULL;
+    }
+    const void *p = NULL;
+    esp_partition_mmap_handle_t handle;
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &p, &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "mmap failed: %s", esp_err_to_name(err));
+        return NULL;
+    }
+    *size = part->size;
+    return p;
+}
+
+#endif
+
+/** 是否为 TrueType / OpenType 字体（未烧录的分区全是 0xFF） */
+static bool is_font(const uint8_t *data, size_t size)
+{
+    if (size < 12) return false;
+    return memcmp(data, "\x00\x01\x00\x00", 4) == 0 || memcmp(data, "OTTO", 4) == 0 ||
+           memcmp(data, "true", 4) == 0 || memcmp(data, "ttcf", 4) == 0;
+}
+
+lv_font_t *flash_font_get(int32_t px)
+{
+#if LV_USE_TINY_TTF
+    if (!s_mapped) {
+        s_mapped = true;
+        s_data = map_font(&s_data_size);
+        if (s_data != NULL && !is_font(s_data, s_data_size)) {
+            ESP_LOGW(TAG, "\"%s\" partition holds no TTF/OTF font", FLASH_FONT_PARTITION);
+            s_data = NULL;
+        }
+        if (s_data != NULL) ESP_LOGI(TAG, "font mapped (%u bytes)", (unsigned)s_data_size);
+    }
+    if (s_data == NULL) return NULL;
+
+    flash_font_size_t *slot = NULL;
+    for (int i = 0; i < FLASH_FONT_MAX_SIZES; i++) {
+        if (s_sizes[i].font != NULL && s_sizes[i].px == px) return s_sizes[i].font;
+        if (s_sizes[i].font == NULL && slot == NULL) slot = &s_sizes[i];
+    }
+    if (slot == NULL) {
+        ESP_LOGW(TAG, "too many font sizes, %ld px not created", (long)px);
+        return NULL;
+    }
+
+    /* CJK 字体基本没有字偶距，关掉以省去字偶距缓存 */
+    lv_font_t *font = lv_tiny_ttf_create_data_ex(s_data, s_data_size, px, LV_FONT_KERNING_NONE,
+                                                 FLASH_FONT_GLYPH_CACHE_CNT);
+    if (font == NULL) {
+        ESP_LOGE(TAG, "tiny_ttf create failed (%ld px)", (long)px);
+        return NULL;
+    }
+    slot->px = px;
+    slot->font = font;
+    return font;
+#else
+    (void)px;
+    return NULL;
+#endif
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+/**
+ * 字体分区中的矢量字体：分区 "font"（partitions.csv）烧录一份子集化的 TTF/OTF（见 subset_font.py），
+ * 用 esp_partition_mmap 映射进地址空间后交给 tiny_ttf 直接读取，字体数据不占内存。
+ * 同一份字体可以创建任意字号，渲染出的字形位图放在 tiny_ttf 的共享缓存中（LV_TINY_TTF_BITMAP_CACHE_SIZE），按 LRU 淘汰。
+ *
+ * 主机端（UI_HOST_PERF）用 mmap 映射环境变量 DESK_AI_FONT_TTF 指定的字体文件代替分区。
+ */
+
+/**
+ * 获取 px 像素大小的字体，同一字号只创建一次（需在 LVGL 锁内调用）。
+ * 没有字体分区、分区中不是字体或打开失败时返回 NULL。
+ */
+lv_font_t *flash_font_get(int32_t px);
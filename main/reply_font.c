@@ -0,0 +1,298 @@
+#include "reply_font.h"
+#include "flash_font.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_lvgl_port.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "REPLY_FONT";
+
+/* 字形库上限：14px 4bpp 的 CJK 字形约 100B，4096 个字约 400KB PSRAM；满了清空重来 */
+#define REPLY_FONT_MAX_GLYPHS  4096
+/* glyph_dsc.bitmap_index 只有 20 位（LV_FONT_FMT_TXT_LARGE=0），位图总量不能超过 1MB */
+#define REPLY_FONT_MAX_BITMAP  (512 * 1024)
+/* 字体分区中的 TTF 使用的字号，与 Montserrat 14 及后端 GLYPH_FONT_SIZE 一致 */
+#define REPLY_FONT_PX          14
+
+typedef struct {
+    uint32_t letter;
+    uint32_t gid;       /* 片段内的 glyph id */
+} frag_glyph_t;
+
+/* 动态字形库：按码点排序的 glyph_lut（第 i 个字的 glyph id 为 i+1），glyph_dsc[0] 保留 */
+static uint32_t *s_letters;
+static lv_font_fmt_txt_glyph_dsc_t *s_glyph_dsc;
+static uint8_t *s_bitmap;
+static uint32_t s_bitmap_size;      /* 已分配 */
+static uint32_t s_bitmap_len;       /* 已使用 */
+static lv_font_fmt_txt_glyph_cache_t s_glyph_cache;
+static lv_font_fmt_txt_dsc_t s_dsc;
+static lv_font_t s_font;
+
+/* reply_label 使用的字体：内置字体的拷贝，fallback 指向字体分区中的 TTF（没有则直接指向动态字形库） */
+static lv_font_t s_reply_font;
+static bool s_reply_font_inited;
+
+const lv_font_t *reply_font_get(void)
+{
+    if (!s_reply_font_inited) {
+        s_reply_font = lv_font_montserrat_14;
+        s_reply_font.fallback = &s_font;
+
+        s_dsc.bpp = 4;
+        s_dsc.bitmap_format = LV_FONT_FMT_TXT_PLAIN;
+        s_dsc.glyph_lut = NULL;     /* 第一次合并时分配 */
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        s_dsc.glyph_cache = &s_glyph_cache;
+#endif
+        s_font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+        s_font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+        s_font.line_height = lv_font_montserrat_14.line_height;
+        s_font.base_line = lv_font_montserrat_14.base_line;
+        s_font.dsc = &s_dsc;
+
+        /* 字体分区中的字体覆盖绝大部分字符；它缺的字（子集之外）再由后端下发的字形补上 */
+        lv_font_t *ttf = flash_font_get(REPLY_FONT_PX);
+        if (ttf != NULL) {
+            ttf->fallback = &s_font;
+            s_reply_font.fallback = ttf;
+            /* TTF 字体可能已被别的标签用过，改了 fallback 之后它缺字处的字宽会变 */
+            lv_text_glyph_run_cache_drop();
+        }
+        s_reply_font_inited = true;
+    }
+    return &s_reply_font;
+}
+
+static int frag_glyph_cmp(const void *a, const void *b)
+{
+    uint32_t la = ((const frag_glyph_t *)a)->letter;
+    uint32_t lb = ((const frag_glyph_t *)b)->letter;
+    return (la > lb) - (la < lb);
+}
+
+/** 动态字形库中是否已有该字符（二分查找 s_letters） */
+static bool has_letter(uint32_t letter)
+{
+    uint32_t lo = 0;
+    uint32_t hi = s_dsc.glyph_lut_len;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (s_letters[mid] < letter) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < s_dsc.glyph_lut_len && s_letters[lo] == letter;
+}
+
+/**
+ * 按 cmaps 列出片段中的全部 (码点, glyph id)，与 lv_font_fmt_txt.c 的查找规则一致；返回个数。
+ * binfont 加载器已拒绝 glyph id 超出 loca 个数的片段，这里的 id 都可以直接索引 glyph_dsc。
+ */
+static uint32_t collect_frag_glyphs(const lv_font_fmt_txt_dsc_t *fdsc, frag_glyph_t *out)
+{
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t *c = &fdsc->cmaps[i];
+        const uint16_t *ulist = c->unicode_list;
+        switch (c->type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            for (uint32_t r = 0; r < c->range_length; r++) {
+                out[n++] = (frag_glyph_t){ c->range_start + r, c->glyph_id_start + r };
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+            const uint8_t *ofs = c->glyph_id_ofs_list;
+            for (uint32_t r = 0; r < c->range_length; r++) {
+                if (ofs[r] == 0 && r != 0) continue;    /* 缺字 */
+                out[n++] = (frag_glyph_t){ c->range_start + r, c->glyph_id_start + ofs[r] };
+            }
+            break;
+        }
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+            for (uint32_t k = 0; k < c->list_length; k++) {
+                out[n++] = (frag_glyph_t){ c->range_start + ulist[k], c->glyph_id_start + k };
+            }
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+            const uint16_t *ofs = c->glyph_id_ofs_list;
+            for (uint32_t k = 0; k < c->list_length; k++) {
+                out[n++] = (frag_glyph_t){ c->range_start + ulist[k], c->glyph_id_start + ofs[k] };
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return n;
+}
+
+static uint32_t glyph_bitmap_size(const lv_font_fmt_txt_glyph_dsc_t *gd, uint32_t bpp)
+{
+    /* PLAIN 格式、stride 为 0 时各行连续按位存放 */
+    return ((uint32_t)gd->box_w * gd->box_h * bpp + 7) / 8;
+}
+
+/** 清空字形库（LVGL 锁内调用） */
+static void reset_glyphs(void)
+{
+    s_dsc.glyph_lut_len = 0;
+    s_bitmap_len = 0;
+    memset(&s_glyph_cache, 0, sizeof(s_glyph_cache));
+}
+
+static bool alloc_glyph_arrays(void)
+{
+    if (s_letters != NULL) return true;
+    s_letters = heap_caps_malloc(REPLY_FONT_MAX_GLYPHS * sizeof(uint32_t), MALLOC_CAP_SPIRAM);
+    s_glyph_dsc = heap_caps_calloc(REPLY_FONT_MAX_GLYPHS + 1, sizeof(lv_font_fmt_txt_glyph_dsc_t), MALLOC_CAP_SPIRAM);
+    if (s_letters == NULL || s_glyph_dsc == NULL) {
+        ESP_LOGE(TAG, "glyph arrays alloc failed");
+        heap_caps_free(s_letters);
+        heap_caps_free(s_glyph_dsc);
+        s_letters = NULL;
+        s_glyph_dsc = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool reply_font_merge(const uint8_t *data, uint32_t size)
+{
+#if LV_USE_FS_MEMFS
+    if (data == NULL || size == 0) return false;
+    reply_font_get();
+
+    lvgl_port_lock(0);
+    bool ok = false;
+    bool changed = false;   /* 字形库有变化（清空或合并了新字形） */
+    frag_glyph_t *glyphs = NULL;
+
+    /* 片段先用 LVGL 自带的 binfont 加载器解析（临时占用 LVGL 堆），再把字形拷进 PSRAM */
+    lv_font_t *frag = lv_binfont_create_from_buffer((void *)data, size);
+    if (frag == NULL) {
+        ESP_LOGW(TAG, "invalid font fragment (%lu bytes)", (unsigned long)size);
+        goto out;
+    }
+    const lv_font_fmt_txt_dsc_t *fdsc = frag->dsc;
+    if (fdsc->bpp != s_dsc.bpp || fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN || fdsc->stride != 0) {
+        ESP_LOGW(TAG, "unsupported fragment: bpp=%d format=%d (expect 4bpp, --no-compress)",
+                 fdsc->bpp, fdsc->bitmap_format);
+        goto out;
+    }
+    if (!alloc_glyph_arrays()) goto out;
+
+    uint32_t max_cnt = 0;
+    for (uint32_t i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t *c = &fdsc->cmaps[i];
+        max_cnt += c->unicode_list ? c->list_length : c->range_length;
+    }
+    glyphs = heap_caps_malloc((max_cnt ? max_cnt : 1) * sizeof(frag_glyph_t), MALLOC_CAP_SPIRAM);
+    if (glyphs == NULL) goto out;
+    uint32_t frag_cnt = collect_frag_glyphs(fdsc, glyphs);
+    qsort(glyphs, frag_cnt, sizeof(frag_glyph_t), frag_glyph_cmp);
+
+    /* 去掉 ASCII，统计片段的全部字符和其中字形库还没有的字符（及位图大小） */
+    uint32_t all_cnt = 0;
+    uint32_t all_bitmap = 0;
+    uint32_t new_cnt = 0;
+    uint32_t new_bitmap = 0;
+    for (uint32_t i = 0; i < frag_cnt; i++) {
+        if (glyphs[i].letter <= 0x7E) continue;
+        uint32_t bsize = glyph_bitmap_size(&fdsc->glyph_dsc[glyphs[i].gid], fdsc->bpp);
+        all_bitmap += bsize;
+        if (!has_letter(glyphs[i].letter)) {
+            new_cnt++;
+            new_bitmap += bsize;
+        }
+        glyphs[all_cnt++] = glyphs[i];
+    }
+    if (new_cnt == 0) {
+        ok = true;
+        goto out;
+    }
+    /* 放不下时清空字形库，之后本条回复用到的字（包括库里原有的）都要从片段重新拷入 */
+    bool reset = s_dsc.glyph_lut_len + new_cnt > REPLY_FONT_MAX_GLYPHS ||
+                 s_bitmap_len + new_bitmap > REPLY_FONT_MAX_BITMAP;
+    if (reset && (all_cnt > REPLY_FONT_MAX_GLYPHS || all_bitmap > REPLY_FONT_MAX_BITMAP)) {
+        ESP_LOGW(TAG, "fragment too large: %lu glyphs, %lu bytes", (unsigned long)all_cnt, (unsigned long)all_bitmap);
+        goto out;
+    }
+    /* 下面会改动 glyph id，先按旧的 id 清掉 LVGL 位图缓存里本字体的字形 */
+    lv_font_fmt_txt_bitmap_cache_drop(&s_font);
+    /* 新字形会改变原先缺字（占位符）处的字宽，已排好的字形序列也要清掉 */
+    lv_text_glyph_run_cache_drop();
+    if (reset) {
+        ESP_LOGI(TAG, "glyph store full (%lu glyphs), reset", (unsigned long)s_dsc.glyph_lut_len);
+        reset_glyphs();
+        changed = true;
+        new_cnt = all_cnt;
+        new_bitmap = all_bitmap;
+    } else {
+        /* 只保留字形库中还没有的字符 */
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < all_cnt; i++) {
+            if (!has_letter(glyphs[i].letter)) glyphs[n++] = glyphs[i];
+        }
+    }
+    if (s_bitmap_len + new_bitmap > s_bitmap_size) {
+        /* 按 16KB 取整扩容，减少 realloc 次数 */
+        uint32_t want = (s_bitmap_len + new_bitmap + 16 * 1024 - 1) & ~(uint32_t)(16 * 1024 - 1);
+        uint8_t *p = heap_caps_realloc(s_bitmap, want, MALLOC_CAP_SPIRAM);
+        if (p == NULL) {
+            ESP_LOGE(TAG, "bitmap realloc failed (%lu bytes)", (unsigned long)want);
+            goto out;
+        }
+        s_bitmap = p;
+        s_bitmap_size = want;
+        s_dsc.glyph_bitmap = s_bitmap;
+    }
+
+    /* 从尾部归并两个有序列表，glyph id 随位置整体后移；位图只追加不移动 */
+    int32_t old_i = (int32_t)s_dsc.glyph_lut_len - 1;
+    int32_t new_i = (int32_t)new_cnt - 1;
+    uint32_t dst = s_dsc.glyph_lut_len + new_cnt;
+    while (new_i >= 0) {
+        dst--;
+        if (old_i >= 0 && s_letters[old_i] > glyphs[new_i].letter) {
+            s_letters[dst] = s_letters[old_i];
+            s_glyph_dsc[dst + 1] = s_glyph_dsc[old_i + 1];
+            old_i--;
+        } else {
+            const lv_font_fmt_txt_glyph_dsc_t *gd = &fdsc->glyph_dsc[glyphs[new_i].gid];
+            uint32_t bsize = glyph_bitmap_size(gd, fdsc->bpp);
+            memcpy(s_bitmap + s_bitmap_len, fdsc->glyph_bitmap + gd->bitmap_index, bsize);
+            s_letters[dst] = glyphs[new_i].letter;
+            s_glyph_dsc[dst + 1] = *gd;
+            s_glyph_dsc[dst + 1].bitmap_index = s_bitmap_len;
+            s_bitmap_len += bsize;
+            new_i--;
+        }
+    }
+
+    s_dsc.glyph_dsc = s_glyph_dsc;
+    s_dsc.glyph_lut = s_letters;
+    s_dsc.glyph_lut_len += new_cnt;
+    /* glyph id 变了，清空码点 -> glyph id 缓存 */
+    memset(&s_glyph_cache, 0, sizeof(s_glyph_cache));
+    ESP_LOGI(TAG, "merged %lu glyphs, total %lu glyphs / %lu bytes bitmap", (unsigned long)new_cnt,
+             (unsigned long)s_dsc.glyph_lut_len, (unsigned long)s_bitmap_len);
+    ok = true;
+    changed = true;
+
+out:
+    /* 原先缺字（占位符）处的字宽变了，让各对象重新计算文字尺寸；流式回复的文字先于字形到达，
+     * 标签按占位符宽度缓存的断行（LV_LABEL_LINE_CACHE）和 text_size 随之失效 */
+    if (changed) lv_obj_report_style_change(NULL);
+    heap_caps_free(glyphs);
+    if (frag != NULL) lv_binfont_destroy(frag);
+    lvgl_port_unlock();
+    return ok;
+#else
+    (void)data;
+    (void)size;
+    ESP_LOGW(TAG, "LV_USE_FS_MEMFS disabled, font fragment ignored");
+    return false;
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+/**
+ * reply_label 的字体：内置 Montserrat 14（ASCII），缺字时回退到动态字形库。
+ * 动态字形库常驻 PSRAM，由后端随回复下发的 binfont 片段（reply_text 用到的非 ASCII 字符）逐次合并而成，
+ * 固件中不必再内置 CJK 字库。
+ */
+const lv_font_t *reply_font_get(void);
+
+/**
+ * 把一个 LVGL binfont 片段（lv_font_conv --format bin --no-compress）合并进动态字形库，已有的字符跳过。
+ * 内部加 LVGL 锁；字形库满（REPLY_FONT_MAX_GLYPHS）时先清空。
+ * 字形库有变化时调用 lv_obj_report_style_change(NULL)，已显示的文字按新字宽重新断行。成功返回 true。
+ */
+bool reply_font_merge(const uint8_t *data, uint32_t size);
@@ -2,10 +2,12 @@
 #include "ui.h"
 #include "audio.h"
 #include "backend.h"
+#include "reply_font.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include <string.h>
 
 static const char *TAG = "STATE";
@@ -18,18 +20,71 @@ static char last_reply_text[LAST_REPLY_TEXT_MAX];
 
 /** THINKING 界面至少显示多久（≥300ms，避免一闪而过） */
 #define THINKING_MIN_DISPLAY_MS  300
+/** 分句回复的音频写入播放缓冲区时最多等多久（缓冲区满时按实时速度腾出空间） */
+#define STREAM_WRITE_TIMEOUT_MS  5000
+
+static bool s_reply_streaming;  /* 本轮回复的音频已在按句边收边播 */
+/** 回复轮次：离开 SPEAKING（或未进入 SPEAKING 就离开 THINKING）时加一，作废还在进行的上一轮 */
+static volatile uint32_t s_round;
+static volatile uint32_t s_reply_round;  /* thinking_task 开始时的 s_round，回复回调据此丢弃作废轮次的数据 */
+/** 保护 current_state 和 s_round：检查轮次与切换状态必须是一步，否则触屏取消可能夹在中间。
+ *  只在修改这两个变量时短暂持有，不在持锁时调用 ui/audio/backend（触屏回调持有 LVGL 锁后再来拿它） */
+static SemaphoreHandle_t s_state_mutex;
+
+static bool set_state_in_round(device_state_t new_state, bool check_round, uint32_t round);
 /** 上传后端最长等待：10s 超时，由 backend.c UPLOAD_TIMEOUT_MS 保证 */
 
 /** 音频播放完成回调：自动返回 IDLE 状态 */
 static void audio_play_done_callback(uint32_t samples, uint32_t sample_rate_hz)
 {
+    /* 用户已点击结束播放、甚至开始了新一轮时，迟到的回调不能把新一轮切回 IDLE。
+     * 离开 SPEAKING 会让 s_round 加一，所以只要轮次没变就还在本轮的 SPEAKING */
+    if (current_state != STATE_SPEAKING || !set_state_in_round(STATE_IDLE, true, s_reply_round)) {
+        ESP_LOGI(TAG, "audio play done after leaving SPEAKING, ignored");
+        return;
+    }
     if (samples > 0 && sample_rate_hz > 0) {
         float duration_sec = (float)samples / (float)sample_rate_hz;
-        ESP_LOGI(TAG, "audio play done: %.2f sec, auto return IDLE", duration_sec);
+        ESP_LOGI(TAG, "audio play done: %.2f sec, returned IDLE", duration_sec);
     } else {
-        ESP_LOGI(TAG, "audio play failed, return IDLE");
+        ESP_LOGI(TAG, "audio play failed, returned IDLE");
+    }
+}
+
+/** 分句回复：收到第一帧音频就开始流式播放并切到 SPEAKING，之后的帧追加到播放缓冲区 */
+static void reply_audio_callback(const int16_t *pcm, uint32_t samples, uint32_t sample_rate_hz)
+{
+    if (s_reply_round != s_round) {
+        return;
+    }
+    if (!s_reply_streaming) {
+        if (!audio_stream_start(sample_rate_hz, audio_play_done_callback)) {
+            return;
+        }
+        s_reply_streaming = true;
+        backend_get_reply_text(last_user_text, sizeof(last_user_text));
+        backend_get_reply_reply_text(last_reply_text, sizeof(last_reply_text));
+        ESP_LOGI(TAG, "THINKING: first sentence audio, switch to SPEAKING");
+        if (!set_state_in_round(STATE_SPEAKING, true, s_reply_round)) {
+            /* 启动播放期间本轮被取消：取消时流还没开始，这里自己停掉 */
+            ESP_LOGI(TAG, "THINKING: round cancelled while starting the stream");
+            s_reply_streaming = false;
+            audio_stream_stop();
+            return;
+        }
+    }
+    if (audio_stream_write(pcm, samples, STREAM_WRITE_TIMEOUT_MS) < samples) {
+        ESP_LOGW(TAG, "reply audio: stream buffer full, frame dropped");
+    }
+}
+
+/** 分句回复：每句的字形先于该句音频到达，合并后 reply_label 即可显示 */
+static void reply_font_callback(const uint8_t *data, uint32_t size)
+{
+    if (s_reply_round != s_round) {
+        return;
     }
-    set_state(STATE_IDLE);
+    (void)reply_font_merge(data, size);
 }
 
 static void thinking_task(void *arg)
@@ -47,9 +102,29 @@ static void thinking_task(void *arg)
     ESP_LOGI(TAG, "THINKING: upload %lu samples (min_display=%dms, timeout=10s)", (unsigned long)samples, THINKING_MIN_DISPLAY_MS);
 
     int64_t start_us = esp_timer_get_time();
+    const uint32_t round = s_round;
+    s_reply_round = round;
+    s_reply_streaming = false;
     bool ok = backend_send_pcm(pcm, samples, AUDIO_SAMPLE_RATE_HZ);
     int64_t elapsed_us = esp_timer_get_time() - start_us;
     int64_t min_display_us = (int64_t)THINKING_MIN_DISPLAY_MS * 1000;
+    if (round != s_round) {
+        /* 本轮已被用户结束（播放已停止、状态已离开），不再切换状态 */
+        ESP_LOGI(TAG, "THINKING: reply round cancelled (%lld ms)", (long long)(elapsed_us / 1000));
+        vTaskDelete(NULL);
+        return;
+    }
+    if (s_reply_streaming) {
+        /* 已经在 SPEAKING 播放前面的句子：更新完整的回复文本，结束输入，播完后自动返回 IDLE */
+        if (ok) {
+            backend_get_reply_text(last_user_text, sizeof(last_user_text));
+            backend_get_reply_reply_text(last_reply_text, sizeof(last_reply_text));
+        }
+        ESP_LOGI(TAG, "THINKING: reply stream %s (%lld ms)", ok ? "done" : "failed", (long long)(elapsed_us / 1000));
+        audio_stream_end();
+        vTaskDelete(NULL);
+        return;
+    }
     if (elapsed_us < min_display_us) {
         uint32_t remain_ms = (uint32_t)((min_display_us - elapsed_us) / 1000);
         vTaskDelay(pdMS_TO_TICKS(remain_ms));
@@ -58,17 +133,24 @@ static void thinking_task(void *arg)
     if (ok) {
         backend_get_reply_text(last_user_text, sizeof(last_user_text));
         backend_get_reply_reply_text(last_reply_text, sizeof(last_reply_text));
+        /* 先合并字形再切到 SPEAKING，reply_label 设置文本时即可显示 CJK 等非 ASCII 字符 */
+        const uint8_t *font_data = NULL;
+        uint32_t font_size = 0;
+        backend_get_reply_font(&font_data, &font_size);
+        if (font_data != NULL) {
+            (void)reply_font_merge(font_data, font_size);
+        }
         if (last_user_text[0] != '\0') {
             ESP_LOGI(TAG, "user said: %s", last_user_text);
         }
         ESP_LOGI(TAG, "THINKING: backend ok, auto switch to SPEAKING");
-        /* 自动切换到 SPEAKING 状态，开始播放音频 */
-        set_state(STATE_SPEAKING);
+        /* 自动切换到 SPEAKING 状态，开始播放音频；最短显示等待期间被取消则不切换 */
+        (void)set_state_in_round(STATE_SPEAKING, true, round);
     } else {
         last_user_text[0] = '\0';
         last_reply_text[0] = '\0';
         ESP_LOGW(TAG, "THINKING: backend failed/timeout -> IDLE");
-        set_state(STATE_IDLE);
+        (void)set_state_in_round(STATE_IDLE, true, round);
     }
     vTaskDelete(NULL);
 }
@@ -76,17 +158,43 @@ static void thinking_task(void *arg)
 void state_init(void)
 {
     current_state = STATE_IDLE;
+    s_state_mutex = xSemaphoreCreateMutex();
+    /* 流式回复：LLM 输出边收边追加到回复标签，不必等到 SPEAKING */
+    backend_set_reply_token_cb(ui_reply_append);
+    /* 分句流水线：每句的字形和音频边收边处理，第一句到了就开始播放 */
+    backend_set_reply_segment_cbs(reply_font_callback, reply_audio_callback);
     ESP_LOGI(TAG, "initial state = IDLE");
 }
 
-void set_state(device_state_t new_state)
+/**
+ * 切换状态。check_round 为 true 时只在 s_round 仍等于 round 时切换，检查和切换在同一次持锁内完成
+ * @return 是否切换了状态
+ */
+static bool set_state_in_round(device_state_t new_state, bool check_round, uint32_t round)
 {
-    if (current_state == new_state) return;
-
+    xSemaphoreTake(s_state_mutex, portMAX_DELAY);
+    if ((check_round && round != s_round) || current_state == new_state) {
+        xSemaphoreGive(s_state_mutex);
+        return false;
+    }
+    device_state_t old_state = current_state;
     current_state = new_state;
-    ESP_LOGI(TAG, "state changed to %d", current_state);
+    /* 离开本轮回复 */
+    bool leave_round = old_state == STATE_SPEAKING || (old_state == STATE_THINKING && new_state != STATE_SPEAKING);
+    if (leave_round) {
+        s_round++;
+    }
+    xSemaphoreGive(s_state_mutex);
+
+    ESP_LOGI(TAG, "state changed to %d", new_state);
     ui_update(new_state);
 
+    if (leave_round) {
+        /* 停止流式播放，后端剩余的句子不再接收 */
+        audio_stream_stop();
+        backend_cancel_reply();
+    }
+
     if (new_state == STATE_LISTENING) {
         audio_start_listening();
     }
@@ -101,11 +209,17 @@ void set_state(device_state_t new_state)
         backend_get_reply_audio(&reply_pcm, &reply_samples, &reply_rate);
         if (reply_pcm != NULL && reply_samples > 0 && reply_rate > 0) {
             audio_play_pcm(reply_pcm, reply_samples, reply_rate, audio_play_done_callback);
-        } else {
+        } else if (!s_reply_streaming) {
             /* 无音频时，通过点击手动返回 IDLE */
             ESP_LOGI(TAG, "SPEAKING: no audio, click to return IDLE");
         }
     }
+    return true;
+}
+
+void set_state(device_state_t new_state)
+{
+    (void)set_state_in_round(new_state, false, 0);
 }
 
 device_state_t get_state(void)
@@ -6,37 +6,27 @@
 #include "smile_img.h"
 #include "hand_img.h"
 #include "heart_img.h"
+#include <stdio.h>
 #include "esp_log.h"
 #include "esp_timer.h"
-#include "driver/spi_master.h"
-#include "driver/gpio.h"
-#include "driver/i2c_master.h"
-#include "esp_lcd_panel_io.h"
-#include "esp_lcd_panel_ops.h"
-#include "esp_lcd_st77916.h"
-#include "esp_lcd_touch_cst816s.h"
 #include "esp_lvgl_port.h"
+#include "display.h"
+#include "reply_font.h"
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+#include "esp_cpu.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lvgl_private.h"   /* lv_profiler_builtin_config_t */
+#endif
 
 static const char *TAG = "UI";
 
-/* Waveshare ESP32-S3-LCD-1.85 引脚 (Wiki: Internal Hardware Connection) */
-#define LCD_PCLK   40
-#define LCD_DATA0  46
-#define LCD_DATA1  45
-#define LCD_DATA2  42
-#define LCD_DATA3  41
-#define LCD_CS     21
-#define LCD_RST    -1   /* 板子为 EXIO2，暂不接复位 */
-#define LCD_BL     5
-#define LCD_H_RES  360
-#define LCD_V_RES  360
-#define LCD_HOST   SPI2_HOST
-
-/* 触屏版 ESP32-S3-Touch-LCD-1.85：CST816 I2C */
-#define TP_I2C_SDA  1
-#define TP_I2C_SCL  3
-#define TP_INT      4
-#define TP_RST      -1  /* EXIO1，暂不接 */
+/* 帧日志串口导出；主机性能测试（host_perf）自己读取帧日志，不启用导出 */
+#if LV_USE_SYSMON_FRAME_LOG && !defined(UI_HOST_PERF)
+#define UI_FRAME_LOG_DUMP  1
+#else
+#define UI_FRAME_LOG_DUMP  0
+#endif
 
 static lv_display_t *disp_handle = NULL;
 static lv_obj_t *screen = NULL;
@@ -48,128 +38,93 @@ static lv_obj_t *heart_obj = NULL;     /* 爱心图标对象（IDLE 状态抚摸
 static lv_obj_t *state_label = NULL;   /* 当前 state 名称，便于 debug */
 static lv_obj_t *reply_label = NULL;   /* SPEAKING 时显示后端 reply_text */
 static lv_timer_t *petting_smile_timer = NULL;  /* 抚摸后笑脸持续定时器 */
+static lv_subject_t state_subject;     /* 界面显示的状态：ui_update 设置，观察者更新各对象 */
 
-static bool panel_io_cb(esp_lcd_panel_io_handle_t panel_io,
-                        esp_lcd_panel_io_event_data_t *edata,
-                        void *user_ctx)
+#if UI_FRAME_LOG_DUMP || (LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN)
+/** 把 LVGL 导出的二进制数据按 "<前缀>:<hex>" 行打印到串口，user_data 为前缀 */
+static void hex_dump_write_cb(const void *buf, uint32_t len, void *user_data)
 {
-    (void)panel_io;
-    (void)edata;
-    (void)user_ctx;
-    return false;
+    static const char hex[] = "0123456789abcdef";
+    const uint8_t *p = buf;
+    char line[2 * 96 + 1];
+    while (len > 0) {
+        uint32_t n = len > 96 ? 96 : len;
+        for (uint32_t i = 0; i < n; i++) {
+            line[2 * i] = hex[p[i] >> 4];
+            line[2 * i + 1] = hex[p[i] & 0x0f];
+        }
+        line[2 * n] = '\0';
+        printf("%s:%s\n", (const char *)user_data, line);
+        p += n;
+        len -= n;
+    }
 }
+#endif
 
-void display_init(void)
-{
-    esp_lcd_panel_io_handle_t io_handle = NULL;
-    esp_lcd_panel_handle_t panel_handle = NULL;
+#if UI_FRAME_LOG_DUMP
+/* 帧日志：每隔一段时间把最近的帧统计以 "LVFL:<hex>" 行打印到串口，
+ * 用 managed_components/lvgl__lvgl/scripts/sysmon_frame_log.py 解码 */
+#define FRAME_LOG_DUMP_PERIOD_MS  10000
+#define FRAME_LOG_SHOW_HEATMAP    0     /* 1: 在屏幕上叠加重绘热力图 */
 
-    ESP_LOGI(TAG, "Init QSPI bus");
-    const spi_bus_config_t bus_cfg = ST77916_PANEL_BUS_QSPI_CONFIG(
-        LCD_PCLK,
-        LCD_DATA0,
-        LCD_DATA1,
-        LCD_DATA2,
-        LCD_DATA3,
-        LCD_H_RES * 80 * sizeof(uint16_t));
-    ESP_ERROR_CHECK(spi_bus_initialize(LCD_HOST, &bus_cfg, SPI_DMA_CH_AUTO));
+static uint32_t frame_log_time_us(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
 
-    ESP_LOGI(TAG, "Install panel IO");
-    const esp_lcd_panel_io_spi_config_t io_cfg =
-        ST77916_PANEL_IO_QSPI_CONFIG(LCD_CS, panel_io_cb, NULL);
-    ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)LCD_HOST,
-                                              &io_cfg, &io_handle));
+static void frame_log_dump_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    if (lv_sysmon_frame_log_get_count(disp_handle) == 0) return;
+    lv_sysmon_frame_log_export(disp_handle, hex_dump_write_cb, "LVFL");
+    lv_sysmon_frame_log_reset(disp_handle);
+}
+#endif
 
-    ESP_LOGI(TAG, "Install ST77916 panel");
-    st77916_vendor_config_t vendor_cfg = {
-        .flags = { .use_qspi_interface = 1 },
-    };
-    const esp_lcd_panel_dev_config_t panel_cfg = {
-        .reset_gpio_num = LCD_RST,
-        .rgb_ele_order = LCD_RGB_ELEMENT_ORDER_RGB,
-        .bits_per_pixel = 16,
-        .vendor_config = &vendor_cfg,
-    };
-    ESP_ERROR_CHECK(esp_lcd_new_panel_st77916(io_handle, &panel_cfg, &panel_handle));
-    esp_lcd_panel_reset(panel_handle);
-    esp_lcd_panel_init(panel_handle);
-    esp_lcd_panel_disp_on_off(panel_handle, true);
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+/* LVGL profiler：环形缓冲只保留最近的事件，定时以 "LVPT:<hex>" 行打印到串口，
+ * 用 managed_components/lvgl__lvgl/scripts/profiler_trace.py 转成 Chrome trace / Perfetto 可打开的 JSON。
+ * 相邻两次导出会有重叠，脚本按事件序号去重，可以直接处理整段串口日志 */
+#define PROFILER_DUMP_PERIOD_MS  10000
 
-    /* 背光 */
-    gpio_config_t bl = {
-        .pin_bit_mask = (1ULL << LCD_BL),
-        .mode = GPIO_MODE_OUTPUT,
-        .pull_up_en = GPIO_PULLUP_DISABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&bl);
-    gpio_set_level(LCD_BL, 1);
+static uint64_t profiler_tick_get_cb(void)
+{
+    return (uint64_t)esp_timer_get_time();
+}
 
-    ESP_LOGI(TAG, "Init LVGL port");
-    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
-    ESP_ERROR_CHECK(lvgl_port_init(&lvgl_cfg));
+static int profiler_tid_get_cb(void)
+{
+    /* 以 FreeRTOS 任务句柄区分线程（LVGL 任务、绘制任务、音频任务等） */
+    return (int)(intptr_t)xTaskGetCurrentTaskHandle();
+}
 
-    /* 缩小显存以适配内部 RAM；启用 PSRAM 后仍可改大或恢复双缓冲 */
-    const lvgl_port_display_cfg_t disp_cfg = {
-        .io_handle = io_handle,
-        .panel_handle = panel_handle,
-        .control_handle = NULL,
-        .buffer_size = LCD_H_RES * 40,
-        .double_buffer = false,
-        .hres = LCD_H_RES,
-        .vres = LCD_V_RES,
-        .monochrome = false,
-        .rotation = {
-            .swap_xy = false,
-            .mirror_x = false,
-            .mirror_y = false,
-        },
-        .color_format = LV_COLOR_FORMAT_RGB565,
-        .flags = {
-            .buff_dma = 1,
-            .swap_bytes = 1,  /* 交换字节序以修复颜色显示 */
-        },
-    };
-    disp_handle = lvgl_port_add_disp(&disp_cfg);
+static int profiler_cpu_get_cb(void)
+{
+    return esp_cpu_get_core_id();
+}
 
-    /* 触屏：CST816 I2C → LVGL input */
-    i2c_master_bus_handle_t tp_i2c = NULL;
-    i2c_master_bus_config_t i2c_bus_cfg = {
-        .i2c_port = I2C_NUM_0,
-        .sda_io_num = TP_I2C_SDA,
-        .scl_io_num = TP_I2C_SCL,
-        .clk_source = I2C_CLK_SRC_DEFAULT,
-    };
-    if (i2c_new_master_bus(&i2c_bus_cfg, &tp_i2c) == ESP_OK) {
-        esp_lcd_panel_io_handle_t tp_io = NULL;
-        esp_lcd_panel_io_i2c_config_t tp_io_cfg = ESP_LCD_TOUCH_IO_I2C_CST816S_CONFIG();
-        tp_io_cfg.scl_speed_hz = 400000;
-        if (esp_lcd_new_panel_io_i2c(tp_i2c, &tp_io_cfg, &tp_io) == ESP_OK) {
-            esp_lcd_touch_handle_t tp_handle = NULL;
-            esp_lcd_touch_config_t tp_cfg = {
-                .x_max = LCD_H_RES,
-                .y_max = LCD_V_RES,
-                .rst_gpio_num = TP_RST,
-                .int_gpio_num = TP_INT,
-                .levels = { .reset = 0, .interrupt = 0 },
-                .flags = { .swap_xy = 0, .mirror_x = 0, .mirror_y = 0 },
-            };
-            if (esp_lcd_touch_new_i2c_cst816s(tp_io, &tp_cfg, &tp_handle) == ESP_OK) {
-                const lvgl_port_touch_cfg_t touch_cfg = {
-                    .disp = disp_handle,
-                    .handle = tp_handle,
-                };
-                lvgl_port_add_touch(&touch_cfg);
-                ESP_LOGI(TAG, "Touch CST816 added");
-            }
-        }
-    } else {
-        ESP_LOGW(TAG, "Touch I2C init skip (no touch?)");
-    }
+static void profiler_dump_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    /* 导出期间暂停记录，避免把串口打印本身记进 trace */
+    lv_profiler_builtin_set_enable(false);
+    lv_profiler_builtin_export(hex_dump_write_cb, "LVPT");
+    lv_profiler_builtin_set_enable(true);
+}
 
-    ESP_LOGI(TAG, "Display init done");
+static void profiler_init(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = profiler_tick_get_cb;
+    config.tid_get_cb = profiler_tid_get_cb;
+    config.cpu_get_cb = profiler_cpu_get_cb;
+    config.ring_buffer = true;
+    lv_profiler_builtin_init(&config);
+    lv_timer_create(profiler_dump_timer_cb, PROFILER_DUMP_PERIOD_MS, NULL);
 }
+#endif
 
 /** 双击检测：记录上次点击时间（微秒） */
 static int64_t last_click_time_us = 0;
@@ -299,8 +254,104 @@ static void screen_clicked_cb(lv_event_t *e)
     }
 }
 
+/** 状态观察者：在 LVGL 任务中按最终状态更新界面（LV_OBSERVER_DEFERRED_NOTIFY 时一帧最多一次） */
+static void state_observer_cb(lv_observer_t *observer, lv_subject_t *subject)
+{
+    (void)observer;
+    /* 添加观察者时会立即回调一次，初始界面已在 ui_init 中创建好 */
+    if (lv_subject_get_int(subject) == lv_subject_get_previous_int(subject)) {
+        return;
+    }
+    device_state_t state = (device_state_t)lv_subject_get_int(subject);
+    lv_color_t text_color;
+    const char *state_name;
+    switch (state) {
+        case STATE_IDLE:
+            text_color = lv_color_hex(0xFFFFFF);  /* 白色 */
+            state_name = "IDLE";
+            break;
+        case STATE_LISTENING:
+            text_color = lv_color_hex(0x00CCFF);  /* 亮蓝 */
+            state_name = "LISTENING";
+            break;
+        case STATE_RECORDED:
+            text_color = lv_color_hex(0x00FF88);  /* 亮青绿 */
+            state_name = "RECORDED";
+            break;
+        case STATE_THINKING:
+            text_color = lv_color_hex(0xFFDD00);  /* 亮黄 */
+            state_name = "THINKING";
+            break;
+        case STATE_SPEAKING:
+            text_color = lv_color_hex(0xFF88FF);  /* 亮粉红 */
+            state_name = "SPEAKING";
+            break;
+        default:
+            text_color = lv_color_hex(0xFFFFFF);
+            state_name = "?";
+            break;
+    }
+    /* 不再修改背景颜色，背景始终是图片 */
+    if (state_label != NULL) {
+        lv_label_set_text(state_label, state_name);
+        lv_obj_set_style_text_color(state_label, text_color, 0);
+    }
+    
+    /* 柴犬图片：只在 IDLE 和 THINKING 状态显示 */
+    if (idle_obj != NULL) {
+        if (state == STATE_IDLE || state == STATE_THINKING) {
+            lv_obj_clear_flag(idle_obj, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(idle_obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    
+    /* 笑脸柴犬图片：只在 SPEAKING 和 LISTENING 状态显示 */
+    if (smile_obj != NULL) {
+        if (state == STATE_SPEAKING || state == STATE_LISTENING) {
+            lv_obj_clear_flag(smile_obj, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(smile_obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    
+    /* 手指图标和爱心图标：状态切换时隐藏（只在 IDLE 抚摸时显示）*/
+    if (state != STATE_IDLE) {
+        if (hand_obj != NULL) {
+            lv_obj_add_flag(hand_obj, LV_OBJ_FLAG_HIDDEN);
+        }
+        if (heart_obj != NULL) {
+            lv_obj_add_flag(heart_obj, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    
+    /* 取消抚摸笑脸定时器（如果离开 IDLE 状态）*/
+    if (state != STATE_IDLE && petting_smile_timer != NULL) {
+        lv_timer_del(petting_smile_timer);
+        petting_smile_timer = NULL;
+    }
+    
+    /* 界面比 set_state 晚一帧更新，这期间 ui_reply_append 可能已经追加了本轮的流式文字：
+     * THINKING 不清空（进入 THINKING 前的 LISTENING 已清空），SPEAKING 只在没有流式文字时显示整段回复 */
+    if (reply_label != NULL) {
+        if (state == STATE_SPEAKING) {
+            const char *shown = lv_label_get_text(reply_label);
+            if (shown == NULL || shown[0] == '\0') {
+                const char *txt = state_get_last_reply_text();
+                lv_label_set_text(reply_label, (txt != NULL && txt[0] != '\0') ? txt : "(no reply)");
+            }
+            lv_obj_clear_flag(reply_label, LV_OBJ_FLAG_HIDDEN);
+        } else if (state != STATE_THINKING) {
+            lv_label_set_text(reply_label, "");
+            lv_obj_add_flag(reply_label, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
 void ui_init(void)
 {
+    /* display_init() 创建的屏幕即默认 display（主机性能测试中为模拟屏） */
+    disp_handle = lv_display_get_default();
     if (disp_handle == NULL) {
         ESP_LOGW(TAG, "Display not inited, skip UI init");
         return;
@@ -359,12 +410,32 @@ void ui_init(void)
     /* 回复文本标签 */
     reply_label = lv_label_create(screen);
     lv_obj_set_style_text_color(reply_label, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_text_font(reply_label, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_font(reply_label, reply_font_get(), 0);  /* 缺字时回退到后端下发的字形 */
     lv_label_set_long_mode(reply_label, LV_LABEL_LONG_WRAP);
     lv_obj_set_width(reply_label, LCD_H_RES - 24);
     lv_obj_align(reply_label, LV_ALIGN_CENTER, 0, 0);
     lv_label_set_text(reply_label, "");
     lv_obj_add_flag(reply_label, LV_OBJ_FLAG_HIDDEN);
+
+    /* 其他任务通过 ui_update 设置状态，界面在下一次 lv_timer_handler() 中统一更新 */
+    lv_subject_init_int(&state_subject, STATE_IDLE);
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    lv_subject_set_deferred(&state_subject, true);
+#endif
+    lv_subject_add_observer(&state_subject, state_observer_cb, NULL);
+
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
+    profiler_init();
+#endif
+
+#if UI_FRAME_LOG_DUMP
+    lv_sysmon_frame_log_start(disp_handle);
+    lv_sysmon_frame_log_set_time_cb(disp_handle, frame_log_time_us);
+    lv_timer_create(frame_log_dump_timer_cb, FRAME_LOG_DUMP_PERIOD_MS, NULL);
+#if FRAME_LOG_SHOW_HEATMAP
+    lv_sysmon_show_heatmap(disp_handle);
+#endif
+#endif
     
     lvgl_port_unlock();
     ESP_LOGI(TAG, "UI init with background image (IDLE -[double click]-> LISTENING -> THINKING -> auto SPEAKING -> auto IDLE)");
@@ -375,83 +446,27 @@ void ui_update(device_state_t state)
     if (screen == NULL) {
         return;
     }
-    lv_color_t text_color;
-    const char *state_name;
-    switch (state) {
-        case STATE_IDLE:
-            text_color = lv_color_hex(0xFFFFFF);  /* 白色 */
-            state_name = "IDLE";
-            break;
-        case STATE_LISTENING:
-            text_color = lv_color_hex(0x00CCFF);  /* 亮蓝 */
-            state_name = "LISTENING";
-            break;
-        case STATE_RECORDED:
-            text_color = lv_color_hex(0x00FF88);  /* 亮青绿 */
-            state_name = "RECORDED";
-            break;
-        case STATE_THINKING:
-            text_color = lv_color_hex(0xFFDD00);  /* 亮黄 */
-            state_name = "THINKING";
-            break;
-        case STATE_SPEAKING:
-            text_color = lv_color_hex(0xFF88FF);  /* 亮粉红 */
-            state_name = "SPEAKING";
-            break;
-        default:
-            text_color = lv_color_hex(0xFFFFFF);
-            state_name = "?";
-            break;
-    }
+    /* 只记下新状态，持锁时间很短；多个任务在一帧内连续切换状态时界面只按最终状态更新一次。
+     * set_state 在状态锁外调用这里，两个任务同时切换时调用顺序不定，所以写入当前状态而不是参数 */
+    (void)state;
     lvgl_port_lock(0);
-    /* 不再修改背景颜色，背景始终是图片 */
-    if (state_label != NULL) {
-        lv_label_set_text(state_label, state_name);
-        lv_obj_set_style_text_color(state_label, text_color, 0);
-    }
-    
-    /* 柴犬图片：只在 IDLE 和 THINKING 状态显示 */
-    if (idle_obj != NULL) {
-        if (state == STATE_IDLE || state == STATE_THINKING) {
-            lv_obj_clear_flag(idle_obj, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(idle_obj, LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-    
-    /* 笑脸柴犬图片：只在 SPEAKING 和 LISTENING 状态显示 */
-    if (smile_obj != NULL) {
-        if (state == STATE_SPEAKING || state == STATE_LISTENING) {
-            lv_obj_clear_flag(smile_obj, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_obj_add_flag(smile_obj, LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-    
-    /* 手指图标和爱心图标：状态切换时隐藏（只在 IDLE 抚摸时显示）*/
-    if (state != STATE_IDLE) {
-        if (hand_obj != NULL) {
-            lv_obj_add_flag(hand_obj, LV_OBJ_FLAG_HIDDEN);
-        }
-        if (heart_obj != NULL) {
-            lv_obj_add_flag(heart_obj, LV_OBJ_FLAG_HIDDEN);
-        }
-    }
-    
-    /* 取消抚摸笑脸定时器（如果离开 IDLE 状态）*/
-    if (state != STATE_IDLE && petting_smile_timer != NULL) {
-        lv_timer_del(petting_smile_timer);
-        petting_smile_timer = NULL;
+    lv_subject_set_int(&state_subject, get_state());
+    lvgl_port_unlock();
+}
+
+void ui_reply_append(const char *text)
+{
+    if (reply_label == NULL || text == NULL || text[0] == '\0') {
+        return;
     }
-    
-    if (reply_label != NULL) {
-        if (state == STATE_SPEAKING) {
-            const char *txt = state_get_last_reply_text();
-            lv_label_set_text(reply_label, (txt != NULL && txt[0] != '\0') ? txt : "(no reply)");
+    lvgl_port_lock(0);
+    /* 分句流水线在第一句音频到达时就切到 SPEAKING，之后的文字继续追加 */
+    device_state_t state = get_state();
+    if (state == STATE_THINKING || state == STATE_SPEAKING) {
+        /* 追加到末尾：标签只重新断最后几行，行数不变时也只重绘最后几行（LV_LABEL_LINE_CACHE） */
+        lv_label_ins_text(reply_label, LV_LABEL_POS_LAST, text);
+        if (lv_obj_has_flag(reply_label, LV_OBJ_FLAG_HIDDEN)) {
             lv_obj_clear_flag(reply_label, LV_OBJ_FLAG_HIDDEN);
-        } else {
-            lv_label_set_text(reply_label, "");
-            lv_obj_add_flag(reply_label, LV_OBJ_FLAG_HIDDEN);
         }
     }
     lvgl_port_unlock();
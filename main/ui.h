@@ -1,7 +1,12 @@
 #pragma once
 #include "state.h"
+#include "display.h"
 
-/** 初始化显示硬件与 LVGL，必须在 ui_init 之前调用 */
-void display_init(void);
 void ui_init(void);
 void ui_update(device_state_t state);
+
+/**
+ * 流式回复：把后端新收到的一段 reply_text 追加到回复标签，THINKING 期间即逐段显示。
+ * 内部加 LVGL 锁，可在任意任务中调用；不在 THINKING / SPEAKING 状态时忽略。
+ */
+void ui_reply_append(const char *text);
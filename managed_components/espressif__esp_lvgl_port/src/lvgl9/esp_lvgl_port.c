@@ -48,6 +48,10 @@ static lvgl_port_ctx_t lvgl_port_ctx;
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
 static void lvgl_port_task_deinit(void);
+static void lvgl_port_timer_resume_cb(void *data);
+#if CONFIG_LVGL_PORT_TICKLESS
+static uint32_t lvgl_port_tick_get(void);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -104,10 +108,18 @@ esp_err_t lvgl_port_resume(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
+#if CONFIG_LVGL_PORT_TICKLESS
+    /* There is no tick timer, the resume callback wakes the task */
+    if (lvgl_port_ctx.running) {
+        lv_timer_enable(true);
+        ret = ESP_OK;
+    }
+#else
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
     }
+#endif
 
     return ret;
 }
@@ -116,10 +128,17 @@ esp_err_t lvgl_port_stop(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
+#if CONFIG_LVGL_PORT_TICKLESS
+    if (lvgl_port_ctx.running) {
+        lv_timer_enable(false);
+        ret = ESP_OK;
+    }
+#else
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
+#endif
 
     return ret;
 }
@@ -129,6 +148,10 @@ esp_err_t lvgl_port_deinit(void)
     /* Stop running task */
     if (lvgl_port_ctx.running) {
         lvgl_port_ctx.running = false;
+#if CONFIG_LVGL_PORT_TICKLESS
+        /* It might sleep without timeout */
+        lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+#endif
     }
 
     return ESP_OK;
@@ -150,6 +173,25 @@ void lvgl_port_unlock(void)
 
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
 {
+#if CONFIG_LVGL_PORT_TICKLESS
+    if (!lvgl_port_ctx.lvgl_task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Unprocessed events are kept in the notification value */
+    if (xPortInIsrContext() == pdTRUE) {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, event, eSetBits, &xHigherPriorityTaskWoken);
+        if (xHigherPriorityTaskWoken) {
+            portYIELD_FROM_ISR( );
+        }
+    } else if (xTaskGetCurrentTaskHandle() != lvgl_port_ctx.lvgl_task) {
+        /* The LVGL task itself calls lv_timer_handler() before blocking again */
+        xTaskNotify(lvgl_port_ctx.lvgl_task, event, eSetBits);
+    }
+
+    return ESP_OK;
+#else
     EventBits_t bits = 0;
     if (!lvgl_port_ctx.lvgl_events) {
         return ESP_ERR_INVALID_STATE;
@@ -177,6 +219,7 @@ esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
     }
 
     return ESP_OK;
+#endif
 }
 
 IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
@@ -210,13 +253,26 @@ static void lvgl_port_task(void *arg)
     xTaskNotifyGive(task_to_notify);
     /* Tick init */
     lvgl_port_tick_init();
+    /* The task sleeps until the next timer deadline, wake it if a timer gets ready earlier */
+    lv_timer_handler_set_resume_cb(lvgl_port_timer_resume_cb, NULL);
 
     ESP_LOGI(TAG, "Starting LVGL task");
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
+#if CONFIG_LVGL_PORT_TICKLESS
+        /* Sleep until the next LVGL timer deadline (rounded up to RTOS ticks) or until woken */
+        TickType_t wait = portMAX_DELAY;
+        if (task_delay_ms != LV_NO_TIMER_READY) {
+            wait = (task_delay_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+        }
+        uint32_t notified = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &notified, wait);
+        events = notified;
+#else
         /* Wait for queue or timeout (sleep task) */
         TickType_t wait = (pdMS_TO_TICKS(task_delay_ms) >= 1 ? pdMS_TO_TICKS(task_delay_ms) : 1);
         events = xEventGroupWaitBits(lvgl_port_ctx.lvgl_events, 0xFF, pdTRUE, pdFALSE, wait);
+#endif
 
         if (lv_display_get_default() && lvgl_port_lock(0)) {
 
@@ -238,9 +294,11 @@ static void lvgl_port_task(void *arg)
             task_delay_ms = 1; /*Keep trying*/
         }
 
+#if !CONFIG_LVGL_PORT_TICKLESS
         if (task_delay_ms == LV_NO_TIMER_READY) {
             task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
         }
+#endif
 
         /* Minimal dealy for the task. When there is too much events, it takes time for other tasks and interrupts. */
         vTaskDelay(1);
@@ -280,6 +338,15 @@ static void lvgl_port_task_deinit(void)
 #endif
 }
 
+static void lvgl_port_timer_resume_cb(void *data)
+{
+    /* The LVGL task gets the new deadline from lv_timer_handler() anyway */
+    if (xTaskGetCurrentTaskHandle() != lvgl_port_ctx.lvgl_task) {
+        lvgl_port_task_wake(LVGL_PORT_EVENT_TIMER, NULL);
+    }
+}
+
+#if !CONFIG_LVGL_PORT_TICKLESS
 static void lvgl_port_tick_increment(void *arg)
 {
     xSemaphoreTake(lvgl_port_ctx.timer_mux, portMAX_DELAY);
@@ -287,9 +354,20 @@ static void lvgl_port_tick_increment(void *arg)
     lv_tick_inc(lvgl_port_ctx.timer_period_ms);
     xSemaphoreGive(lvgl_port_ctx.timer_mux);
 }
+#else
+static uint32_t lvgl_port_tick_get(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+#endif
 
 static esp_err_t lvgl_port_tick_init(void)
 {
+#if CONFIG_LVGL_PORT_TICKLESS
+    /* The tick is read on demand, nothing runs periodically */
+    lv_tick_set_cb(lvgl_port_tick_get);
+    return ESP_OK;
+#else
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lvgl_port_tick_increment,
@@ -297,4 +375,5 @@ static esp_err_t lvgl_port_tick_init(void)
     };
     ESP_RETURN_ON_ERROR(esp_timer_create(&lvgl_tick_timer_args, &lvgl_port_ctx.tick_timer), TAG, "Creating LVGL timer filed!");
     return esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
+#endif
 }
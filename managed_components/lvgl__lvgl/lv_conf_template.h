@@ -151,6 +151,21 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/** 1: Drop the draw tasks which are fully covered by a later opaque fill or image
+ *     and clip the partially covered fills.
+ *  Without an OS the draw tasks are kept queued until the buffer is flushed so that they can be culled. */
+#define LV_DRAW_OCCLUSION_CULLING 0
+
+/** Store the objects of the refreshed screens with their drawn area in a dense array in paint order.
+ *  It's rebuilt only when the object tree or the geometry changes and used to skip the objects
+ *  out of the refreshed area without touching them. */
+#define LV_REFR_RENDER_LIST 0
+
+/** Size of a buffer from which the draw tasks and their descriptors are allocated
+ *  instead of the heap. It's reset when all the draw tasks of the refreshed area are finished.
+ *  If it's full the heap is used. 0: disable*/
+#define LV_DRAW_TASK_ARENA_SIZE 0   /**< [bytes]*/
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -518,6 +533,12 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Cache this many resolved style properties (per part and state) in each `lv_obj_t`
+ *  so that getting the same property again (e.g. when drawing) is only an array lookup.
+ *  The cache is allocated on the first use and invalidated when any style changes.
+ *  Must be a power of 2. 0: disable */
+#define LV_OBJ_STYLE_PROP_CACHE_CNT 0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -657,6 +678,18 @@
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
+/** Number of entries in the direct mapped codepoint -> glyph ID cache which fonts
+ *  in the built-in format can attach (`glyph_cache` in `lv_font_fmt_txt_dsc_t`).
+ *  It makes repeated lookups in fonts with large sparse cmaps (e.g. CJK) cheap.
+ *  0: disable; otherwise a power of 2, at least 32. Uses 4 bytes per entry per font. */
+#define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 64
+
+/** Size in bytes of the LRU cache of decoded A8 glyph bitmaps shared by the fonts in
+ *  the built-in format. A hit saves unpacking (and decompressing) the glyph on every draw,
+ *  which matters for large glyphs, e.g. CJK. Allocated with `lv_malloc` on demand.
+ *  0: disable. Fonts whose glyphs change need `lv_font_fmt_txt_bitmap_cache_drop()`. */
+#define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE 0
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -687,6 +720,12 @@
  *  Depends on LV_TXT_LINE_BREAK_LONG_LEN. */
 #define LV_TXT_LINE_BREAK_LONG_POST_MIN_LEN 3
 
+/** Size in bytes of the LRU cache of shaped texts (glyph runs): the letters of a text with their
+ *  advance widths including kerning. The size calculation, line breaking and drawing of a text
+ *  use the run instead of looking up every glyph again. Texts shorter than 16 bytes are not cached.
+ *  0: disable. Fonts whose glyphs change need `lv_text_glyph_run_cache_drop()`. */
+#define LV_TEXT_GLYPH_RUN_CACHE_SIZE 0
+
 /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
  *  The direction will be processed according to the Unicode Bidirectional Algorithm:
  *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -767,6 +806,7 @@
     #define LV_LABEL_TEXT_SELECTION 1   /**< Enable selecting text of the label */
     #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /**< The count of wait chart */
+    #define LV_LABEL_LINE_CACHE 0       /**< Store the line breaks of the text to not break it again on redraw and when text is appended */
 #endif
 
 #define LV_USE_LED        1
@@ -988,6 +1028,10 @@
     #define LV_TINY_TTF_FILE_SUPPORT 0
     #define LV_TINY_TTF_CACHE_GLYPH_CNT 128
     #define LV_TINY_TTF_CACHE_KERNING_CNT 256
+    /** Size in bytes of an LRU cache of the rendered A8 glyph bitmaps shared by all the
+     *  Tiny TTF fonts (e.g. the sizes created from the same TTF). Allocated with `lv_malloc`
+     *  when the first font is created. 0: each font caches LV_TINY_TTF_CACHE_GLYPH_CNT bitmaps. */
+    #define LV_TINY_TTF_BITMAP_CACHE_SIZE 0
 #endif
 
 /** Rlottie library */
@@ -1070,6 +1114,20 @@
     #if LV_USE_MEM_MONITOR
         #define LV_USE_MEM_MONITOR_POS LV_ALIGN_BOTTOM_LEFT
     #endif
+
+    /** 1: Record per-frame render statistics (dirty areas, pixels, draw task times)
+     *  into a ring buffer which can be exported in a binary format or shown as a heatmap.
+     *  It's allocated with `lv_malloc()` for each display: 128 bytes + 16 bytes per area for each frame,
+     *  about 8 KB with the defaults, plus 2 bytes per heatmap cell. Increase `LV_MEM_SIZE` accordingly. */
+    #define LV_USE_SYSMON_FRAME_LOG 0
+    #if LV_USE_SYSMON_FRAME_LOG
+        /** Number of frames kept in the ring buffer */
+        #define LV_SYSMON_FRAME_LOG_CNT 32
+        /** Maximum number of invalidated areas stored per frame */
+        #define LV_SYSMON_FRAME_LOG_AREA_CNT 8
+        /** Size of a heatmap cell in pixels */
+        #define LV_SYSMON_HEATMAP_CELL_SIZE 20
+    #endif
 #endif /*LV_USE_SYSMON*/
 
 /** 1: Enable runtime performance profiler */
@@ -1147,6 +1205,11 @@
 
 /** 1: Enable an observer pattern implementation */
 #define LV_USE_OBSERVER 1
+#if LV_USE_OBSERVER
+    /** 1: Subjects can be marked with `lv_subject_set_deferred()` to notify their Observers
+     *  only once in the next `lv_timer_handler()` call with the last value they were set to. */
+    #define LV_OBSERVER_DEFERRED_NOTIFY 0
+#endif
 
 /** 1: Enable Pinyin input method
  *  - Requires: lv_keyboard */
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+
+"""
+Add a flat glyph lookup table (and a glyph ID cache) to a C font generated by lv_font_conv.
+
+`lv_font_get_glyph_dsc_fmt_txt()` walks the `cmaps` of the font for every letter, which
+is slow for large CJK fonts with many ranges and long sparse lists. This script collects
+all code points of the font into one sorted `uint32_t` array so a single binary search
+finds the glyph ID, and attaches an `lv_font_fmt_txt_glyph_cache_t` for the most recent
+letters. Both are guarded so the font still compiles with older LVGL versions.
+
+lv_font_conv assigns the glyph IDs in code point order, so the glyph ID of `glyph_lut[i]`
+is `i + 1`. The script verifies this and refuses to modify the font otherwise.
+
+Usage: python3 scripts/font_glyph_lut.py src/font/lv_font_xyz.c [...]
+"""
+
+import argparse
+import re
+import sys
+
+CUSTOM_DATA_HEADER = ' *  ALL CUSTOM DATA\n *--------------------*/\n\n'
+
+
+def get_arg():
+    parser = argparse.ArgumentParser(description='Add a glyph lookup table to lv_font_conv C fonts.')
+    parser.add_argument('font_files', metavar='font_file', type=str, nargs='+',
+                        help='C font file(s) generated by lv_font_conv.')
+    return parser.parse_args()
+
+
+def parse_array(src, name):
+    m = re.search(r'static const uint(?:8|16)_t ' + name + r'\[\] = \{(.*?)\};', src, re.S)
+    if not m:
+        sys.exit('Array %s not found' % name)
+    return [int(v, 0) for v in m.group(1).replace('\n', ' ').split(',') if v.strip()]
+
+
+def parse_cmaps(src):
+    m = re.search(r'static const lv_font_fmt_txt_cmap_t cmaps\[\] = \{(.*?)\n\};', src, re.S)
+    if not m:
+        sys.exit('cmaps not found')
+
+    cmaps = []
+    for block in re.findall(r'\{(.*?)\}', m.group(1), re.S):
+        fields = dict(re.findall(r'\.(\w+)\s*=\s*([\w]+)', block))
+        cmaps.append({
+            'start': int(fields['range_start'], 0),
+            'length': int(fields['range_length'], 0),
+            'gid_start': int(fields['glyph_id_start'], 0),
+            'unicode_list': None if fields['unicode_list'] == 'NULL' else parse_array(src, fields['unicode_list']),
+            'ofs_list': None if fields['glyph_id_ofs_list'] == 'NULL' else parse_array(src, fields['glyph_id_ofs_list']),
+            'type': fields['type'],
+        })
+    return cmaps
+
+
+def collect_glyphs(cmaps):
+    """Return the (code point, glyph ID) pairs of the font in the same way as `get_glyph_dsc_id()`"""
+    glyphs = []
+    for c in cmaps:
+        if c['type'] == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY':
+            glyphs += [(c['start'] + i, c['gid_start'] + i) for i in range(c['length'])]
+        elif c['type'] == 'LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL':
+            glyphs += [(c['start'] + i, c['gid_start'] + ofs) for i, ofs in enumerate(c['ofs_list'])
+                       if ofs != 0 or i == 0]
+        elif c['type'] == 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY':
+            glyphs += [(c['start'] + rcp, c['gid_start'] + i) for i, rcp in enumerate(c['unicode_list'])]
+        elif c['type'] == 'LV_FONT_FMT_TXT_CMAP_SPARSE_FULL':
+            glyphs += [(c['start'] + rcp, c['gid_start'] + c['ofs_list'][i])
+                       for i, rcp in enumerate(c['unicode_list'])]
+        else:
+            sys.exit('Unknown cmap type ' + c['type'])
+
+    return sorted(glyphs)
+
+
+def convert(path):
+    with open(path) as f:
+        src = f.read()
+
+    if 'glyph_lut' in src:
+        print('%s: already has a glyph_lut, skipped' % path)
+        return
+
+    glyphs = collect_glyphs(parse_cmaps(src))
+    for i, (cp, gid) in enumerate(glyphs):
+        if gid != i + 1:
+            sys.exit('%s: the glyph ID of U+%04X is %d instead of %d' % (path, cp, gid, i + 1))
+
+    rows = []
+    for i in range(0, len(glyphs), 8):
+        rows.append('    ' + ', '.join('0x%x' % cp for cp, _ in glyphs[i:i + 8]))
+
+    lut = ('#if LVGL_VERSION_MAJOR >= 9\n'
+           '/*All the code points in ascending order. The glyph ID of `glyph_lut[i]` is `i + 1`*/\n'
+           'static const uint32_t glyph_lut[] = {\n' + ',\n'.join(rows) + '\n};\n\n'
+           '#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE\n'
+           'static lv_font_fmt_txt_glyph_cache_t glyph_cache;\n'
+           '#endif\n'
+           '#endif\n\n')
+
+    fields = ('#if LVGL_VERSION_MAJOR >= 9\n'
+              '    .glyph_lut = glyph_lut,\n'
+              '    .glyph_lut_len = %d,\n'
+              '#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE\n'
+              '    .glyph_cache = &glyph_cache,\n'
+              '#endif\n'
+              '#endif\n' % len(glyphs))
+
+    if CUSTOM_DATA_HEADER not in src:
+        sys.exit('%s: "ALL CUSTOM DATA" section not found' % path)
+    src = src.replace(CUSTOM_DATA_HEADER, CUSTOM_DATA_HEADER + lut, 1)
+
+    dsc_start = src.find('lv_font_fmt_txt_dsc_t font_dsc = {')
+    dsc_end = src.find('\n};', dsc_start)
+    if dsc_start < 0 or dsc_end < 0:
+        sys.exit('%s: font_dsc not found' % path)
+    src = src[:dsc_end + 1] + fields + src[dsc_end + 1:]
+
+    with open(path, 'w') as f:
+        f.write(src)
+
+    print('%s: %d glyphs' % (path, len(glyphs)))
+
+
+if __name__ == '__main__':
+    args = get_arg()
+    for font_file in args.font_files:
+        convert(font_file)
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+"""
+Convert the binary trace of `lv_profiler_builtin_export()` to the Chrome trace
+event JSON format which can be opened in chrome://tracing or https://ui.perfetto.dev
+
+The input is either the raw binary export or a text log (e.g. a UART capture)
+in which the export was printed as hex chunks on lines starting with `LVPT:`.
+It can contain several consecutive exports, e.g. periodic dumps of the ring
+buffer. They usually overlap, so the events are merged by their sequence number.
+
+Layout (little endian):
+    header: char[4] "LVPT", u16 version, u16 reserved, u32 tick_per_sec,
+            u32 event_cnt, u32 name_cnt, u32 first_seq (version 2+)
+    names:  name_cnt * (u16 len, char[len])
+    events: event_cnt * (u64 tick, u32 value, i32 tid, u16 name_idx, u8 cpu, u8 tag)
+
+Tags: 'B'/'E' duration begin/end, 'C' counter, 's'/'f' flow begin/end,
+      'b'/'e' async begin/end.
+"""
+
+import argparse
+import json
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b'LVPT'
+HEADER_SIZE = {1: 20, 2: 24}
+PID = 1
+
+
+def get_arg():
+    parser = argparse.ArgumentParser(description='Convert an LVGL profiler export to Chrome trace JSON.')
+    parser.add_argument('trace_file', metavar='trace_file', type=str,
+                        help='Binary export or a text log with "LVPT:" hex lines.')
+    parser.add_argument('json_file', metavar='json_file', type=str, nargs='?',
+                        help='The output file. If not provided, defaults to \'<trace_file>.json\'.')
+    return parser.parse_args()
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data.startswith(MAGIC):
+        return data
+
+    # Text capture: concatenate the hex payload of the "LVPT:" lines
+    payload = bytearray()
+    for line in data.decode('utf-8', errors='ignore').splitlines():
+        idx = line.find('LVPT:')
+        if idx >= 0:
+            payload += bytes.fromhex(line[idx + 5:].strip())
+
+    if not payload.startswith(MAGIC):
+        sys.exit('No profiler trace found in ' + path)
+
+    return bytes(payload)
+
+
+def read_events(data):
+    """Yield (tick_per_sec, name, tick, value, tid, cpu, tag) of every export in `data` without repeating events."""
+    ofs = 0
+    next_seq = None
+    while ofs < len(data):
+        magic, version, _, tick_per_sec, event_cnt, name_cnt = struct.unpack_from('<4s2H3I', data, ofs)
+        if magic != MAGIC:
+            sys.exit('Corrupted profiler trace at offset %d' % ofs)
+        if version not in HEADER_SIZE:
+            sys.exit('Unsupported profiler trace version %d' % version)
+
+        # Version 1 has no sequence numbers, its exports can't be merged
+        first_seq = struct.unpack_from('<I', data, ofs + 20)[0] if version >= 2 else None
+        ofs += HEADER_SIZE[version]
+
+        names = []
+        for _ in range(name_cnt):
+            (length,) = struct.unpack_from('<H', data, ofs)
+            names.append(data[ofs + 2:ofs + 2 + length].decode('utf-8', errors='replace'))
+            ofs += 2 + length
+
+        for i in range(event_cnt):
+            tick, value, tid, name_idx, cpu, tag = struct.unpack_from('<QIiHBB', data, ofs)
+            ofs += 20
+            if first_seq is not None:
+                seq = (first_seq + i) & 0xffffffff
+                # Already seen in the previous export (the counter can wrap around)
+                if next_seq is not None and (seq - next_seq) & 0xffffffff >= 0x80000000:
+                    continue
+                next_seq = (seq + 1) & 0xffffffff
+            yield tick_per_sec, names[name_idx], tick, value, tid, cpu, chr(tag)
+
+
+def convert(data):
+    trace = []
+    threads = {}
+    open_async = set()
+    for tick_per_sec, name, tick, value, tid, cpu, tag in read_events(data):
+        ev = {
+            'name': name,
+            'ph': tag,
+            'ts': tick * 1000000 / tick_per_sec,
+            'pid': PID,
+            'tid': tid,
+        }
+        threads.setdefault(tid, cpu)
+
+        if tag in 'BE':
+            ev['args'] = {'cpu': cpu}
+        elif tag == 'C':
+            ev['args'] = {ev['name']: value}
+        elif tag in 'sf':
+            ev['id'] = value
+            ev['cat'] = 'flow'
+            # Bind the flow end to the enclosing slice (e.g. execute_drawing)
+            if tag == 'f':
+                ev['bp'] = 'e'
+        elif tag in 'be':
+            key = (ev['name'], value)
+            # The end of an async event is reported where LVGL notices it, which can happen more than once
+            if tag == 'b':
+                open_async.add(key)
+            elif key in open_async:
+                open_async.remove(key)
+            else:
+                continue
+            ev['id'] = value
+            ev['cat'] = 'async'
+        else:
+            continue
+
+        trace.append(ev)
+
+    for tid, cpu in threads.items():
+        trace.append({'name': 'thread_name', 'ph': 'M', 'pid': PID, 'tid': tid,
+                      'args': {'name': 'LVGL-%d (cpu %d)' % (tid, cpu)}})
+
+    return {'traceEvents': trace, 'displayTimeUnit': 'ms'}
+
+
+if __name__ == '__main__':
+    args = get_arg()
+
+    if not args.json_file:
+        args.json_file = Path(args.trace_file).with_suffix('.json').as_posix()
+
+    print('trace_file:', args.trace_file)
+    print('json_file :', args.json_file)
+
+    trace = convert(load(args.trace_file))
+
+    with open(args.json_file, 'w') as f:
+        json.dump(trace, f)
+
+    print('%d events' % len(trace['traceEvents']))
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+
+"""
+Decode the binary frame log exported by `lv_sysmon_frame_log_export()`.
+
+The input is either the raw binary export or a text log (e.g. a UART capture)
+in which the export was printed as hex chunks on lines starting with `LVFL:`.
+
+Layout (little endian):
+    header: char[4] "LVFL", u16 version, u16 frame_cnt, u16 area_slots,
+            u16 task_type_cnt, u16 hor_res, u16 ver_res, u16 cell_size,
+            u16 heatmap_cols, u16 heatmap_rows, u16 reserved
+    frame:  u32 id, u32 timestamp [ms], u32 render_time [us], u32 flush_wait_time [us],
+            u32 px_rendered, u32 px_flushed, u32 px_blended (version 2+),
+            u32 heap_used, u32 heap_free_biggest, u16 heap_frag_pct (version 3+),
+            u16 area_cnt, u16 area_stored,
+            area_stored * (i16 x1, i16 y1, i16 x2, i16 y2),
+            task_type_cnt * u32 task_time [us], task_type_cnt * u16 task_cnt
+    heatmap: heatmap_cols * heatmap_rows * u16, row by row
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b'LVFL'
+
+# Order of `lv_draw_task_type_t`. VECTOR and 3D are present only if enabled.
+TASK_TYPES = ['none', 'fill', 'border', 'box_shadow', 'letter', 'label', 'image', 'layer',
+              'line', 'arc', 'triangle', 'mask_rect', 'mask_bitmap', 'vector', '3d']
+
+HEAT_CHARS = ' .:-=+*#%@'
+
+
+def get_arg():
+    parser = argparse.ArgumentParser(description='Decode an LVGL sysmon frame log.')
+    parser.add_argument('log_file', metavar='log_file', type=str,
+                        help='Binary export or a text log with "LVFL:" hex lines.')
+    parser.add_argument('--json', action='store_true',
+                        help='Print the decoded log as JSON instead of a table.')
+    return parser.parse_args()
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data.startswith(MAGIC):
+        return data
+
+    # Text capture: concatenate the hex payload of the "LVFL:" lines
+    payload = bytearray()
+    for line in data.decode('utf-8', errors='ignore').splitlines():
+        idx = line.find('LVFL:')
+        if idx >= 0:
+            payload += bytes.fromhex(line[idx + 5:].strip())
+
+    if not payload.startswith(MAGIC):
+        sys.exit('No frame log found in ' + path)
+
+    return bytes(payload)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.ofs = 0
+
+    def read(self, fmt):
+        values = struct.unpack_from('<' + fmt, self.data, self.ofs)
+        self.ofs += struct.calcsize('<' + fmt)
+        return values
+
+
+def decode(data):
+    r = Reader(data)
+    (magic, version, frame_cnt, area_slots, task_type_cnt, hor_res, ver_res,
+     cell_size, cols, rows, _) = r.read('4s10H')
+    if magic != MAGIC or version not in (1, 2, 3):
+        sys.exit('Unsupported frame log version %d' % version)
+
+    log = {
+        'hor_res': hor_res,
+        'ver_res': ver_res,
+        'area_slots': area_slots,
+        'cell_size': cell_size,
+        'frames': [],
+    }
+
+    for _ in range(frame_cnt):
+        (fid, timestamp, render_time, flush_wait_time,
+         px_rendered, px_flushed) = r.read('6I')
+        px_blended = r.read('I')[0] if version >= 2 else None
+        heap = r.read('2IH') if version >= 3 else None
+        (area_cnt, area_stored) = r.read('2H')
+        areas = [list(r.read('4h')) for _ in range(area_stored)]
+        task_time = r.read('%dI' % task_type_cnt)
+        task_cnt = r.read('%dH' % task_type_cnt)
+        tasks = {}
+        for i in range(task_type_cnt):
+            if task_cnt[i]:
+                name = TASK_TYPES[i] if i < len(TASK_TYPES) else str(i)
+                tasks[name] = {'cnt': task_cnt[i], 'time_us': task_time[i]}
+
+        log['frames'].append({
+            'id': fid,
+            'timestamp': timestamp,
+            'render_time_us': render_time,
+            'flush_wait_time_us': flush_wait_time,
+            'px_rendered': px_rendered,
+            'px_flushed': px_flushed,
+            'px_blended': px_blended,
+            'heap_used': heap[0] if heap else None,
+            'heap_free_biggest': heap[1] if heap else None,
+            'heap_frag_pct': heap[2] if heap else None,
+            'area_cnt': area_cnt,
+            'areas': areas,
+            'tasks': tasks,
+        })
+
+    heat = r.read('%dH' % (cols * rows))
+    log['heatmap'] = [list(heat[i * cols:(i + 1) * cols]) for i in range(rows)]
+    return log
+
+
+def print_table(log):
+    print('%dx%d, %d frames' % (log['hor_res'], log['ver_res'], len(log['frames'])))
+    print('%8s %10s %10s %10s %10s %10s %10s %10s %10s %5s %6s  %s' % ('id', 'time [ms]', 'render[us]', 'wait [us]',
+                                                                         'px render', 'px flush', 'px blend',
+                                                                         'heap used', 'heap big', 'frag', 'areas',
+                                                                         'draw tasks [us]'))
+    for f in log['frames']:
+        tasks = ', '.join('%s:%d/%d' % (k, v['cnt'], v['time_us']) for k, v in f['tasks'].items())
+        blended = '-' if f['px_blended'] is None else str(f['px_blended'])
+        if f['heap_used'] is None:
+            heap = ('-', '-', '-')
+        else:
+            heap = (str(f['heap_used']), str(f['heap_free_biggest']), '%d%%' % f['heap_frag_pct'])
+        print('%8d %10d %10d %10d %10d %10d %10s %10s %10s %5s %6d  %s' % (f['id'], f['timestamp'], f['render_time_us'],
+                                                                         f['flush_wait_time_us'], f['px_rendered'],
+                                                                         f['px_flushed'], blended, heap[0], heap[1],
+                                                                         heap[2], f['area_cnt'], tasks))
+
+    max_heat = max((max(row) for row in log['heatmap']), default=0)
+    print('\nHeatmap (%d px cells, max %d):' % (log['cell_size'], max_heat))
+    for row in log['heatmap']:
+        line = ''
+        for v in row:
+            line += HEAT_CHARS[(v * (len(HEAT_CHARS) - 1) + max_heat - 1) // max_heat] if max_heat else ' '
+        print('|' + line + '|')
+
+
+if __name__ == '__main__':
+    args = get_arg()
+    log = decode(load(args.log_file))
+
+    if args.json:
+        print(json.dumps(log, indent=2))
+    else:
+        print_table(log)
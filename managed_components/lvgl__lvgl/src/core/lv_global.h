@@ -51,6 +51,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../others/test/lv_test_private.h"
 #include "../layouts/lv_layout_private.h"
+#include "../core/lv_refr_private.h"
 
 /*********************
  *      DEFINES
@@ -92,12 +93,22 @@ typedef struct _lv_global_t {
     lv_ll_t disp_ll;
     lv_display_t * disp_refresh;
     lv_display_t * disp_default;
+#if LV_REFR_RENDER_LIST
+    lv_refr_render_list_t refr_render_list;
+#endif
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    uint32_t style_prop_cache_generation;
+#endif
+#if LV_USE_SYSMON_FRAME_LOG
+    uint32_t style_prop_get_cnt;        /**< Number of `lv_obj_get_style_prop()` calls (wraps around)*/
+    uint32_t style_prop_lookup_cnt;     /**< Number of style list lookups of an object (wraps around)*/
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -110,6 +121,12 @@ typedef struct _lv_global_t {
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
 
+#if LV_USE_OBSERVER && LV_OBSERVER_DEFERRED_NOTIFY
+    struct _lv_subject_t * subject_deferred_head;   /**< Subjects waiting for `lv_subject_notify_deferred()`*/
+    struct _lv_subject_t * subject_deferred_tail;
+    lv_timer_t * subject_deferred_timer;            /**< Resumed when a Subject is added to the list*/
+#endif
+
     uint32_t memory_zero;
     uint32_t math_rand_seed;
 
@@ -133,6 +150,12 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    lv_cache_t * font_fmt_txt_bitmap_cache;
+#endif
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    lv_cache_t * text_glyph_run_cache;
+#endif
 
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
@@ -207,6 +230,11 @@ typedef struct _lv_global_t {
     struct _lv_freetype_context_t * ft_context;
 #endif
 
+#if LV_USE_TINY_TTF && LV_TINY_TTF_BITMAP_CACHE_SIZE
+    lv_cache_t * tiny_ttf_bitmap_cache;
+    lv_ll_t tiny_ttf_font_ll;   /**< The descriptors of the fonts using `tiny_ttf_bitmap_cache`*/
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
@@ -10,11 +10,12 @@
 #include "../misc/lv_event_private.h"
 #include "../misc/lv_area_private.h"
 #include "lv_obj_style_private.h"
+#include "../misc/lv_style_private.h"
 #include "lv_obj_event_private.h"
 #include "lv_obj_class_private.h"
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_private.h"
-#include "lv_refr.h"
+#include "lv_refr_private.h"
 #include "lv_group.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -265,6 +266,7 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
     obj->flags |= f;
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
+        lv_refr_render_list_invalidate();
         if(lv_obj_has_state(obj, LV_STATE_FOCUSED)) {
             lv_group_t * group = lv_obj_get_group(obj);
             if(group != NULL) {
@@ -307,6 +309,7 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
     obj->flags &= (~f);
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
+        lv_refr_render_list_invalidate();
         lv_obj_invalidate(obj);
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
         lv_obj_mark_layout_as_dirty(obj);
@@ -598,6 +601,7 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_enable_style_refresh(false); /*No need to refresh the style because the object will be deleted*/
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
+    lv_obj_style_prop_cache_free(obj);
 
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
@@ -837,13 +841,6 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_PRESS_LOST) {
         lv_obj_remove_state(obj, LV_STATE_PRESSED);
     }
-    else if(code == LV_EVENT_STYLE_CHANGED) {
-        uint32_t child_cnt = lv_obj_get_child_count(obj);
-        for(uint32_t i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
-        }
-    }
     else if(code == LV_EVENT_KEY) {
         if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CHECKABLE)) {
             uint32_t c = lv_event_get_key(e);
@@ -937,12 +934,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_obj_mark_layout_as_dirty(obj);
         }
 
-        uint32_t i;
-        uint32_t child_cnt = lv_obj_get_child_count(obj);
-        for(i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
-        }
+        lv_obj_mark_children_size_as_dirty(obj, lv_event_get_param(e));
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
         int32_t w = lv_obj_get_style_width(obj, LV_PART_MAIN);
@@ -1001,6 +993,8 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     lv_obj_invalidate(obj);
 
     obj->state = new_state;
+    /*The children might inherit the changed properties*/
+    lv_style_prop_cache_invalidate();
     lv_obj_update_layer_type(obj);
     lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj_class_private.h"
 #include "lv_obj_private.h"
+#include "lv_refr_private.h"
 #include "../themes/lv_theme.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
@@ -98,6 +99,8 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         parent->spec_attr->children[parent->spec_attr->child_cnt - 1] = obj;
     }
 
+    lv_refr_render_list_invalidate();
+
     return obj;
 }
 
@@ -9,6 +9,7 @@
 #include "lv_obj_draw_private.h"
 #include "lv_obj_private.h"
 #include "lv_obj_style.h"
+#include "lv_refr_private.h"
 #include "../display/lv_display.h"
 #include "../indev/lv_indev.h"
 #include "../stdlib/lv_string.h"
@@ -375,7 +376,10 @@ void lv_obj_refresh_ext_draw_size(lv_obj_t * obj)
         obj->spec_attr->ext_draw_size = s_new;
     }
 
-    if(s_new != s_old) lv_obj_invalidate(obj);
+    if(s_new != s_old) {
+        lv_refr_render_list_invalidate();
+        lv_obj_invalidate(obj);
+    }
     LV_PROFILER_DRAW_END;
 }
 
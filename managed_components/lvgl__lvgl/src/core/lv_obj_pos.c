@@ -33,6 +33,8 @@
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static bool depends_on_parent_size(lv_obj_t * obj, bool w_changed, bool h_changed);
+static void scrollbar_invalidate_after_layout(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 static bool is_transformed(const lv_obj_t * obj);
 
@@ -188,10 +190,11 @@ bool lv_obj_refr_size(lv_obj_t * obj)
      *surely the scrollbars also changes so invalidate them*/
     bool on1 = lv_area_is_in(&ori, &parent_fit_area, 0);
     if(!on1)
-        lv_obj_scrollbar_invalidate(parent);
+        scrollbar_invalidate_after_layout(parent);
 
     /*Set the length and height
      *Be sure the content is not scrolled in an invalid position on the new size*/
+    lv_refr_render_list_invalidate();
     obj->coords.y2 = obj->coords.y1 + h - 1;
     if(lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL) {
         obj->coords.x1 = obj->coords.x2 - w + 1;
@@ -215,7 +218,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
     bool on2 = lv_area_is_in(&obj->coords, &parent_fit_area, 0);
     if(on1 || (!on1 && on2))
-        lv_obj_scrollbar_invalidate(parent);
+        scrollbar_invalidate_after_layout(parent);
 
     lv_obj_refresh_ext_draw_size(obj);
 
@@ -304,6 +307,38 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+void lv_obj_mark_children_size_as_dirty(lv_obj_t * obj, const lv_area_t * ori)
+{
+    bool w_changed = ori == NULL || lv_area_get_width(ori) != lv_obj_get_width(obj);
+    bool h_changed = ori == NULL || lv_area_get_height(ori) != lv_obj_get_height(obj);
+    if(!w_changed && !h_changed) return;
+
+    bool marked = false;
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(child->layout_inv || child->size_inv) continue;
+
+        /*Without the original coordinates e.g. the padding or the layout could change too
+         *so update all the children which are not positioned by the layout*/
+        bool dep = ori ? depends_on_parent_size(child, w_changed, h_changed) :
+                   !lv_obj_is_layout_positioned(child) || depends_on_parent_size(child, true, true);
+        if(!dep) continue;
+
+        child->size_inv = 1;
+        marked = true;
+    }
+
+    if(!marked) return;
+
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    scr->scr_layout_inv = 1;
+
+    lv_display_t * disp = lv_obj_get_display(scr);
+    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+}
+
 void lv_obj_update_layout(const lv_obj_t * obj)
 {
     if(update_layout_mutex) {
@@ -750,13 +785,14 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
         /*If the object is already out of the parent and its position is changes
          *surely the scrollbars also changes so invalidate them*/
         on1 = lv_area_is_in(&ori, &parent_fit_area, 0);
-        if(!on1) lv_obj_scrollbar_invalidate(parent);
+        if(!on1) scrollbar_invalidate_after_layout(parent);
     }
 
     obj->coords.x1 += diff.x;
     obj->coords.y1 += diff.y;
     obj->coords.x2 += diff.x;
     obj->coords.y2 += diff.y;
+    lv_refr_render_list_invalidate();
 
     lv_obj_move_children_by(obj, diff.x, diff.y, false);
 
@@ -770,7 +806,7 @@ void lv_obj_move_to(lv_obj_t * obj, int32_t x, int32_t y)
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
     if(parent) {
         bool on2 = lv_area_is_in(&obj->coords, &parent_fit_area, 0);
-        if(on1 || (!on1 && on2)) lv_obj_scrollbar_invalidate(parent);
+        if(on1 || (!on1 && on2)) scrollbar_invalidate_after_layout(parent);
     }
 }
 
@@ -778,6 +814,7 @@ void lv_obj_move_children_by(lv_obj_t * obj, int32_t x_diff, int32_t y_diff, boo
 {
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
+    if(child_cnt) lv_refr_render_list_invalidate();
     for(i = 0; i < child_cnt; i++) {
         lv_obj_t * child = obj->spec_attr->children[i];
         if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
@@ -1242,12 +1279,17 @@ static void layout_update_core(lv_obj_t * obj)
         layout_update_core(child);
     }
 
-    if(obj->layout_inv) {
+    if(obj->layout_inv || obj->size_inv) {
+        /*If only the parent was resized the children need to be updated only if the size changes too*/
+        bool children_inv = obj->layout_inv;
         obj->layout_inv = 0;
-        lv_obj_refr_size(obj);
+        obj->size_inv = 0;
+        if(lv_obj_refr_size(obj)) children_inv = true;
         lv_obj_refr_pos(obj);
 
-        if(child_cnt > 0) {
+        if(child_cnt > 0 && children_inv) {
+            /*The layout uses the new size already, no need to run it again because of LV_EVENT_SIZE_CHANGED*/
+            obj->layout_inv = 0;
             lv_layout_apply(obj);
         }
     }
@@ -1256,6 +1298,91 @@ static void layout_update_core(lv_obj_t * obj)
         obj->readjust_scroll_after_layout = 0;
         lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
     }
+
+    if(obj->scrollbar_inv) {
+        obj->scrollbar_inv = 0;
+        lv_obj_scrollbar_invalidate(obj);
+    }
+}
+
+/**
+ * Invalidate the scrollbars of an object now and once more after the layout update.
+ * Getting the scrollbar area needs to check all the children, so do it only once
+ * if many children are resized or moved.
+ * @param obj   pointer to an object
+ */
+static void scrollbar_invalidate_after_layout(lv_obj_t * obj)
+{
+    if(obj->scrollbar_inv) return;
+
+    lv_obj_scrollbar_invalidate(obj);
+    obj->scrollbar_inv = 1;
+
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    scr->scr_layout_inv = 1;
+}
+
+/**
+ * Tell if the size or position of an object is calculated from the size of its parent
+ * @param obj           pointer to an object
+ * @param w_changed     true: the width of the parent has changed
+ * @param h_changed     true: the height of the parent has changed
+ * @return              true: the object needs to be updated
+ */
+static bool depends_on_parent_size(lv_obj_t * obj, bool w_changed, bool h_changed)
+{
+    if(w_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_width(obj, LV_PART_MAIN)) ||
+           LV_COORD_IS_PCT(lv_obj_get_style_min_width(obj, LV_PART_MAIN)) ||
+           LV_COORD_IS_PCT(lv_obj_get_style_max_width(obj, LV_PART_MAIN))) return true;
+    }
+
+    if(h_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_height(obj, LV_PART_MAIN)) ||
+           LV_COORD_IS_PCT(lv_obj_get_style_min_height(obj, LV_PART_MAIN)) ||
+           LV_COORD_IS_PCT(lv_obj_get_style_max_height(obj, LV_PART_MAIN))) return true;
+    }
+
+    /*The position is set by the layout of the parent*/
+    if(lv_obj_is_layout_positioned(obj)) return false;
+
+    lv_align_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
+    if(w_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_x(obj, LV_PART_MAIN))) return true;
+
+        switch(align) {
+            case LV_ALIGN_DEFAULT:
+                if(lv_obj_get_style_base_dir(obj->parent, LV_PART_MAIN) == LV_BASE_DIR_RTL) return true;
+                break;
+            case LV_ALIGN_TOP_MID:
+            case LV_ALIGN_TOP_RIGHT:
+            case LV_ALIGN_BOTTOM_MID:
+            case LV_ALIGN_BOTTOM_RIGHT:
+            case LV_ALIGN_RIGHT_MID:
+            case LV_ALIGN_CENTER:
+                return true;
+            default:
+                break;
+        }
+    }
+
+    if(h_changed) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_y(obj, LV_PART_MAIN))) return true;
+
+        switch(align) {
+            case LV_ALIGN_LEFT_MID:
+            case LV_ALIGN_BOTTOM_LEFT:
+            case LV_ALIGN_BOTTOM_MID:
+            case LV_ALIGN_BOTTOM_RIGHT:
+            case LV_ALIGN_RIGHT_MID:
+            case LV_ALIGN_CENTER:
+                return true;
+            default:
+                break;
+        }
+    }
+
+    return false;
 }
 
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
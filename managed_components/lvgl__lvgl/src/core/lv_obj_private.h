@@ -50,6 +50,9 @@ struct _lv_obj_spec_attr_t {
     uint16_t scroll_dir : 4;        /**< The allowed scroll direction(s), see `lv_dir_t`*/
     uint16_t layer_type : 2;        /**< Cache the layer type here. Element of lv_intermediate_layer_type_t */
     uint16_t name_static : 1;        /**< 1: `name` was not dynamically allocated */
+#if LV_REFR_RENDER_LIST
+    uint32_t render_list_idx;       /**< Index of the object in the render list (valid if the item there is this object)*/
+#endif
 };
 
 struct _lv_obj_t {
@@ -60,6 +63,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_obj_style_prop_cache_t * style_prop_cache;   /**< Recently resolved style properties, allocated on the first use*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -76,12 +82,24 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+    uint16_t size_inv : 1;
+    uint16_t scrollbar_inv : 1;
 };
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Mark the children whose size or position is calculated from the size of an object for update.
+ * Only their size and position will be refreshed and their layout will run again
+ * only if their size changes too.
+ * @param obj       pointer to an object whose size has changed
+ * @param ori       the original coordinates of the object or NULL if not only the size
+ *                  but e.g. the padding or the layout has changed
+ */
+void lv_obj_mark_children_size_as_dirty(lv_obj_t * obj, const lv_area_t * ori);
+
 /**********************
  *      MACROS
  **********************/
@@ -8,8 +8,10 @@
  *********************/
 #include "lv_obj_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_style_private.h"
 #include "lv_obj_style_private.h"
 #include "lv_obj_class_private.h"
+#include "lv_obj_draw_private.h"
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../misc/lv_color.h"
@@ -24,6 +26,19 @@
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    #if (LV_OBJ_STYLE_PROP_CACHE_CNT & (LV_OBJ_STYLE_PROP_CACHE_CNT - 1)) != 0
+        #error "LV_OBJ_STYLE_PROP_CACHE_CNT must be a power of 2"
+    #endif
+    #define style_prop_cache_generation LV_GLOBAL_DEFAULT()->style_prop_cache_generation
+#endif
+
+#if LV_USE_SYSMON_FRAME_LOG
+    #define STYLE_PROP_STAT_INC(cnt) LV_GLOBAL_DEFAULT()->cnt++
+#else
+    #define STYLE_PROP_STAT_INC(cnt)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,6 +64,7 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
                                     lv_style_value_t * v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
+static void mark_children_layout_as_dirty(lv_obj_t * obj);
 static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
 static void trans_anim_cb(void * _tr, int32_t v);
 static void trans_anim_start_cb(lv_anim_t * a);
@@ -60,6 +76,11 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+static lv_obj_style_prop_cache_entry_t * get_prop_cache_entry(lv_obj_t * obj, lv_style_selector_t selector,
+                                                              lv_style_prop_t prop);
+#endif
+static void prop_cache_invalidate(lv_obj_t * obj, bool subtree);
 
 /**********************
  *  STATIC VARIABLES
@@ -268,6 +289,11 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The styles of the object changed even if refreshing is disabled.
+     *The children resolve only the inherited properties from it.*/
+    prop_cache_invalidate(obj, prop == LV_STYLE_PROP_ANY ||
+                          lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+
     if(!style_refr) return;
 
     LV_PROFILER_STYLE_BEGIN;
@@ -286,6 +312,10 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
            lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT) {
             lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
             lv_obj_mark_layout_as_dirty(obj);
+
+            /*Inherited properties can change the children too, others only the space available for them*/
+            if(is_inheritable) mark_children_layout_as_dirty(obj);
+            else lv_obj_mark_children_size_as_dirty(obj, NULL);
         }
     }
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
@@ -353,13 +383,28 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     LV_ASSERT_NULL(obj)
 
     lv_style_selector_t selector = part | obj->state;
+    STYLE_PROP_STAT_INC(style_prop_get_cnt);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_obj_style_prop_cache_entry_t * entry = get_prop_cache_entry((lv_obj_t *)obj, selector, prop);
+    if(entry && entry->prop == prop && entry->selector == selector) return entry->value;
+#endif
+
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    if(entry) {
+        entry->value = value_act;
+        entry->selector = selector;
+        entry->prop = prop;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -388,7 +433,7 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
         lv_obj_invalidate(obj);
     }
 
-    lv_style_set_prop(style, prop, value);
+    lv_style_set_prop_no_cache_invalidate(style, prop, value);
 
 #if LV_OBJ_STYLE_CACHE
     uint32_t prop_shifted = STYLE_PROP_SHIFTED(prop);
@@ -462,7 +507,8 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
     obj->state = new_state;
 
     lv_obj_style_t * style_trans = get_trans_style(obj, part);
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr_dsc->prop, v1);  /*Be sure `trans_style` has a valid value*/
+    /*Be sure `trans_style` has a valid value*/
+    lv_style_set_prop_no_cache_invalidate((lv_style_t *)style_trans->style, tr_dsc->prop, v1);
     lv_obj_refresh_style(obj, tr_dsc->selector, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
@@ -498,6 +544,16 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
     lv_anim_start(&a);
 }
 
+void lv_obj_style_prop_cache_free(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_free(obj->style_prop_cache);
+    obj->style_prop_cache = NULL;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 lv_style_value_t lv_obj_style_apply_color_filter(const lv_obj_t * obj, lv_part_t part, lv_style_value_t v)
 {
 #if LV_USE_COLOR_FILTER
@@ -660,6 +716,7 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part)
 void lv_obj_update_layer_type(lv_obj_t * obj)
 {
     lv_layer_type_t layer_type = calculate_layer_type(obj);
+    if(layer_type != lv_obj_get_layer_type(obj)) lv_refr_render_list_invalidate();
     if(obj->spec_attr) obj->spec_attr->layer_type = layer_type;
     else if(layer_type != LV_LAYER_TYPE_NONE) {
         lv_obj_allocate_spec_attr(obj);
@@ -781,6 +838,7 @@ static lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t sel
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                     lv_style_value_t * v)
 {
+    STYLE_PROP_STAT_INC(style_prop_lookup_cnt);
 
     const uint32_t group = (uint32_t)1 << lv_style_get_prop_group(prop);
     const lv_part_t part = lv_obj_style_get_selector_part(selector);
@@ -870,11 +928,21 @@ static void refresh_children_style(lv_obj_t * obj)
         lv_obj_invalidate(child);
         lv_obj_send_event(child, LV_EVENT_STYLE_CHANGED, NULL);
         lv_obj_invalidate(child);
+        mark_children_layout_as_dirty(child);
 
         refresh_children_style(child); /*Check children too*/
     }
 }
 
+static void mark_children_layout_as_dirty(lv_obj_t * obj)
+{
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_mark_layout_as_dirty(obj->spec_attr->children[i]);
+    }
+}
+
 /**
  * Remove the transition from object's part's property.
  * - Remove the transition from `lv_obj_style_trans_ll` and free it
@@ -975,7 +1043,8 @@ static void trans_anim_cb(void * _tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
+        /*Called in every frame, so don't outdate the cache of the all objects*/
+        lv_style_set_prop_no_cache_invalidate((lv_style_t *)obj->styles[i].style, tr->prop, value_final);
         if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
         break;
 
@@ -1001,7 +1070,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     /*Be sure `trans_style` has a valid value*/
-    lv_style_set_prop((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
+    lv_style_set_prop_no_cache_invalidate((lv_style_t *)style_trans->style, tr->prop, tr->start_value);
     lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
 
 }
@@ -1217,3 +1286,62 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+/**
+ * Get the entry of the property cache where a property of the object should be
+ * @param obj       pointer to an object
+ * @param selector  the part and state of the object to get the property for
+ * @param prop      the property
+ * @return          the entry (it might store an other property) or NULL if the cache can't be used
+ */
+static lv_obj_style_prop_cache_entry_t * get_prop_cache_entry(lv_obj_t * obj, lv_style_selector_t selector,
+                                                              lv_style_prop_t prop)
+{
+    /*E.g. the button matrix temporarily changes the state to get the style of its buttons*/
+    if(obj->skip_trans) return NULL;
+
+    lv_obj_style_prop_cache_t * cache = obj->style_prop_cache;
+    if(cache == NULL) {
+        /*The cache was already freed*/
+        if(obj->is_deleting) return NULL;
+
+        cache = lv_malloc(sizeof(lv_obj_style_prop_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return NULL;
+        cache->generation = style_prop_cache_generation - 1;
+        obj->style_prop_cache = cache;
+    }
+
+    if(cache->generation != style_prop_cache_generation) {
+        lv_memzero(cache->entries, sizeof(cache->entries)); /*LV_STYLE_PROP_INV is 0*/
+        cache->generation = style_prop_cache_generation;
+    }
+
+    uint32_t part_id = lv_obj_style_get_selector_part(selector) >> 16;
+    return &cache->entries[(prop + part_id * 5) & (LV_OBJ_STYLE_PROP_CACHE_CNT - 1)];
+}
+#endif
+
+/**
+ * Mark the cached style properties of an object as outdated
+ * @param obj       pointer to an object
+ * @param subtree   true: the children too, e.g. because they inherit the changed property
+ */
+static void prop_cache_invalidate(lv_obj_t * obj, bool subtree)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    /*Differs from the global generation until it wraps around*/
+    if(obj->style_prop_cache) obj->style_prop_cache->generation = style_prop_cache_generation - 1;
+    if(!subtree) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        prop_cache_invalidate(obj->spec_attr->children[i], true);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(subtree);
+#endif
+}
@@ -32,6 +32,19 @@ struct _lv_obj_style_t {
     uint32_t is_disabled : 1;
 };
 
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+typedef struct {
+    lv_style_value_t value;     /**< The resolved value (the default value if no style sets it)*/
+    uint32_t selector : 24;     /**< The part and state the value was resolved for*/
+    uint32_t prop : 8;          /**< The property, `LV_STYLE_PROP_INV` if the entry is empty*/
+} lv_obj_style_prop_cache_entry_t;
+
+struct _lv_obj_style_prop_cache_t {
+    uint32_t generation;        /**< The entries are valid only if it equals to the global generation*/
+    lv_obj_style_prop_cache_entry_t entries[LV_OBJ_STYLE_PROP_CACHE_CNT];
+};
+#endif
+
 struct _lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -58,6 +71,13 @@ void lv_obj_style_init(void);
  */
 void lv_obj_style_deinit(void);
 
+/**
+ * Free the cache of the resolved style properties of an object.
+ * Called when the object is deleted.
+ * @param obj   pointer to an object
+ */
+void lv_obj_style_prop_cache_free(lv_obj_t * obj);
+
 /**
  * Used internally to create a style transition
  * @param obj
@@ -13,6 +13,7 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../misc/lv_anim_private.h"
+#include "../misc/lv_style_private.h"
 #include "../misc/lv_async.h"
 #include "../core/lv_global.h"
 
@@ -191,6 +192,10 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+    /*The inherited properties come from the new parent*/
+    lv_style_prop_cache_invalidate();
+    lv_refr_render_list_invalidate();
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
     lv_obj_send_event(old_parent, LV_EVENT_CHILD_CHANGED, obj);
@@ -250,6 +255,7 @@ void lv_obj_move_to_index(lv_obj_t * obj, int32_t index)
     }
 
     parent->spec_attr->children[index] = obj;
+    lv_refr_render_list_invalidate();
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, NULL);
     lv_obj_invalidate(parent);
 }
@@ -273,6 +279,7 @@ void lv_obj_swap(lv_obj_t * obj1, lv_obj_t * obj2)
 
     parent2->spec_attr->children[index2] = obj1;
     obj1->parent = parent2;
+    lv_refr_render_list_invalidate();
 
     lv_obj_send_event(parent, LV_EVENT_CHILD_CHANGED, obj2);
     lv_obj_send_event(parent, LV_EVENT_CHILD_CREATED, obj2);
@@ -671,6 +678,7 @@ static void obj_delete_core(lv_obj_t * obj)
         return;
 
     obj->is_deleting = true;
+    lv_refr_render_list_invalidate();
 
     /*Let the user free the resources used in `LV_EVENT_DELETE`*/
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_DELETE, NULL);
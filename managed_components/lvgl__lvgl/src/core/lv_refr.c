@@ -23,7 +23,9 @@
 #include "../draw/lv_draw_private.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_cache.h"
 #include "lv_global.h"
+#include "../others/observer/lv_observer.h"
 
 /*********************
  *      DEFINES
@@ -31,6 +33,9 @@
 
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
+#define render_list LV_GLOBAL_DEFAULT()->refr_render_list
+
+#define RENDER_LIST_DEF_SIZE 32
 
 /**********************
  *      TYPEDEFS
@@ -45,10 +50,19 @@ static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
 static void refr_configured_layer(lv_layer_t * layer);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
+static void refr_obj_children(lv_layer_t * layer, lv_obj_t * obj, uint32_t start);
+#if LV_REFR_RENDER_LIST
+    static void render_list_update(lv_display_t * disp);
+    static bool render_list_add(lv_obj_t * obj);
+    static const lv_refr_render_item_t * render_list_get_item(const lv_obj_t * obj);
+#endif
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+#if LV_USE_PROFILER
+    static void profiler_write_counters(void);
+#endif
 static lv_result_t layer_get_area(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type,
                                   lv_area_t * layer_area_out, lv_area_t * obj_draw_size_out);
 static bool alpha_test_area_on_obj(lv_obj_t * obj, const lv_area_t * area);
@@ -83,6 +97,10 @@ void lv_refr_init(void)
 
 void lv_refr_deinit(void)
 {
+#if LV_REFR_RENDER_LIST
+    lv_free(render_list.items);
+    lv_memzero(&render_list, sizeof(render_list));
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -150,7 +168,6 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     }
 
     if(refr_children) {
-        uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_count(obj);
         if(child_cnt == 0) {
             /*If the object was visible on the clip area call the post draw events too*/
@@ -170,10 +187,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
             }
 
             if(clip_corner == false) {
-                for(i = 0; i < child_cnt; i++) {
-                    lv_obj_t * child = obj->spec_attr->children[i];
-                    lv_obj_refr(layer, child);
-                }
+                refr_obj_children(layer, obj, 0);
 
                 /*If the object was visible on the clip area call the post draw events too*/
                 /*If all the children are redrawn make 'post draw' draw*/
@@ -198,11 +212,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 bottom.y1 = bottom.y2 - rout + 1;
                 if(lv_area_intersect(&bottom, &bottom, &layer->_clip_area)) {
                     layer_children = lv_draw_layer_create(layer, LV_COLOR_FORMAT_ARGB8888, &bottom);
-
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        lv_obj_refr(layer_children, child);
-                    }
+                    refr_obj_children(layer_children, obj, 0);
 
                     /*If all the children are redrawn send 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
@@ -219,11 +229,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 top.y2 = top.y1 + rout - 1;
                 if(lv_area_intersect(&top, &top, &layer->_clip_area)) {
                     layer_children = lv_draw_layer_create(layer, LV_COLOR_FORMAT_ARGB8888, &top);
-
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        lv_obj_refr(layer_children, child);
-                    }
+                    refr_obj_children(layer_children, obj, 0);
 
                     /*If all the children are redrawn send 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
@@ -242,10 +248,7 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 mid.y2 -= rout;
                 if(lv_area_intersect(&mid, &mid, &layer->_clip_area)) {
                     layer->_clip_area = mid;
-                    for(i = 0; i < child_cnt; i++) {
-                        lv_obj_t * child = obj->spec_attr->children[i];
-                        lv_obj_refr(layer, child);
-                    }
+                    refr_obj_children(layer, obj, 0);
 
                     /*If all the children are redrawn make 'post draw' draw*/
                     lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
@@ -335,6 +338,13 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+void lv_refr_render_list_invalidate(void)
+{
+#if LV_REFR_RENDER_LIST
+    render_list.valid = false;
+#endif
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -391,6 +401,11 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+#if LV_USE_OBSERVER && LV_OBSERVER_DEFERRED_NOTIFY
+    /*Apply the Subjects changed since the notify timer ran (e.g. by an input device) in this frame*/
+    lv_subject_notify_deferred();
+#endif
+
     /*Refresh the screen's layout if required*/
     LV_PROFILER_LAYOUT_BEGIN_TAG("layout");
     lv_obj_update_layout(disp_refr->act_scr);
@@ -426,6 +441,10 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         }
     }
 
+#if LV_USE_PROFILER
+    profiler_write_counters();
+#endif
+
     lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
     lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
     disp_refr->inv_p = 0;
@@ -754,6 +773,10 @@ static void refr_invalid_areas(void)
     /*Notify the display driven rendering has started*/
     lv_display_send_event(disp_refr, LV_EVENT_RENDER_START, NULL);
 
+#if LV_REFR_RENDER_LIST
+    render_list_update(disp_refr);
+#endif
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -1098,19 +1121,8 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj)
 
     /*Do until not reach the screen*/
     while(parent != NULL) {
-        bool go = false;
-        uint32_t i;
-        uint32_t child_cnt = lv_obj_get_child_count(parent);
-        for(i = 0; i < child_cnt; i++) {
-            lv_obj_t * child = parent->spec_attr->children[i];
-            if(!go) {
-                if(child == border_p) go = true;
-            }
-            else {
-                /*Refresh the objects*/
-                lv_obj_refr(layer, child);
-            }
-        }
+        /*Refresh the objects after the border*/
+        refr_obj_children(layer, parent, lv_obj_get_index(border_p) + 1);
 
         /*Call the post draw function of the parents of the to object*/
         lv_obj_send_event(parent, LV_EVENT_DRAW_POST_BEGIN, (void *)layer);
@@ -1126,6 +1138,137 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj)
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Refresh the children of an object
+ * @param layer     the layer to draw to
+ * @param obj       pointer to an object
+ * @param start     index of the first child to refresh
+ */
+static void refr_obj_children(lv_layer_t * layer, lv_obj_t * obj, uint32_t start)
+{
+    uint32_t i = start;
+
+#if LV_REFR_RENDER_LIST
+    const lv_refr_render_item_t * item = render_list_get_item(obj);
+    if(item) {
+        uint32_t item_idx = (uint32_t)(item - render_list.items) + 1;
+        uint32_t end_idx = item->next;
+        uint32_t child_idx = 0;
+        while(item_idx < end_idx) {
+            const lv_refr_render_item_t * child = &render_list.items[item_idx];
+            item_idx = child->next;
+            child_idx++;
+            if(child_idx <= start || child->hidden) continue;
+
+            /*Skip the children out of the clip area without touching them (as `lv_obj_redraw` would do).
+             *The area of the layered children also depends on their transformation so always draw them.*/
+            lv_area_t clip_coords;
+            if(!child->layered && !lv_area_intersect(&clip_coords, &layer->_clip_area, &child->draw_area)) continue;
+
+            lv_obj_refr(layer, child->obj);
+
+            /*If the child changed the tree continue without the list*/
+            if(!render_list.valid) break;
+        }
+
+        if(item_idx >= end_idx) return;
+        i = child_idx;
+    }
+#endif
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        lv_obj_refr(layer, child);
+    }
+}
+
+#if LV_REFR_RENDER_LIST
+/**
+ * Rebuild the render list if the object tree, the geometry or the screens changed since it was built
+ * @param disp  the display to refresh
+ */
+static void render_list_update(lv_display_t * disp)
+{
+    if(render_list.valid && render_list.disp == disp &&
+       render_list.act_scr == disp->act_scr && render_list.prev_scr == disp->prev_scr) return;
+
+    LV_PROFILER_REFR_BEGIN;
+    render_list.cnt = 0;
+    render_list.disp = disp;
+    render_list.act_scr = disp->act_scr;
+    render_list.prev_scr = disp->prev_scr;
+    render_list.valid = true;
+
+    lv_obj_t * roots[] = {disp->bottom_layer, disp->prev_scr, disp->act_scr, disp->top_layer, disp->sys_layer};
+    uint32_t i;
+    for(i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+        if(roots[i] == NULL) continue;
+        if(!render_list_add(roots[i])) {
+            render_list.valid = false;
+            break;
+        }
+    }
+    LV_PROFILER_REFR_END;
+}
+
+/**
+ * Append an object and its children to the render list
+ * @param obj   pointer to an object
+ * @return      true: added; false: out of memory
+ */
+static bool render_list_add(lv_obj_t * obj)
+{
+    if(render_list.cnt == render_list.size) {
+        uint32_t new_size = render_list.size ? render_list.size * 2 : RENDER_LIST_DEF_SIZE;
+        lv_refr_render_item_t * new_items = lv_realloc(render_list.items, new_size * sizeof(lv_refr_render_item_t));
+        LV_ASSERT_MALLOC(new_items);
+        if(new_items == NULL) return false;
+        render_list.items = new_items;
+        render_list.size = new_size;
+    }
+
+    uint32_t idx = render_list.cnt;
+    lv_refr_render_item_t * item = &render_list.items[idx];
+    int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+    item->obj = obj;
+    lv_obj_get_coords(obj, &item->draw_area);
+    lv_area_increase(&item->draw_area, ext_draw_size, ext_draw_size);
+    item->hidden = lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    item->layered = lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE;
+    if(obj->spec_attr) obj->spec_attr->render_list_idx = idx;
+    render_list.cnt++;
+
+    /*Hidden objects are not drawn so their children are not needed*/
+    if(!item->hidden) {
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            if(!render_list_add(obj->spec_attr->children[i])) return false;
+        }
+    }
+
+    /*`item` might be reallocated*/
+    render_list.items[idx].next = render_list.cnt;
+    return true;
+}
+
+/**
+ * Get the item of an object in the render list
+ * @param obj   pointer to an object
+ * @return      the item or NULL if the list is outdated or the object is not in the list
+ */
+static const lv_refr_render_item_t * render_list_get_item(const lv_obj_t * obj)
+{
+    if(!render_list.valid || obj->spec_attr == NULL) return NULL;
+
+    uint32_t idx = obj->spec_attr->render_list_idx;
+    if(idx >= render_list.cnt || render_list.items[idx].obj != obj) return NULL;
+
+    return &render_list.items[idx];
+}
+#endif /*LV_REFR_RENDER_LIST*/
+
 static lv_result_t layer_get_area(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type,
                                   lv_area_t * layer_area_out, lv_area_t * obj_draw_size_out)
 {
@@ -1419,6 +1562,9 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     lv_draw_sw_rgb565_swap(px_map, lv_area_get_size(&offset_area));
 #endif
 
+    /*Ended in `wait_for_flushing` when the flush is seen to be ready.
+     *Shows how the flushing overlaps with the rendering of the next part.*/
+    LV_PROFILER_REFR_ASYNC_BEGIN("flushing", disp);
     disp->flush_cb(disp, &offset_area, px_map);
     lv_display_send_event(disp, LV_EVENT_FLUSH_FINISH, &offset_area);
 
@@ -1443,8 +1589,44 @@ static void wait_for_flushing(lv_display_t * disp)
     }
     disp->flushing_last = 0;
 
+    LV_PROFILER_REFR_ASYNC_END("flushing", disp);
+
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
 
     LV_LOG_TRACE("end");
     LV_PROFILER_REFR_END;
 }
+
+#if LV_USE_PROFILER
+/**
+ * Sample the heap usage and the image cache hit rates after each rendered frame
+ */
+static void profiler_write_counters(void)
+{
+#if LV_PROFILER_REFR
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    LV_PROFILER_REFR_COUNTER("heap_used", mon.total_size - mon.free_size);
+#endif
+
+#if LV_PROFILER_CACHE
+    lv_cache_t * img_cache = LV_GLOBAL_DEFAULT()->img_cache;
+    if(img_cache) {
+        int32_t hit_rate = lv_cache_get_hit_rate(img_cache);
+        if(hit_rate >= 0) {
+            LV_PROFILER_CACHE_COUNTER("image_cache_hit_rate", hit_rate);
+        }
+        lv_cache_reset_stats(img_cache);
+    }
+
+    lv_cache_t * img_header_cache = LV_GLOBAL_DEFAULT()->img_header_cache;
+    if(img_header_cache) {
+        int32_t hit_rate = lv_cache_get_hit_rate(img_header_cache);
+        if(hit_rate >= 0) {
+            LV_PROFILER_CACHE_COUNTER("image_header_cache_hit_rate", hit_rate);
+        }
+        lv_cache_reset_stats(img_header_cache);
+    }
+#endif
+}
+#endif
@@ -24,6 +24,28 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_REFR_RENDER_LIST
+/** An object in the render list*/
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t draw_area;        /**< The coordinates of the object increased by its extra draw size*/
+    uint32_t next : 30;         /**< Index of the first item after the children of this object*/
+    uint32_t hidden : 1;        /**< The object is hidden, its children are not in the list*/
+    uint32_t layered : 1;       /**< The object is drawn on a layer, its drawn area is unknown*/
+} lv_refr_render_item_t;
+
+/** The objects of the screens and layers of a display in paint order*/
+typedef struct {
+    lv_refr_render_item_t * items;
+    uint32_t cnt;
+    uint32_t size;              /**< Number of allocated items*/
+    lv_display_t * disp;        /**< The display whose screens are in the list*/
+    lv_obj_t * act_scr;         /**< The active screen when the list was built*/
+    lv_obj_t * prev_scr;        /**< The previous screen when the list was built*/
+    bool valid;                 /**< False if the tree or the geometry changed since the list was built*/
+} lv_refr_render_list_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -66,6 +88,13 @@ void lv_refr_set_disp_refreshing(lv_display_t * disp);
  */
 lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 
+/**
+ * Mark the render list as outdated.
+ * Called when an object is created, deleted, moved, resized, hidden or
+ * moved in the object tree. Does nothing if `LV_REFR_RENDER_LIST` is 0.
+ */
+void lv_refr_render_list_invalidate(void);
+
 /**
  * Render an object to a layer
  * @param layer target drawing layer
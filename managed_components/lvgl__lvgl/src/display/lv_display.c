@@ -1249,6 +1249,7 @@ static void update_resolution(lv_display_t * disp)
 
     lv_area_t prev_coords;
     lv_obj_get_coords(disp->sys_layer, &prev_coords);
+    lv_refr_render_list_invalidate();
     uint32_t i;
     for(i = 0; i < disp->screen_cnt; i++) {
         lv_area_set_width(&disp->screens[i]->coords, hor_res);
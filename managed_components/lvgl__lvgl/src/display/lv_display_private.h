@@ -171,6 +171,10 @@ struct _lv_display_t {
     lv_obj_t * mem_label;
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+    lv_sysmon_frame_log_t * frame_log;
+#endif
+
 };
 
 /**********************
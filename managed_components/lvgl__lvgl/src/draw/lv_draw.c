@@ -39,6 +39,12 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check, uint8_t
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 static inline size_t get_draw_dsc_size(lv_draw_task_type_t type);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+static void * task_alloc(size_t size);
+static void task_free(lv_draw_task_t * t);
+#if LV_DRAW_OCCLUSION_CULLING
+    static bool get_opaque_area(const lv_draw_task_t * t, lv_area_t * opaque_area);
+    static void cull_occluded_tasks(lv_layer_t * layer, lv_draw_task_t * t_cover);
+#endif
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -64,6 +70,13 @@ void lv_draw_init(void)
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
 #endif
+
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    _draw_info.task_arena = lv_malloc(LV_DRAW_TASK_ARENA_SIZE);
+    if(_draw_info.task_arena == NULL) {
+        LV_LOG_WARN("Couldn't allocate the draw task arena, draw tasks will be allocated from the heap");
+    }
+#endif
 }
 
 void lv_draw_deinit(void)
@@ -72,6 +85,15 @@ void lv_draw_deinit(void)
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
 
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    lv_free(_draw_info.task_arena);
+    _draw_info.task_arena = NULL;
+    _draw_info.task_arena_used = 0;
+    _draw_info.task_arena_live = 0;
+    _draw_info.task_arena_max_used = 0;
+    _draw_info.task_arena_miss_cnt = 0;
+#endif
+
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
         lv_draw_unit_t * cur_unit = u;
@@ -102,7 +124,7 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     LV_PROFILER_DRAW_BEGIN;
     size_t dsc_size = get_draw_dsc_size(type);
     LV_ASSERT_FORMAT_MSG(dsc_size > 0, "Draw task size is 0 for type %d", type);
-    lv_draw_task_t * new_task = lv_malloc_zeroed(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
+    lv_draw_task_t * new_task = task_alloc(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + dsc_size);
     LV_ASSERT_MALLOC(new_task);
     new_task->area = *coords;
     new_task->_real_area = *coords;
@@ -115,6 +137,9 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
     new_task->type = type;
     new_task->draw_dsc = (uint8_t *)new_task + LV_ALIGN_UP(sizeof(lv_draw_task_t), 8);
     new_task->state = LV_DRAW_TASK_STATE_WAITING;
+#if LV_USE_SYSMON_FRAME_LOG
+    new_task->disp = lv_refr_get_disp_refreshing();
+#endif
 
     /*Find the tail*/
     if(layer->draw_task_head == NULL) {
@@ -127,6 +152,12 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords,
         tail->next = new_task;
     }
 
+#if LV_USE_PROFILER && LV_PROFILER_DRAW
+    /*Link the creation of the task to its execution in the draw unit*/
+    new_task->seq_id = _draw_info.task_seq_cnt++;
+    LV_PROFILER_DRAW_FLOW_BEGIN("draw_task", new_task->seq_id);
+#endif
+
     LV_PROFILER_DRAW_END;
     return new_task;
 }
@@ -170,7 +201,17 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             t->state = LV_DRAW_TASK_STATE_FINISHED;
         }
         else {
+#if LV_DRAW_OCCLUSION_CULLING
+            cull_occluded_tasks(layer, t);
+#endif
+
+#if LV_DRAW_OCCLUSION_CULLING && LV_USE_OS == LV_OS_NONE
+            /*Without render threads the task would be drawn right away.
+             *Keep it queued until the layer is flushed so that a later opaque task can still cull it.*/
+            lv_draw_dispatch_request();
+#else
             lv_draw_dispatch();
+#endif
         }
     }
     else {
@@ -681,10 +722,161 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
+    task_free(t);
+    LV_PROFILER_DRAW_END;
+}
+
+/**
+ * Allocate zeroed memory for a draw task and its descriptor.
+ * The draw task arena is used if there is enough space in it, else the heap.
+ * @param size      size of the draw task and its descriptor in bytes
+ * @return          pointer to the allocated memory or NULL on error
+ */
+static void * task_alloc(size_t size)
+{
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    size = LV_ALIGN_UP(size, 8);
+    if(_draw_info.task_arena && _draw_info.task_arena_used + size <= LV_DRAW_TASK_ARENA_SIZE) {
+        void * p = _draw_info.task_arena + _draw_info.task_arena_used;
+        _draw_info.task_arena_used += size;
+        _draw_info.task_arena_live++;
+        if(_draw_info.task_arena_used > _draw_info.task_arena_max_used) {
+            _draw_info.task_arena_max_used = _draw_info.task_arena_used;
+        }
+        lv_memzero(p, size);
+        return p;
+    }
+    _draw_info.task_arena_miss_cnt++;
+#endif
+
+    return lv_malloc_zeroed(size);
+}
+
+/**
+ * Free the memory of a draw task allocated by `task_alloc`.
+ * The arena is reset when the last draw task allocated from it is freed,
+ * i.e. when all the draw tasks of the refreshed area are finished.
+ * @param t         pointer to a draw task
+ */
+static void task_free(lv_draw_task_t * t)
+{
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    uint8_t * p = (uint8_t *)t;
+    if(_draw_info.task_arena && p >= _draw_info.task_arena && p < _draw_info.task_arena + LV_DRAW_TASK_ARENA_SIZE) {
+        LV_ASSERT(_draw_info.task_arena_live > 0);
+        _draw_info.task_arena_live--;
+        if(_draw_info.task_arena_live == 0) _draw_info.task_arena_used = 0;
+        return;
+    }
+#endif
+
     lv_free(t);
+}
+
+#if LV_DRAW_OCCLUSION_CULLING
+
+/**
+ * Get the area which is fully covered by a draw task, i.e. where nothing drawn earlier can be seen.
+ * @param t             pointer to a draw task
+ * @param opaque_area   store the covered area here
+ * @return              true: the task covers `opaque_area`; false: the task is not opaque
+ */
+static bool get_opaque_area(const lv_draw_task_t * t, lv_area_t * opaque_area)
+{
+    if(t->opa < LV_OPA_MAX) return false;
+
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    if(!lv_matrix_is_identity(&t->matrix)) return false;
+#endif
+
+    if(t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX) return false;
+        if(dsc->radius != 0) return false;
+        if(dsc->grad.dir != LV_GRAD_DIR_NONE) return false;
+    }
+    else if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX) return false;
+        if(dsc->rotation != 0 || dsc->skew_x != 0 || dsc->skew_y != 0) return false;
+        if(dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE) return false;
+        if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+        if(dsc->clip_radius != 0 || dsc->bitmap_mask_src || dsc->colorkey) return false;
+
+        switch(dsc->header.cf) {
+            case LV_COLOR_FORMAT_RGB565:
+            case LV_COLOR_FORMAT_RGB565_SWAPPED:
+            case LV_COLOR_FORMAT_RGB888:
+            case LV_COLOR_FORMAT_XRGB8888:
+            case LV_COLOR_FORMAT_L8:
+                break;
+            default:
+                return false;
+        }
+    }
+    else {
+        return false;
+    }
+
+    return lv_area_intersect(opaque_area, &t->area, &t->clip_area);
+}
+
+/**
+ * Drop the waiting draw tasks which are fully covered by an opaque draw task
+ * and clip the fills which are partially covered by it.
+ * @param layer         the layer of the draw tasks
+ * @param t_cover       the newly added draw task
+ */
+static void cull_occluded_tasks(lv_layer_t * layer, lv_draw_task_t * t_cover)
+{
+    lv_area_t cover;
+    if(!get_opaque_area(t_cover, &cover)) return;
+
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t && t != t_cover) {
+        /*Tasks already taken by a draw unit can't be changed.
+         *Layers are freed only when they are blended so always keep them.*/
+        if(t->state != LV_DRAW_TASK_STATE_WAITING || t->type == LV_DRAW_TASK_TYPE_LAYER) {
+            t = t->next;
+            continue;
+        }
+
+        lv_area_t drawn;
+        if(!lv_area_intersect(&drawn, &t->_real_area, &t->clip_area)) {
+            t = t->next;
+            continue;
+        }
+
+        if(lv_area_is_in(&drawn, &cover, 0)) {
+            /*The task's resources will be freed on the next dispatch.
+             *It won't be executed, so close its flow here.*/
+            LV_PROFILER_DRAW_FLOW_END("draw_task", t->seq_id);
+            t->state = LV_DRAW_TASK_STATE_FINISHED;
+            _draw_info.culled_task_cnt++;
+        }
+        else if(t->type == LV_DRAW_TASK_TYPE_FILL) {
+            /*Fills draw only in `area` so the clip area can be reduced to the part which is still visible.
+             *`area` is kept as the radius and the gradient are calculated from it.*/
+            if(cover.x1 <= drawn.x1 && cover.x2 >= drawn.x2) {
+                if(cover.y1 <= drawn.y1 && cover.y2 >= drawn.y1) drawn.y1 = cover.y2 + 1;
+                else if(cover.y1 <= drawn.y2 && cover.y2 >= drawn.y2) drawn.y2 = cover.y1 - 1;
+            }
+            else if(cover.y1 <= drawn.y1 && cover.y2 >= drawn.y2) {
+                if(cover.x1 <= drawn.x1 && cover.x2 >= drawn.x1) drawn.x1 = cover.x2 + 1;
+                else if(cover.x1 <= drawn.x2 && cover.x2 >= drawn.x2) drawn.x2 = cover.x1 - 1;
+            }
+            t->clip_area = drawn;
+            t->_real_area = drawn;
+        }
+
+        t = t->next;
+    }
     LV_PROFILER_DRAW_END;
 }
 
+#endif /*LV_DRAW_OCCLUSION_CULLING*/
+
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
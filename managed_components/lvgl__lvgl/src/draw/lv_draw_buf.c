@@ -29,6 +29,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static void * buf_malloc(size_t size, lv_color_format_t color_format);
+static void * buf_malloc_bulk(size_t size, lv_color_format_t color_format);
 static void buf_free(void * buf);
 static void buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
                      const lv_draw_buf_t * src, const lv_area_t * src_area);
@@ -57,6 +58,10 @@ void lv_draw_buf_init_handlers(void)
     lv_draw_buf_init_with_default_handlers(&default_handlers);
     lv_draw_buf_init_with_default_handlers(&font_draw_buf_handlers);
     lv_draw_buf_init_with_default_handlers(&image_cache_draw_buf_handlers);
+
+    /*The glyphs and decoded images are only read while drawing, they can be in slower memory*/
+    font_draw_buf_handlers.buf_malloc_cb = buf_malloc_bulk;
+    image_cache_draw_buf_handlers.buf_malloc_cb = buf_malloc_bulk;
 }
 
 void lv_draw_buf_init_with_default_handlers(lv_draw_buf_handlers_t * handlers)
@@ -560,7 +565,16 @@ static void * buf_malloc(size_t size_bytes, lv_color_format_t color_format)
 
     /*Allocate larger memory to be sure it can be aligned as needed*/
     size_bytes += LV_DRAW_BUF_ALIGN - 1;
-    return lv_malloc(size_bytes);
+    return lv_malloc_hint(size_bytes, LV_MEM_HINT_DMA);
+}
+
+static void * buf_malloc_bulk(size_t size_bytes, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+
+    /*Allocate larger memory to be sure it can be aligned as needed*/
+    size_bytes += LV_DRAW_BUF_ALIGN - 1;
+    return lv_malloc_hint(size_bytes, LV_MEM_HINT_BULK);
 }
 
 static void buf_free(void * buf)
@@ -254,57 +254,94 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t line_end;
 
-    /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
-        /*If the label changed too much recalculate the hint.*/
-        if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
-            dsc->hint->line_start = -1;
-        }
-        last_line_start = dsc->hint->line_start;
-    }
-
-    /*Use the hint if it's valid*/
-    if(dsc->hint && last_line_start >= 0) {
-        line_start = last_line_start;
-        pos.y += dsc->hint->y;
-    }
-
-    uint32_t remaining_len = dsc->text_length;
+    /*The real length lets the line breaking check the ASCII letters a word at a time*/
+    uint32_t remaining_len = lv_strnlen(dsc->text, dsc->text_length);
     lv_text_attributes_t attributes = {0};
     attributes.letter_space = dsc->letter_space;
     attributes.text_flags = dsc->flag;
     attributes.max_width = w;
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, NULL, &attributes);
+    /*Use the stored line breaks if they belong to this text*/
+    const lv_text_lines_t * lines = NULL;
+    uint32_t line_idx = 0;
+    if(dsc->lines && lv_text_lines_is_valid(dsc->lines, dsc->text, remaining_len, font, &attributes)) {
+        lines = dsc->lines;
+    }
 
-    /*Go the first visible line*/
-    while(pos.y + line_height_font < t->clip_area.y1) {
-        /*Go to next line*/
-        remaining_len -= line_end - line_start;
-        line_start = line_end;
-        line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, NULL, &attributes);
-        pos.y += line_height;
+    /*Use the letter widths of the text if it was shaped when its size was calculated*/
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(dsc->text, font, false);
+
+    if(lines) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < t->clip_area.y1 && line_height > 0) {
+            line_idx = (t->clip_area.y1 - line_height_font - pos.y + line_height - 1) / line_height;
+            pos.y += (int32_t)line_idx * line_height;
+        }
+        if(line_idx >= lines->line_cnt) {
+            lv_text_glyph_run_release(run);
+            return;
+        }
+
+        line_start = lines->lines[line_idx].start;
+        line_end = lv_text_lines_get_end(lines, line_idx);
+        remaining_len -= line_start;
+    }
+    else {
+        /*Check the hint to use the cached info*/
+        if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+            /*If the label changed too much recalculate the hint.*/
+            if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
+                dsc->hint->line_start = -1;
+            }
+            last_line_start = dsc->hint->line_start;
+        }
 
-        /*Save at the threshold coordinate*/
-        if(dsc->hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
-            dsc->hint->line_start = line_start;
-            dsc->hint->y          = pos.y - coords->y1;
-            dsc->hint->coord_y    = coords->y1;
+        /*Use the hint if it's valid*/
+        if(dsc->hint && last_line_start >= 0) {
+            line_start = last_line_start;
+            remaining_len -= line_start;
+            pos.y += dsc->hint->y;
         }
 
-        if(dsc->text[line_start] == '\0') return;
+        line_end = line_start + lv_text_glyph_run_get_next_line(run, &dsc->text[line_start], remaining_len, font, NULL,
+                                                                &attributes);
+
+        /*Go the first visible line*/
+        while(pos.y + line_height_font < t->clip_area.y1) {
+            /*Go to next line*/
+            remaining_len -= line_end - line_start;
+            line_start = line_end;
+            line_end += lv_text_glyph_run_get_next_line(run, &dsc->text[line_start], remaining_len, font, NULL,
+                                                        &attributes);
+            pos.y += line_height;
+
+            /*Save at the threshold coordinate*/
+            if(dsc->hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && dsc->hint->line_start < 0) {
+                dsc->hint->line_start = line_start;
+                dsc->hint->y          = pos.y - coords->y1;
+                dsc->hint->coord_y    = coords->y1;
+            }
+
+            if(dsc->text[line_start] == '\0') {
+                lv_text_glyph_run_release(run);
+                return;
+            }
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, &attributes);
+        line_width = lines ? lines->lines[line_idx].width :
+                     lv_text_glyph_run_get_width(run, &dsc->text[line_start], line_end - line_start, font, &attributes);
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, &attributes);
+        line_width = lines ? lines->lines[line_idx].width :
+                     lv_text_glyph_run_get_width(run, &dsc->text[line_start], line_end - line_start, font, &attributes);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -369,6 +406,13 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         const char * bidi_txt = dsc->text + line_start;
 #endif
 
+        /*The letters of the glyph run can be followed only if the text is not reordered here*/
+#if LV_USE_BIDI
+        const lv_text_glyph_t * run_glyph = dsc->has_bided ? lv_text_glyph_run_find(run, line_start) : NULL;
+#else
+        const lv_text_glyph_t * run_glyph = lv_text_glyph_run_find(run, line_start);
+#endif
+
         while(next_char_offset < remaining_len && next_char_offset < line_end - line_start) {
             uint32_t logical_char_pos = 0;
 
@@ -390,6 +434,11 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
             uint32_t letter;
             uint32_t letter_next;
+            const lv_text_glyph_t * letter_glyph = NULL;
+            if(run_glyph) {
+                if(run_glyph->ofs == line_start + next_char_offset) letter_glyph = run_glyph++;
+                else run_glyph = NULL;
+            }
             lv_text_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &next_char_offset);
 
             /* If recolor is enabled */
@@ -466,7 +515,14 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
                 logical_char_pos -= (LABEL_RECOLOR_PAR_LENGTH + 1);
             }
 
-            lv_font_get_glyph_dsc(font, &glyph_dsc, letter, letter_next);
+            if(letter_glyph && letter_glyph->adv_w > 0) {
+                /*The kerning is already in the width of the run*/
+                lv_font_get_glyph_dsc(font, &glyph_dsc, letter, 0);
+                glyph_dsc.adv_w = letter_glyph->adv_w;
+            }
+            else {
+                lv_font_get_glyph_dsc(font, &glyph_dsc, letter, letter_next);
+            }
             letter_w = lv_text_is_marker(letter) ? 0 : glyph_dsc.adv_w;
 
             /*Always set the bg_coordinates for placeholder drawing*/
@@ -532,22 +588,28 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         /*Go to next line*/
         remaining_len -= line_end - line_start;
         line_start = line_end;
-        if(remaining_len) {
-            line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, NULL, &text_attributes);
+        if(lines) {
+            line_idx++;
+            if(line_idx >= lines->line_cnt) break;
+            line_end = lv_text_lines_get_end(lines, line_idx);
+        }
+        else if(remaining_len) {
+            line_end += lv_text_glyph_run_get_next_line(run, &dsc->text[line_start], remaining_len, font, NULL,
+                                                        &text_attributes);
         }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, &text_attributes);
+            line_width = lines ? lines->lines[line_idx].width :
+                         lv_text_glyph_run_get_width(run, &dsc->text[line_start], line_end - line_start, font, &text_attributes);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width(&dsc->text[line_start], line_end - line_start, font, &text_attributes);
+            line_width = lines ? lines->lines[line_idx].width :
+                         lv_text_glyph_run_get_width(run, &dsc->text[line_start], line_end - line_start, font, &text_attributes);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -557,6 +619,8 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         if(pos.y > t->clip_area.y2) break;
     }
 
+    lv_text_glyph_run_release(run);
+
     if(draw_letter_dsc._draw_buf) lv_draw_buf_destroy(draw_letter_dsc._draw_buf);
 
     LV_ASSERT_MEM_INTEGRITY();
@@ -107,6 +107,9 @@ typedef struct {
     /**Pointer to an externally stored struct where some data can be cached to speed up rendering*/
     lv_draw_label_hint_t * hint;
 
+    /**Pointer to the line breaks of `text` stored by `lv_text_lines_get_size`. Used only if they are still valid.*/
+    const lv_text_lines_t * lines;
+
     /* Properties of the letter outlines */
     lv_color_t outline_stroke_color;
     int32_t outline_stroke_width;
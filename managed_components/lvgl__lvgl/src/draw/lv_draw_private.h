@@ -84,6 +84,15 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+#if LV_USE_SYSMON_FRAME_LOG
+    /** The display refreshed when the task was added. The draw threads can't call `lv_refr_get_disp_refreshing()`*/
+    lv_display_t * disp;
+#endif
+
+#if LV_USE_PROFILER && LV_PROFILER_DRAW
+    /** Unique ID of the task, used as the ID of its profiler flow as the task memory is reused*/
+    uint32_t seq_id;
+#endif
 };
 
 struct _lv_draw_mask_t {
@@ -193,6 +202,22 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+#if LV_DRAW_TASK_ARENA_SIZE > 0
+    uint8_t * task_arena;       /**< Buffer to allocate the draw tasks and their descriptors from*/
+    uint32_t task_arena_used;   /**< Number of bytes already allocated from `task_arena`*/
+    uint32_t task_arena_live;   /**< Number of draw tasks in `task_arena` which are not freed yet*/
+    uint32_t task_arena_max_used;   /**< Highest `task_arena_used` so far*/
+    uint32_t task_arena_miss_cnt;   /**< Number of draw tasks allocated from the heap as `task_arena` was full*/
+#endif
+#if LV_DRAW_OCCLUSION_CULLING
+    uint32_t culled_task_cnt;   /**< Number of draw tasks dropped as an opaque task covered them*/
+#endif
+#if LV_USE_SYSMON_FRAME_LOG
+    uint32_t blended_px_cnt;    /**< Number of pixels blended by the software renderer (wraps around)*/
+#endif
+#if LV_USE_PROFILER && LV_PROFILER_DRAW
+    uint32_t task_seq_cnt;      /**< The `seq_id` of the next draw task*/
+#endif
 } lv_draw_global_info_t;
 
 /**********************
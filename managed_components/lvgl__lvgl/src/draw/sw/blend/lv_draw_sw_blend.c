@@ -10,6 +10,7 @@
 #include "lv_draw_sw_blend_private.h"
 #include "../../lv_draw_private.h"
 #include "../lv_draw_sw.h"
+#include "../../../core/lv_global.h"
 #if LV_DRAW_SW_SUPPORT_L8
     #include "lv_draw_sw_blend_to_l8.h"
 #endif
@@ -63,6 +64,12 @@ static inline void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_image(lv_color_f
  *      MACROS
  **********************/
 
+#if LV_USE_SYSMON_FRAME_LOG
+    #define BLENDED_PX_ADD(cnt) LV_GLOBAL_DEFAULT()->draw_info.blended_px_cnt += (cnt)
+#else
+    #define BLENDED_PX_ADD(cnt)
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -82,6 +89,7 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
 
     lv_draw_sw_blend_handler_t handler = lv_draw_sw_get_blend_handler(layer->color_format);
     if(handler) {
+        BLENDED_PX_ADD(lv_area_get_size(&blend_area));
         handler(t, blend_dsc);
         LV_PROFILER_DRAW_END;
         return;
@@ -111,6 +119,7 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
                                  (blend_area.x1 - blend_dsc->mask_area->x1);
         }
 
+        BLENDED_PX_ADD(fill_dsc.dest_w * fill_dsc.dest_h);
         lv_draw_sw_blend_color(layer->color_format, &fill_dsc);
     }
     else {
@@ -162,6 +171,7 @@ void lv_draw_sw_blend(lv_draw_task_t * t, const lv_draw_sw_blend_dsc_t * blend_d
         image_dsc.dest_buf = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1,
                                                     blend_area.y1 - layer->buf_area.y1);
 
+        BLENDED_PX_ADD(image_dsc.dest_w * image_dsc.dest_h);
         lv_draw_sw_blend_image(layer->color_format, &image_dsc);
     }
     LV_PROFILER_DRAW_END;
@@ -10,11 +10,12 @@
 #include "../lv_draw_private.h"
 #if LV_USE_DRAW_SW
 
-#include "../../core/lv_refr.h"
+#include "../../core/lv_refr_private.h"
 #include "../../display/lv_display_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
 #include "../../misc/lv_area_private.h"
+#include "../../others/sysmon/lv_sysmon_private.h"
 
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
     #if LV_USE_THORVG_EXTERNAL
@@ -383,6 +384,11 @@ static void render_thread_cb(void * ptr)
 static void execute_drawing(lv_draw_task_t * t)
 {
     LV_PROFILER_DRAW_BEGIN;
+    LV_PROFILER_DRAW_FLOW_END("draw_task", t->seq_id);
+#if LV_USE_SYSMON_FRAME_LOG
+    uint32_t start_time = lv_sysmon_frame_log_get_time(t->disp);
+#endif
+
     /*Render the draw task*/
     switch(t->type) {
         case LV_DRAW_TASK_TYPE_FILL:
@@ -427,6 +433,9 @@ static void execute_drawing(lv_draw_task_t * t)
             break;
     }
 
+#if LV_USE_SYSMON_FRAME_LOG
+    lv_sysmon_frame_log_add_task(t->disp, t->type, start_time);
+#endif
 
     LV_PROFILER_DRAW_END;
 }
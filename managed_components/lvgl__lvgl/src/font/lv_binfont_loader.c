@@ -137,6 +137,10 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+    /*Uses the cmaps to find the glyph IDs so do it first*/
+    lv_font_fmt_txt_bitmap_cache_drop(font);
+    lv_text_glyph_run_cache_drop();
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -166,6 +170,7 @@ void lv_binfont_destroy(lv_font_t * font)
 
     lv_free((void *)dsc->glyph_bitmap);
     lv_free((void *)dsc->glyph_dsc);
+    lv_free(dsc->glyph_cache);
     lv_free((void *)dsc);
     lv_free(font);
 }
@@ -253,6 +258,11 @@ static bool load_cmaps_tables(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_ds
 
         switch(cmap_table[i].format_type) {
             case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                    /*The glyph ID of every letter of the range is looked up in the list*/
+                    if(cmap_table[i].data_entries_count < cmap_table[i].range_length) {
+                        LV_LOG_WARN("Too short glyph ID list in cmap %u.", i);
+                        return false;
+                    }
                     uint32_t ids_size = (uint32_t)(sizeof(uint8_t) * cmap_table[i].data_entries_count);
                     uint8_t * glyph_id_ofs_list = lv_malloc(ids_size);
 
@@ -327,6 +337,49 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
     return success ? cmaps_length : -1;
 }
 
+/**
+ * Check that the cmaps refer only to existing glyphs.
+ * @param font_dsc      the font with the cmaps already loaded
+ * @param loca_count    number of glyphs in the font
+ * @return              true: all the glyph IDs are less than `loca_count`
+ */
+static bool cmaps_glyph_ids_valid(const lv_font_fmt_txt_dsc_t * font_dsc, uint32_t loca_count)
+{
+    for(uint32_t i = 0; i < font_dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &font_dsc->cmaps[i];
+        uint32_t max_ofs = 0;
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                if(cmap->range_length == 0) continue;
+                max_ofs = cmap->range_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                if(cmap->list_length == 0) continue;
+                max_ofs = cmap->list_length - 1;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                    const uint8_t * ofs = cmap->glyph_id_ofs_list;
+                    for(uint32_t k = 0; k < cmap->range_length; k++) max_ofs = LV_MAX(max_ofs, ofs[k]);
+                    break;
+                }
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+                    const uint16_t * ofs = cmap->glyph_id_ofs_list;
+                    for(uint32_t k = 0; k < cmap->list_length; k++) max_ofs = LV_MAX(max_ofs, ofs[k]);
+                    break;
+                }
+            default:
+                return false;
+        }
+
+        if(cmap->glyph_id_start + max_ofs >= loca_count) {
+            LV_LOG_WARN("Cmap %" LV_PRIu32 " refers to glyph %" LV_PRIu32 " but there are only %" LV_PRIu32 " glyphs.",
+                        i, cmap->glyph_id_start + max_ofs, loca_count);
+            return false;
+        }
+    }
+    return true;
+}
+
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
                           uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
 {
@@ -335,10 +388,11 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         return -1;
     }
 
-    lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)
-                                              lv_malloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    /*The glyph descriptors and bitmaps are the bulk of the font*/
+    size_t glyph_dsc_size = loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t);
+    lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = lv_malloc_hint(glyph_dsc_size, LV_MEM_HINT_BULK);
 
-    lv_memset(glyph_dsc, 0, loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    lv_memset(glyph_dsc, 0, glyph_dsc_size);
 
     font_dsc->glyph_dsc = glyph_dsc;
 
@@ -406,7 +460,7 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
-    uint8_t * glyph_bmp = (uint8_t *)lv_malloc(sizeof(uint8_t) * cur_bmp_size);
+    uint8_t * glyph_bmp = (uint8_t *)lv_malloc_hint(sizeof(uint8_t) * cur_bmp_size, LV_MEM_HINT_BULK);
     LV_ASSERT_MALLOC(glyph_bmp);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -512,6 +566,11 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
         return false;
     }
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*Optional, the font works without it too*/
+    font_dsc->glyph_cache = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_glyph_cache_t));
+#endif
+
     /*loca*/
     uint32_t loca_start = cmaps_start + cmaps_length;
     int32_t loca_length = read_label(fp, loca_start, "loca");
@@ -524,6 +583,11 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
         return false;
     }
 
+    /*Reject broken fonts here, the glyph IDs are used as array indices when drawing*/
+    if(!cmaps_glyph_ids_valid(font_dsc, loca_count)) {
+        return false;
+    }
+
     bool failed = false;
     uint32_t * glyph_offset = lv_malloc(sizeof(uint32_t) * (loca_count + 1));
 
@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
 #include "../misc/lv_text_private.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
@@ -89,6 +90,10 @@ void lv_font_glyph_release_draw_data(lv_font_glyph_dsc_t * g_dsc)
     if(font != NULL && font->release_glyph) {
         font->release_glyph(font, g_dsc);
     }
+    else if(font != NULL && font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt) {
+        /*The fonts generated by lv_font_conv don't set `release_glyph`*/
+        lv_font_release_glyph_fmt_txt(font, g_dsc);
+    }
 }
 
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
@@ -166,7 +171,11 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
 void lv_font_set_kerning(lv_font_t * font, lv_font_kerning_t kerning)
 {
     LV_ASSERT_NULL(font);
+    if(font->kerning == kerning) return;
+
     font->kerning = kerning;
+    /*The stored runs have the kerned advance widths*/
+    lv_text_glyph_run_cache_drop();
 }
 
 int32_t lv_font_get_line_height(const lv_font_t * font)
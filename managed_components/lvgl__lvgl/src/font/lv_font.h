@@ -113,7 +113,8 @@ struct _lv_font_t {
     int8_t underline_thickness;     /**< Thickness of the underline*/
 
     const void * dsc;               /**< Store implementation specific or run_time data or caching here*/
-    const lv_font_t * fallback;     /**< Fallback font for missing glyph. Resolved recursively */
+    const lv_font_t * fallback;     /**< Fallback font for missing glyph. Resolved recursively.
+                                         Call `lv_text_glyph_run_cache_drop()` after changing it on a font in use. */
     void * user_data;               /**< Custom user data for font.*/
 };
 
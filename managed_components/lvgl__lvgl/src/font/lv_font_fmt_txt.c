@@ -14,6 +14,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,19 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #if (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE & (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE - 1)) || LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE < 32
+        #error "LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE must be 0 or a power of 2 not smaller than 32"
+    #endif
+    /*With at least 32 entries the upper bits of any Unicode letter fit into 16 bits*/
+    #define GLYPH_CACHE_LETTER_MAX 0x10FFFF
+#endif
+
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    #define bitmap_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_bitmap_cache
+    #define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,10 +44,23 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const lv_font_fmt_txt_dsc_t * fdsc;     /**< Not the font as copies of a font share the glyphs*/
+    uint32_t gid;
+    lv_draw_buf_t * draw_buf;
+} bitmap_cache_data_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static const void * decode_bitmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                  uint32_t stride_in, lv_draw_buf_t * draw_buf);
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t get_glyph_id_from_lut(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+static uint32_t get_glyph_id_from_cmaps(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
@@ -47,6 +74,15 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    static const void * get_cached_bitmap(lv_font_glyph_dsc_t * g_dsc);
+    static uint32_t get_glyph_cnt(const lv_font_fmt_txt_dsc_t * fdsc);
+    static bool bitmap_cache_create_cb(bitmap_cache_data_t * node, void * user_data);
+    static void bitmap_cache_free_cb(bitmap_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t bitmap_cache_compare_cb(const bitmap_cache_data_t * lhs,
+                                                          const bitmap_cache_data_t * rhs);
+#endif /*LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE*/
+
 static lv_font_t * builtin_font_create_cb(const lv_font_info_t * info, const void * src);
 static void builtin_font_delete_cb(lv_font_t * font);
 static void * builtin_font_dup_src_cb(const void * src);
@@ -99,12 +135,141 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 
     if(g_dsc->req_raw_bitmap) return &fdsc->glyph_bitmap[gdsc->bitmap_index];
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    const void * cached = get_cached_bitmap(g_dsc);
+    if(cached) return cached;
+#endif
+
+    return decode_bitmap(fdsc, gdsc, g_dsc->stride, draw_buf);
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    /*Put together a glyph dsc*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+
+    if(fdsc->stride == 0) dsc_out->stride = 0;
+    else {
+        /*E.g. w = 5, bpp = 2, means 2 bytes/line*/
+        uint32_t bit_count = dsc_out->box_w * fdsc->bpp;
+        uint32_t width_in_bytes = (bit_count + 7) >> 3; /*No division round up*/
+
+        /*E.g. font_dsc stride == 4 means align to 4 byte boundary.
+         *In glyph_dsc store the actual line length in bytes*/
+        dsc_out->stride = LV_ROUND_UP(width_in_bytes, fdsc->stride);
+    }
+
+    dsc_out->format = (uint8_t)fdsc->bpp;
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+
+void lv_font_fmt_txt_bitmap_cache_init(void)
+{
+    bitmap_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(bitmap_cache_data_t),
+                                   LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE,
+    (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)bitmap_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)bitmap_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)bitmap_cache_free_cb,
+    });
+    lv_cache_set_name(bitmap_cache, "FONT_FMT_TXT_BITMAP");
+}
+
+void lv_font_fmt_txt_bitmap_cache_deinit(void)
+{
+    if(bitmap_cache == NULL) return;
+
+    lv_cache_destroy(bitmap_cache, NULL);
+    bitmap_cache = NULL;
+}
+
+#endif /*LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE*/
+
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_UNUSED(font);
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(bitmap_cache, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+#else
+    LV_UNUSED(g_dsc);
+#endif
+}
+
+void lv_font_fmt_txt_bitmap_cache_drop(const lv_font_t * font)
+{
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    if(bitmap_cache == NULL) return;
+
+    if(font == NULL) {
+        lv_cache_drop_all(bitmap_cache, NULL);
+        return;
+    }
+
+    bitmap_cache_data_t search_key = {
+        .fdsc = font->dsc,
+    };
+    uint32_t glyph_cnt = get_glyph_cnt(search_key.fdsc);
+    for(search_key.gid = 1; search_key.gid <= glyph_cnt; search_key.gid++) {
+        lv_cache_drop(bitmap_cache, &search_key, NULL);
+    }
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static const void * decode_bitmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                  uint32_t stride_in, lv_draw_buf_t * draw_buf)
+{
     uint8_t * bitmap_out = draw_buf->data;
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
-    uint32_t stride_in = g_dsc->stride;
-
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         const uint8_t * bitmap_in = &fdsc->glyph_bitmap[gdsc->bitmap_index];
@@ -219,73 +384,52 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     return NULL;
 }
 
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
+static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
+    if(letter == '\0') return 0;
+
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
 
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
-        }
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    /*The entry stores the upper bits of the letter (+1 to tell apart from an empty entry)
+     *and the glyph ID. The lower bits of the letter are the index.*/
+    uint32_t * entry = NULL;
+    uint32_t tag = 0;
+    if(fdsc->glyph_cache && letter <= GLYPH_CACHE_LETTER_MAX) {
+        entry = &fdsc->glyph_cache->entries[letter & (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE - 1)];
+        tag = (letter / LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1) << 16;
+        uint32_t e = *entry;
+        if((e & 0xFFFF0000) == tag) return e & 0xFFFF;
     }
+#endif
 
-    /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
-
-    uint32_t adv_w = gdsc->adv_w;
-    if(is_tab) adv_w *= 2;
-
-    adv_w += kv;
-    adv_w  = (adv_w + (1 << 3)) >> 4;
+    uint32_t glyph_id = fdsc->glyph_lut ? get_glyph_id_from_lut(fdsc, letter) : get_glyph_id_from_cmaps(fdsc, letter);
 
-    dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    if(entry && glyph_id <= 0xFFFF) *entry = tag | glyph_id;
+#endif
 
-    if(fdsc->stride == 0) dsc_out->stride = 0;
-    else {
-        /*E.g. w = 5, bpp = 2, means 2 bytes/line*/
-        uint32_t bit_count = dsc_out->box_w * fdsc->bpp;
-        uint32_t width_in_bytes = (bit_count + 7) >> 3; /*No division round up*/
+    return glyph_id;
+}
 
-        /*E.g. font_dsc stride == 4 means align to 4 byte boundary.
-         *In glyph_dsc store the actual line length in bytes*/
-        dsc_out->stride = LV_ROUND_UP(width_in_bytes, fdsc->stride);
+static uint32_t get_glyph_id_from_lut(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    /*The list is sorted and the glyph ID of the i-th element is i + 1*/
+    const uint32_t * lut = fdsc->glyph_lut;
+    uint32_t low = 0;
+    uint32_t high = fdsc->glyph_lut_len;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if(lut[mid] < letter) low = mid + 1;
+        else high = mid;
     }
 
-    dsc_out->format = (uint8_t)fdsc->bpp;
-    dsc_out->is_placeholder = false;
-    dsc_out->gid.index = gid;
-
-    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
-
-    return true;
+    if(low < fdsc->glyph_lut_len && lut[low] == letter) return low + 1;
+    else return 0;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+static uint32_t get_glyph_id_from_cmaps(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
 {
-    if(letter == '\0') return 0;
-
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -624,6 +768,111 @@ static int unicode_list_compare(const void * ref, const void * element)
     return (*(uint16_t *)ref) - (*(uint16_t *)element);
 }
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+
+static const void * get_cached_bitmap(lv_font_glyph_dsc_t * g_dsc)
+{
+    if(bitmap_cache == NULL) return NULL;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = g_dsc->resolved_font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[g_dsc->gid.index];
+    if(gdsc->box_w == 0 || gdsc->box_h == 0) return NULL;
+
+    bitmap_cache_data_t search_key = {
+        .slot.size = lv_draw_buf_width_to_stride(gdsc->box_w, LV_COLOR_FORMAT_A8) * gdsc->box_h + sizeof(lv_draw_buf_t),
+        .fdsc = fdsc,
+        .gid = g_dsc->gid.index,
+    };
+
+    /*Let the huge glyphs go around the cache instead of evicting everything*/
+    if(search_key.slot.size > lv_cache_get_max_size(bitmap_cache, NULL)) return NULL;
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(bitmap_cache, &search_key, g_dsc);
+    if(entry == NULL) return NULL;
+
+    g_dsc->entry = entry;
+    bitmap_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    return cached_data->draw_buf;
+}
+
+/**
+ * Get the number of glyphs (i.e. the largest glyph ID) of a font
+ */
+static uint32_t get_glyph_cnt(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(fdsc->glyph_lut) return fdsc->glyph_lut_len;
+
+    uint32_t glyph_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t last = 0;
+        uint32_t j;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            last = cmap->range_length - 1;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            last = cmap->list_length - 1;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+            for(j = 0; j < cmap->range_length; j++) last = LV_MAX(last, gid_ofs_8[j]);
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+            for(j = 0; j < cmap->list_length; j++) last = LV_MAX(last, gid_ofs_16[j]);
+        }
+
+        glyph_cnt = LV_MAX(glyph_cnt, cmap->glyph_id_start + last);
+    }
+
+    return glyph_cnt;
+}
+
+static bool bitmap_cache_create_cb(bitmap_cache_data_t * node, void * user_data)
+{
+    const lv_font_glyph_dsc_t * g_dsc = user_data;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &node->fdsc->glyph_dsc[node->gid];
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, gdsc->box_w, gdsc->box_h,
+                                                     LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) {
+        LV_LOG_WARN("out of memory");
+        return false;
+    }
+
+    if(decode_bitmap(node->fdsc, gdsc, g_dsc->stride, draw_buf) == NULL) {
+        lv_draw_buf_destroy(draw_buf);
+        return false;
+    }
+
+    node->draw_buf = draw_buf;
+    return true;
+}
+
+static void bitmap_cache_free_cb(bitmap_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_draw_buf_destroy(node->draw_buf);
+}
+
+static lv_cache_compare_res_t bitmap_cache_compare_cb(const bitmap_cache_data_t * lhs,
+                                                      const bitmap_cache_data_t * rhs)
+{
+    if(lhs->fdsc != rhs->fdsc) {
+        return lhs->fdsc > rhs->fdsc ? 1 : -1;
+    }
+
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    return 0;
+}
+
+#endif /*LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE*/
+
 static lv_font_t * builtin_font_create_cb(const lv_font_info_t * info, const void * src)
 {
     const lv_builtin_font_src_t * font_src = src;
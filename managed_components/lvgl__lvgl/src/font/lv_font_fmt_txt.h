@@ -147,6 +147,16 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 2,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/**
+ * Direct mapped codepoint -> glyph ID cache which can be attached to a font.
+ * The low bits of the codepoint select the entry, and the entry stores the rest of
+ * the codepoint and the glyph ID in one word so it is always read and written atomically.
+ * Not found letters are cached too (with glyph ID 0), so fallback fonts benefit as well.
+ */
+typedef struct {
+    uint32_t entries[LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0 ? LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE : 1];
+} lv_font_fmt_txt_glyph_cache_t;
+
 /** Describe store for additional data for fonts */
 typedef struct {
     /** The bitmaps of all glyphs */
@@ -191,6 +201,18 @@ typedef struct {
      * 4, 8, 16, 32, 64: each line is padded to the given byte boundaries
      */
     uint8_t stride;
+
+    /**
+     * Optional flat, sorted list of all codepoints of the font (generated by `scripts/font_glyph_lut.py`).
+     * The glyph ID of `glyph_lut[i]` is `i + 1`. If set, it's searched instead of walking the `cmaps`.
+     */
+    const uint32_t * glyph_lut;
+
+    /** Number of elements in `glyph_lut`*/
+    uint32_t glyph_lut_len;
+
+    /** Optional, writable codepoint -> glyph ID cache. Used only if `LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE > 0`*/
+    lv_font_fmt_txt_glyph_cache_t * glyph_cache;
 } lv_font_fmt_txt_dsc_t;
 
 typedef struct {
@@ -224,6 +246,21 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Used as `release_glyph` callback in lvgl's native font format.
+ * Gives back the bitmap cache entry acquired by `lv_font_get_bitmap_fmt_txt`.
+ * @param font          pointer to font
+ * @param g_dsc         the glyph descriptor whose `entry` is released
+ */
+void lv_font_release_glyph_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Remove the cached bitmaps of a font (see `LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE`).
+ * Needs to be called before a font is freed or its glyphs are changed.
+ * @param font          pointer to font or NULL to remove the bitmaps of all fonts
+ */
+void lv_font_fmt_txt_bitmap_cache_drop(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
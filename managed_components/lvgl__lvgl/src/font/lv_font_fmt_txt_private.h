@@ -45,6 +45,20 @@ typedef struct {
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+
+/**
+ * Create the shared A8 bitmap cache of the built-in format fonts
+ */
+void lv_font_fmt_txt_bitmap_cache_init(void);
+
+/**
+ * Free the bitmap cache and all the cached bitmaps
+ */
+void lv_font_fmt_txt_bitmap_cache_deinit(void);
+
+#endif /*LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE*/
+
 /**********************
  *      MACROS
  **********************/
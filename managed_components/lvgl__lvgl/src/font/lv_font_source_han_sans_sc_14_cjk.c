@@ -23846,6 +23846,196 @@ static const lv_font_fmt_txt_kern_classes_t kern_classes = {
  *  ALL CUSTOM DATA
  *--------------------*/
 
+#if LVGL_VERSION_MAJOR >= 9
+/*All the code points in ascending order. The glyph ID of `glyph_lut[i]` is `i + 1`*/
+static const uint32_t glyph_lut[] = {
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+    0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+    0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,
+    0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+    0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x3001,
+    0x3002, 0x3005, 0x300c, 0x300d, 0x3041, 0x3042, 0x3043, 0x3044,
+    0x3046, 0x3047, 0x3048, 0x304a, 0x304b, 0x304c, 0x304d, 0x304e,
+    0x304f, 0x3050, 0x3051, 0x3052, 0x3053, 0x3054, 0x3055, 0x3056,
+    0x3057, 0x3058, 0x3059, 0x305a, 0x305b, 0x305c, 0x305d, 0x305e,
+    0x305f, 0x3060, 0x3061, 0x3063, 0x3064, 0x3065, 0x3066, 0x3067,
+    0x3068, 0x3069, 0x306a, 0x306b, 0x306c, 0x306d, 0x306e, 0x306f,
+    0x3070, 0x3071, 0x3072, 0x3073, 0x3074, 0x3075, 0x3076, 0x3077,
+    0x3078, 0x3079, 0x307a, 0x307b, 0x307c, 0x307d, 0x307e, 0x307f,
+    0x3080, 0x3081, 0x3082, 0x3083, 0x3084, 0x3085, 0x3086, 0x3087,
+    0x3088, 0x3089, 0x308a, 0x308b, 0x308c, 0x308d, 0x308f, 0x3092,
+    0x3093, 0x30a1, 0x30a2, 0x30a3, 0x30a4, 0x30a6, 0x30a7, 0x30a8,
+    0x30aa, 0x30ab, 0x30ac, 0x30ad, 0x30ae, 0x30af, 0x30b0, 0x30b1,
+    0x30b2, 0x30b3, 0x30b4, 0x30b5, 0x30b6, 0x30b7, 0x30b8, 0x30b9,
+    0x30ba, 0x30bb, 0x30bc, 0x30bd, 0x30bf, 0x30c0, 0x30c1, 0x30c3,
+    0x30c4, 0x30c6, 0x30c7, 0x30c8, 0x30c9, 0x30ca, 0x30cb, 0x30cd,
+    0x30ce, 0x30cf, 0x30d0, 0x30d1, 0x30d2, 0x30d3, 0x30d4, 0x30d5,
+    0x30d6, 0x30d7, 0x30d9, 0x30da, 0x30db, 0x30dc, 0x30dd, 0x30de,
+    0x30df, 0x30e0, 0x30e1, 0x30e2, 0x30e3, 0x30e4, 0x30e5, 0x30e7,
+    0x30e8, 0x30e9, 0x30ea, 0x30eb, 0x30ec, 0x30ed, 0x30ef, 0x30f3,
+    0x30f6, 0x30fc, 0x4e00, 0x4e03, 0x4e07, 0x4e08, 0x4e09, 0x4e0a,
+    0x4e0b, 0x4e0d, 0x4e13, 0x4e14, 0x4e16, 0x4e21, 0x4e26, 0x4e2d,
+    0x4e3b, 0x4e45, 0x4e4b, 0x4e4e, 0x4e4f, 0x4e57, 0x4e5d, 0x4e5f,
+    0x4e86, 0x4e88, 0x4e89, 0x4e8b, 0x4e8c, 0x4e94, 0x4e9b, 0x4ea1,
+    0x4ea4, 0x4ea6, 0x4eac, 0x4eba, 0x4ec0, 0x4eca, 0x4ecb, 0x4ecd,
+    0x4ed5, 0x4ed6, 0x4ed8, 0x4ee3, 0x4ee4, 0x4ee5, 0x4eee, 0x4ef6,
+    0x4efb, 0x4efd, 0x4f01, 0x4f0a, 0x4f11, 0x4f1a, 0x4f1d, 0x4f38,
+    0x4f3c, 0x4f46, 0x4f4d, 0x4f4e, 0x4f4f, 0x4f53, 0x4f55, 0x4f59,
+    0x4f5c, 0x4f60, 0x4f7f, 0x4f86, 0x4f8b, 0x4f9b, 0x4f9d, 0x4fa1,
+    0x4fbf, 0x4fc2, 0x4fdd, 0x4fe1, 0x4fee, 0x500b, 0x5011, 0x5019,
+    0x501f, 0x5024, 0x503c, 0x505a, 0x505c, 0x5065, 0x5074, 0x5099,
+    0x50b3, 0x50c5, 0x50cd, 0x50cf, 0x50d5, 0x50f9, 0x5104, 0x512a,
+    0x513f, 0x5143, 0x5144, 0x5145, 0x5148, 0x5149, 0x514b, 0x514d,
+    0x5152, 0x515a, 0x5165, 0x5167, 0x5168, 0x5169, 0x516b, 0x516c,
+    0x516d, 0x5171, 0x5176, 0x5177, 0x5185, 0x5186, 0x518a, 0x518d,
+    0x5199, 0x519b, 0x51ac, 0x51b7, 0x51cd, 0x51dd, 0x51e6, 0x51fa,
+    0x5206, 0x5207, 0x520a, 0x5217, 0x521d, 0x5224, 0x5225, 0x5229,
+    0x5230, 0x5236, 0x5238, 0x523b, 0x5247, 0x524a, 0x524d, 0x525b,
+    0x5272, 0x5275, 0x5283, 0x529b, 0x529f, 0x52a0, 0x52a8, 0x52a9,
+    0x52aa, 0x52b3, 0x52c9, 0x52d5, 0x52d9, 0x52dd, 0x52e4, 0x52f5,
+    0x5305, 0x5316, 0x5317, 0x533b, 0x5340, 0x5341, 0x5343, 0x5348,
+    0x534a, 0x5352, 0x5354, 0x5357, 0x5358, 0x5371, 0x5373, 0x537b,
+    0x539a, 0x539f, 0x53b3, 0x53bb, 0x53c2, 0x53c3, 0x53c8, 0x53ca,
+    0x53cb, 0x53cd, 0x53d6, 0x53d7, 0x53e3, 0x53e4, 0x53e5, 0x53e6,
+    0x53ea, 0x53eb, 0x53ef, 0x53f0, 0x53f2, 0x53f3, 0x53f7, 0x53f8,
+    0x5403, 0x5404, 0x5408, 0x540c, 0x540d, 0x5411, 0x5426, 0x5427,
+    0x5440, 0x544a, 0x5462, 0x5468, 0x5473, 0x547c, 0x547d, 0x548c,
+    0x54b2, 0x54c1, 0x54e1, 0x54ea, 0x5546, 0x554a, 0x554f, 0x5566,
+    0x5584, 0x5589, 0x559c, 0x559d, 0x55ae, 0x55b6, 0x55ce, 0x55ef,
+    0x561b, 0x56b4, 0x56db, 0x56de, 0x56e0, 0x56f0, 0x56f3, 0x56fd,
+    0x570b, 0x570d, 0x5712, 0x5718, 0x571f, 0x5723, 0x5728, 0x5730,
+    0x5747, 0x574a, 0x5750, 0x578b, 0x57df, 0x57f7, 0x57fa, 0x5831,
+    0x5834, 0x584a, 0x5869, 0x5883, 0x5897, 0x589e, 0x58ca, 0x58d3,
+    0x58eb, 0x58f0, 0x58f2, 0x5909, 0x590f, 0x5915, 0x5916, 0x591a,
+    0x591c, 0x5920, 0x5927, 0x5929, 0x592a, 0x592b, 0x592e, 0x5931,
+    0x5947, 0x5951, 0x5957, 0x5973, 0x5979, 0x597d, 0x5982, 0x5987,
+    0x59b3, 0x59b9, 0x59bb, 0x59c9, 0x59cb, 0x59d0, 0x59d4, 0x5a18,
+    0x5a5a, 0x5a66, 0x5a92, 0x5abd, 0x5acc, 0x5b09, 0x5b50, 0x5b57,
+    0x5b58, 0x5b63, 0x5b66, 0x5b69, 0x5b6b, 0x5b78, 0x5b83, 0x5b85,
+    0x5b87, 0x5b88, 0x5b89, 0x5b8c, 0x5b98, 0x5b99, 0x5b9a, 0x5b9e,
+    0x5b9f, 0x5ba2, 0x5ba4, 0x5bb3, 0x5bb5, 0x5bb6, 0x5bb9, 0x5bbf,
+    0x5bc4, 0x5bc6, 0x5bcc, 0x5bd2, 0x5bdd, 0x5bdf, 0x5be6, 0x5beb,
+    0x5bfa, 0x5bfe, 0x5c04, 0x5c07, 0x5c08, 0x5c0d, 0x5c0e, 0x5c0f,
+    0x5c11, 0x5c1a, 0x5c24, 0x5c31, 0x5c3a, 0x5c40, 0x5c45, 0x5c4a,
+    0x5c4b, 0x5c55, 0x5c65, 0x5c6c, 0x5c71, 0x5cf6, 0x5d4c, 0x5ddd,
+    0x5dde, 0x5de5, 0x5de6, 0x5dee, 0x5df1, 0x5df2, 0x5e02, 0x5e03,
+    0x5e08, 0x5e0c, 0x5e2b, 0x5e2d, 0x5e2f, 0x5e30, 0x5e33, 0x5e36,
+    0x5e38, 0x5e45, 0x5e73, 0x5e74, 0x5e78, 0x5e7e, 0x5e83, 0x5e86,
+    0x5e95, 0x5e97, 0x5e9c, 0x5ea6, 0x5ea7, 0x5eab, 0x5ead, 0x5eb7,
+    0x5ee0, 0x5efa, 0x5eff, 0x5f0f, 0x5f15, 0x5f1f, 0x5f31, 0x5f35,
+    0x5f37, 0x5f53, 0x5f62, 0x5f71, 0x5f79, 0x5f7c, 0x5f80, 0x5f85,
+    0x5f88, 0x5f8b, 0x5f8c, 0x5f92, 0x5f93, 0x5f97, 0x5f9e, 0x5fa1,
+    0x5fa9, 0x5fc3, 0x5fc5, 0x5fd8, 0x5fd9, 0x5feb, 0x5ff5, 0x600e,
+    0x6012, 0x6015, 0x601d, 0x6025, 0x6027, 0x606f, 0x60a8, 0x60aa,
+    0x60b2, 0x60c5, 0x60f3, 0x6108, 0x610f, 0x611a, 0x611b, 0x611f,
+    0x614b, 0x6163, 0x6167, 0x616e, 0x61c9, 0x61f8, 0x6210, 0x6211,
+    0x6216, 0x6226, 0x6230, 0x623b, 0x623f, 0x6240, 0x624b, 0x624d,
+    0x6253, 0x6255, 0x627e, 0x6280, 0x628a, 0x6295, 0x62bc, 0x62c5,
+    0x62c9, 0x62db, 0x62e1, 0x62ec, 0x62ed, 0x62ff, 0x6301, 0x6307,
+    0x6319, 0x6355, 0x6368, 0x6388, 0x6392, 0x639b, 0x63a1, 0x63a2,
+    0x63a5, 0x63a7, 0x63a8, 0x63cf, 0x63d0, 0x63db, 0x63ee, 0x63fa,
+    0x643a, 0x64c1, 0x64c7, 0x64d4, 0x64da, 0x652f, 0x6539, 0x653e,
+    0x653f, 0x6545, 0x6548, 0x6557, 0x6559, 0x6562, 0x6570, 0x6574,
+    0x6587, 0x6599, 0x65ad, 0x65b0, 0x65b7, 0x65b9, 0x65bc, 0x65bd,
+    0x65c1, 0x65c5, 0x65cf, 0x65e2, 0x65e5, 0x65e6, 0x65e9, 0x65f6,
+    0x6607, 0x660e, 0x6613, 0x6614, 0x661f, 0x6620, 0x6625, 0x6628,
+    0x662f, 0x663c, 0x6642, 0x6669, 0x666e, 0x666f, 0x6674, 0x667a,
+    0x6687, 0x6691, 0x6696, 0x6697, 0x66c7, 0x66dc, 0x66f2, 0x66f4,
+    0x66f8, 0x66fe, 0x66ff, 0x6700, 0x6703, 0x6708, 0x6709, 0x670b,
+    0x670d, 0x671b, 0x671d, 0x671f, 0x6728, 0x672a, 0x672b, 0x672c,
+    0x672d, 0x673a, 0x6750, 0x6751, 0x675f, 0x6761, 0x6765, 0x676f,
+    0x6771, 0x6790, 0x6797, 0x679c, 0x67d0, 0x67e5, 0x67f1, 0x67fb,
+    0x67ff, 0x6811, 0x6821, 0x682a, 0x6839, 0x683c, 0x6843, 0x6848,
+    0x689d, 0x68b0, 0x68ee, 0x690d, 0x691c, 0x695a, 0x696d, 0x6975,
+    0x697d, 0x6982, 0x69cb, 0x69d8, 0x6a02, 0x6a19, 0x6a21, 0x6a23,
+    0x6a2a, 0x6a39, 0x6a4b, 0x6a5f, 0x6b21, 0x6b32, 0x6b4c, 0x6b50,
+    0x6b61, 0x6b62, 0x6b63, 0x6b64, 0x6b65, 0x6b69, 0x6b6f, 0x6b72,
+    0x6b73, 0x6b77, 0x6b7b, 0x6b8a, 0x6b8b, 0x6bb5, 0x6bcd, 0x6bce,
+    0x6bcf, 0x6bd4, 0x6bdb, 0x6c0f, 0x6c11, 0x6c14, 0x6c17, 0x6c34,
+    0x6c37, 0x6c38, 0x6c42, 0x6c5a, 0x6c60, 0x6c7a, 0x6c88, 0x6c92,
+    0x6cb9, 0x6cbb, 0x6cc1, 0x6cca, 0x6cd5, 0x6ce2, 0x6ce3, 0x6ce8,
+    0x6cf3, 0x6d0b, 0x6d17, 0x6d32, 0x6d3b, 0x6d3e, 0x6d41, 0x6d45,
+    0x6d74, 0x6d77, 0x6d88, 0x6dbc, 0x6df1, 0x6df7, 0x6e05, 0x6e07,
+    0x6e08, 0x6e09, 0x6e1b, 0x6e21, 0x6e29, 0x6e2f, 0x6e56, 0x6e90,
+    0x6e96, 0x6e9d, 0x6eff, 0x6f22, 0x6f38, 0x6fc3, 0x6fdf, 0x7063,
+    0x706b, 0x707d, 0x70b9, 0x70ba, 0x7121, 0x7136, 0x7159, 0x71b1,
+    0x71df, 0x722d, 0x7236, 0x7238, 0x7247, 0x725b, 0x7260, 0x7269,
+    0x7279, 0x72ac, 0x72af, 0x72b6, 0x72c0, 0x72ec, 0x72ed, 0x732b,
+    0x733f, 0x7372, 0x73a9, 0x73fe, 0x7403, 0x7406, 0x74b0, 0x7518,
+    0x751a, 0x751f, 0x7522, 0x7523, 0x7528, 0x7530, 0x7531, 0x7533,
+    0x7535, 0x7537, 0x753a, 0x753b, 0x754c, 0x7559, 0x756a, 0x756b,
+    0x7570, 0x7576, 0x75b2, 0x75c5, 0x75db, 0x767a, 0x767c, 0x767d,
+    0x767e, 0x7684, 0x7686, 0x76bf, 0x76d7, 0x76ee, 0x76f4, 0x76f8,
+    0x770b, 0x771f, 0x7720, 0x773e, 0x7740, 0x77e5, 0x77ed, 0x77f3,
+    0x7802, 0x7814, 0x7834, 0x78ba, 0x793a, 0x793c, 0x793e, 0x7956,
+    0x795d, 0x795e, 0x796d, 0x7981, 0x79c0, 0x79c1, 0x79cb, 0x79cd,
+    0x79d1, 0x79d8, 0x79fb, 0x7a0b, 0x7a2e, 0x7a4d, 0x7a76, 0x7a7a,
+    0x7a93, 0x7acb, 0x7ad9, 0x7ae5, 0x7aef, 0x7b11, 0x7b26, 0x7b2c,
+    0x7b46, 0x7b49, 0x7b54, 0x7b56, 0x7b97, 0x7ba1, 0x7bc0, 0x7bc4,
+    0x7c21, 0x7c73, 0x7cbe, 0x7cd6, 0x7cfb, 0x7d00, 0x7d04, 0x7d19,
+    0x7d20, 0x7d30, 0x7d39, 0x7d42, 0x7d44, 0x7d4c, 0x7d50, 0x7d61,
+    0x7d66, 0x7d71, 0x7d75, 0x7d93, 0x7d9a, 0x7dad, 0x7db2, 0x7dd1,
+    0x7dd2, 0x7dda, 0x7de0, 0x7de9, 0x7df4, 0x7e3d, 0x7e3e, 0x7e54,
+    0x7e70, 0x7e7c, 0x7e8c, 0x7edf, 0x7f3a, 0x7f6e, 0x7f8e, 0x7fa9,
+    0x7fd2, 0x8001, 0x8003, 0x8005, 0x800c, 0x8033, 0x805e, 0x806f,
+    0x8072, 0x8077, 0x807d, 0x8089, 0x80a9, 0x80af, 0x80b2, 0x80cc,
+    0x80f8, 0x80fd, 0x8131, 0x814a, 0x8155, 0x8166, 0x8170, 0x819d,
+    0x81c9, 0x81ea, 0x81f3, 0x81fa, 0x8207, 0x8208, 0x8209, 0x822a,
+    0x822c, 0x8239, 0x826f, 0x8272, 0x8282, 0x82b1, 0x82e5, 0x82e6,
+    0x82f1, 0x8336, 0x8377, 0x83d3, 0x83dc, 0x843d, 0x8449, 0x8457,
+    0x8535, 0x8584, 0x85ac, 0x85dd, 0x8607, 0x8655, 0x884c, 0x8853,
+    0x8868, 0x88ab, 0x88cf, 0x88dc, 0x88e1, 0x88fd, 0x8907, 0x897f,
+    0x8981, 0x898b, 0x898f, 0x8996, 0x899a, 0x89aa, 0x89ba, 0x89c0,
+    0x89d2, 0x89e3, 0x89e6, 0x8a00, 0x8a08, 0x8a0a, 0x8a0e, 0x8a13,
+    0x8a18, 0x8a2a, 0x8a2d, 0x8a31, 0x8a33, 0x8a34, 0x8a55, 0x8a66,
+    0x8a71, 0x8a72, 0x8a73, 0x8a8c, 0x8a8d, 0x8a95, 0x8a98, 0x8a9e,
+    0x8aaa, 0x8aac, 0x8aad, 0x8ab0, 0x8ab2, 0x8abf, 0x8ac7, 0x8acb,
+    0x8ad6, 0x8af8, 0x8b02, 0x8b1b, 0x8b1d, 0x8b58, 0x8b70, 0x8b77,
+    0x8b8a, 0x8b93, 0x8ba1, 0x8bde, 0x8c50, 0x8c61, 0x8ca0, 0x8ca1,
+    0x8ca7, 0x8ca9, 0x8cac, 0x8cb7, 0x8cb8, 0x8cbb, 0x8cbf, 0x8cc3,
+    0x8cc7, 0x8cea, 0x8cfd, 0x8d39, 0x8d64, 0x8d70, 0x8d77, 0x8d85,
+    0x8d8a, 0x8da3, 0x8db3, 0x8ddf, 0x8def, 0x8eab, 0x8eca, 0x8edf,
+    0x8ee2, 0x8efd, 0x8f03, 0x8f09, 0x8f15, 0x8f2a, 0x8f38, 0x8f9b,
+    0x8f9e, 0x8fa6, 0x8fb2, 0x8fba, 0x8fbc, 0x8fce, 0x8fd1, 0x8fd4,
+    0x8feb, 0x8ffd, 0x9000, 0x9001, 0x9003, 0x900f, 0x9010, 0x9019,
+    0x901a, 0x901f, 0x9020, 0x9023, 0x902e, 0x9031, 0x9032, 0x9045,
+    0x904a, 0x904b, 0x904e, 0x9053, 0x9054, 0x9055, 0x9060, 0x9069,
+    0x9078, 0x907f, 0x9084, 0x908a, 0x90a3, 0x90aa, 0x90e8, 0x90f5,
+    0x90fd, 0x914d, 0x9152, 0x9154, 0x9178, 0x91ab, 0x91cd, 0x91ce,
+    0x91cf, 0x91d1, 0x91dd, 0x9244, 0x925b, 0x9280, 0x9322, 0x932f,
+    0x9332, 0x9577, 0x9589, 0x958b, 0x9593, 0x95a2, 0x95dc, 0x95f0,
+    0x9633, 0x9644, 0x964d, 0x9650, 0x9662, 0x9664, 0x9678, 0x967d,
+    0x968e, 0x969b, 0x969c, 0x96a3, 0x96a8, 0x96bb, 0x96c6, 0x96d1,
+    0x96d6, 0x96d9, 0x96e2, 0x96e3, 0x96e8, 0x96ea, 0x96f2, 0x96fb,
+    0x9700, 0x9707, 0x9752, 0x9759, 0x975e, 0x9762, 0x9769, 0x9774,
+    0x97f3, 0x97ff, 0x9803, 0x9805, 0x9808, 0x9817, 0x9818, 0x982d,
+    0x983c, 0x984c, 0x9854, 0x9858, 0x985e, 0x986f, 0x98a8, 0x98db,
+    0x98df, 0x98ef, 0x98f2, 0x9928, 0x9996, 0x9999, 0x99c4, 0x99c5,
+    0x9a12, 0x9a13, 0x9a57, 0x9ad4, 0x9ad8, 0x9aea, 0x9b5a, 0x9ce5,
+    0x9e97, 0x9ebc, 0x9ec4, 0x9ed2, 0x9ede, 0x9ee8, 0x9f13, 0x9f3b,
+    0xf001, 0xf008, 0xf00b, 0xf00c, 0xf00d, 0xf011, 0xf013, 0xf015,
+    0xf019, 0xf01c, 0xf021, 0xf026, 0xf027, 0xf028, 0xf03e, 0xf043,
+    0xf048, 0xf04b, 0xf04c, 0xf04d, 0xf051, 0xf052, 0xf053, 0xf054,
+    0xf067, 0xf068, 0xf06e, 0xf070, 0xf071, 0xf074, 0xf077, 0xf078,
+    0xf079, 0xf07b, 0xf093, 0xf095, 0xf0c4, 0xf0c5, 0xf0c7, 0xf0c9,
+    0xf0e0, 0xf0e7, 0xf0ea, 0xf0f3, 0xf11c, 0xf124, 0xf15b, 0xf1eb,
+    0xf240, 0xf241, 0xf242, 0xf243, 0xf244, 0xf287, 0xf293, 0xf2ed,
+    0xf304, 0xf55a, 0xf7c2, 0xf8a2, 0xff08, 0xff09, 0xff0c, 0xff11,
+    0xff12
+};
+
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+static lv_font_fmt_txt_glyph_cache_t glyph_cache;
+#endif
+#endif
+
 #if LV_VERSION_CHECK(8, 0, 0)
 /*Store all the custom data of the font*/
 static  lv_font_fmt_txt_glyph_cache_t cache;
@@ -23865,6 +24055,13 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
 #if LV_VERSION_CHECK(8, 0, 0)
     .cache = &cache
 #endif
+#if LVGL_VERSION_MAJOR >= 9
+    .glyph_lut = glyph_lut,
+    .glyph_lut_len = 1433,
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    .glyph_cache = &glyph_cache,
+#endif
+#endif
 };
 
 
@@ -476,6 +476,7 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
             item->coords.x2 += diff_x;
             item->coords.y1 += diff_y;
             item->coords.y2 += diff_y;
+            lv_refr_render_list_invalidate();
             lv_obj_invalidate(item);
             lv_obj_move_children_by(item, diff_x, diff_y, false);
         }
@@ -11,6 +11,7 @@
 #if LV_USE_FREETYPE
 
 #include "../../misc/lv_fs_private.h"
+#include "../../misc/lv_text.h"
 #include "../../core/lv_global.h"
 
 /*********************
@@ -245,6 +246,8 @@ void lv_freetype_font_delete(lv_font_t * font)
     lv_freetype_font_dsc_t * dsc = (lv_freetype_font_dsc_t *)(font->dsc);
     LV_ASSERT_FREETYPE_FONT_DSC(dsc);
 
+    lv_text_glyph_run_cache_drop();
+
     lv_cache_release(ctx->cache_node_cache, dsc->cache_node_entry, NULL);
     if(lv_cache_entry_get_ref(dsc->cache_node_entry) == 0) {
         lv_cache_drop(ctx->cache_node_cache, dsc->cache_node, NULL);
@@ -12,6 +12,10 @@
 #include "../../core/lv_global.h"
 
 #define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    #define bitmap_cache LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache
+    #define bitmap_cache_font_ll &(LV_GLOBAL_DEFAULT()->tiny_ttf_font_ll)
+#endif
 
 /*********************
  *      DEFINES
@@ -64,6 +68,7 @@ typedef struct ttf_font_desc {
     const uint8_t * stream;
 #endif
     float scale;
+    int32_t font_size;
     int ascent;
     int descent;
     int cache_size;
@@ -88,6 +93,8 @@ typedef struct {
 } tiny_ttf_kerning_cache_create_data_t;
 
 typedef struct _lv_tiny_ttf_cache_data_t {
+    lv_cache_slot_size_t slot;
+    const void * src;       /**< The font data, so the fonts created from the same data share the bitmaps*/
     lv_draw_buf_t * draw_buf;
     uint32_t glyph_index;
     uint32_t size;
@@ -120,6 +127,12 @@ static lv_cache_compare_res_t tiny_ttf_kerning_cache_compare_cb(const tiny_ttf_k
                                                                 const tiny_ttf_kerning_cache_data_t * rhs);
 
 static void lv_tiny_ttf_cache_create(ttf_font_desc_t * dsc);
+static const void * ttf_get_src(const ttf_font_desc_t * dsc);
+
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    static const void * ttf_get_shared_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+    static void ttf_shared_bitmap_cache_drop(const ttf_font_desc_t * dsc);
+#endif
 
 static lv_font_t * tiny_ttf_font_create_cb(const lv_font_info_t * info, const void * src);
 static void tiny_ttf_font_delete_cb(lv_font_t * font);
@@ -156,6 +169,11 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
         return;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    /*The bitmaps of the old size would stay in the shared cache until evicted*/
+    if(dsc->font_size) ttf_shared_bitmap_cache_drop(dsc);
+#endif
+    dsc->font_size = font_size;
     dsc->scale = stbtt_ScaleForMappingEmToPixels(&dsc->info, font_size);
     int line_gap = 0;
     stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
@@ -163,6 +181,7 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
     font->base_line = (int32_t)(dsc->scale * (line_gap - dsc->descent));
 
     /* size change means cache needs to be invalidated. */
+    lv_text_glyph_run_cache_drop();
 
     if(dsc->glyph_cache) {
         lv_cache_destroy(dsc->glyph_cache, NULL);
@@ -185,6 +204,8 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     LV_ASSERT_NULL(font);
 
+    lv_text_glyph_run_cache_drop();
+
     if(font->dsc != NULL) {
         ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
 #if LV_TINY_TTF_FILE_SUPPORT != 0
@@ -193,7 +214,23 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
         }
 #endif
         lv_cache_destroy(ttf->glyph_cache, NULL);
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+        ttf_shared_bitmap_cache_drop(ttf);
+        ttf_font_desc_t ** node;
+        LV_LL_READ(bitmap_cache_font_ll, node) {
+            if(*node == ttf) {
+                lv_ll_remove(bitmap_cache_font_ll, node);
+                lv_free(node);
+                break;
+            }
+        }
+        if(lv_ll_is_empty(bitmap_cache_font_ll)) {
+            lv_cache_destroy(bitmap_cache, NULL);
+            bitmap_cache = NULL;
+        }
+#else
         lv_cache_destroy(ttf->draw_data_cache, NULL);
+#endif
         lv_cache_destroy(ttf->kerning_cache, NULL);
         lv_free(ttf);
         font->dsc = NULL;
@@ -319,7 +356,7 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
             dsc_out->entry = NULL;
             return true;
         }
-        LV_LOG_ERROR("cache not allocated");
+        /*Not an error: the letter can be in the fallback font*/
         return false;
     }
 
@@ -356,13 +393,17 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
 
 static const void * ttf_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    return ttf_get_shared_bitmap(g_dsc, draw_buf);
+#else
     LV_UNUSED(draw_buf);
     uint32_t glyph_index = g_dsc->gid.index;
     const lv_font_t * font = g_dsc->resolved_font;
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     tiny_ttf_cache_data_t search_key = {
+        .src = ttf_get_src(dsc),
         .glyph_index = glyph_index,
-        .size = font->line_height,
+        .size = dsc->font_size,
     };
 
     lv_cache_entry_t * entry = lv_cache_acquire_or_create(dsc->draw_data_cache, &search_key, (void *)font->dsc);
@@ -384,12 +425,17 @@ static const void * ttf_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw
     g_dsc->entry = entry;
     tiny_ttf_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
     return cached_data->draw_buf;
+#endif
 }
 
 static void ttf_release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
 {
     LV_ASSERT_NULL(font);
 
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    /*NULL if the glyph was rendered into the caller's buffer*/
+    if(g_dsc->entry) lv_cache_release(bitmap_cache, g_dsc->entry, NULL);
+#else
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     if(!dsc->cache_size) {  /* no cache, do everything directly */
         lv_draw_buf_destroy((lv_draw_buf_t *)g_dsc->entry);
@@ -400,6 +446,7 @@ static void ttf_release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * g
         }
         lv_cache_release(dsc->draw_data_cache, g_dsc->entry, NULL);
     }
+#endif
     g_dsc->entry = NULL;
 }
 
@@ -414,6 +461,19 @@ static void lv_tiny_ttf_cache_create(ttf_font_desc_t * dsc)
     });
     lv_cache_set_name(dsc->glyph_cache, "TINY_TTF_GLYPH");
 
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    /*The bitmaps are in the cache shared by all the fonts*/
+    if(bitmap_cache == NULL) {
+        bitmap_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(tiny_ttf_cache_data_t),
+                                       LV_TINY_TTF_BITMAP_CACHE_SIZE,
+        (lv_cache_ops_t) {
+            .compare_cb = (lv_cache_compare_cb_t)tiny_ttf_draw_data_cache_compare_cb,
+            .create_cb = (lv_cache_create_cb_t)tiny_ttf_draw_data_cache_create_cb,
+            .free_cb = (lv_cache_free_cb_t)tiny_ttf_draw_data_cache_free_cb,
+        });
+        lv_cache_set_name(bitmap_cache, "TINY_TTF_BITMAP");
+    }
+#else
     dsc->draw_data_cache = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(tiny_ttf_cache_data_t), dsc->cache_size,
     (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t)tiny_ttf_draw_data_cache_compare_cb,
@@ -421,6 +481,7 @@ static void lv_tiny_ttf_cache_create(ttf_font_desc_t * dsc)
         .free_cb = (lv_cache_free_cb_t)tiny_ttf_draw_data_cache_free_cb,
     });
     lv_cache_set_name(dsc->draw_data_cache, "TINY_TTF_DRAW_DATA");
+#endif
 
     dsc->kerning_cache = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(tiny_ttf_kerning_cache_data_t),
                                          LV_TINY_TTF_CACHE_KERNING_CNT,
@@ -496,9 +557,115 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
     out_font->release_glyph = ttf_release_glyph_cb;
     out_font->dsc = dsc;
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+    if(bitmap_cache == NULL) lv_ll_init(bitmap_cache_font_ll, sizeof(ttf_font_desc_t *));
+    ttf_font_desc_t ** node = lv_ll_ins_tail(bitmap_cache_font_ll);
+    if(node == NULL) {
+        lv_free(out_font);
+        lv_free(dsc);
+        LV_LOG_ERROR("tiny_ttf: out of memory");
+        return NULL;
+    }
+    *node = dsc;
+#endif
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
 }
+
+static const void * ttf_get_src(const ttf_font_desc_t * dsc)
+{
+#if LV_TINY_TTF_FILE_SUPPORT != 0
+    /*The fonts opened from a file have their own stream*/
+    return dsc->stream.file ? (const void *)dsc : dsc->stream.data;
+#else
+    return dsc->stream;
+#endif
+}
+
+#if LV_TINY_TTF_BITMAP_CACHE_SIZE
+
+static const void * ttf_get_shared_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    const lv_font_t * font = g_dsc->resolved_font;
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    g_dsc->entry = NULL;
+    if(g_dsc->box_w == 0 || g_dsc->box_h == 0) return NULL;
+
+    tiny_ttf_cache_data_t search_key = {
+        .slot.size = lv_draw_buf_width_to_stride(g_dsc->box_w, LV_COLOR_FORMAT_A8) * g_dsc->box_h + sizeof(lv_draw_buf_t),
+        .src = ttf_get_src(dsc),
+        .glyph_index = g_dsc->gid.index,
+        .size = dsc->font_size,
+    };
+
+    /*Let the huge glyphs go around the cache instead of evicting everything*/
+    lv_cache_entry_t * entry = NULL;
+    if(search_key.slot.size <= lv_cache_get_max_size(bitmap_cache, NULL)) {
+        entry = lv_cache_acquire_or_create(bitmap_cache, &search_key, dsc);
+    }
+
+    if(entry == NULL) {
+        /*Render into the caller's buffer*/
+        if(draw_buf == NULL || search_key.glyph_index == 0) return NULL;
+        lv_draw_buf_clear(draw_buf, NULL);
+        stbtt_MakeGlyphBitmap(&dsc->info, draw_buf->data, g_dsc->box_w, g_dsc->box_h, draw_buf->header.stride,
+                              dsc->scale, dsc->scale, (int)search_key.glyph_index);
+        return draw_buf;
+    }
+
+    g_dsc->entry = entry;
+    tiny_ttf_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    return cached_data->draw_buf;
+}
+
+/**
+ * Remove the bitmaps of a font (with its current size) from the shared cache
+ * unless an other font created from the same data with the same size still uses them
+ */
+static void ttf_shared_bitmap_cache_drop(const ttf_font_desc_t * dsc)
+{
+    if(bitmap_cache == NULL) return;
+
+    const void * src = ttf_get_src(dsc);
+    ttf_font_desc_t ** node;
+    LV_LL_READ(bitmap_cache_font_ll, node) {
+        if(*node != dsc && ttf_get_src(*node) == src && (*node)->font_size == dsc->font_size) return;
+    }
+
+    lv_iter_t * iter = lv_cache_iter_create(bitmap_cache);
+    if(iter == NULL) return;
+
+    /*The cache holds only a few glyphs so walk its entries instead of trying every glyph of the font.
+     *Collect them first as the entries can't be dropped while iterating.*/
+    tiny_ttf_cache_data_t * data = lv_malloc(lv_cache_entry_get_size(sizeof(tiny_ttf_cache_data_t)));
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) {
+        lv_iter_destroy(iter);
+        return;
+    }
+
+    lv_array_t glyph_indices;
+    lv_array_init(&glyph_indices, 16, sizeof(uint32_t));
+    while(lv_iter_next(iter, data) == LV_RESULT_OK) {
+        if(data->src == src && data->size == (uint32_t)dsc->font_size) {
+            lv_array_push_back(&glyph_indices, &data->glyph_index);
+        }
+    }
+    lv_iter_destroy(iter);
+    lv_free(data);
+
+    tiny_ttf_cache_data_t search_key = {
+        .src = src,
+        .size = dsc->font_size,
+    };
+    for(uint32_t i = 0; i < lv_array_size(&glyph_indices); i++) {
+        search_key.glyph_index = *(uint32_t *)lv_array_at(&glyph_indices, i);
+        lv_cache_drop(bitmap_cache, &search_key, NULL);
+    }
+    lv_array_deinit(&glyph_indices);
+}
+
+#endif /*LV_TINY_TTF_BITMAP_CACHE_SIZE*/
 #if LV_TINY_TTF_FILE_SUPPORT != 0
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, int32_t font_size, lv_font_kerning_t kerning,
                                        size_t cache_size)
@@ -622,6 +789,10 @@ static void tiny_ttf_draw_data_cache_free_cb(tiny_ttf_cache_data_t * node, void
 static lv_cache_compare_res_t tiny_ttf_draw_data_cache_compare_cb(const tiny_ttf_cache_data_t * lhs,
                                                                   const tiny_ttf_cache_data_t * rhs)
 {
+    if(lhs->src != rhs->src) {
+        return lhs->src > rhs->src ? 1 : -1;
+    }
+
     if(lhs->glyph_index != rhs->glyph_index) {
         return lhs->glyph_index > rhs->glyph_index ? 1 : -1;
     }
@@ -366,6 +366,39 @@
     #endif
 #endif
 
+/** 1: Drop the draw tasks which are fully covered by a later opaque fill or image
+ *     and clip the partially covered fills.
+ *  Without an OS the draw tasks are kept queued until the buffer is flushed so that they can be culled. */
+#ifndef LV_DRAW_OCCLUSION_CULLING
+    #ifdef CONFIG_LV_DRAW_OCCLUSION_CULLING
+        #define LV_DRAW_OCCLUSION_CULLING CONFIG_LV_DRAW_OCCLUSION_CULLING
+    #else
+        #define LV_DRAW_OCCLUSION_CULLING 0
+    #endif
+#endif
+
+/** Store the objects of the refreshed screens with their drawn area in a dense array in paint order.
+ *  It's rebuilt only when the object tree or the geometry changes and used to skip the objects
+ *  out of the refreshed area without touching them. */
+#ifndef LV_REFR_RENDER_LIST
+    #ifdef CONFIG_LV_REFR_RENDER_LIST
+        #define LV_REFR_RENDER_LIST CONFIG_LV_REFR_RENDER_LIST
+    #else
+        #define LV_REFR_RENDER_LIST 0
+    #endif
+#endif
+
+/** Size of a buffer from which the draw tasks and their descriptors are allocated
+ *  instead of the heap. It's reset when all the draw tasks of the refreshed area are finished.
+ *  If it's full the heap is used. 0: disable*/
+#ifndef LV_DRAW_TASK_ARENA_SIZE
+    #ifdef CONFIG_LV_DRAW_TASK_ARENA_SIZE
+        #define LV_DRAW_TASK_ARENA_SIZE CONFIG_LV_DRAW_TASK_ARENA_SIZE
+    #else
+        #define LV_DRAW_TASK_ARENA_SIZE 0   /**< [bytes]*/
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -1489,6 +1522,18 @@
     #endif
 #endif
 
+/** Cache this many resolved style properties (per part and state) in each `lv_obj_t`
+ *  so that getting the same property again (e.g. when drawing) is only an array lookup.
+ *  The cache is allocated on the first use and invalidated when any style changes.
+ *  Must be a power of 2. 0: disable */
+#ifndef LV_OBJ_STYLE_PROP_CACHE_CNT
+    #ifdef CONFIG_LV_OBJ_STYLE_PROP_CACHE_CNT
+        #define LV_OBJ_STYLE_PROP_CACHE_CNT CONFIG_LV_OBJ_STYLE_PROP_CACHE_CNT
+    #else
+        #define LV_OBJ_STYLE_PROP_CACHE_CNT 0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1956,6 +2001,30 @@
     #endif
 #endif
 
+/** Number of entries in the direct mapped codepoint -> glyph ID cache which fonts
+ *  in the built-in format can attach (`glyph_cache` in `lv_font_fmt_txt_dsc_t`).
+ *  It makes repeated lookups in fonts with large sparse cmaps (e.g. CJK) cheap.
+ *  0: disable; otherwise a power of 2, at least 32. Uses 4 bytes per entry per font. */
+#ifndef LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE 64
+    #endif
+#endif
+
+/** Size in bytes of the LRU cache of decoded A8 glyph bitmaps shared by the fonts in
+ *  the built-in format. A hit saves unpacking (and decompressing) the glyph on every draw,
+ *  which matters for large glyphs, e.g. CJK. Allocated with `lv_malloc` on demand.
+ *  0: disable. Fonts whose glyphs change need `lv_font_fmt_txt_bitmap_cache_drop()`. */
+#ifndef LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Enable drawing placeholders when glyph dsc is not found. */
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef LV_KCONFIG_PRESENT
@@ -2026,6 +2095,18 @@
     #endif
 #endif
 
+/** Size in bytes of the LRU cache of shaped texts (glyph runs): the letters of a text with their
+ *  advance widths including kerning. The size calculation, line breaking and drawing of a text
+ *  use the run instead of looking up every glyph again. Texts shorter than 16 bytes are not cached.
+ *  0: disable. Fonts whose glyphs change need `lv_text_glyph_run_cache_drop()`. */
+#ifndef LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    #ifdef CONFIG_LV_TEXT_GLYPH_RUN_CACHE_SIZE
+        #define LV_TEXT_GLYPH_RUN_CACHE_SIZE CONFIG_LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    #else
+        #define LV_TEXT_GLYPH_RUN_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
  *  The direction will be processed according to the Unicode Bidirectional Algorithm:
  *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -2366,6 +2447,13 @@
             #define LV_LABEL_WAIT_CHAR_COUNT 3  /**< The count of wait chart */
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef CONFIG_LV_LABEL_LINE_CACHE
+            #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+        #else
+            #define LV_LABEL_LINE_CACHE 0       /**< Store the line breaks of the text to not break it again on redraw and when text is appended */
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LED
@@ -3159,6 +3247,16 @@
             #define LV_TINY_TTF_CACHE_KERNING_CNT 256
         #endif
     #endif
+    /** Size in bytes of an LRU cache of the rendered A8 glyph bitmaps shared by all the
+     *  Tiny TTF fonts (e.g. the sizes created from the same TTF). Allocated with `lv_malloc`
+     *  when the first font is created. 0: each font caches LV_TINY_TTF_CACHE_GLYPH_CNT bitmaps. */
+    #ifndef LV_TINY_TTF_BITMAP_CACHE_SIZE
+        #ifdef CONFIG_LV_TINY_TTF_BITMAP_CACHE_SIZE
+            #define LV_TINY_TTF_BITMAP_CACHE_SIZE CONFIG_LV_TINY_TTF_BITMAP_CACHE_SIZE
+        #else
+            #define LV_TINY_TTF_BITMAP_CACHE_SIZE 0
+        #endif
+    #endif
 #endif
 
 /** Rlottie library */
@@ -3379,6 +3477,44 @@
             #endif
         #endif
     #endif
+
+    /** 1: Record per-frame render statistics (dirty areas, pixels, draw task times)
+     *  into a ring buffer which can be exported in a binary format or shown as a heatmap.
+     *  It's allocated with `lv_malloc()` for each display: 128 bytes + 16 bytes per area for each frame,
+     *  about 8 KB with the defaults, plus 2 bytes per heatmap cell. Increase `LV_MEM_SIZE` accordingly. */
+    #ifndef LV_USE_SYSMON_FRAME_LOG
+        #ifdef CONFIG_LV_USE_SYSMON_FRAME_LOG
+            #define LV_USE_SYSMON_FRAME_LOG CONFIG_LV_USE_SYSMON_FRAME_LOG
+        #else
+            #define LV_USE_SYSMON_FRAME_LOG 0
+        #endif
+    #endif
+    #if LV_USE_SYSMON_FRAME_LOG
+        /** Number of frames kept in the ring buffer */
+        #ifndef LV_SYSMON_FRAME_LOG_CNT
+            #ifdef CONFIG_LV_SYSMON_FRAME_LOG_CNT
+                #define LV_SYSMON_FRAME_LOG_CNT CONFIG_LV_SYSMON_FRAME_LOG_CNT
+            #else
+                #define LV_SYSMON_FRAME_LOG_CNT 32
+            #endif
+        #endif
+        /** Maximum number of invalidated areas stored per frame */
+        #ifndef LV_SYSMON_FRAME_LOG_AREA_CNT
+            #ifdef CONFIG_LV_SYSMON_FRAME_LOG_AREA_CNT
+                #define LV_SYSMON_FRAME_LOG_AREA_CNT CONFIG_LV_SYSMON_FRAME_LOG_AREA_CNT
+            #else
+                #define LV_SYSMON_FRAME_LOG_AREA_CNT 8
+            #endif
+        #endif
+        /** Size of a heatmap cell in pixels */
+        #ifndef LV_SYSMON_HEATMAP_CELL_SIZE
+            #ifdef CONFIG_LV_SYSMON_HEATMAP_CELL_SIZE
+                #define LV_SYSMON_HEATMAP_CELL_SIZE CONFIG_LV_SYSMON_HEATMAP_CELL_SIZE
+            #else
+                #define LV_SYSMON_HEATMAP_CELL_SIZE 20
+            #endif
+        #endif
+    #endif
 #endif /*LV_USE_SYSMON*/
 
 /** 1: Enable runtime performance profiler */
@@ -3664,6 +3800,17 @@
         #define LV_USE_OBSERVER 1
     #endif
 #endif
+#if LV_USE_OBSERVER
+    /** 1: Subjects can be marked with `lv_subject_set_deferred()` to notify their Observers
+     *  only once in the next `lv_timer_handler()` call with the last value they were set to. */
+    #ifndef LV_OBSERVER_DEFERRED_NOTIFY
+        #ifdef CONFIG_LV_OBSERVER_DEFERRED_NOTIFY
+            #define LV_OBSERVER_DEFERRED_NOTIFY CONFIG_LV_OBSERVER_DEFERRED_NOTIFY
+        #else
+            #define LV_OBSERVER_DEFERRED_NOTIFY 0
+        #endif
+    #endif
+#endif
 
 /** 1: Enable Pinyin input method
  *  - Requires: lv_keyboard */
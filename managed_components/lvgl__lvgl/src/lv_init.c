@@ -9,8 +9,10 @@
 #include "misc/lv_timer_private.h"
 #include "misc/lv_profiler_builtin_private.h"
 #include "misc/lv_anim_private.h"
+#include "misc/lv_text_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
+#include "font/lv_font_fmt_txt_private.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
@@ -296,6 +298,14 @@ void lv_init(void)
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    lv_font_fmt_txt_bitmap_cache_init();
+#endif
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    lv_text_glyph_run_cache_init();
+#endif
+
 #if LV_USE_DRAW_VG_LITE
     lv_draw_vg_lite_init();
 #endif
@@ -463,6 +473,14 @@ void lv_deinit(void)
     lv_theme_mono_deinit();
 #endif
 
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+    lv_font_fmt_txt_bitmap_cache_deinit();
+#endif
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    lv_text_glyph_run_cache_deinit();
+#endif
+
     lv_image_decoder_deinit();
 
     lv_refr_deinit();
@@ -89,6 +89,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_CACHE_END;
@@ -98,6 +99,10 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -159,6 +164,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -166,6 +172,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->miss_cnt++;
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -296,6 +304,22 @@ const char * lv_cache_get_name(lv_cache_t * cache)
     return cache->name;
 }
 
+int32_t lv_cache_get_hit_rate(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    uint32_t lookup_cnt = cache->hit_cnt + cache->miss_cnt;
+    if(lookup_cnt == 0) return -1;
+
+    return (int32_t)(((uint64_t)cache->hit_cnt * 100) / lookup_cnt);
+}
+
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+}
+
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
 {
     LV_ASSERT_NULL(cache);
@@ -215,6 +215,20 @@ void lv_cache_set_name(lv_cache_t * cache, const char * name);
  */
 const char * lv_cache_get_name(lv_cache_t * cache);
 
+/**
+ * Get the percentage of `lv_cache_acquire` and `lv_cache_acquire_or_create` lookups
+ * which found the entry since the last `lv_cache_reset_stats`.
+ * @param cache         The cache object pointer.
+ * @return              Hit rate in 0..100 range, or -1 if there was no lookup.
+ */
+int32_t lv_cache_get_hit_rate(lv_cache_t * cache);
+
+/**
+ * Restart counting the cache hits and misses.
+ * @param cache         The cache object pointer.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /**
  * Create an iterator for the cache object. The iterator is used to iterate over all cache entries.
  * @param cache         The cache object pointer to create the iterator.
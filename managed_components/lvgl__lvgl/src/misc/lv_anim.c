@@ -29,8 +29,10 @@
 /**In an anim. time this bit indicates that the value is speed, and not time*/
 #define LV_ANIM_SPEED_MASK 0x80000000
 
+/**Initial size of the array of the running animations*/
+#define ANIM_ARRAY_DEF_SIZE 8
+
 #define state LV_GLOBAL_DEFAULT()->anim_state
-#define anim_ll_p &(state.anim_ll)
 
 /**********************
  *      TYPEDEFS
@@ -48,7 +50,10 @@ static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
 static void lv_anim_pause_for_internal(lv_anim_t * a, uint32_t ms);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(const lv_anim_t * a_current);
-static void remove_anim(void * a);
+static void remove_anim(lv_anim_t * a);
+static bool anim_array_add(lv_anim_t * a);
+static void anim_array_remove(lv_anim_t * a);
+static inline int32_t anim_path_eval(lv_anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
@@ -69,7 +74,9 @@ static void remove_anim(void * a);
 
 void lv_anim_core_init(void)
 {
-    lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
+    state.anim_array = NULL;
+    state.anim_cnt = 0;
+    state.anim_size = 0;
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
     state.anim_list_changed = false;
@@ -79,6 +86,10 @@ void lv_anim_core_init(void)
 void lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+    lv_free(state.anim_array);
+    state.anim_array = NULL;
+    state.anim_size = 0;
 }
 
 void lv_anim_enable_vsync_mode(bool enable)
@@ -125,8 +136,8 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         remove_concurrent_anims(a);
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = lv_ll_ins_head(anim_ll_p);
+    /*The animations are allocated one by one so the returned pointer remains valid while it's running*/
+    lv_anim_t * new_anim = lv_malloc(sizeof(lv_anim_t));
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
 
@@ -137,6 +148,12 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     new_anim->last_timer_run = lv_tick_get();
     new_anim->is_paused = false;
 
+    /*Add the new animation to the array of the running animations*/
+    if(!anim_array_add(new_anim)) {
+        lv_free(new_anim);
+        return NULL;
+    }
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->get_value_cb) {
@@ -157,7 +174,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
+    /*Creating an animation changed the array of animations.
      *It's important if it happens in a ready callback. (see `anim_timer`)*/
     anim_mark_list_change();
 
@@ -181,22 +198,24 @@ uint32_t lv_anim_get_playtime(const lv_anim_t * a)
 
 bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
     bool del_any = false;
-    a        = lv_ll_get_head(anim_ll_p);
-    while(a != NULL) {
-        bool del = false;
+
+    /*Go backward: a delete shifts only the later (already checked) animations.
+     *If `a->deleted_cb` deleted more animations too continue from the new end of the array.*/
+    uint32_t i = state.anim_cnt;
+    while(i > 0) {
+        i--;
+        if(i >= state.anim_cnt) {
+            i = state.anim_cnt;
+            continue;
+        }
+
+        lv_anim_t * a = state.anim_array[i];
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             remove_anim(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred*/
             del_any = true;
-            del = true;
         }
-
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
     }
 
     return del_any;
@@ -204,14 +223,19 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_delete_all(void)
 {
-    lv_ll_clear_custom(anim_ll_p, remove_anim);
+    while(state.anim_cnt > 0) {
+        remove_anim(state.anim_array[state.anim_cnt - 1]);
+    }
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) {
+    /*Return the most recently started one*/
+    uint32_t i = state.anim_cnt;
+    while(i > 0) {
+        i--;
+        lv_anim_t * a = state.anim_array[i];
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
@@ -227,11 +251,7 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    LV_LL_READ(anim_ll_p, a) cnt++;
-
-    return cnt;
+    return (uint16_t)LV_MIN(state.anim_cnt, UINT16_MAX);
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -570,12 +590,16 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
-    lv_anim_t * a = lv_ll_get_head(anim_ll_p);
-    while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
+    /*First advance the time of all animations in one loop without calling any user callbacks*/
+    uint32_t tick = lv_tick_get();
+    uint32_t cnt = state.anim_cnt;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_anim_t * a = state.anim_array[i];
+        uint32_t elaps = lv_tick_diff(tick, a->last_timer_run);
 
         if(a->is_paused) {
-            const uint32_t time_paused = lv_tick_elaps(a->pause_time);
+            const uint32_t time_paused = lv_tick_diff(tick, a->pause_time);
             const bool is_pause_over = a->pause_duration != LV_ANIM_PAUSE_FOREVER && time_paused >= a->pause_duration;
 
             if(is_pause_over) {
@@ -588,16 +612,29 @@ static void anim_timer(lv_timer_t * param)
         else {
             a->act_time += elaps;
         }
-        a->last_timer_run = lv_tick_get();
+        a->last_timer_run = tick;
+    }
+
+    /*Now apply the values. Go backward so that the most recently started animations run first.
+     *A delete shifts the later animations back by one, so an already processed animation can be visited again
+     *(`run_round` skips it) but none of the others can be skipped.*/
+    i = state.anim_cnt;
+    while(i > 0) {
+        i--;
+        /*Several animations were deleted in a callback. The ones after the end were already processed.*/
+        if(i >= state.anim_cnt) {
+            i = state.anim_cnt;
+            continue;
+        }
+
+        lv_anim_t * a = state.anim_array[i];
 
         /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
+         * happened in `anim_completed_handler` which could make `a` invalid*/
         state.anim_list_changed = false;
 
         if(!a->is_paused && a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            a->run_round = state.anim_run_round; /*Animations can be moved in the array so need to know which anim has run already*/
             /*The animation will run now for the first time. Call `start_cb`*/
             if(!a->start_cb_called && a->act_time >= 0) {
 
@@ -621,8 +658,8 @@ static void anim_timer(lv_timer_t * param)
                 if(a->act_time > a->duration) a->act_time = a->duration;
 
                 int32_t act_time_before_exec = a->act_time;
-                int32_t new_value;
-                new_value = a->path_cb(a);
+                /*Evaluate the path only now as the callbacks of the animations before could change this one*/
+                int32_t new_value = anim_path_eval(a);
 
                 if(new_value != a->current_value) {
                     a->current_value = new_value;
@@ -643,15 +680,7 @@ static void anim_timer(lv_timer_t * param)
                 }
             }
         }
-
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = lv_ll_get_head(anim_ll_p);
-        else
-            a = lv_ll_get_next(anim_ll_p, a);
     }
-
 }
 
 /**
@@ -671,9 +700,9 @@ static void anim_completed_handler(lv_anim_t * a)
      * - no repeat, reverse play enabled (reverse_duration != 0) and reverse play is completed. */
     if(a->repeat_cnt == 0 && (a->reverse_duration == 0 || a->reverse_play_in_progress == 1)) {
 
-        /*Delete the animation from the list.
+        /*Delete the animation from the array.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        lv_ll_remove(anim_ll_p, a);
+        anim_array_remove(a);
         /*Flag that the list has changed*/
         anim_mark_list_change();
 
@@ -717,7 +746,7 @@ static void anim_vsync_event(lv_event_t * e)
 static void anim_mark_list_change(void)
 {
     state.anim_list_changed = true;
-    if(lv_ll_get_head(anim_ll_p) == NULL) {
+    if(state.anim_cnt == 0) {
         if(state.timer) {
             lv_timer_pause(state.timer);
             return;
@@ -782,11 +811,17 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
 {
     if(a_current->exec_cb == NULL && a_current->custom_exec_cb == NULL) return false;
 
-    lv_anim_t * a;
     bool del_any = false;
-    a = lv_ll_get_head(anim_ll_p);
-    while(a != NULL) {
-        bool del = false;
+    uint32_t i = state.anim_cnt;
+    while(i > 0) {
+        i--;
+        /*`a->deleted_cb` might have deleted other animations too*/
+        if(i >= state.anim_cnt) {
+            i = state.anim_cnt;
+            continue;
+        }
+
+        lv_anim_t * a = state.anim_array[i];
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
          *a wrapper callback is used here an the real callback data is stored in the `user_data`.
          *Therefore equality check would remove all animations.*/
@@ -795,28 +830,83 @@ static bool remove_concurrent_anims(const lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            lv_ll_remove(anim_ll_p, a);
+            anim_array_remove(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
             lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
+            /*Read by `anim_timer`. It need to know if a delete occurred*/
             anim_mark_list_change();
 
             del_any = true;
-            del = true;
         }
-
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? lv_ll_get_head(anim_ll_p) : lv_ll_get_next(anim_ll_p, a);
     }
 
     return del_any;
 }
 
-static void remove_anim(void * a)
+static void remove_anim(lv_anim_t * a)
 {
-    lv_anim_t * anim = a;
-    lv_ll_remove(anim_ll_p, a);
-    if(anim->deleted_cb != NULL) anim->deleted_cb(anim);
+    anim_array_remove(a);
+    if(a->deleted_cb != NULL) a->deleted_cb(a);
     lv_free(a);
 }
+
+/**
+ * Append an animation to the array of the running animations
+ * @param a     pointer to an animation
+ * @return      true: added; false: out of memory
+ */
+static bool anim_array_add(lv_anim_t * a)
+{
+    lv_anim_state_t * state_p = &state;
+    if(state_p->anim_cnt == state_p->anim_size) {
+        uint32_t new_size = state_p->anim_size ? state_p->anim_size * 2 : ANIM_ARRAY_DEF_SIZE;
+        lv_anim_t ** new_array = lv_realloc(state_p->anim_array, new_size * sizeof(lv_anim_t *));
+        LV_ASSERT_MALLOC(new_array);
+        if(new_array == NULL) return false;
+        state_p->anim_array = new_array;
+
+        state_p->anim_size = new_size;
+    }
+
+    a->array_idx = state_p->anim_cnt;
+    state_p->anim_array[state_p->anim_cnt] = a;
+    state_p->anim_cnt++;
+    return true;
+}
+
+/**
+ * Remove an animation from the array of the running animations.
+ * The later animations are moved back by one to keep the order of start.
+ * @param a     pointer to a running animation
+ */
+static void anim_array_remove(lv_anim_t * a)
+{
+    lv_anim_state_t * state_p = &state;
+    uint32_t idx = a->array_idx;
+    LV_ASSERT(idx < state_p->anim_cnt && state_p->anim_array[idx] == a);
+
+    state_p->anim_cnt--;
+    lv_memmove(&state_p->anim_array[idx], &state_p->anim_array[idx + 1],
+               (state_p->anim_cnt - idx) * sizeof(lv_anim_t *));
+
+    uint32_t i;
+    for(i = idx; i < state_p->anim_cnt; i++) {
+        state_p->anim_array[i]->array_idx = i;
+    }
+}
+
+/**
+ * Evaluate the path of an animation at its current time.
+ * The built-in paths are called directly to avoid the indirect call in the common cases.
+ * @param a     pointer to a running animation
+ * @return      the current value of the animation
+ */
+static inline int32_t anim_path_eval(lv_anim_t * a)
+{
+    lv_anim_path_cb_t path_cb = a->path_cb;
+    if(path_cb == lv_anim_path_linear) return lv_anim_path_linear(a);
+    if(path_cb == lv_anim_path_ease_out) return lv_anim_path_ease_out(a);
+    if(path_cb == lv_anim_path_ease_in_out) return lv_anim_path_ease_in_out(a);
+    if(path_cb == lv_anim_path_ease_in) return lv_anim_path_ease_in(a);
+    return path_cb(a);
+}
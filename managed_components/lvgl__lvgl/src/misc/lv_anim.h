@@ -149,6 +149,7 @@ struct _lv_anim_t {
     uint32_t last_timer_run;
     uint32_t pause_time;                      /**<The time when the animation was paused*/
     uint32_t pause_duration;                  /**<The amount of the time the animation must stay paused for*/
+    uint32_t array_idx;                       /**<Index in the array of the running animations */
     uint8_t is_paused : 1;                    /**<Indicates that the animation is paused */
     uint8_t reverse_play_in_progress : 1;     /**< Reverse play is in progress */
     uint8_t run_round : 1;                    /**< When not equal to global.anim_state.anim_run_round (which toggles each
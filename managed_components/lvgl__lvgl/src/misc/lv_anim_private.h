@@ -29,7 +29,9 @@ typedef struct {
     bool anim_run_round;
     bool anim_vsync_registered;
     lv_timer_t * timer;
-    lv_ll_t anim_ll;
+    lv_anim_t ** anim_array;    /**< The running animations in the order of their start */
+    uint32_t anim_cnt;          /**< Number of running animations */
+    uint32_t anim_size;         /**< Allocated size of `anim_array` */
 } lv_anim_state_t;
 
 /**********************
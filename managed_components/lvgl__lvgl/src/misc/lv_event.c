@@ -35,6 +35,8 @@ static void event_mark_deleting(lv_event_list_t * list, lv_event_dsc_t * dsc);
 static bool event_is_marked_deleting(lv_event_dsc_t * dsc);
 static uint32_t event_array_size(lv_event_list_t * list);
 static lv_event_dsc_t ** event_array_at(lv_event_list_t * list, uint32_t index);
+static uint64_t event_code_bit(lv_event_code_t filter);
+static void event_update_mask(lv_event_list_t * list, lv_event_code_t filter);
 
 /**********************
  *  STATIC VARIABLES
@@ -97,6 +99,10 @@ lv_result_t lv_event_send(lv_event_list_t * list, lv_event_t * e, bool preproces
     if(list == NULL) return LV_RESULT_OK;
     if(e->deleted) return LV_RESULT_INVALID;
 
+    /*Nothing to do if no callback is registered for this code*/
+    if(preprocess && !list->has_preprocess) return LV_RESULT_OK;
+    if((list->code_mask & event_code_bit(e->code)) == 0) return LV_RESULT_OK;
+
     /* When obj is deleted in its own event, it will cause the `list->array` header to be released,
      * but the content still exists, which leads to memory leakage.
      * Therefore, back up the header in advance,
@@ -156,6 +162,7 @@ lv_event_dsc_t * lv_event_add(lv_event_list_t * list, lv_event_cb_t cb, lv_event
     }
 
     lv_array_push_back(&list->array, &dsc);
+    event_update_mask(list, filter);
     return dsc;
 }
 
@@ -421,6 +428,14 @@ static void cleanup_event_list(lv_event_list_t * list)
     cleanup_event_list_core(&list->array);
 
     list->has_marked_deleting = false;
+
+    /*Rebuild the mask from the remaining callbacks*/
+    list->code_mask = 0;
+    list->has_preprocess = 0;
+    const uint32_t size = event_array_size(list);
+    for(uint32_t i = 0; i < size; i++) {
+        event_update_mask(list, (*event_array_at(list, i))->filter);
+    }
 }
 
 static void event_mark_deleting(lv_event_list_t * list, lv_event_dsc_t * dsc)
@@ -440,3 +455,15 @@ static lv_event_dsc_t ** event_array_at(lv_event_list_t * list, uint32_t index)
 {
     return lv_array_at(&list->array, index);
 }
+static uint64_t event_code_bit(lv_event_code_t filter)
+{
+    uint32_t code = filter & ~(LV_EVENT_PREPROCESS | LV_EVENT_MARKED_DELETING);
+    return (uint64_t)1 << (code < 63 ? code : 63);
+}
+static void event_update_mask(lv_event_list_t * list, lv_event_code_t filter)
+{
+    if(filter & LV_EVENT_PREPROCESS) list->has_preprocess = 1;
+
+    if((filter & ~LV_EVENT_PREPROCESS) == LV_EVENT_ALL) list->code_mask = UINT64_MAX;
+    else list->code_mask |= event_code_bit(filter);
+}
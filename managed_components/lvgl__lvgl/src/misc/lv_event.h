@@ -127,9 +127,12 @@ typedef enum {
 
 typedef struct {
     lv_array_t array;
+    uint64_t code_mask;                /**< Bit `n` is set if a callback is registered for event code `n`.
+                                         Codes from 63 share the last bit. Used to skip the list quickly. */
     uint8_t is_traversing: 1;          /**< True: the list is being nested traversed */
     uint8_t has_marked_deleting: 1;    /**< True: the list has marked deleting objects
                                          when some of events are marked as deleting */
+    uint8_t has_preprocess: 1;         /**< True: a callback is registered with `LV_EVENT_PREPROCESS` */
 } lv_event_list_t;
 
 /**
@@ -24,6 +24,24 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Counter, flow and async events are optional for the profiler backends.
+ *Use the built-in profiler's implementation if it's available.*/
+#ifndef LV_PROFILER_COUNTER
+    #ifdef LV_PROFILER_BUILTIN_COUNTER
+        #define LV_PROFILER_COUNTER(name, value)    LV_PROFILER_BUILTIN_COUNTER(name, value)
+        #define LV_PROFILER_FLOW_BEGIN(name, id)    LV_PROFILER_BUILTIN_FLOW_BEGIN(name, id)
+        #define LV_PROFILER_FLOW_END(name, id)      LV_PROFILER_BUILTIN_FLOW_END(name, id)
+        #define LV_PROFILER_ASYNC_BEGIN(name, id)   LV_PROFILER_BUILTIN_ASYNC_BEGIN(name, id)
+        #define LV_PROFILER_ASYNC_END(name, id)     LV_PROFILER_BUILTIN_ASYNC_END(name, id)
+    #else
+        #define LV_PROFILER_COUNTER(name, value)
+        #define LV_PROFILER_FLOW_BEGIN(name, id)
+        #define LV_PROFILER_FLOW_END(name, id)
+        #define LV_PROFILER_ASYNC_BEGIN(name, id)
+        #define LV_PROFILER_ASYNC_END(name, id)
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -42,6 +60,11 @@ extern "C" {
 #define LV_PROFILER_END
 #define LV_PROFILER_BEGIN_TAG(tag) LV_UNUSED(tag)
 #define LV_PROFILER_END_TAG(tag)   LV_UNUSED(tag)
+#define LV_PROFILER_COUNTER(name, value)
+#define LV_PROFILER_FLOW_BEGIN(name, id)
+#define LV_PROFILER_FLOW_END(name, id)
+#define LV_PROFILER_ASYNC_BEGIN(name, id)
+#define LV_PROFILER_ASYNC_END(name, id)
 
 #endif /*LV_USE_PROFILER*/
 
@@ -74,11 +97,15 @@ extern "C" {
 #define LV_PROFILER_DRAW_END LV_PROFILER_END
 #define LV_PROFILER_DRAW_BEGIN_TAG(tag) LV_PROFILER_BEGIN_TAG(tag)
 #define LV_PROFILER_DRAW_END_TAG(tag)   LV_PROFILER_END_TAG(tag)
+#define LV_PROFILER_DRAW_FLOW_BEGIN(name, id) LV_PROFILER_FLOW_BEGIN(name, id)
+#define LV_PROFILER_DRAW_FLOW_END(name, id)   LV_PROFILER_FLOW_END(name, id)
 #else
 #define LV_PROFILER_DRAW_BEGIN
 #define LV_PROFILER_DRAW_END
 #define LV_PROFILER_DRAW_BEGIN_TAG(tag)
 #define LV_PROFILER_DRAW_END_TAG(tag)
+#define LV_PROFILER_DRAW_FLOW_BEGIN(name, id)
+#define LV_PROFILER_DRAW_FLOW_END(name, id)
 #endif
 
 #if LV_USE_PROFILER && LV_PROFILER_DECODER
@@ -98,11 +125,17 @@ extern "C" {
 #define LV_PROFILER_REFR_END LV_PROFILER_END
 #define LV_PROFILER_REFR_BEGIN_TAG(tag) LV_PROFILER_BEGIN_TAG(tag)
 #define LV_PROFILER_REFR_END_TAG(tag)   LV_PROFILER_END_TAG(tag)
+#define LV_PROFILER_REFR_COUNTER(name, value) LV_PROFILER_COUNTER(name, value)
+#define LV_PROFILER_REFR_ASYNC_BEGIN(name, id) LV_PROFILER_ASYNC_BEGIN(name, id)
+#define LV_PROFILER_REFR_ASYNC_END(name, id)   LV_PROFILER_ASYNC_END(name, id)
 #else
 #define LV_PROFILER_REFR_BEGIN
 #define LV_PROFILER_REFR_END
 #define LV_PROFILER_REFR_BEGIN_TAG(tag)
 #define LV_PROFILER_REFR_END_TAG(tag)
+#define LV_PROFILER_REFR_COUNTER(name, value)
+#define LV_PROFILER_REFR_ASYNC_BEGIN(name, id)
+#define LV_PROFILER_REFR_ASYNC_END(name, id)
 #endif
 
 #if LV_USE_PROFILER && LV_PROFILER_INDEV
@@ -134,11 +167,13 @@ extern "C" {
 #define LV_PROFILER_CACHE_END LV_PROFILER_END
 #define LV_PROFILER_CACHE_BEGIN_TAG(tag) LV_PROFILER_BEGIN_TAG(tag)
 #define LV_PROFILER_CACHE_END_TAG(tag)   LV_PROFILER_END_TAG(tag)
+#define LV_PROFILER_CACHE_COUNTER(name, value) LV_PROFILER_COUNTER(name, value)
 #else
 #define LV_PROFILER_CACHE_BEGIN
 #define LV_PROFILER_CACHE_END
 #define LV_PROFILER_CACHE_BEGIN_TAG(tag)
 #define LV_PROFILER_CACHE_END_TAG(tag)
+#define LV_PROFILER_CACHE_COUNTER(name, value)
 #endif
 
 #if LV_USE_PROFILER && LV_PROFILER_FS
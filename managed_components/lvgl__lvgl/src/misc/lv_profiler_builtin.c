@@ -22,6 +22,9 @@
 #define LV_PROFILER_STR_MAX_LEN 128
 #define LV_PROFILER_TICK_PER_SEC_MAX 1000000000 /* Maximum accuracy: 1 nanosecond */
 
+#define LV_PROFILER_EXPORT_MAGIC "LVPT"
+#define LV_PROFILER_EXPORT_VERSION 2
+
 #if LV_USE_OS
     #define LV_PROFILER_MULTEX_INIT   lv_mutex_init(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_DEINIT lv_mutex_delete(&profiler_ctx->mutex)
@@ -45,10 +48,9 @@ typedef struct {
     uint64_t tick;     /**< The tick value of the profiler item */
     char tag;          /**< The tag of the profiler item */
     const char * func; /**< A pointer to the function associated with the profiler item */
-#if LV_USE_OS
+    uint32_t value;    /**< Value of a counter or ID of a flow or async event */
     int tid;           /**< The thread ID of the profiler item */
-    int cpu;         /**< The CPU ID of the profiler item */
-#endif
+    int cpu;           /**< The CPU ID of the profiler item */
 } lv_profiler_builtin_item_t;
 
 /**
@@ -58,6 +60,8 @@ typedef struct _lv_profiler_builtin_ctx_t {
     lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
     uint32_t item_num;                     /**< Number of profiler items in the array */
     uint32_t cur_index;                    /**< Index of the current profiler item */
+    bool wrapped;                          /**< The ring buffer was full and the oldest items were overwritten */
+    uint32_t write_cnt;                    /**< Number of items written since init, the sequence number of the next item */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
     bool enable;                           /**< Whether the built-in profiler is enabled */
 #if LV_USE_OS
@@ -74,6 +78,11 @@ static void default_flush_cb(const char * buf);
 static int default_tid_get_cb(void);
 static int default_cpu_get_cb(void);
 static void flush_no_lock(void);
+static void write_no_lock(const char * func, char tag, uint32_t value);
+static uint32_t get_item_count(void);
+static lv_profiler_builtin_item_t * get_item(uint32_t i);
+static uint8_t * put_u16(uint8_t * buf, uint32_t v);
+static uint8_t * put_u32(uint8_t * buf, uint32_t v);
 
 /**********************
  *  STATIC VARIABLES
@@ -186,25 +195,94 @@ void lv_profiler_builtin_write(const char * func, char tag)
     }
 
     LV_PROFILER_MULTEX_LOCK;
+    write_no_lock(func, tag, 0);
+    LV_PROFILER_MULTEX_UNLOCK;
+}
 
-    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
-        flush_no_lock();
-        profiler_ctx->cur_index = 0;
+void lv_profiler_builtin_write_value(const char * name, char tag, uint32_t value)
+{
+    LV_ASSERT_NULL(name);
+
+    if(!(profiler_ctx && profiler_ctx->enable)) {
+        return;
     }
 
-    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
-    item->func = func;
-    item->tag = tag;
-    item->tick = profiler_ctx->config.tick_get_cb();
+    LV_PROFILER_MULTEX_LOCK;
+    write_no_lock(name, tag, value);
+    LV_PROFILER_MULTEX_UNLOCK;
+}
 
-#if LV_USE_OS
-    item->tid = profiler_ctx->config.tid_get_cb();
-    item->cpu = profiler_ctx->config.cpu_get_cb();
-#endif
+uint32_t lv_profiler_builtin_export(lv_profiler_builtin_write_cb_t write_cb, void * user_data)
+{
+    LV_ASSERT_NULL(profiler_ctx);
+    LV_ASSERT_NULL(write_cb);
 
-    profiler_ctx->cur_index++;
+    LV_PROFILER_MULTEX_LOCK;
+
+    uint32_t item_cnt = get_item_count();
+
+    /*Collect the distinct names so that the events can refer to them by index*/
+    const char ** names = lv_malloc(LV_MAX(item_cnt, 1) * sizeof(const char *));
+    LV_ASSERT_MALLOC(names);
+    if(names == NULL) {
+        LV_PROFILER_MULTEX_UNLOCK;
+        return 0;
+    }
+
+    uint32_t name_cnt = 0;
+    uint32_t i;
+    uint32_t n;
+    for(i = 0; i < item_cnt; i++) {
+        const char * func = get_item(i)->func;
+        for(n = 0; n < name_cnt; n++) {
+            if(names[n] == func) break;
+        }
+        if(n == name_cnt) names[name_cnt++] = func;
+    }
+
+    uint8_t buf[LV_PROFILER_STR_MAX_LEN];
+    uint8_t * p;
+    uint32_t size = 0;
+
+    lv_memcpy(buf, LV_PROFILER_EXPORT_MAGIC, 4);
+    p = put_u16(buf + 4, LV_PROFILER_EXPORT_VERSION);
+    p = put_u16(p, 0);
+    p = put_u32(p, profiler_ctx->config.tick_per_sec);
+    p = put_u32(p, item_cnt);
+    p = put_u32(p, name_cnt);
+    p = put_u32(p, profiler_ctx->write_cnt - item_cnt);
+    write_cb(buf, p - buf, user_data);
+    size += p - buf;
+
+    for(n = 0; n < name_cnt; n++) {
+        uint32_t len = LV_MIN(lv_strlen(names[n]), sizeof(buf) - 2);
+        p = put_u16(buf, len);
+        lv_memcpy(p, names[n], len);
+        write_cb(buf, len + 2, user_data);
+        size += len + 2;
+    }
+
+    for(i = 0; i < item_cnt; i++) {
+        lv_profiler_builtin_item_t * item = get_item(i);
+        for(n = 0; n < name_cnt; n++) {
+            if(names[n] == item->func) break;
+        }
+
+        p = put_u32(buf, (uint32_t)item->tick);
+        p = put_u32(p, (uint32_t)(item->tick >> 32));
+        p = put_u32(p, item->value);
+        p = put_u32(p, (uint32_t)item->tid);
+        p = put_u16(p, n);
+        *p++ = (uint8_t)item->cpu;
+        *p++ = (uint8_t)item->tag;
+        write_cb(buf, p - buf, user_data);
+        size += p - buf;
+    }
+
+    lv_free(names);
 
     LV_PROFILER_MULTEX_UNLOCK;
+    return size;
 }
 
 /**********************
@@ -238,33 +316,109 @@ static void flush_no_lock(void)
         return;
     }
 
-    uint32_t cur = 0;
     char buf[LV_PROFILER_STR_MAX_LEN];
     uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
-    while(cur < profiler_ctx->cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[cur++];
+    uint32_t item_cnt = get_item_count();
+    uint32_t i;
+    for(i = 0; i < item_cnt; i++) {
+        lv_profiler_builtin_item_t * item = get_item(i);
         uint64_t sec = item->tick / tick_per_sec;
         uint64_t nsec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
 
-#if LV_USE_OS
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-%d [%d] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s\n",
-                    item->tid,
-                    item->cpu,
-                    sec,
-                    nsec,
-                    item->tag,
-                    item->func);
-#else
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s\n",
-                    sec,
-                    nsec,
-                    item->tag,
-                    item->func);
-#endif
+        /*Map to the tags of the ftrace marker format*/
+        char tag = item->tag;
+        bool has_value = true;
+        switch(tag) {
+            case 'B':
+            case 'E':
+                has_value = false;
+                break;
+            case 'C':
+                break;
+            case 'b':
+                tag = 'S';
+                break;
+            case 'e':
+                tag = 'F';
+                break;
+            default:
+                /*Flow events can't be represented, use the binary export for them*/
+                continue;
+        }
+
+        int len = lv_snprintf(buf, sizeof(buf),
+                              "   LVGL-%d [%d] %" LV_PRIu64 ".%09" LV_PRIu64 ": tracing_mark_write: %c|1|%s",
+                              item->tid,
+                              item->cpu,
+                              sec,
+                              nsec,
+                              tag,
+                              item->func);
+        len = LV_MIN(len, (int)sizeof(buf) - 1);
+        if(has_value) {
+            lv_snprintf(buf + len, sizeof(buf) - len, "|%" LV_PRIu32 "\n", item->value);
+        }
+        else {
+            lv_snprintf(buf + len, sizeof(buf) - len, "\n");
+        }
         profiler_ctx->config.flush_cb(buf);
     }
 }
 
+static void write_no_lock(const char * func, char tag, uint32_t value)
+{
+    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
+        if(profiler_ctx->config.ring_buffer) {
+            profiler_ctx->wrapped = true;
+        }
+        else {
+            flush_no_lock();
+        }
+        profiler_ctx->cur_index = 0;
+    }
+
+    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
+    item->func = func;
+    item->tag = tag;
+    item->value = value;
+    item->tick = profiler_ctx->config.tick_get_cb();
+
+    /*The callbacks are useful without an OS too, e.g. to tell apart the draw units' threads*/
+    item->tid = profiler_ctx->config.tid_get_cb ? profiler_ctx->config.tid_get_cb() : 1;
+    item->cpu = profiler_ctx->config.cpu_get_cb ? profiler_ctx->config.cpu_get_cb() : 0;
+
+    profiler_ctx->cur_index++;
+    profiler_ctx->write_cnt++;
+}
+
+static uint32_t get_item_count(void)
+{
+    return profiler_ctx->wrapped ? profiler_ctx->item_num : profiler_ctx->cur_index;
+}
+
+/**
+ * Get the i-th oldest item
+ */
+static lv_profiler_builtin_item_t * get_item(uint32_t i)
+{
+    if(profiler_ctx->wrapped) {
+        i = (profiler_ctx->cur_index + i) % profiler_ctx->item_num;
+    }
+
+    return &profiler_ctx->item_arr[i];
+}
+
+static uint8_t * put_u16(uint8_t * buf, uint32_t v)
+{
+    buf[0] = v & 0xff;
+    buf[1] = (v >> 8) & 0xff;
+    return buf + 2;
+}
+
+static uint8_t * put_u32(uint8_t * buf, uint32_t v)
+{
+    buf = put_u16(buf, v & 0xffff);
+    return put_u16(buf, v >> 16);
+}
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
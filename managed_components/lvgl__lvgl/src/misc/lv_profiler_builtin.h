@@ -29,10 +29,21 @@ extern "C" {
 #define LV_PROFILER_BUILTIN_BEGIN           LV_PROFILER_BUILTIN_BEGIN_TAG(__func__)
 #define LV_PROFILER_BUILTIN_END             LV_PROFILER_BUILTIN_END_TAG(__func__)
 
+#define LV_PROFILER_BUILTIN_COUNTER(name, value)    lv_profiler_builtin_write_value((name), 'C', (uint32_t)(value))
+#define LV_PROFILER_BUILTIN_FLOW_BEGIN(name, id)    lv_profiler_builtin_write_value((name), 's', (uint32_t)(lv_uintptr_t)(id))
+#define LV_PROFILER_BUILTIN_FLOW_END(name, id)      lv_profiler_builtin_write_value((name), 'f', (uint32_t)(lv_uintptr_t)(id))
+#define LV_PROFILER_BUILTIN_ASYNC_BEGIN(name, id)   lv_profiler_builtin_write_value((name), 'b', (uint32_t)(lv_uintptr_t)(id))
+#define LV_PROFILER_BUILTIN_ASYNC_END(name, id)     lv_profiler_builtin_write_value((name), 'e', (uint32_t)(lv_uintptr_t)(id))
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Called by `lv_profiler_builtin_export` with the consecutive chunks of the binary trace
+ */
+typedef void (*lv_profiler_builtin_write_cb_t)(const void * buf, uint32_t len, void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -72,6 +83,26 @@ void lv_profiler_builtin_flush(void);
  */
 void lv_profiler_builtin_write(const char * func, char tag);
 
+/**
+ * @brief Write an event which carries a value
+ * @param name Name of the counter, flow or async event
+ * @param tag 'C': counter, 's'/'f': flow begin/end, 'b'/'e': async begin/end
+ * @param value The value of the counter or the ID of the flow or async event
+ */
+void lv_profiler_builtin_write_value(const char * name, char tag, uint32_t value);
+
+/**
+ * @brief Export the recorded events from the oldest to the newest in a compact
+ *        binary format. See `scripts/profiler_trace.py` for the layout and
+ *        a converter to Chrome trace JSON. The events are not removed, the
+ *        header holds the sequence number of the first exported event so
+ *        overlapping exports can be merged.
+ * @param write_cb Called with the consecutive chunks of the data
+ * @param user_data Passed to `write_cb`
+ * @return Number of exported bytes
+ */
+uint32_t lv_profiler_builtin_export(lv_profiler_builtin_write_cb_t write_cb, void * user_data);
+
 /**********************
  *      MACROS
  **********************/
@@ -36,6 +36,8 @@ struct _lv_profiler_builtin_config_t {
     void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
     int (*tid_get_cb)(void);            /**< Callback function to get the current thread ID */
     int (*cpu_get_cb)(void);            /**< Callback function to get the current CPU */
+    bool ring_buffer;                   /**< true: overwrite the oldest events when the buffer is full;
+                                         *   false: flush and restart the buffer when it's full */
 };
 
 
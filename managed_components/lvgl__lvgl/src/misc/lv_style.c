@@ -27,6 +27,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -188,6 +189,7 @@ void lv_style_init(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    lv_style_prop_cache_invalidate();
 }
 
 void lv_style_reset(lv_style_t * style)
@@ -199,6 +201,7 @@ void lv_style_reset(lv_style_t * style)
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
+    lv_style_prop_cache_invalidate();
 }
 
 
@@ -276,6 +279,7 @@ lv_style_prop_t lv_style_register_prop(uint8_t flag)
     /* This should never happen - we should bail out above */
     LV_ASSERT_NULL(lv_style_custom_prop_flag_lookup_table);
     lv_style_custom_prop_flag_lookup_table[last_custom_prop_id - LV_STYLE_NUM_BUILT_IN_PROPS] = flag;
+    lv_style_prop_cache_invalidate();
     return last_custom_prop_id;
 }
 
@@ -328,6 +332,7 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
 
             lv_free(old_values);
+            lv_style_prop_cache_invalidate();
             LV_PROFILER_STYLE_END;
             return true;
         }
@@ -339,57 +344,12 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
 {
-    LV_ASSERT_STYLE(style);
-
-    if(lv_style_is_const(style)) {
-        LV_LOG_ERROR("Cannot set property of constant style");
-        return;
-    }
-
-    LV_ASSERT(prop != LV_STYLE_PROP_INV);
-    LV_PROFILER_STYLE_BEGIN;
-    lv_style_prop_t * props;
-    int32_t i;
-
-    if(style->values_and_props) {
-        props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                values[i] = value;
-                LV_PROFILER_STYLE_END;
-                return;
-            }
-        }
-    }
-
-    size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
-    uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
-    if(values_and_props == NULL) {
-        LV_PROFILER_STYLE_END;
-        return;
-    }
-
-    style->values_and_props = values_and_props;
-
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    /*Shift all props to make place for the value before them*/
-    for(i = style->prop_cnt - 1; i >= 0; i--) {
-        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
-    }
-    style->prop_cnt++;
-
-    /*Go to the new position with the props*/
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-
-    /*Set the new property and value*/
-    props[style->prop_cnt - 1] = prop;
-    values[style->prop_cnt - 1] = value;
+    if(style_set_prop(style, prop, value)) lv_style_prop_cache_invalidate();
+}
 
-    uint32_t group = lv_style_get_prop_group(prop);
-    style->has_group |= (uint32_t)1 << group;
-    LV_PROFILER_STYLE_END;
+void lv_style_set_prop_no_cache_invalidate(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    style_set_prop(style, prop, value);
 }
 
 lv_style_res_t lv_style_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
@@ -506,6 +466,78 @@ uint8_t lv_style_prop_lookup_flags(lv_style_prop_t prop)
     return 0;
 }
 
+void lv_style_prop_cache_invalidate(void)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    LV_GLOBAL_DEFAULT()->style_prop_cache_generation++;
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Add or update a property of a style
+ * @param style     pointer to a style
+ * @param prop      the property
+ * @param value     the new value
+ * @return          true: the style has changed
+ */
+static bool style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
+{
+    LV_ASSERT_STYLE(style);
+
+    if(lv_style_is_const(style)) {
+        LV_LOG_ERROR("Cannot set property of constant style");
+        return false;
+    }
+
+    LV_ASSERT(prop != LV_STYLE_PROP_INV);
+    LV_PROFILER_STYLE_BEGIN;
+    lv_style_prop_t * props;
+    int32_t i;
+
+    if(style->values_and_props) {
+        props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+        for(i = style->prop_cnt - 1; i >= 0; i--) {
+            if(props[i] == prop) {
+                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+                bool changed = values[i].ptr != value.ptr || values[i].num != value.num ||
+                               !lv_color_eq(values[i].color, value.color);
+                values[i] = value;
+                LV_PROFILER_STYLE_END;
+                return changed;
+            }
+        }
+    }
+
+    size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    uint8_t * values_and_props = lv_realloc(style->values_and_props, size);
+    if(values_and_props == NULL) {
+        LV_PROFILER_STYLE_END;
+        return false;
+    }
+
+    style->values_and_props = values_and_props;
+
+    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    /*Shift all props to make place for the value before them*/
+    for(i = style->prop_cnt - 1; i >= 0; i--) {
+        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    }
+    style->prop_cnt++;
+
+    /*Go to the new position with the props*/
+    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+
+    /*Set the new property and value*/
+    props[style->prop_cnt - 1] = prop;
+    values[style->prop_cnt - 1] = value;
+
+    uint32_t group = lv_style_get_prop_group(prop);
+    style->has_group |= (uint32_t)1 << group;
+    LV_PROFILER_STYLE_END;
+    return true;
+}
@@ -28,6 +28,23 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Mark the style property values cached in the objects as outdated.
+ * Called when a style or the list of styles of an object changes.
+ * Does nothing if `LV_OBJ_STYLE_PROP_CACHE_CNT` is 0.
+ */
+void lv_style_prop_cache_invalidate(void);
+
+/**
+ * Set a property of a style used by only one object, e.g. its local or transition style.
+ * Unlike `lv_style_set_prop` it leaves the property cache of the other objects valid;
+ * `lv_obj_refresh_style` marks the cache of the object and its children as outdated.
+ * @param style     pointer to a style
+ * @param prop      the property
+ * @param value     the new value
+ */
+void lv_style_set_prop_no_cache_invalidate(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value);
+
 /**********************
  *      MACROS
  **********************/
@@ -14,11 +14,19 @@
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
 #include "../misc/lv_types.h"
+#include "../misc/cache/lv_cache.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
+#define TEXT_HASH_INIT 2166136261U   /*FNV-1a offset basis*/
+#define GLYPH_RUN_MIN_LEN 16        /*Shorter texts are measured without shaping them first*/
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    #define glyph_run_cache LV_GLOBAL_DEFAULT()->text_glyph_run_cache
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +36,25 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static uint32_t text_hash(uint32_t hash, const char * text, uint32_t len);
+static bool lines_add(lv_text_lines_t * lines, uint32_t start, int32_t width);
+static const lv_text_glyph_run_t * glyph_run_acquire(const char * text, uint32_t text_len, uint32_t hash,
+                                                     const lv_font_t * font, const lv_text_glyph_run_t * prefix, bool create);
+static void glyph_run_release(const lv_text_glyph_run_t * run, bool drop);
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    static bool glyph_run_create_cb(lv_text_glyph_run_t * node, const lv_text_glyph_run_t * prefix);
+    static void glyph_run_free_cb(lv_text_glyph_run_t * node, void * user_data);
+    static lv_cache_compare_res_t glyph_run_compare_cb(const lv_text_glyph_run_t * lhs, const lv_text_glyph_run_t * rhs);
+#endif
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_text_utf8_size(const char * str);
     static uint32_t lv_text_unicode_to_utf8(uint32_t letter_uni);
     static uint32_t lv_text_utf8_conv_wc(uint32_t c);
     static uint32_t lv_text_utf8_next(const char * txt, uint32_t * i);
+    static uint32_t lv_text_utf8_decode(const char * txt, uint32_t * i, uint32_t len, uint32_t * letters,
+                                        uint32_t * ofs, uint32_t max_cnt);
     static uint32_t lv_text_utf8_prev(const char * txt, uint32_t * i_start);
     static uint32_t lv_text_utf8_get_byte_id(const char * txt, uint32_t utf8_id);
     static uint32_t lv_text_utf8_get_char_id(const char * txt, uint32_t byte_id);
@@ -42,6 +64,8 @@
     static uint32_t lv_text_unicode_to_iso8859_1(uint32_t letter_uni);
     static uint32_t lv_text_iso8859_1_conv_wc(uint32_t c);
     static uint32_t lv_text_iso8859_1_next(const char * txt, uint32_t * i);
+    static uint32_t lv_text_iso8859_1_decode(const char * txt, uint32_t * i, uint32_t len, uint32_t * letters,
+                                             uint32_t * ofs, uint32_t max_cnt);
     static uint32_t lv_text_iso8859_1_prev(const char * txt, uint32_t * i_start);
     static uint32_t lv_text_iso8859_1_get_byte_id(const char * txt, uint32_t utf8_id);
     static uint32_t lv_text_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
@@ -59,6 +83,8 @@
     uint32_t (*const lv_text_unicode_to_encoded)(uint32_t)                = lv_text_unicode_to_utf8;
     uint32_t (*const lv_text_encoded_conv_wc)(uint32_t)                   = lv_text_utf8_conv_wc;
     uint32_t (*const lv_text_encoded_next)(const char *, uint32_t *)      = lv_text_utf8_next;
+    uint32_t (*const lv_text_encoded_decode)(const char *, uint32_t *, uint32_t, uint32_t *, uint32_t *,
+                                             uint32_t)                    = lv_text_utf8_decode;
     uint32_t (*const lv_text_encoded_prev)(const char *, uint32_t *)      = lv_text_utf8_prev;
     uint32_t (*const lv_text_encoded_get_byte_id)(const char *, uint32_t) = lv_text_utf8_get_byte_id;
     uint32_t (*const lv_text_encoded_get_char_id)(const char *, uint32_t) = lv_text_utf8_get_char_id;
@@ -68,6 +94,8 @@
     uint32_t (*const lv_text_unicode_to_encoded)(uint32_t)                = lv_text_unicode_to_iso8859_1;
     uint32_t (*const lv_text_encoded_conv_wc)(uint32_t)                   = lv_text_iso8859_1_conv_wc;
     uint32_t (*const lv_text_encoded_next)(const char *, uint32_t *)      = lv_text_iso8859_1_next;
+    uint32_t (*const lv_text_encoded_decode)(const char *, uint32_t *, uint32_t, uint32_t *, uint32_t *,
+                                             uint32_t)                    = lv_text_iso8859_1_decode;
     uint32_t (*const lv_text_encoded_prev)(const char *, uint32_t *)      = lv_text_iso8859_1_prev;
     uint32_t (*const lv_text_encoded_get_byte_id)(const char *, uint32_t) = lv_text_iso8859_1_get_byte_id;
     uint32_t (*const lv_text_encoded_get_char_id)(const char *, uint32_t)     = lv_text_iso8859_1_get_char_id;
@@ -124,14 +152,19 @@ void lv_text_get_size_attributes(lv_point_t * size_res, const char * text, const
         attributes->max_width = LV_COORD_MAX;
     }
 
+    /*Shape the text once for breaking the lines and measuring them*/
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(text, font, true);
+    uint32_t text_len = run ? run->text_len : lv_strlen(text);
+
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
-        new_line_start += lv_text_get_next_line(
-                              &text[line_start], LV_TEXT_LEN_MAX, font, NULL, attributes);
+        new_line_start += lv_text_glyph_run_get_next_line(run, &text[line_start], text_len - line_start, font, NULL,
+                                                          attributes);
 
         if((unsigned long)size_res->y +
            (unsigned long)letter_height + (unsigned long)attributes->line_space > LV_MAX_OF(int32_t)) {
             LV_LOG_WARN("integer overflow while calculating text height");
+            lv_text_glyph_run_release(run);
             return;
         }
         else {
@@ -140,13 +173,15 @@ void lv_text_get_size_attributes(lv_point_t * size_res, const char * text, const
         }
 
         /*Calculate the longest line*/
-        int32_t act_line_length = lv_text_get_width(
-                                      &text[line_start], new_line_start - line_start, font, attributes);
+        int32_t act_line_length = lv_text_glyph_run_get_width(run,
+                                                              &text[line_start], new_line_start - line_start, font, attributes);
 
         size_res->x = LV_MAX(act_line_length, size_res->x);
         line_start  = new_line_start;
     }
 
+    lv_text_glyph_run_release(run);
+
     /*Make the text one line taller if the last character is '\n' or '\r'*/
     if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
         size_res->y += letter_height + attributes->line_space;
@@ -159,6 +194,190 @@ void lv_text_get_size_attributes(lv_point_t * size_res, const char * text, const
         size_res->y -= attributes->line_space;
 }
 
+void lv_text_lines_get_size(lv_point_t * size_res, lv_text_lines_t * lines, const char * text,
+                            const lv_font_t * font, lv_text_attributes_t * attributes)
+{
+    LV_ASSERT_NULL(lines);
+    LV_ASSERT_NULL(attributes);
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(text);
+
+    if(attributes->text_flags & LV_TEXT_FLAG_EXPAND) {
+        attributes->max_width = LV_COORD_MAX;
+    }
+
+    uint32_t text_len = lv_strlen(text);
+    uint32_t hash = TEXT_HASH_INIT;
+    uint32_t keep_cnt = 0;
+    bool appended = false;
+    if(lines->line_cnt && lines->font == font && lines->letter_space == attributes->letter_space &&
+       lines->max_width == attributes->max_width && lines->text_flags == attributes->text_flags &&
+       text_len >= lines->text_len) {
+        hash = text_hash(hash, text, lines->text_len);
+        if(hash == lines->text_hash) {
+            /*If text was appended the last line can be broken differently.
+             *Long words can be broken in the line before it too.*/
+            if(text_len == lines->text_len) keep_cnt = lines->line_cnt;
+            else keep_cnt = lines->line_cnt > 2 ? lines->line_cnt - 2 : 0;
+            appended = true;
+        }
+    }
+
+    lines->reused_cnt = keep_cnt;
+    if(keep_cnt != lines->line_cnt || text_len != lines->text_len) {
+        uint32_t line_start = 0;
+        if(keep_cnt) {
+            line_start = lines->lines[keep_cnt].start;
+            hash = text_hash(hash, &text[lines->text_len], text_len - lines->text_len);
+        }
+        else {
+            hash = text_hash(TEXT_HASH_INIT, text, text_len);
+        }
+
+        /*Shape the text. If it was appended, only the new letters need to be shaped.*/
+        const lv_text_glyph_run_t * prefix = NULL;
+        if(appended) {
+            prefix = glyph_run_acquire(lines->text, lines->text_len, lines->text_hash, font, NULL, false);
+        }
+        const lv_text_glyph_run_t * run = glyph_run_acquire(text, text_len, hash, font, prefix, true);
+        glyph_run_release(prefix, true);   /*Replaced by the run of the appended text*/
+
+        lines->font = font;
+        lines->letter_space = attributes->letter_space;
+        lines->max_width = attributes->max_width;
+        lines->text_flags = attributes->text_flags;
+        lines->text_len = text_len;
+        lines->text_hash = hash;
+        lines->line_cnt = keep_cnt;
+
+        while(text[line_start] != '\0') {
+            uint32_t line_end = line_start + lv_text_glyph_run_get_next_line(run, &text[line_start],
+                                                                             text_len - line_start, font, NULL, attributes);
+            int32_t width = lv_text_glyph_run_get_width(run, &text[line_start], line_end - line_start, font, attributes);
+            if(!lines_add(lines, line_start, width)) {
+                lv_text_glyph_run_release(run);
+                lv_text_lines_reset(lines);
+                lv_text_get_size_attributes(size_res, text, font, attributes);
+                return;
+            }
+            line_start = line_end;
+        }
+        lv_text_glyph_run_release(run);
+    }
+    lines->text = text;
+
+    int32_t letter_height = lv_font_get_line_height(font);
+    size_res->x = 0;
+    uint32_t i;
+    for(i = 0; i < lines->line_cnt; i++) {
+        size_res->x = LV_MAX(lines->lines[i].width, size_res->x);
+    }
+
+    int64_t h = (int64_t)lines->line_cnt * (letter_height + attributes->line_space);
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(text_len && (text[text_len - 1] == '\n' || text[text_len - 1] == '\r')) {
+        h += letter_height + attributes->line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(h == 0) h = letter_height;
+    else h -= attributes->line_space;
+
+    if(h > (int64_t)LV_MAX_OF(int32_t)) {
+        LV_LOG_WARN("integer overflow while calculating text height");
+        h = LV_MAX_OF(int32_t);
+    }
+    size_res->y = (int32_t)h;
+}
+
+bool lv_text_lines_is_valid(const lv_text_lines_t * lines, const char * text, uint32_t text_len,
+                            const lv_font_t * font, const lv_text_attributes_t * attributes)
+{
+    int32_t max_width = (attributes->text_flags & LV_TEXT_FLAG_EXPAND) ? LV_COORD_MAX : attributes->max_width;
+
+    return lines->line_cnt && lines->text == text && lines->text_len <= text_len && lines->font == font &&
+           lines->letter_space == attributes->letter_space && lines->max_width == max_width &&
+           lines->text_flags == attributes->text_flags;
+}
+
+void lv_text_lines_reset(lv_text_lines_t * lines)
+{
+    lv_free(lines->lines);
+    lv_memzero(lines, sizeof(lv_text_lines_t));
+}
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+
+void lv_text_glyph_run_cache_init(void)
+{
+    glyph_run_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_text_glyph_run_t),
+                                      LV_TEXT_GLYPH_RUN_CACHE_SIZE,
+    (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)glyph_run_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)glyph_run_create_cb,
+        .free_cb = (lv_cache_free_cb_t)glyph_run_free_cb,
+    });
+    lv_cache_set_name(glyph_run_cache, "TEXT_GLYPH_RUN");
+}
+
+void lv_text_glyph_run_cache_deinit(void)
+{
+    if(glyph_run_cache == NULL) return;
+
+    lv_cache_destroy(glyph_run_cache, NULL);
+    glyph_run_cache = NULL;
+}
+
+#endif /*LV_TEXT_GLYPH_RUN_CACHE_SIZE*/
+
+void lv_text_glyph_run_cache_drop(void)
+{
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    if(glyph_run_cache == NULL) return;
+
+    lv_cache_drop_all(glyph_run_cache, NULL);
+#endif
+}
+
+const lv_text_glyph_run_t * lv_text_glyph_run_acquire(const char * text, const lv_font_t * font, bool create)
+{
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    LV_ASSERT_NULL(text);
+
+    uint32_t text_len = lv_strlen(text);
+    if(text_len < GLYPH_RUN_MIN_LEN) return NULL;
+
+    return glyph_run_acquire(text, text_len, text_hash(TEXT_HASH_INIT, text, text_len), font, NULL, create);
+#else
+    LV_UNUSED(text);
+    LV_UNUSED(font);
+    LV_UNUSED(create);
+    return NULL;
+#endif
+}
+
+void lv_text_glyph_run_release(const lv_text_glyph_run_t * run)
+{
+    glyph_run_release(run, false);
+}
+
+const lv_text_glyph_t * lv_text_glyph_run_find(const lv_text_glyph_run_t * run, uint32_t ofs)
+{
+    if(run == NULL || ofs > run->text_len) return NULL;
+
+    /*The letters are sorted by their byte index. The end of the text is also found.*/
+    uint32_t low = 0;
+    uint32_t high = run->glyph_cnt;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if(run->glyphs[mid].ofs < ofs) low = mid + 1;
+        else high = mid;
+    }
+
+    return run->glyphs[low].ofs == ofs ? &run->glyphs[low] : NULL;
+}
+
 bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -219,12 +438,15 @@ bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
  * @param flags settings for the text from 'txt_flag_type' enum
  * @param[out] word_w_ptr width (in pixels) of the parsed word. May be NULL.
  * @param cmd_state Pointer to a lv_text_cmd_state_t variable which stored the current state of command processing
+ * @param glyph the letter of `txt[0]` in the glyph run of the text to take the letters and widths from it. May be NULL.
+ * @param dec decoder of the text at `txt[0]` to take the letters from it if `glyph` is NULL
  * @return the index of the first char of the next word (in byte index not letter index. With UTF-8 they are different)
  */
 static uint32_t lv_text_get_next_word(const char * txt, const lv_font_t * font,
                                       int32_t letter_space, int32_t max_width,
                                       lv_text_flag_t flag, uint32_t * word_w_ptr,
-                                      lv_text_cmd_state_t * cmd_state)
+                                      lv_text_cmd_state_t * cmd_state, const lv_text_glyph_t * glyph,
+                                      lv_text_decoder_t * dec)
 {
     if(txt == NULL || txt[0] == '\0') return 0;
     if(font == NULL) return 0;
@@ -239,13 +461,30 @@ static uint32_t lv_text_get_next_word(const char * txt, const lv_font_t * font,
     uint32_t word_len = 0;   /*Number of characters in the traversed word*/
     uint32_t break_index = NO_BREAK_FOUND; /*only used for "long" words*/
     uint32_t break_letter_count = 0; /*Number of characters up to the long word break point*/
+    /*Byte index of `txt` in the text of the glyph run or the decoder*/
+    uint32_t glyph_base = glyph ? glyph->ofs : lv_text_decoder_get_pos(dec);
 
-    letter = lv_text_encoded_next(txt, &i_next);
+    /*`glyph` follows the letter at `i`*/
+    if(glyph) {
+        letter = glyph->letter;
+        i_next = glyph[1].ofs - glyph_base;
+    }
+    else {
+        letter = lv_text_decoder_next(dec);
+        i_next = lv_text_decoder_get_pos(dec) - glyph_base;
+    }
     i_next_next = i_next;
 
     /*Obtain the full word, regardless if it fits or not in max_width*/
     while(txt[i] != '\0') {
-        letter_next = lv_text_encoded_next(txt, &i_next_next);
+        if(glyph) {
+            letter_next = glyph[1].letter;
+            if(txt[i_next] != '\0') i_next_next = glyph[2].ofs - glyph_base;
+        }
+        else {
+            letter_next = lv_text_decoder_next(dec);
+            i_next_next = lv_text_decoder_get_pos(dec) - glyph_base;
+        }
         word_len++;
 
         /*Handle the recolor command*/
@@ -254,11 +493,12 @@ static uint32_t lv_text_get_next_word(const char * txt, const lv_font_t * font,
                 i = i_next;
                 i_next = i_next_next;
                 letter = letter_next;
+                if(glyph) glyph++;
                 continue;   /*Skip the letter if it is part of a command*/
             }
         }
 
-        letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        letter_w = glyph ? glyph->adv_w : lv_font_get_glyph_width(font, letter, letter_next);
         cur_w += letter_w;
 
         if(letter_w > 0) {
@@ -296,6 +536,7 @@ static uint32_t lv_text_get_next_word(const char * txt, const lv_font_t * font,
         i = i_next;
         i_next = i_next_next;
         letter = letter_next;
+        if(glyph) glyph++;
     }
 
     /*Entire Word fits in the provided space*/
@@ -344,6 +585,12 @@ static uint32_t lv_text_get_next_word(const char * txt, const lv_font_t * font,
 uint32_t lv_text_get_next_line(const char * txt, uint32_t len,
                                const lv_font_t * font, int32_t * used_width, lv_text_attributes_t * attributes)
 {
+    return lv_text_glyph_run_get_next_line(NULL, txt, len, font, used_width, attributes);
+}
+
+uint32_t lv_text_glyph_run_get_next_line(const lv_text_glyph_run_t * run, const char * txt, uint32_t len,
+                                         const lv_font_t * font, int32_t * used_width, lv_text_attributes_t * attributes)
+{
 
     if(used_width) *used_width = 0;
 
@@ -375,14 +622,20 @@ uint32_t lv_text_get_next_line(const char * txt, uint32_t len,
     uint32_t i = 0;                                        /*Iterating index into txt*/
     uint32_t max_width = attributes->max_width;
 
+    /*Decode the letters not in the glyph run in blocks*/
+    lv_text_decoder_t dec;
+    lv_text_decoder_init(&dec, txt, len);
+
     while(i < len && txt[i] != '\0' && max_width > 0) {
         lv_text_flag_t word_flag = attributes->text_flags;
 
         if(i == 0) word_flag |= LV_TEXT_FLAG_BREAK_ALL;
 
         uint32_t word_w = 0;
+        const lv_text_glyph_t * glyph = run ? lv_text_glyph_run_find(run, (uint32_t)(&txt[i] - run->text)) : NULL;
+        if(glyph == NULL) lv_text_decoder_seek(&dec, i);
         uint32_t advance = lv_text_get_next_word(&txt[i], font, attributes->letter_space,
-                                                 max_width, word_flag, &word_w, &cmd_state);
+                                                 max_width, word_flag, &word_w, &cmd_state, glyph, &dec);
         max_width -= word_w;
         line_w += word_w;
 
@@ -417,6 +670,12 @@ uint32_t lv_text_get_next_line(const char * txt, uint32_t len,
 
 int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * font,
                           const lv_text_attributes_t * attributes)
+{
+    return lv_text_glyph_run_get_width(NULL, txt, length, font, attributes);
+}
+
+int32_t lv_text_glyph_run_get_width(const lv_text_glyph_run_t * run, const char * txt, uint32_t length,
+                                    const lv_font_t * font, const lv_text_attributes_t * attributes)
 {
     if(txt == NULL) return 0;
     if(font == NULL) return 0;
@@ -425,14 +684,24 @@ int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * f
     uint32_t i                = 0;
     int32_t width             = 0;
     lv_text_cmd_state_t cmd_state = LV_TEXT_CMD_STATE_WAIT;
+    uint32_t glyph_base = run ? (uint32_t)(txt - run->text) : 0; /*Byte index of `txt` in the text of the run*/
+    const lv_text_glyph_t * glyph = lv_text_glyph_run_find(run, glyph_base);
 
     if(length != 0) {
         while(txt[i] != '\0' && i < length) {
 
             uint32_t letter;
-            uint32_t letter_next;
+            uint32_t letter_next = 0;
+            const lv_text_glyph_t * letter_glyph = glyph;
 
-            lv_text_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+            if(glyph) {
+                letter = glyph->letter;
+                glyph++;
+                i = glyph->ofs - glyph_base;
+            }
+            else {
+                lv_text_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+            }
 
             if((attributes->text_flags & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(lv_text_is_cmd(&cmd_state, letter) != false) {
@@ -440,7 +709,7 @@ int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * f
                 }
             }
 
-            int32_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
+            int32_t char_width = letter_glyph ? letter_glyph->adv_w : lv_font_get_glyph_width(font, letter, letter_next);
             if(char_width > 0) {
                 width += char_width;
                 width += attributes->letter_space;
@@ -541,6 +810,200 @@ void lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? lv_text_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+void lv_text_decoder_init(lv_text_decoder_t * dec, const char * txt, uint32_t len)
+{
+    dec->txt = txt;
+    dec->len = len;
+    dec->idx = 0;
+    dec->cnt = 0;
+    dec->ofs[0] = 0;
+}
+
+void lv_text_decoder_seek(lv_text_decoder_t * dec, uint32_t pos)
+{
+    /*Usually it steps back a few letters in the current block*/
+    uint32_t k = dec->idx;
+    while(k > 0 && dec->ofs[k] > pos) k--;
+    while(k < dec->cnt && dec->ofs[k] < pos) k++;
+
+    if(dec->ofs[k] != pos) {
+        k = 0;
+        dec->cnt = 0;
+        dec->ofs[0] = pos;
+    }
+    dec->idx = k;
+}
+
+bool lv_text_decoder_fill(lv_text_decoder_t * dec)
+{
+    uint32_t i = dec->ofs[dec->cnt];
+    dec->ofs[0] = i;
+    dec->idx = 0;
+    dec->cnt = lv_text_encoded_decode(dec->txt, &i, dec->len, dec->letters, dec->ofs, LV_TEXT_DECODER_CNT);
+
+    /*After `len` go on till the end of the text like `lv_text_encoded_next`*/
+    if(dec->cnt == 0 && dec->txt[i] != '\0') {
+        dec->letters[0] = lv_text_encoded_next(dec->txt, &i);
+        dec->cnt = 1;
+    }
+    dec->ofs[dec->cnt] = i;
+
+    return dec->cnt > 0;
+}
+
+/**
+ * Continue an FNV-1a hash with `len` bytes of `text`
+ */
+static uint32_t text_hash(uint32_t hash, const char * text, uint32_t len)
+{
+    uint32_t i;
+    for(i = 0; i < len; i++) {
+        hash ^= (uint8_t)text[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/**
+ * Get the glyph run of a text from the cache
+ * @param text      the text
+ * @param text_len  length of `text` in bytes
+ * @param hash      hash of the `text_len` bytes of `text`
+ * @param font      the font of the text
+ * @param prefix    the run of the text before something was appended to it. Its letters are copied. May be NULL.
+ * @param create    true: shape the text if it's not cached
+ * @return          the run or NULL
+ */
+static const lv_text_glyph_run_t * glyph_run_acquire(const char * text, uint32_t text_len, uint32_t hash,
+                                                     const lv_font_t * font, const lv_text_glyph_run_t * prefix, bool create)
+{
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    if(glyph_run_cache == NULL || text_len < GLYPH_RUN_MIN_LEN) return NULL;
+
+    lv_text_glyph_run_t search_key = {
+        .text = text,
+        .font = font,
+        .text_len = text_len,
+        .text_hash = hash,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(glyph_run_cache, &search_key, NULL);
+    if(entry == NULL && create) {
+        search_key.glyph_cnt = lv_text_get_encoded_length(text);
+        search_key.slot.size = sizeof(lv_text_glyph_run_t) + (search_key.glyph_cnt + 1) * sizeof(lv_text_glyph_t);
+
+        /*Let the huge texts go around the cache instead of evicting everything*/
+        if(search_key.slot.size > lv_cache_get_max_size(glyph_run_cache, NULL)) return NULL;
+
+        entry = lv_cache_acquire_or_create(glyph_run_cache, &search_key, (void *)prefix);
+    }
+    if(entry == NULL) return NULL;
+
+    return lv_cache_entry_get_data(entry);
+#else
+    LV_UNUSED(text);
+    LV_UNUSED(text_len);
+    LV_UNUSED(hash);
+    LV_UNUSED(font);
+    LV_UNUSED(prefix);
+    LV_UNUSED(create);
+    return NULL;
+#endif
+}
+
+/**
+ * Give back a glyph run
+ * @param run       the run or NULL
+ * @param drop      true: also remove it from the cache
+ */
+static void glyph_run_release(const lv_text_glyph_run_t * run, bool drop)
+{
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    if(run == NULL) return;
+
+    /*A dropped run is freed when it's released*/
+    if(drop) lv_cache_drop(glyph_run_cache, run, NULL);
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry((void *)run, sizeof(lv_text_glyph_run_t));
+    lv_cache_release(glyph_run_cache, entry, NULL);
+#else
+    LV_UNUSED(run);
+    LV_UNUSED(drop);
+#endif
+}
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+
+static bool glyph_run_create_cb(lv_text_glyph_run_t * node, const lv_text_glyph_run_t * prefix)
+{
+    node->glyphs = lv_malloc((node->glyph_cnt + 1) * sizeof(lv_text_glyph_t));
+    LV_ASSERT_MALLOC(node->glyphs);
+    if(node->glyphs == NULL) return false;
+
+    /*Keep the letters of an appended text except the last one as its kerning changes with the new
+     *next letter. If the last letter was cut (invalid) the one before it changes too.*/
+    uint32_t glyph_idx = 0;
+    if(prefix && prefix->glyph_cnt && prefix->glyph_cnt <= node->glyph_cnt) {
+        glyph_idx = prefix->glyph_cnt - 1;
+        if(glyph_idx && prefix->glyphs[glyph_idx].letter == 0) glyph_idx--;
+        lv_memcpy(node->glyphs, prefix->glyphs, glyph_idx * sizeof(lv_text_glyph_t));
+    }
+
+    lv_text_decoder_t dec;
+    lv_text_decoder_init(&dec, node->text, node->text_len);
+    lv_text_decoder_seek(&dec, glyph_idx ? prefix->glyphs[glyph_idx].ofs : 0);
+    while(glyph_idx < node->glyph_cnt && lv_text_decoder_get_pos(&dec) < node->text_len) {
+        lv_text_glyph_t * glyph = &node->glyphs[glyph_idx];
+        glyph->ofs = lv_text_decoder_get_pos(&dec);
+        glyph->letter = lv_text_decoder_next(&dec);
+        uint32_t letter_next = glyph->letter != '\0' ? lv_text_decoder_peek(&dec) : 0;
+        glyph->adv_w = lv_font_get_glyph_width(node->font, glyph->letter, letter_next);
+        glyph_idx++;
+    }
+
+    node->glyph_cnt = glyph_idx;
+    node->glyphs[glyph_idx].letter = 0;
+    node->glyphs[glyph_idx].ofs = node->text_len;
+    node->glyphs[glyph_idx].adv_w = 0;
+
+    return true;
+}
+
+static void glyph_run_free_cb(lv_text_glyph_run_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(node->glyphs);
+    node->glyphs = NULL;
+}
+
+static lv_cache_compare_res_t glyph_run_compare_cb(const lv_text_glyph_run_t * lhs, const lv_text_glyph_run_t * rhs)
+{
+    if(lhs->text != rhs->text) return lhs->text > rhs->text ? 1 : -1;
+    if(lhs->font != rhs->font) return lhs->font > rhs->font ? 1 : -1;
+    if(lhs->text_len != rhs->text_len) return lhs->text_len > rhs->text_len ? 1 : -1;
+    if(lhs->text_hash != rhs->text_hash) return lhs->text_hash > rhs->text_hash ? 1 : -1;
+    return 0;
+}
+
+#endif /*LV_TEXT_GLYPH_RUN_CACHE_SIZE*/
+
+static bool lines_add(lv_text_lines_t * lines, uint32_t start, int32_t width)
+{
+    if(lines->line_cnt == lines->line_cap) {
+        uint32_t new_cap = lines->line_cap ? lines->line_cap * 2 : 8;
+        lv_text_line_t * new_lines = lv_realloc(lines->lines, new_cap * sizeof(lv_text_line_t));
+        LV_ASSERT_MALLOC(new_lines);
+        if(new_lines == NULL) return false;
+        lines->lines = new_lines;
+        lines->line_cap = new_cap;
+    }
+
+    lines->lines[lines->line_cnt].start = start;
+    lines->lines[lines->line_cnt].width = width;
+    lines->line_cnt++;
+    return true;
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -706,6 +1169,67 @@ static uint32_t lv_text_utf8_next(const char * txt, uint32_t * i)
     return result;
 }
 
+/**
+ * Decode the UTF-8 characters of a string at once.
+ * Aligned words of ASCII characters are checked and copied at once.
+ * @param txt pointer to '\0' terminated string
+ * @param i start byte index in 'txt'. After the call it will point after the last decoded character.
+ * @param len decode the characters starting before this byte index or `LV_TEXT_LEN_MAX` to check one byte at a time
+ * @param letters store the decoded Unicode characters here
+ * @param ofs store the byte index of the characters here. Can be NULL.
+ * @param max_cnt size of `letters` and `ofs`
+ * @return the number of decoded characters
+ */
+static uint32_t lv_text_utf8_decode(const char * txt, uint32_t * i, uint32_t len, uint32_t * letters,
+                                    uint32_t * ofs, uint32_t max_cnt)
+{
+    uint32_t cnt = 0;
+    uint32_t p = *i;
+
+    /*The words can be read only if they are known to be part of the text*/
+    bool word = len != LV_TEXT_LEN_MAX;
+
+    while(cnt < max_cnt && p < len) {
+        /*4 ASCII characters and no '\0': no byte has the top bit set before or after subtracting 1*/
+        if(word && ((lv_uintptr_t)&txt[p] & 0x3) == 0 && len - p >= 4 && max_cnt - cnt >= 4) {
+            uint32_t w;
+            lv_memcpy(&w, &txt[p], sizeof(w));
+            if((((w - 0x01010101U) | w) & 0x80808080U) == 0) {
+                uint32_t k;
+                for(k = 0; k < 4; k++) {
+                    if(ofs) ofs[cnt] = p;
+                    letters[cnt] = (uint8_t)txt[p];
+                    cnt++;
+                    p++;
+                }
+                continue;
+            }
+        }
+
+        if(txt[p] == '\0') break;
+
+        if(ofs) ofs[cnt] = p;
+        uint8_t c = txt[p];
+        if(LV_IS_ASCII(c)) {
+            letters[cnt] = c;
+            p++;
+        }
+        /*Most of the other letters are 3 bytes long (e.g. CJK)*/
+        else if(LV_IS_3BYTES_UTF8_CODE(c) && !LV_IS_INVALID_UTF8_CODE(txt[p + 1]) &&
+                !LV_IS_INVALID_UTF8_CODE(txt[p + 2])) {
+            letters[cnt] = ((uint32_t)(c & 0x0F) << 12) | ((uint32_t)(txt[p + 1] & 0x3F) << 6) | (txt[p + 2] & 0x3F);
+            p += 3;
+        }
+        else {
+            letters[cnt] = lv_text_utf8_next(txt, &p);
+        }
+        cnt++;
+    }
+
+    *i = p;
+    return cnt;
+}
+
 /**
  * Get previous UTF-8 character form a string.
  * @param txt pointer to '\0' terminated string
@@ -791,7 +1315,8 @@ static uint32_t lv_text_utf8_get_length(const char * txt)
     uint32_t i   = 0;
 
     while(txt[i] != '\0') {
-        lv_text_encoded_next(txt, &i);
+        if(LV_IS_ASCII(txt[i])) i++;
+        else lv_text_utf8_next(txt, &i);
         len++;
     }
 
@@ -855,6 +1380,32 @@ static uint32_t lv_text_iso8859_1_next(const char * txt, uint32_t * i)
     return letter;
 }
 
+/**
+ * Decode the ISO8859-1 characters of a string at once.
+ * @param txt pointer to '\0' terminated string
+ * @param i start byte index in 'txt'. After the call it will point after the last decoded character.
+ * @param len decode the characters before this byte index or `LV_TEXT_LEN_MAX`
+ * @param letters store the decoded characters here
+ * @param ofs store the byte index of the characters here. Can be NULL.
+ * @param max_cnt size of `letters` and `ofs`
+ * @return the number of decoded characters
+ */
+static uint32_t lv_text_iso8859_1_decode(const char * txt, uint32_t * i, uint32_t len, uint32_t * letters,
+                                         uint32_t * ofs, uint32_t max_cnt)
+{
+    uint32_t cnt = 0;
+    uint32_t p = *i;
+    while(cnt < max_cnt && p < len && txt[p] != '\0') {
+        if(ofs) ofs[cnt] = p;
+        letters[cnt] = (uint8_t)txt[p];
+        cnt++;
+        p++;
+    }
+
+    *i = p;
+    return cnt;
+}
+
 /**
  * Get previous ISO8859-1 character form a string.
  * @param txt pointer to '\0' terminated string
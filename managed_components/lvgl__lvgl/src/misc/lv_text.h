@@ -75,6 +75,13 @@ typedef enum {
 void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, int32_t letter_space,
                       int32_t line_space, int32_t max_width, lv_text_flag_t flag);
 
+/**
+ * Remove all the shaped texts from the glyph run cache (see `LV_TEXT_GLYPH_RUN_CACHE_SIZE`).
+ * Needs to be called before a font is freed or when the widths of its glyphs can change,
+ * e.g. new glyphs, size, kerning or fallback. The font setters of LVGL call it.
+ */
+void lv_text_glyph_run_cache_drop(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_text.h"
+#include "cache/lv_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +30,8 @@ extern "C" {
 
 #define LV_TEXT_LEN_MAX UINT32_MAX
 
+#define LV_TEXT_DECODER_CNT 32  /**< Number of letters decoded at once by `lv_text_decoder_t`*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -47,6 +50,60 @@ typedef struct {
     lv_text_flag_t text_flags;
 } lv_text_attributes_t;
 
+/** A line of a text in `lv_text_lines_t`*/
+typedef struct {
+    uint32_t start;             /**< Byte index of the first character of the line*/
+    int32_t width;              /**< Width of the line in px*/
+} lv_text_line_t;
+
+/** Store where the lines of a text start and how wide they are to avoid breaking
+ * the lines again on every size calculation and redraw.
+ * If only new text is appended, only the last lines are broken again.*/
+struct _lv_text_lines_t {
+    const char * text;          /**< The text the lines belong to*/
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t max_width;
+    lv_text_flag_t text_flags;
+    uint32_t text_len;          /**< Length of `text` in bytes*/
+    uint32_t text_hash;         /**< Hash of `text` to tell if it was only appended*/
+    uint32_t line_cnt;
+    uint32_t reused_cnt;        /**< Number of lines kept by the last `lv_text_lines_get_size`*/
+    uint32_t line_cap;          /**< Allocated size of `lines`*/
+    lv_text_line_t * lines;
+};
+
+/** A letter of a shaped text in `lv_text_glyph_run_t`*/
+typedef struct {
+    uint32_t letter;            /**< The Unicode letter*/
+    uint32_t ofs;               /**< Byte index of the letter in the text*/
+    int32_t adv_w;              /**< Width of the letter with the kerning to the next letter, 0 for markers*/
+} lv_text_glyph_t;
+
+/** The letters of a text with their widths. The text is shaped once and the run is shared by
+ * the size calculation, line breaking and drawing through the glyph run cache
+ * (see `LV_TEXT_GLYPH_RUN_CACHE_SIZE`).*/
+typedef struct {
+    lv_cache_slot_size_t slot;  /**< Size of the run in the cache*/
+    const char * text;          /**< The shaped text*/
+    const lv_font_t * font;
+    uint32_t text_len;          /**< Length of `text` in bytes*/
+    uint32_t text_hash;         /**< Hash of `text` as the same buffer can hold a new text*/
+    uint32_t glyph_cnt;         /**< Number of letters. `glyphs[glyph_cnt]` is the end of the text with `ofs == text_len`*/
+    lv_text_glyph_t * glyphs;
+} lv_text_glyph_run_t;
+
+/** Iterate over the letters of a text decoded in blocks with `lv_text_encoded_decode`
+ * to avoid decoding the letters one by one (and most of them twice for the kerning).*/
+typedef struct {
+    const char * txt;
+    uint32_t len;               /**< Length of `txt` in bytes or `LV_TEXT_LEN_MAX` if unknown*/
+    uint32_t idx;               /**< Index of the next letter in `letters`*/
+    uint32_t cnt;               /**< Number of decoded letters in the block*/
+    uint32_t letters[LV_TEXT_DECODER_CNT];
+    uint32_t ofs[LV_TEXT_DECODER_CNT + 1];  /**< Byte index of the letters. `ofs[cnt]` is the end of the block*/
+} lv_text_decoder_t;
+
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -67,6 +124,85 @@ void lv_text_attributes_init(lv_text_attributes_t * attributes);
  */
 void lv_text_get_size_attributes(lv_point_t * size_res, const char * text, const lv_font_t * font,
                                  lv_text_attributes_t * attributes);
+/**
+ * Get the size of a text like `lv_text_get_size_attributes` but store the line breaks in `lines`
+ * and reuse them if the text, font and attributes are the same or the text was only appended.
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param lines store the lines here. Zero initialized or used earlier with this function.
+ * @param text pointer to a text
+ * @param font pointer to font of the text
+ * @param attributes the text attributes, flags for line break behaviour, spacing etc
+ */
+void lv_text_lines_get_size(lv_point_t * size_res, lv_text_lines_t * lines, const char * text,
+                            const lv_font_t * font, lv_text_attributes_t * attributes);
+
+/**
+ * Check if the lines stored by `lv_text_lines_get_size` can be used to draw a text
+ * @param lines the stored lines
+ * @param text the text to draw
+ * @param text_len the number of bytes to draw from `text`
+ * @param font the font of the text
+ * @param attributes the text attributes (`line_space` is not used)
+ * @return true: the lines belong to the text
+ */
+bool lv_text_lines_is_valid(const lv_text_lines_t * lines, const char * text, uint32_t text_len,
+                            const lv_font_t * font, const lv_text_attributes_t * attributes);
+
+/**
+ * Free the stored lines
+ * @param lines the lines to free
+ */
+void lv_text_lines_reset(lv_text_lines_t * lines);
+
+/**
+ * Get the index after the last character of a line
+ * @param lines the stored lines
+ * @param line_idx index of a line
+ * @return byte index of the end of the line
+ */
+static inline uint32_t lv_text_lines_get_end(const lv_text_lines_t * lines, uint32_t line_idx)
+{
+    return line_idx + 1 < lines->line_cnt ? lines->lines[line_idx + 1].start : lines->text_len;
+}
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+
+/**
+ * Create the cache of the shaped texts
+ */
+void lv_text_glyph_run_cache_init(void);
+
+/**
+ * Free the glyph run cache and all the cached runs
+ */
+void lv_text_glyph_run_cache_deinit(void);
+
+#endif /*LV_TEXT_GLYPH_RUN_CACHE_SIZE*/
+
+/**
+ * Get the shaped letters of a text from the glyph run cache
+ * @param text      a '\0' terminated text
+ * @param font      the font of the text
+ * @param create    true: shape the text if it's not in the cache yet; false: only look it up
+ * @return          the glyph run or NULL if it's not cached (e.g. the text is short or the cache is disabled).
+ *                  It needs to be given back with `lv_text_glyph_run_release`.
+ */
+const lv_text_glyph_run_t * lv_text_glyph_run_acquire(const char * text, const lv_font_t * font, bool create);
+
+/**
+ * Give back a glyph run acquired by `lv_text_glyph_run_acquire`
+ * @param run       the glyph run or NULL
+ */
+void lv_text_glyph_run_release(const lv_text_glyph_run_t * run);
+
+/**
+ * Find the letter starting at a byte index of the text in a glyph run
+ * @param run       the glyph run or NULL
+ * @param ofs       byte index in the text of the run
+ * @return          the letter at `ofs` or NULL if no letter starts there
+ */
+const lv_text_glyph_t * lv_text_glyph_run_find(const lv_text_glyph_run_t * run, uint32_t ofs);
+
 /**
  * Give the length of a text with a given font with text flags
  * @param txt a '\0' terminate string
@@ -79,6 +215,18 @@ void lv_text_get_size_attributes(lv_point_t * size_res, const char * text, const
 int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * font,
                           const lv_text_attributes_t * attributes);
 
+/**
+ * Like `lv_text_get_width` but take the letter widths from a glyph run of the text
+ * @param run pointer to the glyph run of the text `txt` is part of or NULL to look up the glyphs
+ * @param txt a '\0' terminate string
+ * @param length length of 'txt' in byte count
+ * @param font pointer to font of the text
+ * @param attributes the text attributes, flags for line break behaviour, spacing etc
+ * @return length of a char_num long text
+ */
+int32_t lv_text_glyph_run_get_width(const lv_text_glyph_run_t * run, const char * txt, uint32_t length,
+                                    const lv_font_t * font, const lv_text_attributes_t * attributes);
+
 /**
  * Check if c is command state
  * @param state
@@ -90,7 +238,8 @@ bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c);
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
- * @param len length of 'txt' in bytes
+ * @param len length of 'txt' in bytes or `LV_TEXT_LEN_MAX` if not known.
+ *            It mustn't be larger than the text as ASCII letters are read a word at a time up to it.
  * @param font pointer to a font
  * @param used_width When used_width != NULL, save the width of this line if
  * flag == LV_TEXT_FLAG_NONE, otherwise save -1.
@@ -101,6 +250,21 @@ bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c);
 uint32_t lv_text_get_next_line(const char * txt, uint32_t len, const lv_font_t * font, int32_t * used_width,
                                lv_text_attributes_t * attributes);
 
+/**
+ * Like `lv_text_get_next_line` but take the letter widths from a glyph run of the text
+ * @param run pointer to the glyph run of the text `txt` is part of or NULL to look up the glyphs
+ * @param txt a '\0' terminated string
+ * @param len length of 'txt' in bytes or `LV_TEXT_LEN_MAX` if not known.
+ *            It mustn't be larger than the text as ASCII letters are read a word at a time up to it.
+ * @param font pointer to a font
+ * @param used_width When used_width != NULL, save the width of this line if
+ * flag == LV_TEXT_FLAG_NONE, otherwise save -1.
+ * @param attributes text attributes, flags to control line break behaviour, spacing etc
+ * @return the index of the first char of the new line
+ */
+uint32_t lv_text_glyph_run_get_next_line(const lv_text_glyph_run_t * run, const char * txt, uint32_t len,
+                                         const lv_font_t * font, int32_t * used_width, lv_text_attributes_t * attributes);
+
 /**
  * Insert a string into another
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
@@ -138,6 +302,61 @@ char * lv_text_set_text_vfmt(const char * fmt, va_list ap) LV_FORMAT_ATTRIBUTE(1
  */
 void lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t * letter_next, uint32_t * ofs);
 
+/**
+ * Initialize a decoder to iterate over the letters of a text
+ * @param dec       the decoder to initialize
+ * @param txt       a '\0' terminated string
+ * @param len       length of `txt` in bytes to decode ASCII text a word at a time
+ *                  or `LV_TEXT_LEN_MAX` if not known. The letters after it are decoded too.
+ */
+void lv_text_decoder_init(lv_text_decoder_t * dec, const char * txt, uint32_t len);
+
+/**
+ * Continue decoding from a byte index. Cheap if the letter is in the current block.
+ * @param dec       the decoder
+ * @param pos       byte index of a letter in the text
+ */
+void lv_text_decoder_seek(lv_text_decoder_t * dec, uint32_t pos);
+
+/**
+ * Decode the next block of letters. Called by `lv_text_decoder_next` and `lv_text_decoder_peek`.
+ * @param dec       the decoder
+ * @return          false: the end of the text is reached
+ */
+bool lv_text_decoder_fill(lv_text_decoder_t * dec);
+
+/**
+ * Get the next letter like `lv_text_encoded_next`
+ * @param dec       the decoder
+ * @return          the letter or 0 at the end of the text or on invalid code
+ */
+static inline uint32_t lv_text_decoder_next(lv_text_decoder_t * dec)
+{
+    if(dec->idx == dec->cnt && !lv_text_decoder_fill(dec)) return 0;
+    return dec->letters[dec->idx++];
+}
+
+/**
+ * Get the next letter without stepping over it
+ * @param dec       the decoder
+ * @return          the letter or 0 at the end of the text or on invalid code
+ */
+static inline uint32_t lv_text_decoder_peek(lv_text_decoder_t * dec)
+{
+    if(dec->idx == dec->cnt && !lv_text_decoder_fill(dec)) return 0;
+    return dec->letters[dec->idx];
+}
+
+/**
+ * Get the byte index of the next letter
+ * @param dec       the decoder
+ * @return          the byte index in the text
+ */
+static inline uint32_t lv_text_decoder_get_pos(const lv_text_decoder_t * dec)
+{
+    return dec->ofs[dec->idx];
+}
+
 /**
  * Test if char is break char or not (a text can broken here or not)
  * @param letter a letter
@@ -282,6 +501,21 @@ extern uint32_t (*const lv_text_encoded_conv_wc)(uint32_t c);
  */
 extern uint32_t (*const lv_text_encoded_next)(const char * txt, uint32_t * i_start);
 
+/**
+ * Decode the encoded characters of a string at once. ASCII text is checked a word at a time.
+ * @param txt       pointer to '\0' terminated string
+ * @param i_start   start index in 'txt' where to start.
+ *                  After the call it will point after the last decoded character.
+ * @param len       decode the characters starting before this byte index. The bytes before it need to be
+ *                  part of `txt`, or `LV_TEXT_LEN_MAX` to decode till the '\0' one byte at a time.
+ * @param letters   store the decoded Unicode characters here (0 on invalid data code)
+ * @param ofs       store the byte index of the characters here. Can be NULL.
+ * @param max_cnt   the size of `letters` and `ofs`
+ * @return          the number of decoded characters
+ */
+extern uint32_t (*const lv_text_encoded_decode)(const char * txt, uint32_t * i_start, uint32_t len,
+                                                uint32_t * letters, uint32_t * ofs, uint32_t max_cnt);
+
 /**
  * Get the previous encoded character form a string.
  *
@@ -12,6 +12,7 @@
 #include "../stdlib/lv_sprintf.h"
 #include "lv_assert.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include "lv_profiler.h"
 
 /*********************
@@ -20,6 +21,10 @@
 
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_DEF_SIZE 8
+
+/*The deadlines are compared with wrap around so longer periods are ordered as if they were this long*/
+#define HEAP_PERIOD_MAX (UINT32_MAX / 4)
 
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
@@ -31,9 +36,16 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static bool timer_heap_reserve(uint32_t cnt);
+static void timer_heap_insert(lv_timer_t * timer);
+static void timer_heap_remove(lv_timer_t * timer);
+static void timer_heap_update(lv_timer_t * timer);
+static void timer_heap_sift_up(uint32_t idx);
+static void timer_heap_sift_down(uint32_t idx);
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,44 +102,22 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Run the ready timers in the order of their deadlines. The heap is read again after each callback
+     *so the callbacks can create and delete any timers.*/
+    int64_t run_start = state_p->run_seq;
+    while(state_p->timer_heap_cnt > 0) {
+        lv_timer_t * timer = state_p->timer_heap[0];
+        if(lv_timer_time_remaining(timer) != 0) break;
 
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
+        /*Only the timers which already ran in this call are left (e.g. with 0 period)*/
+        if(timer->seq > run_start) break;
 
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
-        }
-
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+        lv_timer_exec(timer);
     }
 
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->timer_heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->timer_heap[0]);
+
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
     if(idle_period_time >= IDLE_MEAS_PERIOD) {
@@ -166,6 +156,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve a heap slot for every timer, so resuming a paused one can't run out of memory*/
+    if(!timer_heap_reserve(state.timer_cnt + 1)) return NULL;
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -177,8 +170,10 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->seq = --state.create_seq;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    timer_heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -193,8 +188,10 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    timer_heap_remove(timer);
     lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
+    if(state.timer_active == timer) state.timer_active = NULL;
 
     lv_free(timer);
 }
@@ -203,12 +200,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    timer_heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    if(timer->heap_idx == LV_TIMER_HEAP_IDX_NONE) timer_heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -216,12 +215,16 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_heap_update(timer);
+    lv_timer_handler_resume();
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_heap_update(timer);
+    lv_timer_handler_resume();
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -246,6 +249,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -260,6 +264,12 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.timer_heap);
+    state.timer_heap = NULL;
+    state.timer_heap_cnt = 0;
+    state.timer_heap_size = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -304,42 +314,41 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a timer whose remaining time is zero
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
-{
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
-
-        if(timer->timer_cb && original_repeat_count != 0) {
-            LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
-            timer->timer_cb(timer);
-            LV_PROFILER_TIMER_END_TAG("timer_cb");
-        }
+static void lv_timer_exec(lv_timer_t * timer)
+{
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->seq = ++state.run_seq;
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    /*Move the timer to its next deadline before the callback as the callback might delete it*/
+    timer_heap_update(timer);
+    state.timer_active = timer;
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+
+    if(timer->timer_cb && original_repeat_count != 0) {
+        LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
+        timer->timer_cb(timer);
+        LV_PROFILER_TIMER_END_TAG("timer_cb");
+    }
+
+    if(state.timer_active) {
+        LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
     }
+    else {
+        LV_TRACE_TIMER("timer callback finished");
+    }
+
+    LV_ASSERT_MEM_INTEGRITY();
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(state.timer_active) { /*The timer might be deleted by itself as well*/
+        state.timer_active = NULL;
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
                 LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
@@ -351,8 +360,6 @@ static bool lv_timer_exec(lv_timer_t * timer)
             }
         }
     }
-
-    return exec;
 }
 
 /**
@@ -386,3 +393,123 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Make sure the heap has room for the given number of timers
+ * @param cnt       the number of timers to hold
+ * @return          true: the slots are available, false: out of memory
+ */
+static bool timer_heap_reserve(uint32_t cnt)
+{
+    lv_timer_state_t * state_p = &state;
+    if(cnt <= state_p->timer_heap_size) return true;
+
+    uint32_t new_size = state_p->timer_heap_size ? state_p->timer_heap_size * 2 : HEAP_DEF_SIZE;
+    if(new_size < cnt) new_size = cnt;
+    lv_timer_t ** new_heap = lv_realloc(state_p->timer_heap, new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+
+    state_p->timer_heap = new_heap;
+    state_p->timer_heap_size = new_size;
+    return true;
+}
+
+/**
+ * Add a timer to the heap of the timers to run.
+ * Its slot was reserved by `lv_timer_create`.
+ * @param timer pointer to lv_timer
+ */
+static void timer_heap_insert(lv_timer_t * timer)
+{
+    lv_timer_state_t * state_p = &state;
+    LV_ASSERT(state_p->timer_heap_cnt < state_p->timer_heap_size);
+
+    uint32_t idx = state_p->timer_heap_cnt;
+    state_p->timer_heap_cnt++;
+    state_p->timer_heap[idx] = timer;
+    timer->heap_idx = idx;
+    timer_heap_sift_up(idx);
+}
+
+/**
+ * Remove a timer from the heap if it's there
+ * @param timer pointer to lv_timer
+ */
+static void timer_heap_remove(lv_timer_t * timer)
+{
+    lv_timer_state_t * state_p = &state;
+    uint32_t idx = timer->heap_idx;
+    if(idx == LV_TIMER_HEAP_IDX_NONE) return;
+
+    timer->heap_idx = LV_TIMER_HEAP_IDX_NONE;
+    state_p->timer_heap_cnt--;
+    if(idx == state_p->timer_heap_cnt) return;
+
+    /*Move the last timer to the hole and restore the order*/
+    lv_timer_t * last = state_p->timer_heap[state_p->timer_heap_cnt];
+    state_p->timer_heap[idx] = last;
+    last->heap_idx = idx;
+    timer_heap_sift_up(idx);
+    timer_heap_sift_down(last->heap_idx);
+}
+
+/**
+ * Restore the order of the heap after the deadline of a timer has changed
+ * @param timer pointer to lv_timer
+ */
+static void timer_heap_update(lv_timer_t * timer)
+{
+    if(timer->heap_idx == LV_TIMER_HEAP_IDX_NONE) return;
+
+    timer_heap_sift_up(timer->heap_idx);
+    timer_heap_sift_down(timer->heap_idx);
+}
+
+static void timer_heap_sift_up(uint32_t idx)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    lv_timer_t * timer = heap[idx];
+    while(idx > 0) {
+        uint32_t parent = (idx - 1) / 2;
+        if(!timer_is_before(timer, heap[parent])) break;
+        heap[idx] = heap[parent];
+        heap[idx]->heap_idx = idx;
+        idx = parent;
+    }
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
+
+static void timer_heap_sift_down(uint32_t idx)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    uint32_t cnt = state.timer_heap_cnt;
+    lv_timer_t * timer = heap[idx];
+    while(1) {
+        uint32_t child = idx * 2 + 1;
+        if(child >= cnt) break;
+        if(child + 1 < cnt && timer_is_before(heap[child + 1], heap[child])) child++;
+        if(!timer_is_before(heap[child], timer)) break;
+        heap[idx] = heap[child];
+        heap[idx]->heap_idx = idx;
+        idx = child;
+    }
+    heap[idx] = timer;
+    timer->heap_idx = idx;
+}
+
+/**
+ * Tell if a timer needs to run before an other one
+ * @param a pointer to lv_timer
+ * @param b pointer to lv_timer
+ * @return true: `a` is due earlier or at the same time but it's newer or ran earlier than `b`
+ */
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    uint32_t due_a = a->last_run + LV_MIN(a->period, HEAP_PERIOD_MAX);
+    uint32_t due_b = b->last_run + LV_MIN(b->period, HEAP_PERIOD_MAX);
+    if(due_a != due_b) return (int32_t)(due_a - due_b) < 0;
+
+    return a->seq < b->seq;
+}
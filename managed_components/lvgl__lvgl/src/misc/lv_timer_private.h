@@ -20,6 +20,8 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_TIMER_HEAP_IDX_NONE UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,15 +37,23 @@ struct _lv_timer_t {
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
     volatile int paused;
     uint32_t auto_delete : 1;
+    uint32_t heap_idx;         /**< Index in the timer heap or `LV_TIMER_HEAP_IDX_NONE` if paused */
+    int64_t seq;               /**< Orders the timers due at the same time: the newer ones first,
+                                    then the ones which ran earlier */
 };
 
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
+    lv_timer_t ** timer_heap;  /**< Min-heap of the not paused timers ordered by their next run */
+    uint32_t timer_heap_cnt;   /**< Number of timers in `timer_heap` */
+    uint32_t timer_heap_size;  /**< Number of allocated slots in `timer_heap`, at least `timer_cnt` */
+    uint32_t timer_cnt;        /**< Number of timers, paused ones included */
+    lv_timer_t * timer_active; /**< The timer whose callback is running. NULL if it deletes itself */
+    int64_t create_seq;        /**< Decremented for each new timer */
+    int64_t run_seq;           /**< Incremented for each run of a timer */
 
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
-    bool timer_created;
     volatile uint32_t timer_time_until_next;
 
     bool already_running;
@@ -174,6 +174,8 @@ typedef struct _lv_draw_mask_t lv_draw_mask_t;
 
 typedef struct _lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct _lv_text_lines_t lv_text_lines_t;
+
 typedef struct _lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct _lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -182,6 +184,8 @@ typedef struct _lv_draw_mask_rect_dsc_t lv_draw_mask_rect_dsc_t;
 
 typedef struct _lv_obj_style_t lv_obj_style_t;
 
+typedef struct _lv_obj_style_prop_cache_t lv_obj_style_prop_cache_t;
+
 typedef struct _lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
 typedef struct _lv_hit_test_info_t lv_hit_test_info_t;
@@ -371,6 +375,10 @@ typedef struct _lv_sysmon_backend_data_t lv_sysmon_backend_data_t;
 typedef struct _lv_sysmon_perf_info_t lv_sysmon_perf_info_t;
 #endif /*LV_USE_PERF_MONITOR*/
 
+#if LV_USE_SYSMON_FRAME_LOG
+typedef struct _lv_sysmon_frame_log_t lv_sysmon_frame_log_t;
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 #endif /*LV_USE_SYSMON*/
 
 
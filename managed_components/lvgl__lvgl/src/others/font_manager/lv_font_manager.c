@@ -13,6 +13,7 @@
 
 #include "lv_font_manager_recycle.h"
 #include "../../misc/lv_ll.h"
+#include "../../misc/lv_text.h"
 #include "../../stdlib/lv_sprintf.h"
 
 /*********************
@@ -227,6 +228,9 @@ lv_font_t * lv_font_manager_create_font(lv_font_manager_t * manager,
         cur_font = (lv_font_t *)cur_font->fallback;
     }
 
+    /*The fonts can be shared with earlier families whose fallback changed now*/
+    lv_text_glyph_run_cache_drop();
+
     return ret_font;
 }
 
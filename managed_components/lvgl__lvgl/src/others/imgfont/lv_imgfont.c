@@ -71,6 +71,9 @@ void lv_imgfont_destroy(lv_font_t * font)
 {
     LV_ASSERT_NULL(font);
 
+    /*A font created later at the same address mustn't find the runs of this one*/
+    lv_text_glyph_run_cache_drop();
+
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_free(dsc);
 }
@@ -13,6 +13,7 @@
 #include "../../lvgl.h"
 #include "../../core/lv_obj_private.h"
 #include "../../misc/lv_event_private.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,10 @@
     #define FLT_MAX 3.402823466e+38F /* float max value */
 #endif
 
+#define deferred_head LV_GLOBAL_DEFAULT()->subject_deferred_head
+#define deferred_tail LV_GLOBAL_DEFAULT()->subject_deferred_tail
+#define deferred_timer LV_GLOBAL_DEFAULT()->subject_deferred_timer
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -82,7 +87,12 @@ static void obj_flag_observer_cb(lv_observer_t * observer, lv_subject_t * subjec
 static void obj_state_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
 static void obj_value_changed_event_cb(lv_event_t * e);
 
+static bool subject_value_changed(lv_subject_t * subject);
 static void lv_subject_notify_if_changed(lv_subject_t * subject);
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    static void deferred_remove(lv_subject_t * subject);
+    static void deferred_timer_cb(lv_timer_t * timer);
+#endif
 
 static void subject_set_string_free_user_data_event_cb(lv_event_t * e);
 
@@ -94,6 +104,13 @@ static void subject_set_string_free_user_data_event_cb(lv_event_t * e);
  *      MACROS
  **********************/
 
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    /*While a deferred notification is pending `prev_value` is the value the Observers saw last time*/
+    #define SUBJECT_SAVE_PREV_VALUE(subject) (!(subject)->deferred_pending)
+#else
+    #define SUBJECT_SAVE_PREV_VALUE(subject) true
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -118,7 +135,7 @@ void lv_subject_set_int(lv_subject_t * subject, int32_t value)
 
     value = LV_CLAMP(subject->min_value.num, value, subject->max_value.num);
 
-    subject->prev_value.num = subject->value.num;
+    if(SUBJECT_SAVE_PREV_VALUE(subject)) subject->prev_value.num = subject->value.num;
     subject->value.num = value;
     lv_subject_notify_if_changed(subject);
 }
@@ -185,7 +202,7 @@ void lv_subject_set_float(lv_subject_t * subject, float value)
 
     value = LV_CLAMP(subject->min_value.float_v, value, subject->max_value.float_v);
 
-    subject->prev_value.float_v = subject->value.float_v;
+    if(SUBJECT_SAVE_PREV_VALUE(subject)) subject->prev_value.float_v = subject->value.float_v;
     subject->value.float_v = value;
     lv_subject_notify_if_changed(subject);
 }
@@ -255,7 +272,7 @@ void lv_subject_copy_string(lv_subject_t * subject, const char * buf)
     }
 
     if(subject->size < 1) return;
-    if(subject->prev_value.pointer) {
+    if(subject->prev_value.pointer && SUBJECT_SAVE_PREV_VALUE(subject)) {
         lv_strlcpy((char *)subject->prev_value.pointer, subject->value.pointer, subject->size);
     }
 
@@ -273,7 +290,7 @@ void lv_subject_snprintf(lv_subject_t * subject, const char * format, ...)
 
     if(subject->size < 1U) return;
 
-    if(subject->prev_value.pointer) {
+    if(subject->prev_value.pointer && SUBJECT_SAVE_PREV_VALUE(subject)) {
         lv_strlcpy((char *)subject->prev_value.pointer, subject->value.pointer, subject->size);
     }
 
@@ -322,7 +339,7 @@ void lv_subject_set_pointer(lv_subject_t * subject, void * ptr)
         return;
     }
 
-    subject->prev_value.pointer = subject->value.pointer;
+    if(SUBJECT_SAVE_PREV_VALUE(subject)) subject->prev_value.pointer = subject->value.pointer;
     subject->value.pointer = ptr;
     lv_subject_notify_if_changed(subject);
 }
@@ -363,7 +380,7 @@ void lv_subject_set_color(lv_subject_t * subject, lv_color_t color)
         return;
     }
 
-    subject->prev_value.color = subject->value.color;
+    if(SUBJECT_SAVE_PREV_VALUE(subject)) subject->prev_value.color = subject->value.color;
     subject->value.color = color;
     lv_subject_notify_if_changed(subject);
 }
@@ -405,6 +422,10 @@ void lv_subject_init_group(lv_subject_t * group_subject, lv_subject_t * list[],
 
 void lv_subject_deinit(lv_subject_t * subject)
 {
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    if(subject->deferred_pending) deferred_remove(subject);
+#endif
+
     lv_observer_t * observer = lv_ll_get_head(&subject->subs_ll);
     while(observer) {
         lv_observer_t * observer_next = lv_ll_get_next(&subject->subs_ll, observer);
@@ -570,6 +591,45 @@ void lv_subject_notify(lv_subject_t * subject)
     } while(subject->notify_restart_query);
 }
 
+#if LV_OBSERVER_DEFERRED_NOTIFY
+
+void lv_subject_set_deferred(lv_subject_t * subject, bool en)
+{
+    LV_ASSERT_NULL(subject);
+
+    if(!en && subject->deferred_pending) {
+        deferred_remove(subject);
+        subject->deferred = 0;
+        if(subject_value_changed(subject)) lv_subject_notify(subject);
+    }
+
+    if(en && deferred_timer == NULL) {
+        deferred_timer = lv_timer_create(deferred_timer_cb, 0, NULL);
+        LV_ASSERT_MALLOC(deferred_timer);
+        if(deferred_timer) lv_timer_pause(deferred_timer);
+    }
+
+    subject->deferred = en;
+}
+
+void lv_subject_notify_deferred(void)
+{
+    /*Observers can set other deferred Subjects too. They are added to the tail and notified in this call*/
+    while(deferred_head) {
+        lv_subject_t * subject = deferred_head;
+        deferred_head = subject->deferred_next;
+        if(deferred_head == NULL) deferred_tail = NULL;
+        subject->deferred_next = NULL;
+        subject->deferred_pending = 0;
+
+        if(subject_value_changed(subject)) lv_subject_notify(subject);
+    }
+
+    if(deferred_timer) lv_timer_pause(deferred_timer);
+}
+
+#endif /*LV_OBSERVER_DEFERRED_NOTIFY*/
+
 lv_subject_increment_dsc_t * lv_obj_add_subject_increment_event(lv_obj_t * obj, lv_subject_t * subject,
                                                                 lv_event_code_t trigger, int32_t step)
 {
@@ -1070,44 +1130,84 @@ static void obj_value_changed_event_cb(lv_event_t * e)
     lv_subject_set_int(subject, lv_obj_has_state(obj, LV_STATE_CHECKED));
 }
 
-static void lv_subject_notify_if_changed(lv_subject_t * subject)
+static bool subject_value_changed(lv_subject_t * subject)
 {
-
     switch(subject->type) {
         case LV_SUBJECT_TYPE_INVALID :
         case LV_SUBJECT_TYPE_NONE :
-            return;
+            return false;
         case LV_SUBJECT_TYPE_INT :
-            if(subject->value.num != subject->prev_value.num) {
-                lv_subject_notify(subject);
-            }
-            break;
+            return subject->value.num != subject->prev_value.num;
 #if LV_USE_FLOAT
         case LV_SUBJECT_TYPE_FLOAT :
-            if(subject->value.float_v != subject->prev_value.float_v) {
-                lv_subject_notify(subject);
-            }
-            break;
+            return subject->value.float_v != subject->prev_value.float_v;
 #endif
         case LV_SUBJECT_TYPE_GROUP :
         case LV_SUBJECT_TYPE_POINTER :
             /* Always notify as we don't know how to compare this */
-            lv_subject_notify(subject);
-            break;
+            return true;
         case LV_SUBJECT_TYPE_COLOR  :
-            if(!lv_color_eq(subject->value.color, subject->prev_value.color)) {
-                lv_subject_notify(subject);
-            }
-            break;
+            return !lv_color_eq(subject->value.color, subject->prev_value.color);
         case LV_SUBJECT_TYPE_STRING:
-            if(!subject->prev_value.pointer ||
-               lv_strcmp(subject->value.pointer, subject->prev_value.pointer)) {
-                lv_subject_notify(subject);
-            }
-            break;
+            return !subject->prev_value.pointer || lv_strcmp(subject->value.pointer, subject->prev_value.pointer);
     }
+
+    return false;
 }
 
+static void lv_subject_notify_if_changed(lv_subject_t * subject)
+{
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    if(subject->deferred) {
+        /*The Observers will see only the last value so keep `prev_value` as they saw it last time*/
+        if(subject->deferred_pending) return;
+        if(!subject_value_changed(subject)) return;
+
+        subject->deferred_pending = 1;
+        subject->deferred_next = NULL;
+        if(deferred_tail) deferred_tail->deferred_next = subject;
+        else deferred_head = subject;
+        deferred_tail = subject;
+
+        /*Wake up the timer handler even if nothing else is to be done*/
+        if(deferred_timer) {
+            lv_timer_resume(deferred_timer);
+            lv_timer_ready(deferred_timer);
+        }
+        return;
+    }
+#endif
+
+    if(subject_value_changed(subject)) lv_subject_notify(subject);
+}
+
+#if LV_OBSERVER_DEFERRED_NOTIFY
+static void deferred_remove(lv_subject_t * subject)
+{
+    lv_subject_t * prev = NULL;
+    lv_subject_t * s = deferred_head;
+    while(s && s != subject) {
+        prev = s;
+        s = s->deferred_next;
+    }
+
+    if(s == NULL) return;
+
+    if(prev) prev->deferred_next = subject->deferred_next;
+    else deferred_head = subject->deferred_next;
+    if(deferred_tail == subject) deferred_tail = prev;
+
+    subject->deferred_next = NULL;
+    subject->deferred_pending = 0;
+}
+
+static void deferred_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_subject_notify_deferred();
+}
+#endif
+
 static void subject_set_string_free_user_data_event_cb(lv_event_t * e)
 {
     subject_set_string_user_data_t * user_data = lv_event_get_user_data(e);
@@ -54,7 +54,7 @@ typedef union {
 /**
  * The Subject (an observable value)
  */
-typedef struct {
+typedef struct _lv_subject_t {
     lv_ll_t subs_ll;                     /**< Subscribers */
     lv_subject_value_t value;            /**< Current value */
     lv_subject_value_t prev_value;       /**< Previous value */
@@ -65,6 +65,11 @@ typedef struct {
     uint32_t size                 : 24;  /**< String buffer size or group length */
     uint32_t notify_restart_query :  1;  /**< If an Observer was deleted during notification,
                                           * start notifying from the beginning. */
+#if LV_OBSERVER_DEFERRED_NOTIFY
+    uint32_t deferred             :  1;  /**< Notify the Observers in the next `lv_timer_handler()` call */
+    uint32_t deferred_pending     :  1;  /**< Changed since the Observers were notified the last time */
+    struct _lv_subject_t * deferred_next; /**< Next Subject waiting for the notification */
+#endif
 } lv_subject_t;
 
 /**
@@ -373,6 +378,30 @@ void * lv_observer_get_user_data(const lv_observer_t * observer);
  */
 void lv_subject_notify(lv_subject_t * subject);
 
+#if LV_OBSERVER_DEFERRED_NOTIFY
+
+/**
+ * Notify the Observers of a Subject only in the next `lv_timer_handler()` call instead of
+ * in the `lv_subject_set_...()` functions. If the Subject is set several times until then
+ * the Observers are notified only once, with the last value, and
+ * `lv_subject_get_previous_...()` returns the value they were notified with the last time.
+ * It's useful for Subjects set from other threads: they need to hold the LVGL lock
+ * only while the value is copied.
+ * @param subject       pointer to Subject
+ * @param en            true: defer the notifications; false: notify in the `lv_subject_set_...()`
+ *                      functions again (a pending notification is sent immediately)
+ */
+void lv_subject_set_deferred(lv_subject_t * subject, bool en);
+
+/**
+ * Notify the Observers of all the deferred Subjects which have changed since their last notification.
+ * It's called by a timer and before refreshing a display, but can be called manually to apply
+ * the changes earlier.
+ */
+void lv_subject_notify_deferred(void);
+
+#endif /*LV_OBSERVER_DEFERRED_NOTIFY*/
+
 /**
  * Add an event handler to increment (or decrement) the value of a subject on a trigger.
  * @param obj       pointer to a widget
@@ -17,6 +17,8 @@
 #include "../../stdlib/lv_string.h"
 #include "../../widgets/label/lv_label.h"
 #include "../../display/lv_display_private.h"
+#include "../../draw/lv_draw.h"
+#include "../../misc/lv_area_private.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +31,11 @@
     #define sysmon_mem LV_GLOBAL_DEFAULT()->sysmon_mem
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+    #define FRAME_LOG_MAGIC     "LVFL"
+    #define FRAME_LOG_VERSION   3
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -50,6 +57,16 @@
     static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject);
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+    static lv_sysmon_frame_log_t * frame_log_get(lv_display_t ** disp);
+    static void frame_log_disp_event_cb(lv_event_t * e);
+    static void frame_log_add_heat(lv_sysmon_frame_log_t * log, const lv_area_t * area);
+    static uint32_t frame_log_time_default(void);
+    static uint8_t * put_u16(uint8_t * buf, uint32_t v);
+    static uint8_t * put_u32(uint8_t * buf, uint32_t v);
+    static void heatmap_draw_event_cb(lv_event_t * e);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -198,6 +215,230 @@ void lv_sysmon_hide_memory(lv_display_t * disp)
 
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+
+void lv_sysmon_frame_log_start(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) {
+        LV_LOG_WARN("There is no default display");
+        return;
+    }
+
+    if(disp->frame_log) return;
+
+    lv_sysmon_frame_log_t * log = lv_malloc_zeroed(sizeof(lv_sysmon_frame_log_t));
+    LV_ASSERT_MALLOC(log);
+    if(log == NULL) return;
+
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    log->heatmap_cols = (hor_res + LV_SYSMON_HEATMAP_CELL_SIZE - 1) / LV_SYSMON_HEATMAP_CELL_SIZE;
+    log->heatmap_rows = (ver_res + LV_SYSMON_HEATMAP_CELL_SIZE - 1) / LV_SYSMON_HEATMAP_CELL_SIZE;
+    log->heatmap = lv_malloc_zeroed(log->heatmap_cols * log->heatmap_rows * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(log->heatmap);
+    if(log->heatmap == NULL) {
+        lv_free(log);
+        return;
+    }
+
+    log->time_cb = frame_log_time_default;
+    disp->frame_log = log;
+    lv_display_add_event_cb(disp, frame_log_disp_event_cb, LV_EVENT_ALL, NULL);
+}
+
+void lv_sysmon_frame_log_stop(lv_display_t * disp)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return;
+
+    lv_display_remove_event_cb_with_user_data(disp, frame_log_disp_event_cb, NULL);
+    if(log->heatmap_obj) lv_obj_delete(log->heatmap_obj);
+    lv_free(log->heatmap);
+    lv_free(log);
+    disp->frame_log = NULL;
+}
+
+void lv_sysmon_frame_log_reset(lv_display_t * disp)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return;
+
+    lv_memzero(log->frames, sizeof(log->frames));
+    lv_memzero(log->heatmap, log->heatmap_cols * log->heatmap_rows * sizeof(uint16_t));
+    log->frame_cnt = 0;
+    log->act = NULL;
+    if(log->heatmap_obj) lv_obj_invalidate(log->heatmap_obj);
+}
+
+void lv_sysmon_frame_log_set_time_cb(lv_display_t * disp, lv_sysmon_time_cb_t time_cb)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return;
+
+    log->time_cb = time_cb ? time_cb : frame_log_time_default;
+}
+
+uint32_t lv_sysmon_frame_log_get_count(lv_display_t * disp)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return 0;
+
+    return LV_MIN(log->frame_cnt, LV_SYSMON_FRAME_LOG_CNT);
+}
+
+const lv_sysmon_frame_t * lv_sysmon_frame_log_get_frame(lv_display_t * disp, uint32_t idx)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return NULL;
+    if(idx >= LV_MIN(log->frame_cnt, LV_SYSMON_FRAME_LOG_CNT)) return NULL;
+
+    return &log->frames[(log->frame_cnt - 1 - idx) % LV_SYSMON_FRAME_LOG_CNT];
+}
+
+uint32_t lv_sysmon_frame_log_get_heat(lv_display_t * disp, int32_t x, int32_t y)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return 0;
+    if(x < 0 || y < 0) return 0;
+
+    int32_t col = x / LV_SYSMON_HEATMAP_CELL_SIZE;
+    int32_t row = y / LV_SYSMON_HEATMAP_CELL_SIZE;
+    if(col >= log->heatmap_cols || row >= log->heatmap_rows) return 0;
+
+    return log->heatmap[row * log->heatmap_cols + col];
+}
+
+uint32_t lv_sysmon_frame_log_export(lv_display_t * disp, lv_sysmon_frame_log_write_cb_t write_cb, void * user_data)
+{
+    LV_ASSERT_NULL(write_cb);
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) return 0;
+
+    uint8_t buf[LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT * 6];
+    uint8_t * p;
+    uint32_t size = 0;
+    uint32_t frame_num = LV_MIN(log->frame_cnt, LV_SYSMON_FRAME_LOG_CNT);
+
+    /*Header*/
+    lv_memcpy(buf, FRAME_LOG_MAGIC, 4);
+    p = put_u16(buf + 4, FRAME_LOG_VERSION);
+    p = put_u16(p, frame_num);
+    p = put_u16(p, LV_SYSMON_FRAME_LOG_AREA_CNT);
+    p = put_u16(p, LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT);
+    p = put_u16(p, lv_display_get_horizontal_resolution(disp));
+    p = put_u16(p, lv_display_get_vertical_resolution(disp));
+    p = put_u16(p, LV_SYSMON_HEATMAP_CELL_SIZE);
+    p = put_u16(p, log->heatmap_cols);
+    p = put_u16(p, log->heatmap_rows);
+    p = put_u16(p, 0);
+    write_cb(buf, p - buf, user_data);
+    size += p - buf;
+
+    /*Frames from the oldest to the newest*/
+    uint32_t i;
+    for(i = frame_num; i > 0; i--) {
+        const lv_sysmon_frame_t * f = &log->frames[(log->frame_cnt - i) % LV_SYSMON_FRAME_LOG_CNT];
+        uint32_t area_stored = LV_MIN(f->area_cnt, LV_SYSMON_FRAME_LOG_AREA_CNT);
+
+        p = put_u32(buf, f->id);
+        p = put_u32(p, f->timestamp);
+        p = put_u32(p, f->render_time);
+        p = put_u32(p, f->flush_wait_time);
+        p = put_u32(p, f->px_rendered);
+        p = put_u32(p, f->px_flushed);
+        p = put_u32(p, f->px_blended);
+        p = put_u32(p, f->heap_used);
+        p = put_u32(p, f->heap_free_biggest);
+        p = put_u16(p, f->heap_frag_pct);
+        p = put_u16(p, f->area_cnt);
+        p = put_u16(p, area_stored);
+        write_cb(buf, p - buf, user_data);
+        size += p - buf;
+
+        uint32_t a;
+        for(a = 0; a < area_stored; a++) {
+            p = put_u16(buf, f->areas[a].x1);
+            p = put_u16(p, f->areas[a].y1);
+            p = put_u16(p, f->areas[a].x2);
+            p = put_u16(p, f->areas[a].y2);
+            write_cb(buf, p - buf, user_data);
+            size += p - buf;
+        }
+
+        p = buf;
+        uint32_t t;
+        for(t = 0; t < LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT; t++) p = put_u32(p, f->task_time[t]);
+        for(t = 0; t < LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT; t++) p = put_u16(p, f->task_cnt[t]);
+        write_cb(buf, p - buf, user_data);
+        size += p - buf;
+    }
+
+    /*Heatmap, row by row*/
+    uint32_t cell_num = log->heatmap_cols * log->heatmap_rows;
+    uint32_t c = 0;
+    while(c < cell_num) {
+        p = buf;
+        while(c < cell_num && p < buf + sizeof(buf)) {
+            p = put_u16(p, log->heatmap[c]);
+            c++;
+        }
+        write_cb(buf, p - buf, user_data);
+        size += p - buf;
+    }
+
+    return size;
+}
+
+void lv_sysmon_show_heatmap(lv_display_t * disp)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL) {
+        LV_LOG_WARN("The frame log is not started");
+        return;
+    }
+
+    if(log->heatmap_obj == NULL) {
+        lv_obj_t * obj = lv_obj_create(lv_display_get_layer_sys(disp));
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_size(obj, lv_pct(100), lv_pct(100));
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(obj, heatmap_draw_event_cb, LV_EVENT_DRAW_MAIN, log);
+        log->heatmap_obj = obj;
+    }
+
+    lv_obj_remove_flag(log->heatmap_obj, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_invalidate(log->heatmap_obj);
+}
+
+void lv_sysmon_hide_heatmap(lv_display_t * disp)
+{
+    lv_sysmon_frame_log_t * log = frame_log_get(&disp);
+    if(log == NULL || log->heatmap_obj == NULL) return;
+
+    lv_obj_add_flag(log->heatmap_obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+uint32_t lv_sysmon_frame_log_get_time(lv_display_t * disp)
+{
+    if(disp == NULL || disp->frame_log == NULL || disp->frame_log->act == NULL) return 0;
+
+    return disp->frame_log->time_cb();
+}
+
+void lv_sysmon_frame_log_add_task(lv_display_t * disp, uint32_t type, uint32_t start_time)
+{
+    if(disp == NULL || disp->frame_log == NULL) return;
+
+    lv_sysmon_frame_t * f = disp->frame_log->act;
+    if(f == NULL || type >= LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT) return;
+
+    f->task_time[type] += disp->frame_log->time_cb() - start_time;
+    if(f->task_cnt[type] < UINT16_MAX) f->task_cnt[type]++;
+}
+
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -409,4 +650,162 @@ static void mem_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
 
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+
+static lv_sysmon_frame_log_t * frame_log_get(lv_display_t ** disp)
+{
+    if(*disp == NULL) *disp = lv_display_get_default();
+    if(*disp == NULL) {
+        LV_LOG_WARN("There is no default display");
+        return NULL;
+    }
+
+    return (*disp)->frame_log;
+}
+
+static void frame_log_disp_event_cb(lv_event_t * e)
+{
+    lv_display_t * disp = lv_event_get_target(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_sysmon_frame_log_t * log = disp->frame_log;
+    lv_sysmon_frame_t * f = log->act;
+
+    switch(code) {
+        case LV_EVENT_RENDER_START: {
+                f = &log->frames[log->frame_cnt % LV_SYSMON_FRAME_LOG_CNT];
+                lv_memzero(f, sizeof(lv_sysmon_frame_t));
+                f->id = log->frame_cnt;
+                f->timestamp = lv_tick_get();
+
+                /*The invalidated areas are already joined at this point*/
+                uint32_t i;
+                for(i = 0; i < disp->inv_p; i++) {
+                    if(disp->inv_area_joined[i]) continue;
+                    const lv_area_t * a = &disp->inv_areas[i];
+                    if(f->area_cnt < LV_SYSMON_FRAME_LOG_AREA_CNT) f->areas[f->area_cnt] = *a;
+                    f->area_cnt++;
+                    f->px_rendered += lv_area_get_size(a);
+                    frame_log_add_heat(log, a);
+                }
+
+                log->act = f;
+                log->render_start = log->time_cb();
+                log->blended_px_start = LV_GLOBAL_DEFAULT()->draw_info.blended_px_cnt;
+                break;
+            }
+        case LV_EVENT_RENDER_READY: {
+                if(f == NULL) break;
+                f->render_time = log->time_cb() - log->render_start;
+                f->px_blended = LV_GLOBAL_DEFAULT()->draw_info.blended_px_cnt - log->blended_px_start;
+
+                /*It walks the heap so read it after the render time was measured.
+                 *All zeros if the allocator doesn't support it (e.g. LV_STDLIB_CLIB).*/
+                lv_mem_monitor_t mon;
+                lv_mem_monitor(&mon);
+                f->heap_used = mon.total_size - mon.free_size;
+                f->heap_free_biggest = mon.free_biggest_size;
+                f->heap_frag_pct = mon.frag_pct;
+
+                log->frame_cnt++;
+                log->act = NULL;
+                break;
+            }
+        case LV_EVENT_FLUSH_START:
+            if(f == NULL) break;
+            f->px_flushed += lv_area_get_size(lv_event_get_param(e));
+            break;
+        case LV_EVENT_FLUSH_WAIT_START:
+            if(f == NULL) break;
+            log->flush_wait_start = log->time_cb();
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            if(f == NULL) break;
+            f->flush_wait_time += log->time_cb() - log->flush_wait_start;
+            break;
+        case LV_EVENT_DELETE:
+            if(log->heatmap_obj) lv_obj_delete(log->heatmap_obj);
+            lv_free(log->heatmap);
+            lv_free(log);
+            disp->frame_log = NULL;
+            break;
+        default:
+            break;
+    }
+}
+
+static void frame_log_add_heat(lv_sysmon_frame_log_t * log, const lv_area_t * area)
+{
+    int32_t col1 = LV_MAX(area->x1, 0) / LV_SYSMON_HEATMAP_CELL_SIZE;
+    int32_t row1 = LV_MAX(area->y1, 0) / LV_SYSMON_HEATMAP_CELL_SIZE;
+    int32_t col2 = LV_MIN(area->x2 / LV_SYSMON_HEATMAP_CELL_SIZE, log->heatmap_cols - 1);
+    int32_t row2 = LV_MIN(area->y2 / LV_SYSMON_HEATMAP_CELL_SIZE, log->heatmap_rows - 1);
+
+    int32_t row;
+    int32_t col;
+    for(row = row1; row <= row2; row++) {
+        uint16_t * cell = &log->heatmap[row * log->heatmap_cols + col1];
+        for(col = col1; col <= col2; col++) {
+            if(*cell < UINT16_MAX) (*cell)++;
+            cell++;
+        }
+    }
+}
+
+static uint32_t frame_log_time_default(void)
+{
+    return lv_tick_get() * 1000;
+}
+
+static uint8_t * put_u16(uint8_t * buf, uint32_t v)
+{
+    buf[0] = v & 0xff;
+    buf[1] = (v >> 8) & 0xff;
+    return buf + 2;
+}
+
+static uint8_t * put_u32(uint8_t * buf, uint32_t v)
+{
+    buf = put_u16(buf, v & 0xffff);
+    return put_u16(buf, v >> 16);
+}
+
+static void heatmap_draw_event_cb(lv_event_t * e)
+{
+    lv_sysmon_frame_log_t * log = lv_event_get_user_data(e);
+    lv_layer_t * layer = lv_event_get_layer(e);
+    uint32_t cell_num = log->heatmap_cols * log->heatmap_rows;
+
+    uint32_t max = 0;
+    uint32_t i;
+    for(i = 0; i < cell_num; i++) {
+        if(log->heatmap[i] > max) max = log->heatmap[i];
+    }
+    if(max == 0) return;
+
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = lv_palette_main(LV_PALETTE_RED);
+
+    int32_t row;
+    int32_t col;
+    for(row = 0; row < log->heatmap_rows; row++) {
+        for(col = 0; col < log->heatmap_cols; col++) {
+            uint32_t heat = log->heatmap[row * log->heatmap_cols + col];
+            if(heat == 0) continue;
+
+            lv_area_t a;
+            a.x1 = col * LV_SYSMON_HEATMAP_CELL_SIZE;
+            a.y1 = row * LV_SYSMON_HEATMAP_CELL_SIZE;
+            a.x2 = a.x1 + LV_SYSMON_HEATMAP_CELL_SIZE - 1;
+            a.y2 = a.y1 + LV_SYSMON_HEATMAP_CELL_SIZE - 1;
+            if(!lv_area_is_on(&a, &layer->_clip_area)) continue;
+
+            dsc.opa = LV_OPA_10 + (heat * (LV_OPA_70 - LV_OPA_10)) / max;
+            lv_draw_fill(layer, &dsc, &a);
+        }
+    }
+}
+
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 #endif /*LV_USE_SYSMON*/
@@ -16,6 +16,7 @@ extern "C" {
 
 #include "../../misc/lv_timer.h"
 #include "../../others/observer/lv_observer.h"
+#include "../../misc/lv_area.h"
 
 #if LV_USE_SYSMON
 
@@ -31,10 +32,44 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_USE_SYSMON_FRAME_LOG
+/** Number of draw task time slots in a frame record. Indexed by `lv_draw_task_type_t`.
+ *  Fixed so that the export format doesn't depend on the enabled draw features.*/
+#define LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT   16
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_SYSMON_FRAME_LOG
+
+/** Statistics of a single rendered frame*/
+typedef struct {
+    uint32_t id;                /**< Sequence number of the frame since the log was started*/
+    uint32_t timestamp;         /**< `lv_tick_get()` when rendering started [ms]*/
+    uint32_t render_time;       /**< Time from render start to render ready, flush waiting included [us]*/
+    uint32_t flush_wait_time;   /**< Time spent waiting for the flush callback [us]*/
+    uint32_t px_rendered;       /**< Number of pixels in the (joined) invalidated areas*/
+    uint32_t px_flushed;        /**< Number of pixels passed to the flush callback*/
+    uint32_t px_blended;        /**< Number of pixels blended by the software renderer, overdraw included*/
+    uint32_t heap_used;         /**< Used size of the LVGL heap when rendering was ready [bytes]*/
+    uint32_t heap_free_biggest; /**< Largest free block of the LVGL heap when rendering was ready [bytes]*/
+    uint8_t heap_frag_pct;      /**< Fragmentation of the LVGL heap when rendering was ready [%]*/
+    uint32_t task_time[LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT];  /**< Draw time per draw task type [us]*/
+    uint16_t task_cnt[LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT];   /**< Number of executed draw tasks per type*/
+    uint16_t area_cnt;          /**< Number of invalidated areas. Only the first `LV_SYSMON_FRAME_LOG_AREA_CNT` are stored*/
+    lv_area_t areas[LV_SYSMON_FRAME_LOG_AREA_CNT];
+} lv_sysmon_frame_t;
+
+/** Return a free running time stamp in microseconds*/
+typedef uint32_t (*lv_sysmon_time_cb_t)(void);
+
+/** Called by `lv_sysmon_frame_log_export` with the consecutive chunks of the binary log*/
+typedef void (*lv_sysmon_frame_log_write_cb_t)(const void * buf, uint32_t len, void * user_data);
+
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -100,6 +135,84 @@ void lv_sysmon_hide_memory(lv_display_t * disp);
 
 #endif /*LV_USE_MEM_MONITOR*/
 
+#if LV_USE_SYSMON_FRAME_LOG
+
+/**
+ * Start recording the statistics of every rendered frame into a ring buffer
+ * of `LV_SYSMON_FRAME_LOG_CNT` frames and accumulate the invalidated areas in a heatmap.
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_frame_log_start(lv_display_t * disp);
+
+/**
+ * Stop recording and free the frame log and the heatmap
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_frame_log_stop(lv_display_t * disp);
+
+/**
+ * Clear the recorded frames and the heatmap
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_frame_log_reset(lv_display_t * disp);
+
+/**
+ * Set a microsecond time source for the render and draw task timings.
+ * By default `lv_tick_get() * 1000` is used which is too coarse for the draw tasks.
+ * @param disp      target display, NULL: use the default
+ * @param time_cb   the time source, NULL: use the default
+ */
+void lv_sysmon_frame_log_set_time_cb(lv_display_t * disp, lv_sysmon_time_cb_t time_cb);
+
+/**
+ * Get the number of frames available in the ring buffer
+ * @param disp      target display, NULL: use the default
+ * @return          number of frames, at most `LV_SYSMON_FRAME_LOG_CNT`
+ */
+uint32_t lv_sysmon_frame_log_get_count(lv_display_t * disp);
+
+/**
+ * Get a recorded frame
+ * @param disp      target display, NULL: use the default
+ * @param idx       0: the last rendered frame, 1: the one before it, etc.
+ * @return          pointer to the frame or NULL if `idx` is out of range
+ */
+const lv_sysmon_frame_t * lv_sysmon_frame_log_get_frame(lv_display_t * disp, uint32_t idx);
+
+/**
+ * Get how many times a heatmap cell was invalidated
+ * @param disp      target display, NULL: use the default
+ * @param x         x coordinate of a pixel in the cell
+ * @param y         y coordinate of a pixel in the cell
+ * @return          the counter of the cell (saturates at 0xFFFF)
+ */
+uint32_t lv_sysmon_frame_log_get_heat(lv_display_t * disp, int32_t x, int32_t y);
+
+/**
+ * Export the frames (from the oldest to the newest) and the heatmap in a compact
+ * little endian binary format. See `scripts/sysmon_frame_log.py` for the layout and a decoder.
+ * @param disp      target display, NULL: use the default
+ * @param write_cb  called with the consecutive chunks of the data
+ * @param user_data passed to `write_cb`
+ * @return          number of exported bytes
+ */
+uint32_t lv_sysmon_frame_log_export(lv_display_t * disp, lv_sysmon_frame_log_write_cb_t write_cb, void * user_data);
+
+/**
+ * Show the heatmap as a translucent overlay on the system layer.
+ * Cells which were invalidated more often are drawn more opaque.
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_show_heatmap(lv_display_t * disp);
+
+/**
+ * Hide the heatmap overlay
+ * @param disp      target display, NULL: use the default
+ */
+void lv_sysmon_hide_heatmap(lv_display_t * disp);
+
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 /**********************
  *      MACROS
  **********************/
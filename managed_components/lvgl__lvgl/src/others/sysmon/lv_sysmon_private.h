@@ -67,6 +67,22 @@ struct _lv_sysmon_perf_info_t {
 };
 #endif
 
+#if LV_USE_SYSMON_FRAME_LOG
+struct _lv_sysmon_frame_log_t {
+    lv_sysmon_frame_t frames[LV_SYSMON_FRAME_LOG_CNT];
+    lv_sysmon_frame_t * act;        /**< The frame being rendered, NULL outside of rendering*/
+    uint32_t frame_cnt;             /**< Number of frames recorded since the last reset*/
+    uint32_t render_start;
+    uint32_t flush_wait_start;
+    uint32_t blended_px_start;      /**< `blended_px_cnt` of the draw module when rendering started*/
+    lv_sysmon_time_cb_t time_cb;
+    lv_obj_t * heatmap_obj;
+    uint16_t * heatmap;
+    uint16_t heatmap_cols;
+    uint16_t heatmap_rows;
+};
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -81,6 +97,25 @@ void lv_sysmon_builtin_init(void);
  */
 void lv_sysmon_builtin_deinit(void);
 
+#if LV_USE_SYSMON_FRAME_LOG
+
+/**
+ * Get the current time of the frame log of a display. Used to time the draw tasks.
+ * @param disp      the display being refreshed, can be NULL
+ * @return          time stamp in microseconds or 0 if there is no frame being recorded
+ */
+uint32_t lv_sysmon_frame_log_get_time(lv_display_t * disp);
+
+/**
+ * Add the time of an executed draw task to the frame being recorded
+ * @param disp          the display being refreshed, can be NULL
+ * @param type          type of the draw task (`lv_draw_task_type_t`)
+ * @param start_time    value of `lv_sysmon_frame_log_get_time()` before the task was executed
+ */
+void lv_sysmon_frame_log_add_task(lv_display_t * disp, uint32_t type, uint32_t start_time);
+
+#endif /*LV_USE_SYSMON_FRAME_LOG*/
+
 /**********************
  *      MACROS
  **********************/
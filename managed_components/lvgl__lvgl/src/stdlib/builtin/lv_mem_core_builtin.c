@@ -46,6 +46,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static void mem_monitor_finish(lv_mem_monitor_t * mon_p);
+static lv_mem_hint_pool_t * get_hint_pool(const void * p);
 
 /**********************
  *  STATIC VARIABLES
@@ -86,6 +88,8 @@ void lv_mem_init(void)
     state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
 
+    lv_memzero(state.hint_pools, sizeof(state.hint_pools));
+
     lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
 
     /*Record the first pool*/
@@ -102,6 +106,7 @@ void lv_mem_deinit(void)
 {
     lv_ll_clear(&state.pool_ll);
     lv_tlsf_destroy(state.tlsf);
+    lv_memzero(state.hint_pools, sizeof(state.hint_pools));
 #if LV_USE_OS
     lv_mutex_delete(&state.mutex);
 #endif
@@ -136,6 +141,70 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
     LV_LOG_WARN("invalid pool: %p", pool);
 }
 
+lv_mem_pool_t lv_mem_add_pool_hint(void * mem, size_t bytes, lv_mem_hint_t hint)
+{
+    if(hint >= LV_MEM_HINT_CNT) {
+        LV_LOG_WARN("invalid memory class: %d", hint);
+        return NULL;
+    }
+
+    lv_mem_hint_pool_t * hint_pool = &state.hint_pools[hint];
+    if(hint_pool->tlsf) {
+        LV_LOG_WARN("memory class %d already has a pool", hint);
+        return NULL;
+    }
+
+    /*The size of the largest block is limited by the TLSF configuration*/
+    size_t bytes_max = lv_tlsf_size() + lv_tlsf_pool_overhead() + lv_tlsf_block_size_max();
+    if(bytes > bytes_max) {
+        LV_LOG_INFO("only %zu bytes of the %zu bytes are used", bytes_max, bytes);
+        bytes = bytes_max;
+    }
+
+    lv_tlsf_t tlsf = lv_tlsf_create_with_pool(mem, bytes);
+    if(tlsf == NULL) {
+        LV_LOG_WARN("failed to add memory pool, address: %p, size: %zu", mem, bytes);
+        return NULL;
+    }
+
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    hint_pool->start = mem;
+    hint_pool->size = bytes;
+    hint_pool->cur_used = 0;
+    hint_pool->max_used = 0;
+    hint_pool->tlsf = tlsf;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    return lv_tlsf_get_pool(tlsf);
+}
+
+void * lv_malloc_hint_core(size_t size, lv_mem_hint_t hint)
+{
+    if(hint >= LV_MEM_HINT_CNT || state.hint_pools[hint].tlsf == NULL) return lv_malloc_core(size);
+
+    lv_mem_hint_pool_t * hint_pool = &state.hint_pools[hint];
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    void * p = lv_tlsf_malloc(hint_pool->tlsf, size);
+    if(p) {
+        hint_pool->cur_used += lv_tlsf_block_size(p);
+        hint_pool->max_used = LV_MAX(hint_pool->cur_used, hint_pool->max_used);
+    }
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+
+    /*The pool of the class is full*/
+    if(p == NULL) p = lv_malloc_core(size);
+
+    return p;
+}
+
 void * lv_malloc_core(size_t size)
 {
 #if LV_USE_OS
@@ -160,6 +229,29 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
+    lv_mem_hint_pool_t * hint_pool = get_hint_pool(p);
+    if(hint_pool) {
+        size_t old_size = lv_tlsf_block_size(p);
+        void * p_new = lv_tlsf_realloc(hint_pool->tlsf, p, new_size);
+        if(p_new) {
+            hint_pool->cur_used -= old_size;
+            hint_pool->cur_used += lv_tlsf_block_size(p_new);
+            hint_pool->max_used = LV_MAX(hint_pool->cur_used, hint_pool->max_used);
+        }
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        if(p_new) return p_new;
+
+        /*The pool of the class is full, move the data to the default pool*/
+        p_new = lv_malloc_core(new_size);
+        if(p_new) {
+            lv_memcpy(p_new, p, LV_MIN(old_size, new_size));
+            lv_free_core(p);
+        }
+        return p_new;
+    }
+
     size_t old_size = lv_tlsf_block_size(p);
     void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
 
@@ -184,10 +276,19 @@ void lv_free_core(void * p)
 #if LV_MEM_ADD_JUNK
     lv_memset(p, 0xbb, lv_tlsf_block_size(data));
 #endif
-    size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
+    lv_mem_hint_pool_t * hint_pool = get_hint_pool(p);
+    if(hint_pool) {
+        size_t size = lv_tlsf_block_size(p);
+        lv_tlsf_free(hint_pool->tlsf, p);
+        if(hint_pool->cur_used > size) hint_pool->cur_used -= size;
+        else hint_pool->cur_used = 0;
+    }
+    else {
+        size_t size = lv_tlsf_block_size(p);
+        lv_tlsf_free(state.tlsf, p);
+        if(state.cur_used > size) state.cur_used -= size;
+        else state.cur_used = 0;
+    }
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -205,20 +306,26 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
     }
 
-    mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
-    if(mon_p->free_size > 0) {
-        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
-        mon_p->frag_pct = 100 - mon_p->frag_pct;
-    }
-    else {
-        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
-    }
-
+    mem_monitor_finish(mon_p);
     mon_p->max_used = state.max_used;
 
     LV_TRACE_MEM("finished");
 }
 
+void lv_mem_monitor_hint_core(lv_mem_monitor_t * mon_p, lv_mem_hint_t hint)
+{
+    if(hint >= LV_MEM_HINT_CNT || state.hint_pools[hint].tlsf == NULL) {
+        lv_mem_monitor_core(mon_p);
+        return;
+    }
+
+    lv_mem_hint_pool_t * hint_pool = &state.hint_pools[hint];
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(hint_pool->tlsf), lv_mem_walker, mon_p);
+    mem_monitor_finish(mon_p);
+    mon_p->max_used = hint_pool->max_used;
+}
+
 lv_result_t lv_mem_test_core(void)
 {
 #if LV_USE_OS
@@ -232,6 +339,17 @@ lv_result_t lv_mem_test_core(void)
         return LV_RESULT_INVALID;
     }
 
+    for(uint32_t i = 0; i < LV_MEM_HINT_CNT; i++) {
+        lv_tlsf_t tlsf = state.hint_pools[i].tlsf;
+        if(tlsf && (lv_tlsf_check(tlsf) || lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf)))) {
+            LV_LOG_WARN("pool of memory class %d failed", (int)i);
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return LV_RESULT_INVALID;
+        }
+    }
+
     lv_pool_t * pool_p;
     LV_LL_READ(&state.pool_ll, pool_p) {
         if(lv_tlsf_check_pool(*pool_p)) {
@@ -268,6 +386,38 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
         mon_p->free_size += size;
         if(size > mon_p->free_biggest_size)
             mon_p->free_biggest_size = size;
+
+        uint32_t i = 0;
+        while(i < LV_MEM_MONITOR_FREE_HIST_CNT - 1 && size >= ((size_t)64 << i)) i++;
+        mon_p->free_hist[i]++;
+    }
+}
+
+static void mem_monitor_finish(lv_mem_monitor_t * mon_p)
+{
+    mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
+    if(mon_p->free_size > 0) {
+        mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
+        mon_p->frag_pct = 100 - mon_p->frag_pct;
+    }
+    else {
+        mon_p->frag_pct = 0; /*no fragmentation if all the RAM is used*/
     }
 }
+
+/**
+ * Get the pool of a memory class which contains a memory address
+ * @param p     pointer to an allocated memory
+ * @return      the pool or NULL if `p` is in the default pool
+ */
+static lv_mem_hint_pool_t * get_hint_pool(const void * p)
+{
+    for(uint32_t i = 0; i < LV_MEM_HINT_CNT; i++) {
+        lv_mem_hint_pool_t * hint_pool = &state.hint_pools[i];
+        if(hint_pool->tlsf && (lv_uintptr_t)p - (lv_uintptr_t)hint_pool->start < hint_pool->size) return hint_pool;
+    }
+
+    return NULL;
+}
+
 #endif /*LV_STDLIB_BUILTIN*/
@@ -17,6 +17,7 @@ extern "C" {
  *********************/
 
 #include "lv_tlsf.h"
+#include "../lv_mem.h"
 #include "../../osal/lv_os_private.h"
 
 /*********************
@@ -27,6 +28,15 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** The pool of a memory class added by `lv_mem_add_pool_hint()`*/
+typedef struct {
+    lv_tlsf_t tlsf;     /**< NULL if the class has no own pool*/
+    uint8_t * start;
+    size_t size;
+    size_t cur_used;
+    size_t max_used;
+} lv_mem_hint_pool_t;
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
@@ -35,6 +45,7 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+    lv_mem_hint_pool_t hint_pools[LV_MEM_HINT_CNT];
 } lv_tlsf_state_t;
 
 /**********************
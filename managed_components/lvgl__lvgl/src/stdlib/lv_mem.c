@@ -40,6 +40,8 @@ void * lv_malloc_core(size_t size);
 void * lv_realloc_core(void * p, size_t new_size);
 void lv_free_core(void * p);
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p);
+void * lv_malloc_hint_core(size_t size, lv_mem_hint_t hint);
+void lv_mem_monitor_hint_core(lv_mem_monitor_t * mon_p, lv_mem_hint_t hint);
 lv_result_t lv_mem_test_core(void);
 
 /**********************
@@ -89,6 +91,33 @@ void * lv_malloc(size_t size)
     return alloc;
 }
 
+void * lv_malloc_hint(size_t size, lv_mem_hint_t hint)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    LV_TRACE_MEM("allocating %lu bytes for class %d", (unsigned long)size, hint);
+    if(size == 0) {
+        LV_TRACE_MEM("using zero_mem");
+        return &zero_mem;
+    }
+
+    void * alloc = lv_malloc_hint_core(size, hint);
+    if(alloc == NULL) {
+        LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
+        return NULL;
+    }
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(alloc, 0xaa, size);
+#endif
+
+    LV_TRACE_MEM("allocated at %p", alloc);
+    return alloc;
+#else
+    LV_UNUSED(hint);
+    return lv_malloc(size);
+#endif
+}
+
 void * lv_malloc_zeroed(size_t size)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
@@ -183,6 +212,17 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_mem_monitor_core(mon_p);
 }
 
+void lv_mem_monitor_hint(lv_mem_monitor_t * mon_p, lv_mem_hint_t hint)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    lv_mem_monitor_hint_core(mon_p, hint);
+#else
+    LV_UNUSED(hint);
+    lv_mem_monitor(mon_p);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -23,12 +23,26 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** Number of buckets in `lv_mem_monitor_t::free_hist`*/
+#define LV_MEM_MONITOR_FREE_HIST_CNT 8
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 typedef void * lv_mem_pool_t;
 
+/**
+ * Memory classes for `lv_malloc_hint()`. With the builtin allocator each class can have its own pool
+ * (see `lv_mem_add_pool_hint()`), else the default pool is used.
+ */
+typedef enum {
+    LV_MEM_HINT_HOT = 0,    /**< Small, frequently accessed data, e.g. objects and styles */
+    LV_MEM_HINT_BULK,       /**< Large buffers which can be in slower (external) RAM, e.g. decoded images and glyphs */
+    LV_MEM_HINT_DMA,        /**< Buffers which might be accessed by DMA, e.g. draw buffers */
+    LV_MEM_HINT_CNT,
+} lv_mem_hint_t;
+
 /**
  * Heap information structure.
  */
@@ -41,6 +55,9 @@ typedef struct {
     size_t max_used;    /**< Max size of Heap memory used */
     uint8_t used_pct;   /**< Percentage used */
     uint8_t frag_pct;   /**< Amount of fragmentation */
+    /** Number of free blocks by size: bucket 0 counts the blocks smaller than 64 bytes,
+     *  bucket `i` the blocks in [32 << i, 64 << i) and the last bucket all the larger ones */
+    size_t free_hist[LV_MEM_MONITOR_FREE_HIST_CNT];
 } lv_mem_monitor_t;
 
 /**********************
@@ -61,6 +78,16 @@ lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
+/**
+ * Use a memory area for the allocations of a memory class.
+ * Only one pool can be added for each class. Only with `LV_STDLIB_BUILTIN`.
+ * @param mem       pointer to the memory area, e.g. allocated from PSRAM
+ * @param bytes     size of the memory area. Only `LV_MEM_SIZE + LV_MEM_POOL_EXPAND_SIZE` bytes are used at most.
+ * @param hint      the memory class to use the area for
+ * @return          the new pool or NULL on failure
+ */
+lv_mem_pool_t lv_mem_add_pool_hint(void * mem, size_t bytes, lv_mem_hint_t hint);
+
 /**
  * Allocate memory dynamically
  * @param size requested size in bytes
@@ -90,6 +117,16 @@ void * lv_zalloc(size_t size);
  */
 void * lv_malloc_zeroed(size_t size);
 
+/**
+ * Allocate memory dynamically from the pool of a memory class.
+ * If the class has no pool or it's full the default pool is used.
+ * The memory can be freed and reallocated as usual.
+ * @param size requested size in bytes
+ * @param hint the memory class of the allocation
+ * @return pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_hint(size_t size, lv_mem_hint_t hint);
+
 /**
  * Free an allocated data
  * @param data pointer to an allocated memory
@@ -134,12 +171,26 @@ void lv_free_core(void * p);
  */
 void * lv_realloc_core(void * p, size_t new_size);
 
+/**
+ * Used internally to execute a `malloc` operation from the pool of a memory class
+ * @param size      size in bytes to `malloc`
+ * @param hint      the memory class of the allocation
+ */
+void * lv_malloc_hint_core(size_t size, lv_mem_hint_t hint);
+
 /**
  * Used internally by lv_mem_monitor() to gather LVGL heap state information.
  * @param mon_p      pointer to lv_mem_monitor_t object to be populated.
  */
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p);
 
+/**
+ * Used internally by lv_mem_monitor_hint() to gather the state of the pool of a memory class.
+ * @param mon_p      pointer to lv_mem_monitor_t object to be populated.
+ * @param hint       the memory class
+ */
+void lv_mem_monitor_hint_core(lv_mem_monitor_t * mon_p, lv_mem_hint_t hint);
+
 lv_result_t lv_mem_test_core(void);
 
 /**
@@ -155,6 +206,15 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Give information about the pool used by a memory class.
+ * If the class has no pool, the default pool is described.
+ * @param mon_p pointer to a lv_mem_monitor_t variable,
+ *              the result of the analysis will be stored here
+ * @param hint  the memory class
+ */
+void lv_mem_monitor_hint(lv_mem_monitor_t * mon_p, lv_mem_hint_t hint);
+
 /**********************
  *      MACROS
  **********************/
@@ -60,6 +60,15 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
     return;
 }
 
+lv_mem_pool_t lv_mem_add_pool_hint(void * mem, size_t bytes, lv_mem_hint_t hint)
+{
+    /*Not supported*/
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    LV_UNUSED(hint);
+    return NULL;
+}
+
 void * lv_malloc_core(size_t size)
 {
 #if MICROPY_MALLOC_USES_ALLOCATED_SIZE
@@ -11,6 +11,7 @@
 #include "../../misc/lv_anim_private.h"
 #include "../../draw/lv_draw_label_private.h"
 #include "../../core/lv_obj_class_private.h"
+#include "../../core/lv_obj_draw_private.h"
 #if LV_USE_LABEL != 0
 #include "../../core/lv_obj_private.h"
 #include "../../misc/lv_assert.h"
@@ -348,13 +349,14 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
     attributes.max_width = lv_area_get_width(&txt_coords);
 
     int32_t y = 0;
+    const uint32_t text_len = lv_strlen(txt);
     uint32_t line_start = 0;
     uint32_t new_line_start = 0;
     while(txt[new_line_start] != '\0') {
         bool last_line = y + letter_height + attributes.line_space + letter_height > max_h;
         if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) attributes.text_flags |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, NULL, &attributes);
+        new_line_start += lv_text_get_next_line(&txt[line_start], text_len - line_start, font, NULL, &attributes);
 
         if(byte_id < new_line_start || txt[new_line_start] == '\0')
             break; /*The line of 'index' letter begins at 'line_start'*/
@@ -427,6 +429,7 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
     lv_area_t txt_coords;
     lv_obj_get_content_coords(obj, &txt_coords);
     const char * txt         = lv_label_get_text(obj);
+    const uint32_t text_len  = lv_strlen(txt);
     uint32_t line_start      = 0;
     uint32_t new_line_start  = 0;
     int32_t max_h = lv_area_get_height(&txt_coords);
@@ -447,7 +450,7 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
         bool last_line = y + letter_height + attributes.line_space + letter_height > max_h;
         if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) attributes.text_flags |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, NULL, &attributes);
+        new_line_start += lv_text_get_next_line(&txt[line_start], text_len - line_start, font, NULL, &attributes);
 
         if(pos.y <= y + letter_height) {
             /*The line is found (stored in 'line_start')*/
@@ -490,13 +493,16 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in, bool
     uint32_t i = 0;
     uint32_t i_act = i;
 
+    lv_text_decoder_t dec;
+    lv_text_decoder_init(&dec, bidi_txt, length);
+
     if(new_line_start > 0) {
         while(i + line_start < new_line_start) {
-            uint32_t letter;
-            uint32_t letter_next;
             /*Get the current letter and the next letter for kerning*/
             /*Be careful 'i' already points to the next character*/
-            lv_text_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
+            uint32_t letter = lv_text_decoder_next(&dec);
+            uint32_t letter_next = letter != '\0' ? lv_text_decoder_peek(&dec) : 0;
+            i = lv_text_decoder_get_pos(&dec);
 
             if((attributes.text_flags & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(lv_text_is_cmd(&cmd_state, bidi_txt[i]) != false) {
@@ -551,6 +557,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     lv_obj_get_content_coords(obj, &txt_coords);
     lv_text_attributes_t attributes = {0};
     const char * txt         = lv_label_get_text(obj);
+    const uint32_t text_len  = lv_strlen(txt);
     lv_label_t * label     = (lv_label_t *)obj;
     uint32_t line_start      = 0;
     uint32_t new_line_start  = 0;
@@ -569,7 +576,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
         bool last_line = y + letter_height + attributes.line_space + letter_height > max_h;
         if(last_line && label->long_mode == LV_LABEL_LONG_MODE_DOTS) attributes.text_flags |= LV_TEXT_FLAG_BREAK_ALL;
 
-        new_line_start += lv_text_get_next_line(&txt[line_start], LV_TEXT_LEN_MAX, font, NULL, &attributes);
+        new_line_start += lv_text_get_next_line(&txt[line_start], text_len - line_start, font, NULL, &attributes);
 
         if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
         y += letter_height + attributes.line_space;
@@ -598,11 +605,17 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
     uint32_t letter = '\0';
     uint32_t letter_next = '\0';
 
+    lv_text_decoder_t dec;
+    lv_text_decoder_init(&dec, txt, new_line_start);
+    lv_text_decoder_seek(&dec, line_start);
+
     if(new_line_start > 0) {
         while(i <= new_line_start - 1) {
             /*Get the current letter and the next letter for kerning*/
             /*Be careful 'i' already points to the next character*/
-            lv_text_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+            letter = lv_text_decoder_next(&dec);
+            letter_next = letter != '\0' ? lv_text_decoder_peek(&dec) : 0;
+            i = lv_text_decoder_get_pos(&dec);
 
             if((attributes.text_flags & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(lv_text_is_cmd(&cmd_state, txt[i]) != false) {
@@ -707,7 +720,12 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     /*Cannot append to static text*/
     if(label->static_txt != 0) return;
 
+#if LV_LABEL_LINE_CACHE
+    /*When appending lv_label_refr_text invalidates only the new lines*/
+    if(pos != LV_LABEL_POS_LAST) lv_obj_invalidate(obj);
+#else
     lv_obj_invalidate(obj);
+#endif
 
     /*Allocate space for the new text*/
     size_t old_len = lv_strlen(label->text);
@@ -788,6 +806,9 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+#if LV_LABEL_LINE_CACHE
+    lv_text_lines_reset(&label->lines);
+#endif
 #if LV_USE_TRANSLATION
     if(label->translation_tag) lv_free(label->translation_tag);
     label->translation_tag = NULL;
@@ -806,6 +827,10 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     lv_obj_t * obj = lv_event_get_current_target(e);
 
     if((code == LV_EVENT_STYLE_CHANGED) || (code == LV_EVENT_SIZE_CHANGED)) {
+#if LV_LABEL_LINE_CACHE
+        /*The glyphs of the font might have changed too*/
+        if(code == LV_EVENT_STYLE_CHANGED) lv_text_lines_reset(&((lv_label_t *)obj)->lines);
+#endif
         lv_label_refr_text(obj);
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
@@ -894,6 +919,12 @@ static void draw_main(lv_event_t * e)
         label_draw_dsc.hint = &label->hint;
     }
 #endif
+#if LV_LABEL_LINE_CACHE
+    /*The dots are written into the text so the stored lines don't match it*/
+    if(label->long_mode != LV_LABEL_LONG_MODE_DOTS) {
+        label_draw_dsc.lines = &label->lines;
+    }
+#endif
 
     label_draw_dsc.flag = flag;
     label_draw_dsc.base.layer = layer;
@@ -1088,7 +1119,11 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_point_t size;
 
     lv_label_revert_dots(obj);
+#if LV_LABEL_LINE_CACHE
+    lv_text_lines_get_size(&size, &label->lines, label->text, font, &attributes);
+#else
     lv_text_get_size_attributes(&size, label->text, font, &attributes);
+#endif
     label->text_size = size;
 
     lv_obj_refresh_self_size(obj);
@@ -1329,7 +1364,19 @@ static void lv_label_refr_text(lv_obj_t * obj)
         }
     }
     else if(label->long_mode == LV_LABEL_LONG_MODE_CLIP || label->long_mode == LV_LABEL_LONG_MODE_WRAP) {
-        /*Do nothing*/
+#if LV_LABEL_LINE_CACHE
+        /*If text was appended only the lines after the kept ones need to be redrawn.
+         *If the size of the label changes the layout invalidates the whole label anyway.*/
+        if(label->lines.reused_cnt && label->lines.reused_cnt < label->lines.line_cnt) {
+            int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+            int32_t line_height = lv_font_get_line_height(font) + attributes.line_space;
+            lv_area_t inv_area = obj->coords;
+            lv_area_increase(&inv_area, ext_size, ext_size);
+            inv_area.y1 = LV_MAX(inv_area.y1, txt_coords.y1 + (int32_t)label->lines.reused_cnt * line_height - ext_size);
+            lv_obj_invalidate_area(obj, &inv_area);
+            return;
+        }
+#endif
     }
 
     lv_obj_invalidate(obj);
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "../../draw/lv_draw_label_private.h"
+#include "../../misc/lv_text_private.h"
 #include "../../core/lv_obj_private.h"
 #include "lv_label.h"
 
@@ -41,6 +42,10 @@ struct _lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_text_lines_t lines;              /**< Line breaks of the text to draw it without breaking the lines again */
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -514,21 +514,22 @@ uint32_t lv_spangroup_get_expand_width(lv_obj_t * obj, uint32_t max_width)
     uint32_t width = LV_COORD_IS_PCT(spans->indent) ? 0 : spans->indent;
     int32_t letter_space = 0;
     lv_span_t * cur_span;
+    lv_text_decoder_t dec;
     LV_LL_READ(&spans->child_ll, cur_span) {
         uint32_t letter;
         uint32_t letter_next;
         const lv_font_t * font = lv_span_get_style_text_font(obj, cur_span);
 
         letter_space = lv_span_get_style_text_letter_space(obj, cur_span);
-        uint32_t j = 0;
         const char * cur_txt = cur_span->txt;
         span_text_check(&cur_txt);
-        while(cur_txt[j] != '\0') {
+        lv_text_decoder_init(&dec, cur_txt, LV_TEXT_LEN_MAX);
+        while(cur_txt[lv_text_decoder_get_pos(&dec)] != '\0') {
             if(max_width > 0 && width >= max_width) {
                 return max_width;
             }
-            letter      = lv_text_encoded_next(cur_txt, &j);
-            letter_next = lv_text_encoded_next(&cur_txt[j], NULL);
+            letter      = lv_text_decoder_next(&dec);
+            letter_next = lv_text_decoder_peek(&dec);
             uint32_t letter_w = lv_font_get_glyph_width(font, letter, letter_next);
             width = width + letter_w + letter_space;
         }
@@ -912,7 +913,7 @@ static bool lv_text_get_snippet(const char * txt, const lv_font_t * font,
     attributes.max_width = real_max_width;
     attributes.text_flags = flag;
 
-    uint32_t ofs = lv_text_get_next_line(txt, LV_TEXT_LEN_MAX, font, use_width, &attributes);
+    uint32_t ofs = lv_text_get_next_line(txt, lv_strlen(txt), font, use_width, &attributes);
     *end_ofs = ofs;
 
     if(txt[ofs] == '\0' && *use_width <= attributes.max_width && !(ofs && (txt[ofs - 1] == '\n' || txt[ofs - 1] == '\r'))) {
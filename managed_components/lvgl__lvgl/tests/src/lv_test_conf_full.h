@@ -3,6 +3,12 @@
 
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
 #define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_DRAW_OCCLUSION_CULLING       1
+#define LV_REFR_RENDER_LIST             1
+#define LV_DRAW_TASK_ARENA_SIZE         (4 * 1024)
+#ifndef LV_OBJ_STYLE_PROP_CACHE_CNT
+#define LV_OBJ_STYLE_PROP_CACHE_CNT     32
+#endif
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -45,11 +51,14 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE   (32 * 1024)
+#define LV_TEXT_GLYPH_RUN_CACHE_SIZE        (16 * 1024)
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
 #define LV_USE_MEM_MONITOR          1
 #define LV_LABEL_TEXT_SELECTION     1
+#define LV_LABEL_LINE_CACHE         1
 
 #define LV_USE_CALENDAR_CHINESE 1
 #define LV_USE_LOTTIE 1
@@ -93,12 +102,15 @@
 #define LV_USE_IMGFONT      1
 #define LV_USE_IME_PINYIN       1
 #define LV_USE_OBSERVER         1
+#define LV_OBSERVER_DEFERRED_NOTIFY 1
 #define LV_USE_FILE_EXPLORER    1
 #define LV_USE_TINY_TTF         1
 #define LV_TINY_TTF_FILE_SUPPORT 1
+#define LV_TINY_TTF_BITMAP_CACHE_SIZE   (64 * 1024)
 #define LV_USE_SYSMON           1
 #define LV_USE_MEM_MONITOR      1
 #define LV_USE_PERF_MONITOR     1
+#define LV_USE_SYSMON_FRAME_LOG 1
 #define LV_USE_SNAPSHOT         1
 #define LV_USE_THORVG_INTERNAL  1
 #define LV_USE_LZ4_INTERNAL     1
@@ -47,6 +47,25 @@ void lv_test_deinit(void)
     lv_deinit();
 }
 
+#if LV_USE_CANVAS
+lv_obj_t * lv_test_canvas_create(int32_t w, int32_t h, lv_layer_t * layer)
+{
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_XRGB8888, LV_STRIDE_AUTO);
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_init_layer(canvas, layer);
+    return canvas;
+}
+
+void lv_test_canvas_delete(lv_obj_t * canvas)
+{
+    lv_draw_buf_t * draw_buf = lv_canvas_get_draw_buf(canvas);
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+}
+#endif
+
 static void test_log_print_cb(lv_log_level_t level, const char * buf)
 {
     if(level < LV_LOG_LEVEL_WARN) {
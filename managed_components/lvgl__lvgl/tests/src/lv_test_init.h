@@ -12,6 +12,23 @@ extern "C" {
 void lv_test_init(void);
 void lv_test_deinit(void);
 
+#if LV_USE_CANVAS
+/**
+ * Create a canvas with a white XRGB8888 buffer on the active screen and init a layer to draw on it
+ * @param w         width of the canvas
+ * @param h         height of the canvas
+ * @param layer     initialized to draw on the canvas, finish it with `lv_canvas_finish_layer()`
+ * @return          the created canvas
+ */
+lv_obj_t * lv_test_canvas_create(int32_t w, int32_t h, lv_layer_t * layer);
+
+/**
+ * Delete a canvas created by `lv_test_canvas_create()` with its buffer
+ * @param canvas    pointer to the canvas
+ */
+void lv_test_canvas_delete(lv_obj_t * canvas);
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
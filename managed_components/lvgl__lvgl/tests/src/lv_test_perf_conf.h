@@ -444,6 +444,9 @@
         /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
         #define LV_OBJ_STYLE_CACHE      0
 
+        /** Cache this many resolved style properties in each `lv_obj_t`. Must be a power of 2. 0: disable */
+        #define LV_OBJ_STYLE_PROP_CACHE_CNT 32
+
         /** Add `id` field to `lv_obj_t` */
         #define LV_USE_OBJ_ID           0
 
@@ -573,6 +576,7 @@
         /* Demonstrate special features */
         #define LV_FONT_MONTSERRAT_28_COMPRESSED 0  /**< bpp = 3 */
         #define LV_FONT_DEJAVU_16_PERSIAN_HEBREW 0  /**< Hebrew, Arabic, Persian letters and all their forms */
+        #define LV_FONT_SOURCE_HAN_SANS_SC_14_CJK   1  /**< 1338 most common CJK radicals */
 
         /** Pixel perfect monospaced fonts */
         #define LV_FONT_UNSCII_8  0
@@ -600,6 +604,10 @@
         /** Enables/disables support for compressed fonts. */
         #define LV_USE_FONT_COMPRESSED 0
 
+        /** Size in bytes of the LRU cache of decoded A8 glyph bitmaps shared by the fonts in
+        *  the built-in format. 0: disable. */
+        #define LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE (32 * 1024)
+
         /** Enable drawing placeholders when glyph dsc is not found. */
         #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -630,6 +638,9 @@
         *  Depends on LV_TXT_LINE_BREAK_LONG_LEN. */
         #define LV_TXT_LINE_BREAK_LONG_POST_MIN_LEN 3
 
+        /** Size in bytes of the LRU cache of shaped texts (glyph runs). 0: disable. */
+        #define LV_TEXT_GLYPH_RUN_CACHE_SIZE (16 * 1024)
+
         /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
         *  The direction will be processed according to the Unicode Bidirectional Algorithm:
         *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -707,6 +718,7 @@
             #define LV_LABEL_TEXT_SELECTION 1   /**< Enable selecting text of the label */
             #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
             #define LV_LABEL_WAIT_CHAR_COUNT 3  /**< The count of wait chart */
+            #define LV_LABEL_LINE_CACHE 1       /**< Store the line breaks of the text to not break it again on redraw and when text is appended */
         #endif
 
         #define LV_USE_LED        1
@@ -0,0 +1,187 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#define CULLED_CNT LV_GLOBAL_DEFAULT()->draw_info.culled_task_cnt
+#define BLENDED_PX_CNT LV_GLOBAL_DEFAULT()->draw_info.blended_px_cnt
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    canvas = lv_test_canvas_create(100, 100, &layer);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_test_canvas_delete(canvas);
+}
+
+static void fill(lv_color_t color, lv_opa_t opa, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = color;
+    dsc.opa = opa;
+
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_draw_fill(&layer, &dsc, &area);
+}
+
+static void assert_px(lv_color_t color, int32_t x, int32_t y)
+{
+    lv_color32_t px = lv_canvas_get_px(canvas, x, y);
+    TEST_ASSERT_EQUAL_HEX8(color.red, px.red);
+    TEST_ASSERT_EQUAL_HEX8(color.green, px.green);
+    TEST_ASSERT_EQUAL_HEX8(color.blue, px.blue);
+}
+
+void test_fully_covered_fill_is_culled(void)
+{
+    uint32_t culled_start = CULLED_CNT;
+    uint32_t blended_start = BLENDED_PX_CNT;
+
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 10, 10, 49, 49);
+    fill(lv_color_hex(0x0000ff), LV_OPA_COVER, 0, 0, 99, 99);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(culled_start + 1, CULLED_CNT);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, BLENDED_PX_CNT - blended_start);
+    assert_px(lv_color_hex(0x0000ff), 20, 20);
+}
+
+void test_partially_covered_fill_is_clipped(void)
+{
+    uint32_t culled_start = CULLED_CNT;
+    uint32_t blended_start = BLENDED_PX_CNT;
+
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 0, 0, 99, 99);
+    fill(lv_color_hex(0x0000ff), LV_OPA_COVER, 0, 0, 99, 49);
+
+    /*Only the bottom half of the red fill remains visible*/
+    TEST_ASSERT_EQUAL_INT32(50, layer.draw_task_head->clip_area.y1);
+    TEST_ASSERT_EQUAL_INT32(99, layer.draw_task_head->clip_area.y2);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(culled_start, CULLED_CNT);
+    TEST_ASSERT_EQUAL_UINT32(100 * 100, BLENDED_PX_CNT - blended_start);
+    assert_px(lv_color_hex(0x0000ff), 50, 25);
+    assert_px(lv_color_hex(0xff0000), 50, 75);
+}
+
+void test_translucent_fill_does_not_cull(void)
+{
+    uint32_t culled_start = CULLED_CNT;
+
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 10, 10, 49, 49);
+    fill(lv_color_hex(0x0000ff), LV_OPA_50, 0, 0, 99, 99);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(culled_start, CULLED_CNT);
+    lv_color32_t px = lv_canvas_get_px(canvas, 20, 20);
+    TEST_ASSERT_NOT_EQUAL(0x00, px.red);
+}
+
+void test_opaque_image_culls_fill_below(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+    uint32_t culled_start = CULLED_CNT;
+
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 10, 10, 49, 49);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = &test_image_cogwheel_rgb565;
+    lv_area_t area = {0, 0, 99, 99};
+    lv_draw_image(&layer, &dsc, &area);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(culled_start + 1, CULLED_CNT);
+}
+
+void test_rotated_image_does_not_cull(void)
+{
+    LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+    uint32_t culled_start = CULLED_CNT;
+
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 10, 10, 49, 49);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = &test_image_cogwheel_rgb565;
+    dsc.rotation = 450;
+    lv_area_t area = {0, 0, 99, 99};
+    lv_draw_image(&layer, &dsc, &area);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(culled_start, CULLED_CNT);
+}
+
+#if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN && LV_PROFILER_DRAW
+
+static uint8_t export_buf[16 * 1024];
+static uint32_t export_len;
+
+static void export_cb(const void * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(user_data);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(export_buf), export_len + len);
+    lv_memcpy(export_buf + export_len, buf, len);
+    export_len += len;
+}
+
+static uint32_t get_u32(uint32_t ofs)
+{
+    return export_buf[ofs] | (export_buf[ofs + 1] << 8) | (export_buf[ofs + 2] << 16) | ((uint32_t)export_buf[ofs + 3] << 24);
+}
+
+void test_culled_task_closes_its_flow(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = sizeof(export_buf);
+    config.ring_buffer = true;
+    lv_profiler_builtin_init(&config);
+    lv_profiler_builtin_set_enable(true);
+
+    uint32_t culled_start = CULLED_CNT;
+    fill(lv_color_hex(0xff0000), LV_OPA_COVER, 10, 10, 49, 49);
+    fill(lv_color_hex(0x0000ff), LV_OPA_COVER, 0, 0, 99, 99);
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_EQUAL_UINT32(culled_start + 1, CULLED_CNT);
+
+    lv_profiler_builtin_set_enable(false);
+    export_len = 0;
+    lv_profiler_builtin_export(export_cb, NULL);
+    lv_profiler_builtin_uninit();
+
+    uint32_t event_cnt = get_u32(12);
+    uint32_t name_cnt = get_u32(16);
+    uint32_t ofs = 24;
+    uint32_t i;
+    for(i = 0; i < name_cnt; i++) ofs += 2 + (export_buf[ofs] | (export_buf[ofs + 1] << 8));
+
+    /*Both tasks open a flow and both close it, the culled one without being executed*/
+    uint32_t flow_begin_cnt = 0;
+    uint32_t flow_end_cnt = 0;
+    for(i = 0; i < event_cnt; i++) {
+        uint8_t tag = export_buf[ofs + i * 20 + 19];
+        if(tag == 's') flow_begin_cnt++;
+        else if(tag == 'f') flow_end_cnt++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, flow_begin_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, flow_end_cnt);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+#include "lv_test_init.h"
+
+#define DRAW_INFO LV_GLOBAL_DEFAULT()->draw_info
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    canvas = lv_test_canvas_create(100, 100, &layer);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_test_canvas_delete(canvas);
+}
+
+static bool is_in_arena(const void * p)
+{
+    const uint8_t * p8 = p;
+    return p8 >= DRAW_INFO.task_arena && p8 < DRAW_INFO.task_arena + LV_DRAW_TASK_ARENA_SIZE;
+}
+
+static void add_fill(int32_t i)
+{
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.color = lv_palette_main(i % LV_PALETTE_LAST);
+    /*Translucent so that the tasks are not culled*/
+    dsc.opa = LV_OPA_50;
+
+    lv_area_t area = {i % 90, i % 90, i % 90 + 9, i % 90 + 9};
+    lv_draw_fill(&layer, &dsc, &area);
+}
+
+void test_draw_tasks_are_allocated_from_the_arena(void)
+{
+    TEST_ASSERT_NOT_NULL(DRAW_INFO.task_arena);
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_used);
+
+    add_fill(0);
+    add_fill(1);
+    add_fill(2);
+
+    TEST_ASSERT_EQUAL_UINT32(3, DRAW_INFO.task_arena_live);
+    lv_draw_task_t * t;
+    for(t = layer.draw_task_head; t; t = t->next) {
+        TEST_ASSERT_TRUE(is_in_arena(t));
+        TEST_ASSERT_TRUE(is_in_arena(t->draw_dsc));
+    }
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*Reset as all the tasks are finished*/
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_live);
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_used);
+}
+
+void test_draw_tasks_fall_back_to_the_heap_when_the_arena_is_full(void)
+{
+    uint32_t task_size = LV_ALIGN_UP(LV_ALIGN_UP(sizeof(lv_draw_task_t), 8) + sizeof(lv_draw_fill_dsc_t), 8);
+    uint32_t arena_task_cnt = LV_DRAW_TASK_ARENA_SIZE / task_size;
+
+    uint32_t i;
+    for(i = 0; i < arena_task_cnt + 5; i++) {
+        add_fill(i);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(arena_task_cnt, DRAW_INFO.task_arena_live);
+
+    uint32_t heap_task_cnt = 0;
+    lv_draw_task_t * t;
+    for(t = layer.draw_task_head; t; t = t->next) {
+        if(!is_in_arena(t)) heap_task_cnt++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, heap_task_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_live);
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_used);
+}
+
+void test_draw_task_arena_is_reset_after_refresh(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Arena");
+
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_live);
+    TEST_ASSERT_EQUAL_UINT32(0, DRAW_INFO.task_arena_used);
+}
+
+#endif
@@ -12,6 +12,7 @@ void setUp(void)
 void tearDown(void)
 {
     /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
 }
 
 void test_tiny_ttf_rendering_test(void)
@@ -114,4 +115,80 @@ void test_tiny_ttf_gpos(void)
 #endif
 }
 
+#if LV_USE_TINY_TTF && LV_TINY_TTF_BITMAP_CACHE_SIZE
+static lv_draw_buf_t * take_snapshot(void)
+{
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    return snapshot;
+}
+#endif
+
+void test_tiny_ttf_shared_bitmap_cache(void)
+{
+#if LV_USE_TINY_TTF && LV_TINY_TTF_BITMAP_CACHE_SIZE
+    extern const uint8_t test_ubuntu_font[];
+    extern size_t test_ubuntu_font_size;
+    TEST_ASSERT_NULL(LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache);
+
+    /*The sizes created from the same data share one cache*/
+    lv_font_t * font_20 = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 20);
+    lv_font_t * font_30 = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 30);
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache;
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL_UINT32(LV_TINY_TTF_BITMAP_CACHE_SIZE, lv_cache_get_max_size(cache, NULL));
+
+    lv_obj_t * label_20 = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label_20, font_20, 0);
+    lv_label_set_text(label_20, "Hello world");
+    lv_obj_t * label_30 = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label_30, font_30, 0);
+    lv_label_set_text(label_30, "Hello world");
+    lv_obj_set_y(label_30, 40);
+    lv_draw_buf_t * cached = take_snapshot();
+    size_t size_both = lv_cache_get_size(cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, size_both);
+
+    /*Glyphs larger than the whole cache are rendered into the label's buffer*/
+    lv_cache_drop_all(cache, NULL);
+    lv_cache_set_max_size(cache, 1, NULL);
+    lv_draw_buf_t * uncached = take_snapshot();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_size(cache, NULL));
+    TEST_ASSERT_EQUAL_MEMORY(cached->data, uncached->data, cached->data_size);
+    lv_cache_set_max_size(cache, LV_TINY_TTF_BITMAP_CACHE_SIZE, NULL);
+    lv_draw_buf_destroy(uncached);
+    lv_draw_buf_destroy(cached);
+
+    /*Only the bitmaps of the deleted font are dropped*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(size_both, lv_cache_get_size(cache, NULL));
+    lv_obj_delete(label_30);
+    lv_tiny_ttf_destroy(font_30);
+    size_t size_20 = lv_cache_get_size(cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, size_20);
+    TEST_ASSERT_LESS_THAN(size_both, size_20);
+
+    /*The bitmaps of the old size are dropped on resize*/
+    lv_tiny_ttf_set_size(font_20, 24);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_cache_get_size(cache, NULL));
+    lv_obj_report_style_change(NULL);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN(size_20, lv_cache_get_size(cache, NULL));
+
+    /*The bitmaps stay while an other font of the same data and size uses them*/
+    lv_font_t * font_24 = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 24);
+    size_t size_24 = lv_cache_get_size(cache, NULL);
+    lv_tiny_ttf_destroy(font_24);
+    TEST_ASSERT_EQUAL_UINT32(size_24, lv_cache_get_size(cache, NULL));
+
+    /*The cache is freed with the last font*/
+    lv_obj_delete(label_20);
+    lv_tiny_ttf_destroy(font_20);
+    TEST_ASSERT_NULL(LV_GLOBAL_DEFAULT()->tiny_ttf_bitmap_cache);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
@@ -263,4 +263,163 @@ void test_anim_vsync_mode(void)
     lv_anim_delete(&var, exec_cb);
 }
 
+static int32_t delete_vars[16];
+
+static void delete_other_completed_cb(lv_anim_t * a)
+{
+    /*Delete an animation which is processed before or after this one*/
+    int32_t * var = lv_anim_get_user_data(a);
+    lv_anim_delete(var, exec_cb);
+}
+
+void test_anim_delete_in_callback(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+
+    uint32_t i;
+    for(i = 0; i < 16; i++) {
+        delete_vars[i] = -1;
+        lv_anim_set_var(&a, &delete_vars[i]);
+        /*The short ones delete a long one when they are completed*/
+        if(i % 4 == 0) {
+            lv_anim_set_duration(&a, 50);
+            lv_anim_set_user_data(&a, &delete_vars[15 - i]);
+            lv_anim_set_completed_cb(&a, delete_other_completed_cb);
+        }
+        else {
+            lv_anim_set_duration(&a, 200);
+            lv_anim_set_user_data(&a, NULL);
+            lv_anim_set_completed_cb(&a, NULL);
+        }
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL(16, lv_anim_count_running());
+
+    lv_test_wait(60);
+    /*4 short animations are completed and deleted 4 long ones*/
+    TEST_ASSERT_EQUAL(8, lv_anim_count_running());
+
+    /*All the remaining ones are still updated in every round*/
+    lv_test_wait(40);
+    for(i = 0; i < 16; i++) {
+        if(i % 4 == 0) TEST_ASSERT_EQUAL(100, delete_vars[i]);
+        else if((15 - i) % 4 == 0) TEST_ASSERT_LESS_THAN(100, delete_vars[i]);
+        else TEST_ASSERT_EQUAL(50, delete_vars[i]);
+    }
+
+    lv_test_wait(200);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    for(i = 0; i < 16; i++) {
+        if((15 - i) % 4 != 0) TEST_ASSERT_EQUAL(100, delete_vars[i]);
+    }
+}
+
+static lv_anim_t * retarget_anim;
+
+static void retarget_exec_cb(void * var, int32_t v)
+{
+    exec_cb(var, v);
+
+    /*Change an animation which is applied after this one in the same round*/
+    if(retarget_anim) {
+        lv_anim_set_values(retarget_anim, 0, 1000);
+        retarget_anim = NULL;
+    }
+}
+
+void test_anim_changed_in_callback_uses_the_new_values(void)
+{
+    int32_t var_a = 0;
+    int32_t var_b = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_var(&a, &var_b);
+    lv_anim_t * b = lv_anim_start(&a);
+
+    /*Started later so it's applied first*/
+    lv_anim_set_exec_cb(&a, retarget_exec_cb);
+    lv_anim_set_var(&a, &var_a);
+    lv_anim_start(&a);
+
+    lv_tick_inc(10);
+    lv_anim_refr_now();
+    TEST_ASSERT_GREATER_THAN(0, var_a);
+    TEST_ASSERT_EQUAL(var_a, var_b);
+
+    /*Both have the same time, so `b` has to be at about 10 times the value of `a` in the same round*/
+    retarget_anim = b;
+    lv_tick_inc(10);
+    lv_anim_refr_now();
+    TEST_ASSERT_NULL(retarget_anim);
+    TEST_ASSERT_GREATER_OR_EQUAL(var_a * 10, var_b);
+    TEST_ASSERT_LESS_THAN((var_a + 1) * 10, var_b);
+}
+
+void test_anim_get_returns_latest(void)
+{
+    int32_t var;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &var);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_set_delay(&a, 100);
+    lv_anim_t * a1 = lv_anim_start(&a);
+    lv_anim_t * a2 = lv_anim_start(&a);
+
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+    TEST_ASSERT_EQUAL_PTR(a2, lv_anim_get(&var, exec_cb));
+
+    lv_anim_delete_all();
+    TEST_ASSERT_NULL(lv_anim_get(&var, exec_cb));
+    TEST_ASSERT_NOT_EQUAL(a1, a2);
+}
+
+static int32_t * order_log[4];
+static uint32_t order_log_cnt;
+
+static void order_exec_cb(void * var, int32_t v)
+{
+    exec_cb(var, v);
+    if(order_log_cnt < 4) order_log[order_log_cnt++] = var;
+}
+
+void test_anim_order_is_kept_after_delete(void)
+{
+    int32_t var_old = 0;
+    int32_t var_mid = 0;
+    int32_t var_new = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_duration(&a, 100);
+    lv_anim_set_exec_cb(&a, order_exec_cb);
+    lv_anim_set_var(&a, &var_old);
+    lv_anim_start(&a);
+    lv_anim_set_var(&a, &var_mid);
+    lv_anim_start(&a);
+    lv_anim_set_var(&a, &var_new);
+    lv_anim_start(&a);
+
+    /*Delete the oldest one, the others still have to run from the newest to the oldest*/
+    lv_anim_delete(&var_old, NULL);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    order_log_cnt = 0;
+    lv_tick_inc(10);
+    lv_anim_refr_now();
+    TEST_ASSERT_EQUAL(2, order_log_cnt);
+    TEST_ASSERT_EQUAL_PTR(&var_new, order_log[0]);
+    TEST_ASSERT_EQUAL_PTR(&var_mid, order_log[1]);
+}
+
 #endif
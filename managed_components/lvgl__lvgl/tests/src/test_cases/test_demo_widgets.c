@@ -5,10 +5,60 @@
 
 #include "unity/unity.h"
 
+#if LV_USE_DEMO_WIDGETS && LV_USE_SYSMON_FRAME_LOG
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+static lv_obj_tree_walk_res_t count_prop_caches_cb(lv_obj_t * obj, void * user_data)
+{
+    uint32_t * cnt = user_data;
+    if(obj->style_prop_cache) (*cnt)++;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+#endif
+
+/*Redraw the whole widgets demo a few times and report how many style properties were
+ *resolved from the style lists (`get_prop_core`) per frame and what the property caches cost*/
+static void style_prop_lookup_bench(void)
+{
+    const uint32_t frame_cnt = 10;
+
+    lv_refr_now(NULL);
+
+    uint32_t get_start = LV_GLOBAL_DEFAULT()->style_prop_get_cnt;
+    uint32_t lookup_start = LV_GLOBAL_DEFAULT()->style_prop_lookup_cnt;
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+    uint32_t get_cnt = (LV_GLOBAL_DEFAULT()->style_prop_get_cnt - get_start) / frame_cnt;
+    uint32_t lookup_cnt = (LV_GLOBAL_DEFAULT()->style_prop_lookup_cnt - lookup_start) / frame_cnt;
+
+    uint32_t obj_cnt = 0;
+    uint32_t cache_size = 0;
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    lv_obj_tree_walk(NULL, count_prop_caches_cb, &obj_cnt);
+    cache_size = sizeof(lv_obj_style_prop_cache_t);
+#endif
+
+    TEST_PRINTF("LV_OBJ_STYLE_PROP_CACHE_CNT %d: %" LV_PRIu32 " style prop gets/frame, %" LV_PRIu32
+                " style list lookups/frame, %" LV_PRIu32 " caches of %" LV_PRIu32 " bytes",
+                LV_OBJ_STYLE_PROP_CACHE_CNT, get_cnt, lookup_cnt, obj_cnt, cache_size);
+
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    TEST_ASSERT_LESS_THAN_UINT32(get_cnt, lookup_cnt);
+#endif
+}
+
+#endif
+
 void test_demo_widgets(void)
 {
 #if LV_USE_DEMO_WIDGETS
     lv_demo_widgets();
+#if LV_USE_SYSMON_FRAME_LOG
+    style_prop_lookup_bench();
+#endif
 #endif
 }
 
@@ -177,4 +177,66 @@ void test_event_remove_event_cb(void)
     lv_obj_delete(obj);
 }
 
+static uint32_t event_code_mask_cnt;
+
+static void event_code_mask_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    event_code_mask_cnt++;
+}
+
+static void event_code_mask_remove_cb(lv_event_t * e)
+{
+    event_code_mask_cnt++;
+    lv_obj_remove_event_cb(lv_event_get_current_target(e), event_code_mask_remove_cb);
+}
+
+void test_event_code_mask(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+
+    lv_obj_add_event_cb(obj, event_code_mask_cb, LV_EVENT_CLICKED, NULL);
+    event_code_mask_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_PRESSED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, event_code_mask_cnt);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, event_code_mask_cnt);
+
+    /*LV_EVENT_ALL matches every code until it's removed*/
+    lv_event_dsc_t * dsc_all = lv_obj_add_event_cb(obj, event_code_mask_cb, LV_EVENT_ALL, NULL);
+    event_code_mask_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_PRESSED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, event_code_mask_cnt);
+    lv_obj_remove_event_dsc(obj, dsc_all);
+    event_code_mask_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_PRESSED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, event_code_mask_cnt);
+
+    /*Preprocessed callbacks are called only once*/
+    lv_obj_add_event_cb(obj, event_code_mask_cb, LV_EVENT_PRESSED | LV_EVENT_PREPROCESS, NULL);
+    lv_obj_send_event(obj, LV_EVENT_PRESSED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, event_code_mask_cnt);
+
+    /*Registered codes share a bit but still need an exact match*/
+    uint32_t id1 = lv_event_register_id();
+    uint32_t id2 = lv_event_register_id();
+    lv_obj_add_event_cb(obj, event_code_mask_cb, id1, NULL);
+    event_code_mask_cnt = 0;
+    lv_obj_send_event(obj, id2, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, event_code_mask_cnt);
+    lv_obj_send_event(obj, id1, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, event_code_mask_cnt);
+
+    /*Removing a callback from its own event*/
+    lv_obj_add_event_cb(obj, event_code_mask_remove_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    event_code_mask_cnt = 0;
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_send_event(obj, LV_EVENT_VALUE_CHANGED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, event_code_mask_cnt);
+    lv_obj_send_event(obj, LV_EVENT_CLICKED, NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, event_code_mask_cnt);
+
+    lv_obj_delete(obj);
+}
+
 #endif
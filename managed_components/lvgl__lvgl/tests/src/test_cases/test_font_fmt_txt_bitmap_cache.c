@@ -0,0 +1,170 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE
+
+#define bitmap_cache LV_GLOBAL_DEFAULT()->font_fmt_txt_bitmap_cache
+
+static lv_draw_buf_t * draw_buf;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    draw_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    lv_font_fmt_txt_bitmap_cache_drop(NULL);
+    lv_cache_reset_stats(bitmap_cache);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static const lv_draw_buf_t * get_bitmap(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * g)
+{
+    lv_memzero(g, sizeof(*g));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, g, letter, 0));
+    lv_draw_buf_t * buf = lv_draw_buf_reshape(draw_buf, LV_COLOR_FORMAT_A8, g->box_w, g->box_h, LV_STRIDE_AUTO);
+    TEST_ASSERT_NOT_NULL(buf);
+    return lv_font_get_glyph_bitmap(g, buf);
+}
+
+static void assert_same_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    const lv_draw_buf_t * cached = get_bitmap(font, letter, &g);
+    TEST_ASSERT_NOT_NULL(cached);
+    TEST_ASSERT_NOT_NULL(g.entry);
+    TEST_ASSERT_TRUE(cached != draw_buf);
+
+    /*Decode it again without the cache*/
+    lv_cache_t * cache = bitmap_cache;
+    bitmap_cache = NULL;
+    lv_font_glyph_dsc_t g_ref;
+    const lv_draw_buf_t * decoded = get_bitmap(font, letter, &g_ref);
+    bitmap_cache = cache;
+    TEST_ASSERT_TRUE(decoded == draw_buf);
+    TEST_ASSERT_NULL(g_ref.entry);
+
+    TEST_ASSERT_EQUAL_UINT32(decoded->header.w, cached->header.w);
+    TEST_ASSERT_EQUAL_UINT32(decoded->header.h, cached->header.h);
+    TEST_ASSERT_EQUAL_UINT32(decoded->header.stride, cached->header.stride);
+    /*Only the glyph is written, not the padding at the end of the lines*/
+    uint32_t y;
+    for(y = 0; y < cached->header.h; y++) {
+        uint32_t ofs = y * cached->header.stride;
+        TEST_ASSERT_EQUAL_MEMORY(decoded->data + ofs, cached->data + ofs, cached->header.w);
+    }
+
+    lv_font_glyph_release_draw_data(&g);
+    TEST_ASSERT_NULL(g.entry);
+}
+
+void test_bitmap_cache_matches_the_decoded_bitmaps(void)
+{
+    /*4 bpp*/
+    assert_same_bitmap(&lv_font_montserrat_14, 'A');
+    assert_same_bitmap(&lv_font_montserrat_14, 'g');
+    assert_same_bitmap(&lv_font_source_han_sans_sc_14_cjk, 0x4F60); /*你*/
+    /*Compressed*/
+    assert_same_bitmap(&lv_font_montserrat_28_compressed, 'W');
+    /*1 bpp*/
+    assert_same_bitmap(&lv_font_unscii_8, 'x');
+}
+
+void test_bitmap_cache_hits_the_second_time(void)
+{
+    lv_font_glyph_dsc_t g;
+    const lv_draw_buf_t * first = get_bitmap(&lv_font_montserrat_14, 'A', &g);
+    lv_font_glyph_release_draw_data(&g);
+    TEST_ASSERT_EQUAL_INT32(0, lv_cache_get_hit_rate(bitmap_cache));
+
+    const lv_draw_buf_t * second = get_bitmap(&lv_font_montserrat_14, 'A', &g);
+    lv_font_glyph_release_draw_data(&g);
+    TEST_ASSERT_TRUE(first == second);
+    TEST_ASSERT_EQUAL_INT32(50, lv_cache_get_hit_rate(bitmap_cache));
+
+    /*Empty glyphs are not cached*/
+    size_t size = lv_cache_get_size(bitmap_cache, NULL);
+    TEST_ASSERT_NULL(get_bitmap(&lv_font_montserrat_14, ' ', &g));
+    TEST_ASSERT_NULL(g.entry);
+    TEST_ASSERT_EQUAL(size, lv_cache_get_size(bitmap_cache, NULL));
+}
+
+void test_bitmap_cache_drop_font(void)
+{
+    lv_font_glyph_dsc_t g;
+    get_bitmap(&lv_font_montserrat_14, 'A', &g);
+    lv_font_glyph_release_draw_data(&g);
+    size_t size = lv_cache_get_size(bitmap_cache, NULL);
+    TEST_ASSERT_NOT_EQUAL(0, size);
+
+    get_bitmap(&lv_font_source_han_sans_sc_14_cjk, 0x4F60, &g);
+    lv_font_glyph_release_draw_data(&g);
+    TEST_ASSERT_GREATER_THAN(size, lv_cache_get_size(bitmap_cache, NULL));
+
+    /*Only the bitmaps of the given font are removed*/
+    lv_font_fmt_txt_bitmap_cache_drop(&lv_font_source_han_sans_sc_14_cjk);
+    TEST_ASSERT_EQUAL(size, lv_cache_get_size(bitmap_cache, NULL));
+
+    lv_font_t * font = lv_binfont_create("A:src/test_assets/test_font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    get_bitmap(font, 'A', &g);
+    TEST_ASSERT_NOT_NULL(g.entry);
+    lv_font_glyph_release_draw_data(&g);
+    TEST_ASSERT_GREATER_THAN(size, lv_cache_get_size(bitmap_cache, NULL));
+
+    lv_binfont_destroy(font);
+    TEST_ASSERT_EQUAL(size, lv_cache_get_size(bitmap_cache, NULL));
+}
+
+void test_bitmap_cache_label(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    lv_label_set_text(label, "你好，桌面助手");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_INT32(0, lv_cache_get_hit_rate(bitmap_cache));
+
+    /*Every glyph is found in the cache*/
+    lv_cache_reset_stats(bitmap_cache);
+    lv_obj_invalidate(label);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_INT32(100, lv_cache_get_hit_rate(bitmap_cache));
+
+    lv_obj_delete(label);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_bitmap_cache_matches_the_decoded_bitmaps(void)
+{
+}
+
+void test_bitmap_cache_hits_the_second_time(void)
+{
+}
+
+void test_bitmap_cache_drop_font(void)
+{
+}
+
+void test_bitmap_cache_label(void)
+{
+}
+
+#endif /*LV_FONT_FMT_TXT_BITMAP_CACHE_SIZE*/
+
+#endif
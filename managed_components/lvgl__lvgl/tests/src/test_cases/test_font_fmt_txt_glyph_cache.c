@@ -0,0 +1,111 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+/*The same font without the glyph LUT and cache, i.e. using only the cmaps*/
+static lv_font_t ref_font;
+static lv_font_fmt_txt_dsc_t ref_dsc;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    ref_font = lv_font_source_han_sans_sc_14_cjk;
+    ref_dsc = *(const lv_font_fmt_txt_dsc_t *)ref_font.dsc;
+    ref_dsc.glyph_lut = NULL;
+    ref_dsc.glyph_lut_len = 0;
+    ref_dsc.glyph_cache = NULL;
+    ref_font.dsc = &ref_dsc;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static uint32_t get_gid(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc_fmt_txt(font, &g, letter, 0)) return 0;
+    return g.gid.index;
+}
+
+void test_glyph_lut_matches_the_cmaps(void)
+{
+    const lv_font_t * font = &lv_font_source_han_sans_sc_14_cjk;
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    TEST_ASSERT_NOT_NULL(dsc->glyph_lut);
+
+    /*The second round is served from the cache*/
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t found = 0;
+        uint32_t letter;
+        for(letter = 1; letter < 0x10000; letter++) {
+            /*It's drawn as a space*/
+            if(letter == '\t') continue;
+
+            uint32_t gid = get_gid(&ref_font, letter);
+            TEST_ASSERT_EQUAL_UINT32(gid, get_gid(font, letter));
+            if(gid) found++;
+        }
+        TEST_ASSERT_EQUAL_UINT32(dsc->glyph_lut_len, found);
+    }
+}
+
+void test_glyph_cache_stores_the_last_letters(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    const lv_font_t * font = &lv_font_source_han_sans_sc_14_cjk;
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    TEST_ASSERT_NOT_NULL(dsc->glyph_cache);
+
+    uint32_t letter = 0x4F60; /*你*/
+    uint32_t * entry = &dsc->glyph_cache->entries[letter & (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE - 1)];
+    uint32_t tag = (letter / LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1) << 16;
+
+    uint32_t gid = get_gid(font, letter);
+    TEST_ASSERT_NOT_EQUAL_UINT32(0, gid);
+    TEST_ASSERT_EQUAL_HEX32(tag | gid, *entry);
+
+    /*A letter with the same index evicts it*/
+    uint32_t other = letter + LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE;
+    get_gid(font, other);
+    TEST_ASSERT_EQUAL_HEX32(((other / LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1) << 16) | get_gid(&ref_font, other), *entry);
+
+    /*Missing letters are cached too*/
+    letter = 0x1F600;
+    entry = &dsc->glyph_cache->entries[letter & (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE - 1)];
+    TEST_ASSERT_EQUAL_UINT32(0, get_gid(font, letter));
+    TEST_ASSERT_EQUAL_HEX32((letter / LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE + 1) << 16, *entry);
+
+    /*Invalid letters are not*/
+    letter = 0x110000;
+    entry = &dsc->glyph_cache->entries[letter & (LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE - 1)];
+    *entry = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, get_gid(font, letter));
+    TEST_ASSERT_EQUAL_HEX32(0, *entry);
+#endif
+}
+
+void test_glyph_cache_of_binfont(void)
+{
+    lv_font_t * font = lv_binfont_create("A:src/test_assets/test_font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+#if LV_FONT_FMT_TXT_GLYPH_CACHE_SIZE
+    TEST_ASSERT_NOT_NULL(dsc->glyph_cache);
+#else
+    TEST_ASSERT_NULL(dsc->glyph_cache);
+#endif
+
+    uint32_t gid = get_gid(font, 'A');
+    TEST_ASSERT_NOT_EQUAL_UINT32(0, gid);
+    TEST_ASSERT_EQUAL_UINT32(gid, get_gid(font, 'A'));
+
+    lv_binfont_destroy(font);
+}
+
+#endif
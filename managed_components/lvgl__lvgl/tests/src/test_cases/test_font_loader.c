@@ -28,6 +28,7 @@ static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
 void test_font_loader_with_cache(void);
 void test_font_loader_no_cache(void);
 void test_font_loader_from_buffer(void);
+void test_font_loader_invalid_glyph_id(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -145,6 +146,22 @@ void test_font_loader_from_buffer(void)
     common();
 }
 
+void test_font_loader_invalid_glyph_id(void)
+{
+    static uint8_t buf[sizeof(test_font_1_buf)];
+    lv_memcpy(buf, test_font_1_buf, sizeof(buf));
+
+    /*The "head" section is followed by the "cmap" section: length, label, subtable count
+     *and the 16 bytes long subtables with `glyph_id_start` at offset 10*/
+    uint32_t head_len = buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((uint32_t)buf[3] << 24);
+    uint8_t * glyph_id_start = &buf[head_len + 12 + 10];
+    glyph_id_start[0] = 0xff;
+    glyph_id_start[1] = 0xff;
+
+    /*The font would index the glyph descriptors out of bounds*/
+    TEST_ASSERT_NULL(lv_binfont_create_from_buffer(buf, sizeof(buf)));
+}
+
 void test_font_loader_reload(void)
 {
     /*Reload a font which is being used by a label*/
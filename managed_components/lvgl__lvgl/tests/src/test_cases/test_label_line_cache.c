@@ -0,0 +1,343 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_LABEL_LINE_CACHE
+
+static const char * texts[] = {
+    "",
+    "Hello",
+    "Hello\n",
+    "\n\nTwo empty lines",
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Ut auctor sed dui interdum convallis.",
+    "Averyveryveryveryveryverylongwordwhichdoesnotfitintoasingleline and some more text\nwith a\r\nnew line",
+    "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，请直接告诉我。",
+};
+
+static lv_text_lines_t lines;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_memzero(&lines, sizeof(lines));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_text_lines_reset(&lines);
+    lv_obj_clean(lv_screen_active());
+}
+
+static void init_attributes(lv_text_attributes_t * attributes, int32_t max_width)
+{
+    lv_memzero(attributes, sizeof(*attributes));
+    attributes->letter_space = 1;
+    attributes->line_space = 3;
+    attributes->max_width = max_width;
+}
+
+static void assert_same_size(const char * text, const lv_font_t * font, int32_t max_width)
+{
+    lv_text_attributes_t attributes;
+    init_attributes(&attributes, max_width);
+
+    lv_point_t ref;
+    lv_text_get_size_attributes(&ref, text, font, &attributes);
+
+    lv_point_t size;
+    lv_text_lines_get_size(&size, &lines, text, font, &attributes);
+    TEST_ASSERT_EQUAL_INT32(ref.x, size.x);
+    TEST_ASSERT_EQUAL_INT32(ref.y, size.y);
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(text), lines.text_len);
+
+    /*The lines are the same as the ones found by `lv_text_get_next_line`*/
+    uint32_t line_start = 0;
+    uint32_t i;
+    for(i = 0; i < lines.line_cnt; i++) {
+        TEST_ASSERT_EQUAL_UINT32(line_start, lines.lines[i].start);
+        uint32_t line_end = line_start + lv_text_get_next_line(&text[line_start], LV_TEXT_LEN_MAX, font, NULL,
+                                                               &attributes);
+        TEST_ASSERT_EQUAL_UINT32(line_end, lv_text_lines_get_end(&lines, i));
+        line_start = line_end;
+    }
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(text), line_start);
+}
+
+void test_label_line_cache_size(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_source_han_sans_sc_14_cjk};
+    const int32_t widths[] = {LV_COORD_MAX, 200, 50, 1};
+
+    uint32_t f;
+    for(f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        uint32_t w;
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            uint32_t t;
+            for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+                assert_same_size(texts[t], fonts[f], widths[w]);
+                /*And again with the stored lines*/
+                assert_same_size(texts[t], fonts[f], widths[w]);
+            }
+        }
+    }
+}
+
+void test_label_line_cache_append(void)
+{
+    const lv_font_t * font = &lv_font_source_han_sans_sc_14_cjk;
+    char buf[512] = "";
+    lv_text_attributes_t attributes;
+    init_attributes(&attributes, 100);
+
+    /*Add the text piece by piece like a streamed reply (3 letters of 3 bytes each time)*/
+    const char * text = texts[6];
+    uint32_t len = lv_strlen(text);
+    uint32_t i;
+    for(i = 9; i <= len; i += 9) {
+        lv_strncpy(buf, text, i);
+        buf[i] = '\0';
+        assert_same_size(buf, font, 100);
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(4, lines.line_cnt);
+
+    /*Only the last 2 lines are broken again: mark the first line to see it's kept*/
+    uint32_t line_cnt = lines.line_cnt;
+    lines.lines[0].width = 1000;
+    lv_strcat(buf, "好的");
+    lv_point_t size;
+    lv_text_lines_get_size(&size, &lines, buf, font, &attributes);
+    TEST_ASSERT_EQUAL_INT32(1000, size.x);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(line_cnt, lines.line_cnt);
+
+    /*Changing the beginning of the text breaks all the lines again*/
+    buf[0] = 'A';
+    assert_same_size(buf, font, 100);
+    TEST_ASSERT_NOT_EQUAL_INT32(1000, lines.lines[0].width);
+}
+
+void test_label_line_cache_invalidate(void)
+{
+    const char * text = texts[4];
+    lv_text_attributes_t attributes;
+    init_attributes(&attributes, 100);
+
+    lv_point_t size;
+    lv_text_lines_get_size(&size, &lines, text, &lv_font_montserrat_14, &attributes);
+    TEST_ASSERT_TRUE(lv_text_lines_is_valid(&lines, text, LV_TEXT_LEN_MAX, &lv_font_montserrat_14, &attributes));
+    TEST_ASSERT_FALSE(lv_text_lines_is_valid(&lines, text, 10, &lv_font_montserrat_14, &attributes));
+    TEST_ASSERT_FALSE(lv_text_lines_is_valid(&lines, texts[5], LV_TEXT_LEN_MAX, &lv_font_montserrat_14, &attributes));
+    TEST_ASSERT_FALSE(lv_text_lines_is_valid(&lines, text, LV_TEXT_LEN_MAX, &lv_font_montserrat_24, &attributes));
+
+    /*A new width, font or letter space breaks the lines again*/
+    lines.lines[0].width = 1000;
+    assert_same_size(text, &lv_font_montserrat_14, 150);
+    lines.lines[0].width = 1000;
+    assert_same_size(text, &lv_font_montserrat_24, 150);
+    lines.lines[0].width = 1000;
+    attributes.letter_space = 5;
+    lv_text_lines_get_size(&size, &lines, text, &lv_font_montserrat_24, &attributes);
+    TEST_ASSERT_NOT_EQUAL_INT32(1000, size.x);
+
+    /*The lines are used for any width with LV_TEXT_FLAG_EXPAND*/
+    attributes.text_flags = LV_TEXT_FLAG_EXPAND;
+    lv_text_lines_get_size(&size, &lines, text, &lv_font_montserrat_24, &attributes);
+    attributes.max_width = 10;
+    TEST_ASSERT_TRUE(lv_text_lines_is_valid(&lines, text, LV_TEXT_LEN_MAX, &lv_font_montserrat_24, &attributes));
+    TEST_ASSERT_EQUAL_UINT32(1, lines.line_cnt);
+
+    lv_text_lines_reset(&lines);
+    TEST_ASSERT_FALSE(lv_text_lines_is_valid(&lines, text, LV_TEXT_LEN_MAX, &lv_font_montserrat_24, &attributes));
+    TEST_ASSERT_NULL(lines.lines);
+}
+
+static lv_draw_buf_t * take_snapshot(void)
+{
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    return snapshot;
+}
+
+void test_label_line_cache_draw(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_obj_set_width(label, 120);
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_line_space(label, 4, 0);
+    lv_label_set_text(label, texts[6]);
+    lv_obj_set_y(label, -20); /*Start from a clipped line*/
+
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "\nLorem ipsum dolor sit amet, consectetur adipiscing elit.");
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_THAN_UINT32(4, label_p->lines.line_cnt);
+    lv_draw_buf_t * with_lines = take_snapshot();
+
+    /*Draw again breaking the lines while drawing*/
+    lv_text_lines_reset(&label_p->lines);
+    lv_draw_buf_t * without_lines = take_snapshot();
+
+    TEST_ASSERT_EQUAL_UINT32(with_lines->data_size, without_lines->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(without_lines->data, with_lines->data, with_lines->data_size);
+
+    lv_draw_buf_destroy(with_lines);
+    lv_draw_buf_destroy(without_lines);
+}
+
+void test_label_line_cache_style_change(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_obj_set_width(label, 120);
+    lv_label_set_text(label, texts[4]);
+    TEST_ASSERT_GREATER_THAN_UINT32(1, label_p->lines.line_cnt);
+
+    /*Setting the same text again keeps the lines*/
+    label_p->lines.lines[0].width = 1000;
+    lv_label_set_text(label, texts[4]);
+    TEST_ASSERT_EQUAL_INT32(1000, label_p->lines.lines[0].width);
+
+    /*The glyphs of a font might be changed and reported as a style change*/
+    lv_obj_report_style_change(NULL);
+    TEST_ASSERT_NOT_EQUAL_INT32(1000, label_p->lines.lines[0].width);
+}
+
+/*A fallback font which gets glyphs only later, like a font merged from the glyphs sent with a streamed text*/
+static bool growing_font_has_glyphs;
+
+static bool growing_font_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter,
+                                       uint32_t letter_next)
+{
+    LV_UNUSED(font);
+    LV_UNUSED(letter_next);
+    if(!growing_font_has_glyphs || letter < 0x80) return false;
+
+    dsc->adv_w = 14;
+    dsc->box_w = 0;
+    dsc->box_h = 0;
+    dsc->format = LV_FONT_GLYPH_FORMAT_NONE;
+    return true;
+}
+
+void test_label_line_cache_font_glyphs_added(void)
+{
+    lv_font_t growing_font = {
+        .get_glyph_dsc = growing_font_get_glyph_dsc,
+        .line_height = lv_font_montserrat_14.line_height,
+        .base_line = lv_font_montserrat_14.base_line,
+    };
+    lv_font_t font = lv_font_montserrat_14;
+    font.fallback = &growing_font;
+    growing_font_has_glyphs = false;
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_obj_set_style_text_font(label, &font, 0);
+    lv_obj_set_width(label, 120);
+    lv_label_set_text(label, texts[6]);
+    lv_obj_update_layout(label);
+    int32_t placeholder_width = label_p->lines.lines[0].width;
+    uint32_t placeholder_line_cnt = label_p->lines.line_cnt;
+
+    /*The glyphs arrive after the text and the font reports it as a style change*/
+    growing_font_has_glyphs = true;
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+    lv_text_glyph_run_cache_drop();
+#endif
+    lv_obj_report_style_change(NULL);
+
+    /*The lines are broken again with the new glyph widths*/
+    lv_text_attributes_t attributes;
+    lv_memzero(&attributes, sizeof(attributes));
+    attributes.max_width = 120;
+    lv_point_t ref;
+    lv_text_lines_get_size(&ref, &lines, texts[6], &font, &attributes);
+    TEST_ASSERT_EQUAL_INT32(ref.x, label_p->text_size.x);
+    TEST_ASSERT_EQUAL_INT32(ref.y, label_p->text_size.y);
+    TEST_ASSERT_NOT_EQUAL_INT32(placeholder_width, label_p->lines.lines[0].width);
+    TEST_ASSERT_GREATER_THAN_UINT32(placeholder_line_cnt, label_p->lines.line_cnt);
+
+    TEST_ASSERT_EQUAL_UINT32(lines.line_cnt, label_p->lines.line_cnt);
+    uint32_t i;
+    for(i = 0; i < lines.line_cnt; i++) {
+        TEST_ASSERT_EQUAL_UINT32(lines.lines[i].start, label_p->lines.lines[i].start);
+        TEST_ASSERT_EQUAL_INT32(lines.lines[i].width, label_p->lines.lines[i].width);
+    }
+
+    lv_obj_delete(label);
+}
+
+void test_label_line_cache_append_invalidates_new_lines(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_t * label_p = (lv_label_t *)label;
+    lv_obj_set_pos(label, 10, 10);
+    lv_obj_set_size(label, 120, 200);
+    lv_label_set_text(label, texts[4]);
+    lv_refr_now(NULL);
+    uint32_t line_cnt = label_p->lines.line_cnt;
+    TEST_ASSERT_GREATER_THAN_UINT32(3, line_cnt);
+
+    /*Only the last 2 lines are redrawn*/
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, " Proin");
+    TEST_ASSERT_EQUAL_UINT32(line_cnt - 2, label_p->lines.reused_cnt);
+    TEST_ASSERT_EQUAL_INT32(1, disp->inv_p);
+    int32_t line_height = lv_font_get_line_height(lv_obj_get_style_text_font(label, 0));
+    int32_t ext_size = lv_obj_get_ext_draw_size(label);
+    TEST_ASSERT_EQUAL_INT32(10 + (int32_t)(line_cnt - 2) * line_height - ext_size, disp->inv_areas[0].y1);
+    TEST_ASSERT_EQUAL_INT32(label->coords.y2 + ext_size, disp->inv_areas[0].y2);
+    lv_refr_now(NULL);
+
+    /*Inserting into the middle redraws the whole label*/
+    lv_label_ins_text(label, 5, "x");
+    TEST_ASSERT_EQUAL_UINT32(0, label_p->lines.reused_cnt);
+    TEST_ASSERT_EQUAL_INT32(1, disp->inv_p);
+    TEST_ASSERT_EQUAL_INT32(label->coords.y1 - ext_size, disp->inv_areas[0].y1);
+    lv_refr_now(NULL);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_label_line_cache_size(void)
+{
+}
+
+void test_label_line_cache_append(void)
+{
+}
+
+void test_label_line_cache_invalidate(void)
+{
+}
+
+void test_label_line_cache_draw(void)
+{
+}
+
+void test_label_line_cache_style_change(void)
+{
+}
+
+void test_label_line_cache_font_glyphs_added(void)
+{
+}
+
+void test_label_line_cache_append_invalidates_new_lines(void)
+{
+}
+
+#endif /*LV_LABEL_LINE_CACHE*/
+
+#endif
@@ -0,0 +1,123 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * cont;
+
+static void layout_changed_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 200, 200);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * create_item(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, 20, 20);
+    return obj;
+}
+
+void test_layout_update_independent_children_are_not_laid_out(void)
+{
+    uint32_t layout_cnt = 0;
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * item = create_item(cont);
+    lv_obj_set_size(item, LV_PCT(100), LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(item, LV_FLEX_FLOW_ROW);
+    create_item(item);
+    create_item(item);
+    lv_obj_add_event_cb(item, layout_changed_event_cb, LV_EVENT_LAYOUT_CHANGED, &layout_cnt);
+    lv_obj_update_layout(cont);
+
+    /*The height of the item doesn't depend on the container*/
+    layout_cnt = 0;
+    lv_obj_set_height(cont, 150);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_UINT32(0, layout_cnt);
+    TEST_ASSERT_EQUAL_INT32(200, lv_obj_get_width(item));
+
+    /*The width does*/
+    lv_obj_set_width(cont, 150);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_UINT32(1, layout_cnt);
+    TEST_ASSERT_EQUAL_INT32(150, lv_obj_get_width(item));
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_x(lv_obj_get_child(item, 1)));
+}
+
+void test_layout_update_dependent_children_follow_the_parent_size(void)
+{
+    lv_obj_t * pct = create_item(cont);
+    lv_obj_set_size(pct, 20, LV_PCT(50));
+
+    lv_obj_t * centered = create_item(cont);
+    lv_obj_center(centered);
+
+    lv_obj_t * fixed = create_item(cont);
+    lv_obj_set_pos(fixed, 10, 10);
+    lv_obj_update_layout(cont);
+
+    lv_obj_set_size(cont, 100, 120);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(60, lv_obj_get_height(pct));
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_x(centered));
+    TEST_ASSERT_EQUAL_INT32(50, lv_obj_get_y(centered));
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_x(fixed));
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_y(fixed));
+}
+
+void test_layout_update_padding_moves_the_children(void)
+{
+    lv_obj_t * item = create_item(cont);
+    lv_obj_set_pos(item, 10, 10);
+    lv_obj_update_layout(cont);
+
+    lv_obj_set_style_pad_all(cont, 5, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(15, item->coords.x1 - cont->coords.x1);
+    TEST_ASSERT_EQUAL_INT32(15, item->coords.y1 - cont->coords.y1);
+}
+
+void test_layout_update_removed_layout_moves_the_children(void)
+{
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+    lv_obj_t * item1 = create_item(cont);
+    lv_obj_t * item2 = create_item(cont);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(20, lv_obj_get_x(item2));
+
+    lv_obj_set_layout(cont, LV_LAYOUT_NONE);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_x(item1));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_x(item2));
+}
+
+void test_layout_update_base_dir_moves_the_children(void)
+{
+    lv_obj_t * item = create_item(cont);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_x(item));
+
+    lv_obj_set_style_base_dir(cont, LV_BASE_DIR_RTL, 0);
+    lv_obj_update_layout(cont);
+    TEST_ASSERT_EQUAL_INT32(180, lv_obj_get_x(item));
+}
+
+#endif
@@ -24,6 +24,83 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+void test_mem_monitor_free_hist(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    size_t cnt = 0;
+    for(int i = 0; i < LV_MEM_MONITOR_FREE_HIST_CNT; i++) cnt += mon.free_hist[i];
+    TEST_ASSERT_EQUAL(mon.free_cnt, cnt);
+
+    /*The biggest free block is in the last bucket*/
+    TEST_ASSERT_GREATER_OR_EQUAL(64 << (LV_MEM_MONITOR_FREE_HIST_CNT - 2), mon.free_biggest_size);
+    TEST_ASSERT_NOT_EQUAL(0, mon.free_hist[LV_MEM_MONITOR_FREE_HIST_CNT - 1]);
+#endif
+}
+
+void test_mem_hint_pool(void)
+{
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    static uint64_t bulk_mem[8 * 1024 / sizeof(uint64_t)];
+    uint8_t * bulk_start = (uint8_t *)bulk_mem;
+    uint8_t * bulk_end = bulk_start + sizeof(bulk_mem);
+
+    /*Without an own pool the default pool is used*/
+    lv_mem_monitor_t mon_default;
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon_default);
+    lv_mem_monitor_hint(&mon, LV_MEM_HINT_BULK);
+    TEST_ASSERT_EQUAL(mon_default.total_size, mon.total_size);
+
+    TEST_ASSERT_NOT_NULL(lv_mem_add_pool_hint(bulk_mem, sizeof(bulk_mem), LV_MEM_HINT_BULK));
+    TEST_ASSERT_NULL(lv_mem_add_pool_hint(bulk_mem, sizeof(bulk_mem), LV_MEM_HINT_BULK));
+
+    uint8_t * p = lv_malloc_hint(1000, LV_MEM_HINT_BULK);
+    TEST_ASSERT_TRUE(p >= bulk_start && p < bulk_end);
+    lv_memset(p, 0x55, 1000);
+
+    lv_mem_monitor_hint(&mon, LV_MEM_HINT_BULK);
+    TEST_ASSERT_LESS_THAN(sizeof(bulk_mem), mon.total_size);
+    TEST_ASSERT_EQUAL(1, mon.used_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(mon.total_size - 1000, mon.free_size);
+
+    /*Stays in the pool of the class*/
+    p = lv_realloc(p, 2000);
+    TEST_ASSERT_TRUE(p >= bulk_start && p < bulk_end);
+
+    /*Doesn't fit, so the default pool is used*/
+    uint8_t * q = lv_malloc_hint(16 * 1024, LV_MEM_HINT_BULK);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_FALSE(q >= bulk_start && q < bulk_end);
+
+    /*Moved to the default pool when it doesn't fit anymore*/
+    p = lv_realloc(p, 16 * 1024);
+    TEST_ASSERT_FALSE(p >= bulk_start && p < bulk_end);
+    for(int i = 0; i < 1000; i++) TEST_ASSERT_EQUAL_UINT8(0x55, p[i]);
+
+    uint8_t * hot = lv_malloc_hint(100, LV_MEM_HINT_HOT);
+    TEST_ASSERT_FALSE(hot >= bulk_start && hot < bulk_end);
+
+    /*Glyphs are allocated from the bulk pool*/
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create_ex(lv_draw_buf_get_font_handlers(), 20, 20, LV_COLOR_FORMAT_A8,
+                                                     LV_STRIDE_AUTO);
+    TEST_ASSERT_TRUE(draw_buf->unaligned_data >= (void *)bulk_start && draw_buf->unaligned_data < (void *)bulk_end);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+
+    lv_draw_buf_destroy(draw_buf);
+    lv_free(p);
+    lv_free(q);
+    lv_free(hot);
+
+    lv_mem_monitor_hint(&mon, LV_MEM_HINT_BULK);
+    TEST_ASSERT_EQUAL(0, mon.used_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(2000, mon.max_used);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+#endif
+}
+
 /* #7573: Test memcpy with unaligned addresses */
 void test_memcpy_unaligned(void)
 {
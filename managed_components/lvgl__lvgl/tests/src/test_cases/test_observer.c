@@ -1018,4 +1018,120 @@ void test_observer_deinit(void)
     TEST_ASSERT_MEM_LEAK_LESS_THAN(mem, 32);
 }
 
+
+#if LV_OBSERVER_DEFERRED_NOTIFY
+
+void test_observer_deferred_int(void)
+{
+    static lv_subject_t subject;
+    lv_subject_init_int(&subject, 5);
+    lv_subject_set_deferred(&subject, true);
+    lv_observer_t * observer = lv_subject_add_observer(&subject, observer_int, NULL);
+    lv_subject_add_observer(&subject, observer_basic, NULL);
+    TEST_ASSERT_EQUAL(1, observer_called);
+
+    /* Only the last value is notified, and the previous value is the last notified one */
+    lv_subject_set_int(&subject, 10);
+    lv_subject_set_int(&subject, 15);
+    TEST_ASSERT_EQUAL(15, lv_subject_get_int(&subject));
+    TEST_ASSERT_EQUAL(5, lv_subject_get_previous_int(&subject));
+    TEST_ASSERT_EQUAL(1, observer_called);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, observer_called);
+    TEST_ASSERT_EQUAL(5, prev_v);
+    TEST_ASSERT_EQUAL(15, current_v);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, observer_called);
+
+    /* Observers shouldn't be called if the value is set back before the notification */
+    lv_subject_set_int(&subject, 20);
+    lv_subject_set_int(&subject, 15);
+    lv_subject_notify_deferred();
+    TEST_ASSERT_EQUAL(2, observer_called);
+
+    /* Disabling the deferred mode sends the pending notification */
+    lv_subject_set_int(&subject, 25);
+    TEST_ASSERT_EQUAL(2, observer_called);
+    lv_subject_set_deferred(&subject, false);
+    TEST_ASSERT_EQUAL(3, observer_called);
+    TEST_ASSERT_EQUAL(15, prev_v);
+    TEST_ASSERT_EQUAL(25, current_v);
+
+    lv_subject_set_int(&subject, 30);
+    TEST_ASSERT_EQUAL(4, observer_called);
+
+    lv_observer_remove(observer);
+    lv_subject_deinit(&subject);
+}
+
+void test_observer_deferred_string(void)
+{
+    char buf_current[32];
+    char buf_previous[32];
+    lv_subject_t subject;
+    lv_subject_init_string(&subject, buf_current, buf_previous, sizeof(buf_current), "hello");
+    lv_subject_set_deferred(&subject, true);
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_bind_text(label, &subject, NULL);
+    TEST_ASSERT_EQUAL_STRING("hello", lv_label_get_text(label));
+
+    lv_subject_copy_string(&subject, "how");
+    lv_subject_snprintf(&subject, "%s are you?", "how");
+    TEST_ASSERT_EQUAL_STRING("how are you?", lv_subject_get_string(&subject));
+    TEST_ASSERT_EQUAL_STRING("hello", lv_subject_get_previous_string(&subject));
+    TEST_ASSERT_EQUAL_STRING("hello", lv_label_get_text(label));
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("how are you?", lv_label_get_text(label));
+
+    lv_subject_copy_string(&subject, "bye");
+    lv_subject_deinit(&subject);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("how are you?", lv_label_get_text(label));
+}
+
+static lv_subject_t deferred_chain_subject;
+
+static void observer_set_chain(lv_observer_t * observer, lv_subject_t * subject)
+{
+    LV_UNUSED(observer);
+    lv_subject_set_int(&deferred_chain_subject, lv_subject_get_int(subject) * 2);
+}
+
+void test_observer_deferred_chain(void)
+{
+    static lv_subject_t subject1;
+    static lv_subject_t subject2;
+    lv_subject_init_int(&subject1, 0);
+    lv_subject_init_int(&subject2, 0);
+    lv_subject_init_int(&deferred_chain_subject, 0);
+    lv_subject_set_deferred(&subject1, true);
+    lv_subject_set_deferred(&subject2, true);
+    lv_subject_set_deferred(&deferred_chain_subject, true);
+
+    lv_subject_add_observer(&subject1, observer_set_chain, NULL);
+    lv_subject_add_observer(&deferred_chain_subject, observer_basic, NULL);
+    lv_subject_add_observer(&subject2, observer_basic, NULL);
+    lv_subject_notify_deferred();
+    observer_called = 0;
+
+    /* A pending Subject can be removed from the middle of the queue */
+    lv_subject_set_int(&subject1, 1);
+    lv_subject_set_int(&subject2, 1);
+    lv_subject_deinit(&subject2);
+
+    /* Subjects set by the Observers are notified in the same call */
+    lv_subject_notify_deferred();
+    TEST_ASSERT_EQUAL(2, lv_subject_get_int(&deferred_chain_subject));
+    TEST_ASSERT_EQUAL(1, observer_called);
+
+    lv_subject_deinit(&subject1);
+    lv_subject_deinit(&deferred_chain_subject);
+}
+
+#endif /*LV_OBSERVER_DEFERRED_NOTIFY*/
+
 #endif
@@ -98,4 +98,227 @@ void test_profiler_disable(void)
     TEST_ASSERT_EQUAL_CHAR(output_buf[4][0], '\0');
 }
 
+void test_profiler_counter_and_async(void)
+{
+    lv_profiler_builtin_set_enable(true);
+
+    profiler_tick = 0;
+    output_line = 0;
+    lv_memzero(output_buf, sizeof(output_buf));
+
+    LV_PROFILER_COUNTER("counter", 42);
+    LV_PROFILER_ASYNC_BEGIN("async", 7);
+    LV_PROFILER_FLOW_BEGIN("flow", 3);
+    LV_PROFILER_ASYNC_END("async", 7);
+
+    lv_profiler_builtin_flush();
+
+    /*Flow events can't be represented in the text format*/
+    TEST_ASSERT_EQUAL_INT(3, output_line);
+    TEST_ASSERT_EQUAL_STRING("   LVGL-1 [0] 0.000000000: tracing_mark_write: C|1|counter|42\n", output_buf[0]);
+    TEST_ASSERT_EQUAL_STRING("   LVGL-1 [0] 1.000000000: tracing_mark_write: S|1|async|7\n", output_buf[1]);
+    TEST_ASSERT_EQUAL_STRING("   LVGL-1 [0] 3.000000000: tracing_mark_write: F|1|async|7\n", output_buf[2]);
+}
+
+static uint8_t export_buf[64 * 1024];
+static uint32_t export_len;
+
+static void export_cb(const void * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(user_data);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(export_buf), export_len + len);
+    lv_memcpy(export_buf + export_len, buf, len);
+    export_len += len;
+}
+
+static uint32_t get_u16(uint32_t ofs)
+{
+    return export_buf[ofs] | (export_buf[ofs + 1] << 8);
+}
+
+static uint32_t get_u32(uint32_t ofs)
+{
+    return get_u16(ofs) | (get_u16(ofs + 2) << 16);
+}
+
+static void init_ring_buffer(size_t buf_size)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = buf_size;
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = flush_cb;
+    config.ring_buffer = true;
+    lv_profiler_builtin_init(&config);
+    lv_profiler_builtin_set_enable(true);
+
+    profiler_tick = 0;
+    output_line = 0;
+    export_len = 0;
+}
+
+void test_profiler_export(void)
+{
+    init_ring_buffer(1024);
+
+    LV_PROFILER_BEGIN_TAG("tag");
+    LV_PROFILER_COUNTER("counter", 1234);
+    LV_PROFILER_END_TAG("tag");
+
+    uint32_t size = lv_profiler_builtin_export(export_cb, NULL);
+    TEST_ASSERT_EQUAL_UINT32(export_len, size);
+
+    /*Header*/
+    TEST_ASSERT_EQUAL_MEMORY("LVPT", export_buf, 4);
+    TEST_ASSERT_EQUAL_UINT32(2, get_u16(4));
+    TEST_ASSERT_EQUAL_UINT32(1000000, get_u32(8));
+    TEST_ASSERT_EQUAL_UINT32(3, get_u32(12));
+    TEST_ASSERT_EQUAL_UINT32(2, get_u32(16));
+    TEST_ASSERT_EQUAL_UINT32(0, get_u32(20));
+
+    /*Name table*/
+    uint32_t ofs = 24;
+    TEST_ASSERT_EQUAL_UINT32(3, get_u16(ofs));
+    TEST_ASSERT_EQUAL_MEMORY("tag", export_buf + ofs + 2, 3);
+    ofs += 2 + 3;
+    TEST_ASSERT_EQUAL_UINT32(7, get_u16(ofs));
+    TEST_ASSERT_EQUAL_MEMORY("counter", export_buf + ofs + 2, 7);
+    ofs += 2 + 7;
+
+    /*Events: tick, value, tid, name index, cpu, tag*/
+    TEST_ASSERT_EQUAL_UINT32(ofs + 3 * 20, size);
+    TEST_ASSERT_EQUAL_UINT32(0, get_u32(ofs));
+    TEST_ASSERT_EQUAL_UINT32(0, get_u16(ofs + 16));
+    TEST_ASSERT_EQUAL_CHAR('B', export_buf[ofs + 19]);
+    ofs += 20;
+    TEST_ASSERT_EQUAL_UINT32(1, get_u32(ofs));
+    TEST_ASSERT_EQUAL_UINT32(1234, get_u32(ofs + 8));
+    TEST_ASSERT_EQUAL_UINT32(1, get_u16(ofs + 16));
+    TEST_ASSERT_EQUAL_CHAR('C', export_buf[ofs + 19]);
+    ofs += 20;
+    TEST_ASSERT_EQUAL_CHAR('E', export_buf[ofs + 19]);
+}
+
+void test_profiler_ring_buffer_keeps_the_latest_events(void)
+{
+    init_ring_buffer(1024);
+
+    uint32_t i;
+    for(i = 0; i < 1000; i++) {
+        LV_PROFILER_COUNTER("counter", i);
+    }
+
+    /*Nothing is flushed when the buffer is full*/
+    TEST_ASSERT_EQUAL_INT(0, output_line);
+
+    lv_profiler_builtin_export(export_cb, NULL);
+    uint32_t event_cnt = get_u32(12);
+    TEST_ASSERT_LESS_THAN_UINT32(1000, event_cnt);
+
+    /*The oldest exported event is the first one which wasn't overwritten*/
+    uint32_t ofs = 24 + 2 + 7;
+    TEST_ASSERT_EQUAL_UINT32(1000 - event_cnt, get_u32(20));
+    TEST_ASSERT_EQUAL_UINT32(1000 - event_cnt, get_u32(ofs + 8));
+    TEST_ASSERT_EQUAL_UINT32(999, get_u32(ofs + (event_cnt - 1) * 20 + 8));
+
+    /*The next export overlaps with this one, the sequence number tells where it starts*/
+    for(i = 1000; i < 1010; i++) {
+        LV_PROFILER_COUNTER("counter", i);
+    }
+    export_len = 0;
+    lv_profiler_builtin_export(export_cb, NULL);
+    TEST_ASSERT_EQUAL_UINT32(1010 - event_cnt, get_u32(20));
+    TEST_ASSERT_EQUAL_UINT32(1010 - event_cnt, get_u32(ofs + 8));
+}
+
+static int get_tid_cb(void)
+{
+    return 42;
+}
+
+static int get_cpu_cb(void)
+{
+    return 3;
+}
+
+void test_profiler_thread_and_cpu_id(void)
+{
+    /*The callbacks are used regardless of `LV_USE_OS`*/
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.tick_per_sec = 1;
+    config.tick_get_cb = get_tick_cb;
+    config.tid_get_cb = get_tid_cb;
+    config.cpu_get_cb = get_cpu_cb;
+    config.flush_cb = flush_cb;
+    lv_profiler_builtin_init(&config);
+    lv_profiler_builtin_set_enable(true);
+
+    profiler_tick = 0;
+    output_line = 0;
+    export_len = 0;
+
+    LV_PROFILER_COUNTER("counter", 5);
+
+    lv_profiler_builtin_export(export_cb, NULL);
+    uint32_t ofs = 24 + 2 + 7;
+    TEST_ASSERT_EQUAL_UINT32(42, get_u32(ofs + 12));
+    TEST_ASSERT_EQUAL_UINT32(3, export_buf[ofs + 18]);
+
+    lv_profiler_builtin_flush();
+    TEST_ASSERT_EQUAL_STRING("   LVGL-42 [3] 0.000000000: tracing_mark_write: C|1|counter|5\n", output_buf[0]);
+}
+
+void test_profiler_draw_task_flow(void)
+{
+    init_ring_buffer(64 * 1024);
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 100, 100);
+    lv_refr_now(NULL);
+    /*The draw tasks of the second frame reuse the memory of the first ones*/
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_profiler_builtin_set_enable(false);
+
+    lv_profiler_builtin_export(export_cb, NULL);
+    uint32_t event_cnt = get_u32(12);
+    uint32_t name_cnt = get_u32(16);
+
+    uint32_t ofs = 24;
+    uint32_t n;
+    for(n = 0; n < name_cnt; n++) ofs += 2 + get_u16(ofs);
+
+    /*Each executed draw task closes a flow opened when the task was added.
+     *The flow IDs are unique even if a draw task is allocated at the address of an earlier one.*/
+    uint32_t flow_begin_cnt = 0;
+    uint32_t flow_end_cnt = 0;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < event_cnt; i++) {
+        uint32_t ev = ofs + i * 20;
+        if(export_buf[ev + 19] == 's') {
+            flow_begin_cnt++;
+            for(j = 0; j < i; j++) {
+                uint32_t prev = ofs + j * 20;
+                TEST_ASSERT_FALSE(export_buf[prev + 19] == 's' && get_u32(prev + 8) == get_u32(ev + 8));
+            }
+        }
+        if(export_buf[ev + 19] != 'f') continue;
+
+        flow_end_cnt++;
+        bool found = false;
+        for(j = 0; j < i; j++) {
+            uint32_t prev = ofs + j * 20;
+            if(export_buf[prev + 19] == 's' && get_u32(prev + 8) == get_u32(ev + 8)) found = true;
+        }
+        TEST_ASSERT_TRUE(found);
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, flow_end_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(flow_end_cnt, flow_begin_cnt);
+    lv_obj_delete(obj);
+}
+
 #endif
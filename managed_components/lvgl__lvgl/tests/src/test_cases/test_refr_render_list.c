@@ -0,0 +1,130 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * boxes[4];
+static uint32_t draw_cnt[4];
+
+static void draw_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        boxes[i] = lv_obj_create(lv_screen_active());
+        lv_obj_remove_style_all(boxes[i]);
+        lv_obj_set_style_bg_opa(boxes[i], LV_OPA_COVER, 0);
+        lv_obj_set_size(boxes[i], 50, 50);
+        lv_obj_set_pos(boxes[i], i * 100, 0);
+        lv_obj_add_event_cb(boxes[i], draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, &draw_cnt[i]);
+    }
+
+    lv_refr_now(NULL);
+    lv_memzero(draw_cnt, sizeof(draw_cnt));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void refr_first_box(void)
+{
+    /*Draw the pending changes first to count only the drawings of the first box's area*/
+    lv_refr_now(NULL);
+    lv_memzero(draw_cnt, sizeof(draw_cnt));
+    lv_obj_invalidate(boxes[0]);
+    lv_refr_now(NULL);
+}
+
+void test_refr_render_list_only_visible_children_are_drawn(void)
+{
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[2]);
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[3]);
+}
+
+void test_refr_render_list_moved_object_is_drawn(void)
+{
+    refr_first_box();
+
+    lv_obj_set_x(boxes[2], 20);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[2]);
+
+    lv_obj_set_x(boxes[2], 200);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[2]);
+}
+
+void test_refr_render_list_scrolled_object_is_drawn(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 100, 50);
+    lv_obj_set_pos(cont, 0, 100);
+    lv_obj_set_parent(boxes[3], cont);
+    lv_obj_set_pos(boxes[3], 0, 100);
+    lv_obj_set_pos(boxes[0], 0, 100);
+
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[3]);
+
+    lv_obj_scroll_to_y(cont, 100, LV_ANIM_OFF);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[3]);
+}
+
+void test_refr_render_list_hidden_object_is_drawn_when_shown(void)
+{
+    lv_obj_set_x(boxes[1], 10);
+    lv_obj_add_flag(boxes[1], LV_OBJ_FLAG_HIDDEN);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[1]);
+
+    lv_obj_remove_flag(boxes[1], LV_OBJ_FLAG_HIDDEN);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[1]);
+}
+
+void test_refr_render_list_new_and_deleted_objects(void)
+{
+    uint32_t new_cnt = 0;
+    refr_first_box();
+
+    lv_obj_t * obj = lv_obj_create(boxes[0]);
+    lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, &new_cnt);
+    lv_refr_now(NULL);
+    new_cnt = 0;
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, new_cnt);
+
+    lv_obj_delete(boxes[1]);
+    lv_obj_set_x(boxes[2], 10);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[2]);
+}
+
+void test_refr_render_list_ext_draw_size(void)
+{
+    lv_obj_set_x(boxes[1], 60);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(0, draw_cnt[1]);
+
+    /*The shadow reaches the first box*/
+    lv_obj_set_style_shadow_width(boxes[1], 30, 0);
+    refr_first_box();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_cnt[1]);
+}
+
+#endif
@@ -222,4 +222,110 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_prop_cache_invalidation(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_opa(&style, LV_OPA_50);
+    lv_style_set_text_color(&style, lv_color_hex(0xff0000));
+
+    lv_obj_t * parent1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj = lv_obj_create(parent1);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x00ff00), LV_PART_MAIN);
+
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*Changing a shared style is seen without reporting it*/
+    lv_style_set_bg_opa(&style, LV_OPA_70);
+    TEST_ASSERT_EQUAL(LV_OPA_70, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_style_remove_prop(&style, LV_STYLE_BG_OPA);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*State change*/
+    lv_obj_set_style_bg_opa(obj, LV_OPA_30, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_30, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*Disabled style*/
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+    lv_obj_style_set_disabled(obj, &style, LV_PART_MAIN, true);
+    TEST_ASSERT_FALSE(lv_color_eq(lv_color_hex(0xff0000), lv_obj_get_style_text_color(obj, LV_PART_MAIN)));
+
+    /*Inherited from the new parent*/
+    lv_obj_set_parent(obj, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Inherited from the parent's state*/
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x0000ff), LV_STATE_CHECKED);
+    lv_obj_add_state(parent2, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+
+    /*Other parts are cached separately*/
+    lv_obj_set_style_bg_opa(obj, LV_OPA_40, LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL(LV_OPA_40, lv_obj_get_style_bg_opa(obj, LV_PART_SCROLLBAR));
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_delete(obj);
+    lv_style_reset(&style);
+}
+
+
+void test_style_prop_cache_local_changes(void)
+{
+#if LV_OBJ_STYLE_PROP_CACHE_CNT
+    static const lv_style_prop_t trans_props[] = {LV_STYLE_BG_OPA, LV_STYLE_PROP_INV};
+    lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, trans_props, lv_anim_path_linear, 100, 0, NULL);
+
+    /*The other tests leave widgets with already reset styles on the active screen*/
+    lv_obj_t * old_screen = lv_screen_active();
+    lv_obj_t * screen = lv_obj_create(NULL);
+    lv_screen_load(screen);
+
+    lv_obj_t * parent = lv_obj_create(screen);
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_t * other = lv_obj_create(screen);
+    lv_obj_remove_style_all(child);
+    lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, LV_STATE_PRESSED);
+    lv_obj_set_style_bg_opa(parent, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_transition(parent, &trans, LV_STATE_PRESSED);
+
+    lv_obj_get_style_text_color(child, LV_PART_MAIN);
+    lv_obj_get_style_bg_opa(other, LV_PART_MAIN);
+    uint32_t generation = LV_GLOBAL_DEFAULT()->style_prop_cache_generation;
+
+    /*A local style reaches the children inheriting it, the others keep their cache*/
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x00ff00), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL_UINT32(generation, LV_GLOBAL_DEFAULT()->style_prop_cache_generation);
+
+    /*The running transition updates only its object*/
+    lv_obj_add_state(parent, LV_STATE_PRESSED);
+    generation = LV_GLOBAL_DEFAULT()->style_prop_cache_generation;
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_opa_t opa_half = lv_obj_get_style_bg_opa(parent, LV_PART_MAIN);
+    TEST_ASSERT_GREATER_THAN(LV_OPA_TRANSP, opa_half);
+    TEST_ASSERT_LESS_THAN(LV_OPA_COVER, opa_half);
+    TEST_ASSERT_EQUAL_UINT32(generation, LV_GLOBAL_DEFAULT()->style_prop_cache_generation);
+
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_bg_opa(parent, LV_PART_MAIN));
+
+    lv_screen_load(old_screen);
+    lv_obj_delete(screen);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
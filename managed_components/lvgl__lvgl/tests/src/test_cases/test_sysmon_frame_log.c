@@ -0,0 +1,239 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static uint32_t fake_time;
+static uint8_t export_buf[16 * 1024];
+static uint32_t export_len;
+
+static uint32_t fake_time_cb(void)
+{
+    fake_time += 10;
+    return fake_time;
+}
+
+static void export_cb(const void * buf, uint32_t len, void * user_data)
+{
+    LV_UNUSED(user_data);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(export_buf), export_len + len);
+    lv_memcpy(export_buf + export_len, buf, len);
+    export_len += len;
+}
+
+static uint32_t get_u16(uint32_t ofs)
+{
+    return export_buf[ofs] | (export_buf[ofs + 1] << 8);
+}
+
+static uint32_t get_u32(uint32_t ofs)
+{
+    return get_u16(ofs) | (get_u16(ofs + 2) << 16);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_refr_now(NULL);
+    lv_sysmon_frame_log_start(NULL);
+    export_len = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_sysmon_frame_log_stop(NULL);
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_obj_t * create_obj(int32_t x, int32_t y)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, 50, 50);
+    lv_refr_now(NULL);
+    lv_sysmon_frame_log_reset(NULL);
+    return obj;
+}
+
+void test_frame_log_records_the_invalidated_areas(void)
+{
+    lv_obj_t * obj = create_obj(10, 10);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_sysmon_frame_log_get_count(NULL));
+    const lv_sysmon_frame_t * f = lv_sysmon_frame_log_get_frame(NULL, 0);
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_NULL(lv_sysmon_frame_log_get_frame(NULL, 1));
+
+    TEST_ASSERT_EQUAL_UINT32(0, f->id);
+    TEST_ASSERT_EQUAL_UINT16(1, f->area_cnt);
+    TEST_ASSERT_EQUAL_INT32(10, f->areas[0].x1);
+    TEST_ASSERT_EQUAL_INT32(10, f->areas[0].y1);
+    TEST_ASSERT_EQUAL_INT32(59, f->areas[0].x2);
+    TEST_ASSERT_EQUAL_INT32(59, f->areas[0].y2);
+    TEST_ASSERT_EQUAL_UINT32(50 * 50, f->px_rendered);
+    TEST_ASSERT_EQUAL_UINT32(50 * 50, f->px_flushed);
+#if LV_DRAW_OCCLUSION_CULLING
+    /*The screen's background under the opaque object is not blended*/
+    TEST_ASSERT_EQUAL_UINT32(50 * 50, f->px_blended);
+#else
+    TEST_ASSERT_EQUAL_UINT32(2 * 50 * 50, f->px_blended);
+#endif
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_sysmon_frame_log_get_heat(NULL, 15, 15));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_sysmon_frame_log_get_heat(NULL, 55, 55));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_sysmon_frame_log_get_heat(NULL, 400, 400));
+}
+
+void test_frame_log_times_the_draw_tasks(void)
+{
+    lv_obj_t * obj = create_obj(10, 10);
+    lv_sysmon_frame_log_set_time_cb(NULL, fake_time_cb);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    const lv_sysmon_frame_t * f = lv_sysmon_frame_log_get_frame(NULL, 0);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, f->render_time);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, f->task_cnt[LV_DRAW_TASK_TYPE_FILL]);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, f->task_time[LV_DRAW_TASK_TYPE_FILL]);
+    TEST_ASSERT_EQUAL_UINT32(0, f->task_cnt[LV_DRAW_TASK_TYPE_ARC]);
+}
+
+void test_frame_log_is_a_ring_buffer(void)
+{
+    lv_obj_t * obj = create_obj(10, 10);
+
+    uint32_t i;
+    for(i = 0; i < LV_SYSMON_FRAME_LOG_CNT + 5; i++) {
+        lv_obj_invalidate(obj);
+        lv_refr_now(NULL);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_FRAME_LOG_CNT, lv_sysmon_frame_log_get_count(NULL));
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_FRAME_LOG_CNT + 4, lv_sysmon_frame_log_get_frame(NULL, 0)->id);
+    TEST_ASSERT_EQUAL_UINT32(5, lv_sysmon_frame_log_get_frame(NULL, LV_SYSMON_FRAME_LOG_CNT - 1)->id);
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_FRAME_LOG_CNT + 5, lv_sysmon_frame_log_get_heat(NULL, 15, 15));
+}
+
+void test_frame_log_records_the_heap(void)
+{
+    lv_obj_t * obj = create_obj(10, 10);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    /*A big allocation shows up in the next frame*/
+    void * buf = lv_malloc(8 * 1024);
+    TEST_ASSERT_NOT_NULL(buf);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    const lv_sysmon_frame_t * f_before = lv_sysmon_frame_log_get_frame(NULL, 1);
+    const lv_sysmon_frame_t * f_after = lv_sysmon_frame_log_get_frame(NULL, 0);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, f_before->heap_free_biggest);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(f_before->heap_used + 8 * 1024, f_after->heap_used);
+    TEST_ASSERT_EQUAL_UINT32(mon.total_size - mon.free_size, f_after->heap_used);
+    TEST_ASSERT_EQUAL_UINT32(mon.free_biggest_size, f_after->heap_free_biggest);
+    TEST_ASSERT_EQUAL_UINT8(mon.frag_pct, f_after->heap_frag_pct);
+#else
+    TEST_ASSERT_EQUAL_UINT32(f_before->heap_used, f_after->heap_used);
+#endif
+
+    lv_free(buf);
+}
+
+void test_frame_log_export(void)
+{
+    lv_obj_t * obj1 = create_obj(10, 10);
+    lv_obj_t * obj2 = create_obj(300, 200);
+
+    lv_obj_invalidate(obj1);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(obj1);
+    lv_obj_invalidate(obj2);
+    lv_refr_now(NULL);
+
+    uint32_t size = lv_sysmon_frame_log_export(NULL, export_cb, NULL);
+    TEST_ASSERT_EQUAL_UINT32(export_len, size);
+
+    /*Header*/
+    TEST_ASSERT_EQUAL_MEMORY("LVFL", export_buf, 4);
+    TEST_ASSERT_EQUAL_UINT32(3, get_u16(4));
+    TEST_ASSERT_EQUAL_UINT32(2, get_u16(6));
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_FRAME_LOG_AREA_CNT, get_u16(8));
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT, get_u16(10));
+    TEST_ASSERT_EQUAL_UINT32(800, get_u16(12));
+    TEST_ASSERT_EQUAL_UINT32(480, get_u16(14));
+    TEST_ASSERT_EQUAL_UINT32(LV_SYSMON_HEATMAP_CELL_SIZE, get_u16(16));
+    uint32_t cols = get_u16(18);
+    uint32_t rows = get_u16(20);
+    TEST_ASSERT_EQUAL_UINT32((800 + LV_SYSMON_HEATMAP_CELL_SIZE - 1) / LV_SYSMON_HEATMAP_CELL_SIZE, cols);
+    TEST_ASSERT_EQUAL_UINT32((480 + LV_SYSMON_HEATMAP_CELL_SIZE - 1) / LV_SYSMON_HEATMAP_CELL_SIZE, rows);
+
+    /*The oldest frame comes first*/
+    uint32_t ofs = 24;
+    uint32_t task_size = LV_SYSMON_FRAME_LOG_TASK_TYPE_CNT * 6;
+    TEST_ASSERT_EQUAL_UINT32(0, get_u32(ofs));
+    TEST_ASSERT_EQUAL_UINT32(50 * 50, get_u32(ofs + 16));
+    const lv_sysmon_frame_t * f = lv_sysmon_frame_log_get_frame(NULL, 1);
+    TEST_ASSERT_EQUAL_UINT32(f->px_blended, get_u32(ofs + 24));
+    TEST_ASSERT_EQUAL_UINT32(f->heap_used, get_u32(ofs + 28));
+    TEST_ASSERT_EQUAL_UINT32(f->heap_free_biggest, get_u32(ofs + 32));
+    TEST_ASSERT_EQUAL_UINT32(f->heap_frag_pct, get_u16(ofs + 36));
+    TEST_ASSERT_EQUAL_UINT32(1, get_u16(ofs + 38));
+    TEST_ASSERT_EQUAL_UINT32(1, get_u16(ofs + 40));
+    TEST_ASSERT_EQUAL_UINT32(10, get_u16(ofs + 42));
+    TEST_ASSERT_EQUAL_UINT32(59, get_u16(ofs + 46));
+    ofs += 42 + 1 * 8 + task_size;
+
+    TEST_ASSERT_EQUAL_UINT32(1, get_u32(ofs));
+    TEST_ASSERT_EQUAL_UINT32(2 * 50 * 50, get_u32(ofs + 16));
+    TEST_ASSERT_EQUAL_UINT32(2, get_u16(ofs + 38));
+    TEST_ASSERT_EQUAL_UINT32(2, get_u16(ofs + 40));
+    TEST_ASSERT_EQUAL_UINT32(300, get_u16(ofs + 50));
+    ofs += 42 + 2 * 8 + task_size;
+
+    /*Heatmap*/
+    TEST_ASSERT_EQUAL_UINT32(ofs + cols * rows * 2, size);
+    TEST_ASSERT_EQUAL_UINT32(2, get_u16(ofs));
+    uint32_t cell_obj2 = (200 / LV_SYSMON_HEATMAP_CELL_SIZE) * cols + 300 / LV_SYSMON_HEATMAP_CELL_SIZE;
+    TEST_ASSERT_EQUAL_UINT32(1, get_u16(ofs + cell_obj2 * 2));
+}
+
+void test_frame_log_heatmap_overlay(void)
+{
+    lv_obj_t * obj = create_obj(10, 10);
+
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+
+    lv_sysmon_show_heatmap(NULL);
+    lv_display_t * disp = lv_display_get_default();
+    lv_obj_t * heatmap = disp->frame_log->heatmap_obj;
+    TEST_ASSERT_NOT_NULL(heatmap);
+    TEST_ASSERT_FALSE(lv_obj_has_flag(heatmap, LV_OBJ_FLAG_CLICKABLE));
+    TEST_ASSERT_EQUAL_PTR(lv_display_get_layer_sys(disp), lv_obj_get_parent(heatmap));
+
+    /*Showing the overlay invalidates the whole screen so the object's cells are the hottest*/
+    lv_refr_now(NULL);
+    lv_draw_buf_t * buf = lv_display_get_buf_active(disp);
+    lv_color32_t * hot = lv_draw_buf_goto_xy(buf, 15, 15);
+    lv_color32_t * cold = lv_draw_buf_goto_xy(buf, 400, 400);
+    TEST_ASSERT_LESS_THAN_UINT8(cold->green, hot->green);
+    TEST_ASSERT_LESS_THAN_UINT8(0xff, cold->green);
+
+    lv_sysmon_hide_heatmap(NULL);
+    TEST_ASSERT_TRUE(lv_obj_has_flag(heatmap, LV_OBJ_FLAG_HIDDEN));
+}
+
+#endif
@@ -0,0 +1,359 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_TEXT_GLYPH_RUN_CACHE_SIZE
+
+static const char * texts[] = {
+    "Hello",
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Ut auctor sed dui interdum convallis.",
+    "Averyveryveryveryveryverylongwordwhichdoesnotfitintoasingleline and some more text\nwith a\r\nnew line",
+    "AVAWAY To Ta Te Yo LT. \"Kerning\" pairs: AV, Wa, Yo, F., P.",
+    "Lorem #ff0000 ipsum dolor# sit #00ff00 amet,# consectetur ## adipiscing elit.",
+    "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，请直接告诉我。",
+};
+
+static lv_cache_t * cache;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    cache = LV_GLOBAL_DEFAULT()->text_glyph_run_cache;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_cache_set_max_size(cache, LV_TEXT_GLYPH_RUN_CACHE_SIZE, NULL);
+    lv_text_glyph_run_cache_drop();
+    lv_obj_clean(lv_screen_active());
+}
+
+static void set_cache_enabled(bool en)
+{
+    lv_text_glyph_run_cache_drop();
+    lv_cache_set_max_size(cache, en ? LV_TEXT_GLYPH_RUN_CACHE_SIZE : 0, NULL);
+}
+
+/*The letters and widths of the run are the same as the ones found by decoding the text*/
+static void assert_run_valid(const lv_text_glyph_run_t * run, const char * text, const lv_font_t * font)
+{
+    TEST_ASSERT_NOT_NULL(run);
+    TEST_ASSERT_EQUAL_PTR(text, run->text);
+    TEST_ASSERT_EQUAL_PTR(font, run->font);
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(text), run->text_len);
+    TEST_ASSERT_EQUAL_UINT32(lv_text_get_encoded_length(text), run->glyph_cnt);
+
+    uint32_t ofs = 0;
+    uint32_t i;
+    for(i = 0; i < run->glyph_cnt; i++) {
+        TEST_ASSERT_EQUAL_UINT32(ofs, run->glyphs[i].ofs);
+        TEST_ASSERT_EQUAL_PTR(&run->glyphs[i], lv_text_glyph_run_find(run, ofs));
+
+        uint32_t letter;
+        uint32_t letter_next;
+        lv_text_encoded_letter_next_2(text, &letter, &letter_next, &ofs);
+        TEST_ASSERT_EQUAL_UINT32(letter, run->glyphs[i].letter);
+        TEST_ASSERT_EQUAL_INT32(lv_font_get_glyph_width(font, letter, letter_next), run->glyphs[i].adv_w);
+    }
+
+    /*The end of the text can be found too*/
+    TEST_ASSERT_EQUAL_UINT32(run->text_len, run->glyphs[run->glyph_cnt].ofs);
+    TEST_ASSERT_EQUAL_PTR(&run->glyphs[run->glyph_cnt], lv_text_glyph_run_find(run, run->text_len));
+    TEST_ASSERT_NULL(lv_text_glyph_run_find(run, run->text_len + 1));
+}
+
+void test_text_glyph_run_letters(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_source_han_sans_sc_14_cjk};
+
+    uint32_t f;
+    for(f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        uint32_t t;
+        for(t = 1; t < sizeof(texts) / sizeof(texts[0]); t++) {
+            const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(texts[t], fonts[f], true);
+            assert_run_valid(run, texts[t], fonts[f]);
+
+            /*Found in the cache the next time*/
+            const lv_text_glyph_run_t * run2 = lv_text_glyph_run_acquire(texts[t], fonts[f], false);
+            TEST_ASSERT_EQUAL_PTR(run, run2);
+            lv_text_glyph_run_release(run2);
+            lv_text_glyph_run_release(run);
+        }
+    }
+
+    /*No letter starts inside a multi-byte letter*/
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(texts[5], &lv_font_source_han_sans_sc_14_cjk, false);
+    TEST_ASSERT_NOT_NULL(run);
+    TEST_ASSERT_NULL(lv_text_glyph_run_find(run, 1));
+    lv_text_glyph_run_release(run);
+
+    /*Short texts are not shaped*/
+    TEST_ASSERT_NULL(lv_text_glyph_run_acquire(texts[0], &lv_font_montserrat_14, true));
+}
+
+void test_text_glyph_run_key(void)
+{
+    char buf[128];
+    lv_strcpy(buf, texts[1]);
+
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(buf, &lv_font_montserrat_14, true);
+    TEST_ASSERT_NOT_NULL(run);
+    lv_text_glyph_run_release(run);
+
+    /*Another font, another buffer with the same text or a changed text is not the same run*/
+    TEST_ASSERT_NULL(lv_text_glyph_run_acquire(buf, &lv_font_montserrat_24, false));
+    TEST_ASSERT_NULL(lv_text_glyph_run_acquire(texts[1], &lv_font_montserrat_14, false));
+    buf[0] = 'X';
+    TEST_ASSERT_NULL(lv_text_glyph_run_acquire(buf, &lv_font_montserrat_14, false));
+    buf[0] = texts[1][0];
+    run = lv_text_glyph_run_acquire(buf, &lv_font_montserrat_14, false);
+    TEST_ASSERT_NOT_NULL(run);
+    lv_text_glyph_run_release(run);
+
+    /*Dropped if the glyphs of the fonts change*/
+    lv_text_glyph_run_cache_drop();
+    TEST_ASSERT_NULL(lv_text_glyph_run_acquire(buf, &lv_font_montserrat_14, false));
+}
+
+static int32_t get_width(const char * text, const lv_font_t * font)
+{
+    lv_point_t size;
+    lv_text_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    return size.x;
+}
+
+static int32_t get_width_uncached(const char * text, const lv_font_t * font)
+{
+    set_cache_enabled(false);
+    int32_t w = get_width(text, font);
+    set_cache_enabled(true);
+    return w;
+}
+
+void test_text_glyph_run_font_changes(void)
+{
+    /*Kerning*/
+    lv_font_t font = lv_font_montserrat_24;
+    int32_t kerned_w = get_width(texts[3], &font);
+    TEST_ASSERT_EQUAL_INT32(get_width_uncached(texts[3], &font), kerned_w);
+    lv_font_set_kerning(&font, LV_FONT_KERNING_NONE);
+    int32_t unkerned_w = get_width(texts[3], &font);
+    TEST_ASSERT_EQUAL_INT32(get_width_uncached(texts[3], &font), unkerned_w);
+    TEST_ASSERT_NOT_EQUAL(kerned_w, unkerned_w);
+
+#if LV_USE_TINY_TTF
+    /*Size of a TTF font*/
+    extern const uint8_t test_ubuntu_font[];
+    extern size_t test_ubuntu_font_size;
+    lv_font_t * ttf = lv_tiny_ttf_create_data(test_ubuntu_font, test_ubuntu_font_size, 20);
+    int32_t small_w = get_width(texts[1], ttf);
+    lv_tiny_ttf_set_size(ttf, 40);
+    int32_t large_w = get_width(texts[1], ttf);
+    TEST_ASSERT_EQUAL_INT32(get_width_uncached(texts[1], ttf), large_w);
+    TEST_ASSERT_GREATER_THAN_INT32(small_w, large_w);
+    lv_tiny_ttf_destroy(ttf);
+#endif
+
+    /*Fallback of a font in use*/
+    lv_font_t font_fb = lv_font_montserrat_14;
+    font_fb.fallback = NULL;
+    int32_t no_fb_w = get_width(texts[5], &font_fb);
+    font_fb.fallback = &lv_font_source_han_sans_sc_14_cjk;
+    lv_text_glyph_run_cache_drop();
+    int32_t fb_w = get_width(texts[5], &font_fb);
+    TEST_ASSERT_EQUAL_INT32(get_width_uncached(texts[5], &font_fb), fb_w);
+    TEST_ASSERT_NOT_EQUAL(no_fb_w, fb_w);
+}
+
+static void init_attributes(lv_text_attributes_t * attributes, int32_t max_width, lv_text_flag_t flags)
+{
+    lv_memzero(attributes, sizeof(*attributes));
+    attributes->letter_space = 1;
+    attributes->line_space = 3;
+    attributes->max_width = max_width;
+    attributes->text_flags = flags;
+}
+
+void test_text_glyph_run_size(void)
+{
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_24, &lv_font_source_han_sans_sc_14_cjk};
+    const int32_t widths[] = {LV_COORD_MAX, 200, 50, 1};
+    const lv_text_flag_t flags[] = {LV_TEXT_FLAG_NONE, LV_TEXT_FLAG_RECOLOR, LV_TEXT_FLAG_BREAK_ALL};
+
+    uint32_t f;
+    for(f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        uint32_t w;
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            uint32_t fl;
+            for(fl = 0; fl < sizeof(flags) / sizeof(flags[0]); fl++) {
+                uint32_t t;
+                for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+                    lv_text_attributes_t attributes;
+                    init_attributes(&attributes, widths[w], flags[fl]);
+
+                    set_cache_enabled(false);
+                    lv_point_t ref;
+                    lv_text_get_size_attributes(&ref, texts[t], fonts[f], &attributes);
+
+                    set_cache_enabled(true);
+                    lv_point_t size;
+                    lv_text_get_size_attributes(&size, texts[t], fonts[f], &attributes);
+                    TEST_ASSERT_EQUAL_INT32(ref.x, size.x);
+                    TEST_ASSERT_EQUAL_INT32(ref.y, size.y);
+
+                    /*Again with the cached run*/
+                    lv_text_get_size_attributes(&size, texts[t], fonts[f], &attributes);
+                    TEST_ASSERT_EQUAL_INT32(ref.x, size.x);
+                    TEST_ASSERT_EQUAL_INT32(ref.y, size.y);
+                }
+            }
+        }
+    }
+}
+
+void test_text_glyph_run_append(void)
+{
+    /*Add the text piece by piece like a streamed reply. Cut the letters in half sometimes.*/
+    const lv_font_t * font = &lv_font_source_han_sans_sc_14_cjk;
+    const char * text = "Woof! 你好！我是你的桌面助手。AVAWAY To Ta。今天天气很好，适合出去走走。";
+    char buf[256] = "";
+    lv_text_lines_t lines;
+    lv_memzero(&lines, sizeof(lines));
+    lv_text_attributes_t attributes;
+    init_attributes(&attributes, 100, LV_TEXT_FLAG_NONE);
+
+    uint32_t len = lv_strlen(text);
+    lv_point_t ref[64];
+    TEST_ASSERT_LESS_THAN_UINT32(sizeof(ref) / sizeof(ref[0]), len / 4 + 1);
+
+    /*The sizes without the runs*/
+    set_cache_enabled(false);
+    uint32_t i;
+    for(i = 4; i <= len + 3; i += 4) {
+        uint32_t n = LV_MIN(i, len);
+        lv_strncpy(buf, text, n);
+        buf[n] = '\0';
+        lv_text_get_size_attributes(&ref[i / 4], buf, font, &attributes);
+    }
+    set_cache_enabled(true);
+
+    for(i = 4; i <= len + 3; i += 4) {
+        uint32_t n = LV_MIN(i, len);
+        lv_strncpy(buf, text, n);
+        buf[n] = '\0';
+
+        lv_point_t size;
+        lv_text_lines_get_size(&size, &lines, buf, font, &attributes);
+        TEST_ASSERT_EQUAL_INT32(ref[i / 4].x, size.x);
+        TEST_ASSERT_EQUAL_INT32(ref[i / 4].y, size.y);
+
+        const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(buf, font, false);
+        if(n < 16) {
+            TEST_ASSERT_NULL(run);
+            continue;
+        }
+        assert_run_valid(run, buf, font);
+        lv_text_glyph_run_release(run);
+    }
+
+    /*The runs of the shorter texts were replaced, only the last one is kept*/
+    TEST_ASSERT_EQUAL_UINT32(sizeof(lv_text_glyph_run_t) +
+                             (lv_text_get_encoded_length(buf) + 1) * sizeof(lv_text_glyph_t),
+                             lv_cache_get_size(cache, NULL));
+
+    lv_text_lines_reset(&lines);
+}
+
+static lv_draw_buf_t * take_snapshot(void)
+{
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    return snapshot;
+}
+
+static void assert_same_draw(lv_obj_t * label)
+{
+    /*Drawn with the stored run*/
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(lv_label_get_text(label),
+                                                                lv_obj_get_style_text_font(label, 0), true);
+    TEST_ASSERT_NOT_NULL(run);
+    lv_text_glyph_run_release(run);
+    lv_obj_invalidate(label);
+    lv_draw_buf_t * with_run = take_snapshot();
+
+    /*Drawn looking up all the glyphs*/
+    set_cache_enabled(false);
+    lv_obj_invalidate(label);
+    lv_draw_buf_t * without_run = take_snapshot();
+    set_cache_enabled(true);
+
+    TEST_ASSERT_EQUAL_UINT32(with_run->data_size, without_run->data_size);
+    TEST_ASSERT_EQUAL_MEMORY(without_run->data, with_run->data, with_run->data_size);
+
+    lv_draw_buf_destroy(with_run);
+    lv_draw_buf_destroy(without_run);
+}
+
+void test_text_glyph_run_draw(void)
+{
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label, 200);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_obj_set_style_text_letter_space(label, 2, 0);
+    lv_label_set_recolor(label, true);
+    lv_label_set_text(label, texts[4]);
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, texts[3]);
+
+    /*Shaped when the size of the label was calculated*/
+    const lv_text_glyph_run_t * run = lv_text_glyph_run_acquire(lv_label_get_text(label), &lv_font_montserrat_24, false);
+    TEST_ASSERT_NOT_NULL(run);
+    lv_text_glyph_run_release(run);
+    assert_same_draw(label);
+
+    /*Breaking the lines while drawing*/
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_text_lines_reset(&((lv_label_t *)label)->lines);
+    assert_same_draw(label);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_text_glyph_run_letters(void)
+{
+}
+
+void test_text_glyph_run_key(void)
+{
+}
+
+void test_text_glyph_run_size(void)
+{
+}
+
+void test_text_glyph_run_append(void)
+{
+}
+
+void test_text_glyph_run_draw(void)
+{
+}
+
+void test_text_glyph_run_font_changes(void)
+{
+}
+
+#endif /*LV_TEXT_GLYPH_RUN_CACHE_SIZE*/
+
+#endif
@@ -0,0 +1,242 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static uint32_t order[8];
+static uint32_t order_cnt;
+static lv_timer_t * other_timer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    order_cnt = 0;
+    other_timer = NULL;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void record_cb(lv_timer_t * timer)
+{
+    if(order_cnt < 8) order[order_cnt++] = (uint32_t)(lv_uintptr_t)lv_timer_get_user_data(timer);
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    record_cb(timer);
+    if(other_timer) {
+        lv_timer_delete(other_timer);
+        other_timer = NULL;
+    }
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    record_cb(timer);
+    lv_timer_t * new_timer = lv_timer_create(record_cb, 0, (void *)100);
+    lv_timer_set_repeat_count(new_timer, 1);
+}
+
+static void resume_cb(void * data)
+{
+    uint32_t * cnt = data;
+    (*cnt)++;
+}
+
+static void delete_self_cb(lv_timer_t * timer)
+{
+    record_cb(timer);
+    lv_timer_delete(timer);
+}
+
+void test_timer_should_run_in_order_of_deadline(void)
+{
+    lv_timer_t * t1 = lv_timer_create(record_cb, 30, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(record_cb, 10, (void *)2);
+    lv_timer_t * t3 = lv_timer_create(record_cb, 20, (void *)3);
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(0, order_cnt);
+
+    lv_tick_inc(30);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, order[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, order[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, order[2]);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+    lv_timer_delete(t3);
+}
+
+void test_timer_should_run_newer_first_at_the_same_deadline(void)
+{
+    lv_timer_t * t1 = lv_timer_create(record_cb, 10, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(record_cb, 10, (void *)2);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, order[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, order[1]);
+
+    /*The order is kept in the next periods too*/
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(4, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, order[2]);
+    TEST_ASSERT_EQUAL_UINT32(1, order[3]);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+}
+
+void test_timer_zero_period_should_run_once_per_call(void)
+{
+    lv_timer_t * t1 = lv_timer_create(record_cb, 0, (void *)1);
+    lv_timer_t * t2 = lv_timer_create(record_cb, 0, (void *)2);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(4, order_cnt);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t2);
+}
+
+void test_timer_should_allow_deleting_an_other_timer_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(delete_other_cb, 10, (void *)1);
+    other_timer = lv_timer_create(record_cb, 10, (void *)2);
+    lv_timer_t * t3 = lv_timer_create(record_cb, 10, (void *)3);
+
+    /*`t1` runs first and deletes `other_timer` before its turn*/
+    lv_timer_set_period(t1, 5);
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, order[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, order[1]);
+    TEST_ASSERT_NULL(other_timer);
+
+    lv_timer_delete(t1);
+    lv_timer_delete(t3);
+}
+
+void test_timer_should_allow_creating_and_deleting_timers_in_callback(void)
+{
+    lv_timer_t * t1 = lv_timer_create(create_cb, 10, (void *)1);
+    lv_timer_create(delete_self_cb, 20, (void *)2);
+    lv_timer_set_repeat_count(t1, 1);
+
+    /*The new timer is ready at once so it runs in the same call. One shot timers are deleted.*/
+    lv_tick_inc(10);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(10, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, order[0]);
+    TEST_ASSERT_EQUAL_UINT32(100, order[1]);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, order_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, order[2]);
+
+    /*Only the timers of LVGL are left*/
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        TEST_ASSERT_TRUE(timer->timer_cb != record_cb);
+        TEST_ASSERT_TRUE(timer->timer_cb != create_cb);
+        TEST_ASSERT_TRUE(timer->timer_cb != delete_self_cb);
+        timer = lv_timer_get_next(timer);
+    }
+}
+
+void test_timer_pause_ready_and_reset_should_update_the_deadline(void)
+{
+    lv_timer_t * t1 = lv_timer_create(record_cb, 1000, (void *)1);
+
+    lv_timer_pause(t1);
+    lv_tick_inc(1000);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, order_cnt);
+
+    /*Overdue after resuming*/
+    lv_timer_resume(t1);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, order_cnt);
+
+    lv_timer_ready(t1);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+
+    lv_tick_inc(500);
+    lv_timer_reset(t1);
+    lv_tick_inc(600);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, order_cnt);
+
+    lv_tick_inc(400);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, order_cnt);
+
+    lv_timer_delete(t1);
+}
+
+void test_timer_set_period_and_ready_should_wake_the_handler(void)
+{
+    uint32_t resume_cnt = 0;
+    lv_timer_t * t1 = lv_timer_create(record_cb, 1000, (void *)1);
+    lv_timer_handler_set_resume_cb(resume_cb, &resume_cnt);
+
+    /*A sleeping handler has to learn about the earlier deadline*/
+    lv_timer_set_period(t1, 10);
+    TEST_ASSERT_EQUAL_UINT32(1, resume_cnt);
+
+    lv_timer_ready(t1);
+    TEST_ASSERT_EQUAL_UINT32(2, resume_cnt);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, order_cnt);
+
+    lv_timer_handler_set_resume_cb(NULL, NULL);
+    lv_timer_delete(t1);
+}
+
+
+void test_timer_resume_should_not_need_to_allocate(void)
+{
+    lv_timer_state_t * timer_state = &LV_GLOBAL_DEFAULT()->timer_state;
+    lv_timer_t * paused[8];
+    lv_timer_t * running[8];
+    uint32_t i;
+
+    /*Fill the slots freed by the paused timers with new ones*/
+    for(i = 0; i < 8; i++) {
+        paused[i] = lv_timer_create(record_cb, 10, (void *)(lv_uintptr_t)i);
+        lv_timer_pause(paused[i]);
+    }
+    for(i = 0; i < 8; i++) running[i] = lv_timer_create(record_cb, 1000, NULL);
+
+    /*Every timer has its slot, so resuming only moves them into the heap*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(timer_state->timer_cnt, timer_state->timer_heap_size);
+    lv_timer_t ** heap = timer_state->timer_heap;
+    for(i = 0; i < 8; i++) lv_timer_resume(paused[i]);
+    TEST_ASSERT_EQUAL_PTR(heap, timer_state->timer_heap);
+
+    lv_tick_inc(10);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(8, order_cnt);
+
+    for(i = 0; i < 8; i++) {
+        lv_timer_delete(paused[i]);
+        lv_timer_delete(running[i]);
+    }
+}
+
+#endif
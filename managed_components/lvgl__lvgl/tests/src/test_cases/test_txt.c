@@ -205,4 +205,101 @@ void test_lv_text_encoded_letter_next_2_should_handle_two_utf8_characters(void)
     TEST_ASSERT_EQUAL_UINT32(2, ofs);           /* Offset after 'é' */
 }
 
+
+/*Compare the bulk decoding of `txt` to decoding it letter by letter at every alignment of the text*/
+static void check_encoded_decode(const char * txt, uint32_t max_cnt)
+{
+    uint32_t align;
+    for(align = 0; align < 4; align++) {
+        uint32_t buf_u32[32];
+        char * buf = (char *)buf_u32 + align;
+        uint32_t len = strlen(txt);
+        TEST_ASSERT_LESS_THAN(sizeof(buf_u32) - 4, len);
+        memcpy(buf, txt, len + 1);
+
+        uint32_t letters[64];
+        uint32_t ofs[64];
+        uint32_t cnt = 0;
+        uint32_t i = 0;
+        while(cnt < 64) {
+            uint32_t n = lv_text_encoded_decode(buf, &i, len, &letters[cnt], &ofs[cnt], max_cnt);
+            if(n == 0) break;
+            TEST_ASSERT_LESS_OR_EQUAL(max_cnt, n);
+            cnt += n;
+        }
+        TEST_ASSERT_EQUAL_UINT32(len, i);
+
+        uint32_t k = 0;
+        uint32_t j = 0;
+        while(buf[j] != '\0') {
+            TEST_ASSERT_LESS_THAN(cnt, k);
+            TEST_ASSERT_EQUAL_UINT32(j, ofs[k]);
+            TEST_ASSERT_EQUAL_UINT32(lv_text_encoded_next(buf, &j), letters[k]);
+            k++;
+        }
+        TEST_ASSERT_EQUAL_UINT32(cnt, k);
+        TEST_ASSERT_EQUAL_UINT32(lv_text_get_encoded_length(buf), cnt);
+    }
+}
+
+void test_txt_encoded_decode_should_match_encoded_next(void)
+{
+    const char * txt = "Hello 你好, world! abcdefgh 天气很好。ÁÉ end";
+    check_encoded_decode(txt, 64);
+    check_encoded_decode(txt, 5);
+    check_encoded_decode(txt, 1);
+
+    /*Invalid codes are decoded to 0 like with `lv_text_encoded_next`*/
+    check_encoded_decode("abcd\xE4" "efgh\x80ijkl\xC3", 64);
+}
+
+void test_txt_encoded_decode_should_stop_at_len(void)
+{
+    const char * txt = "abcdefgh你好";
+    uint32_t letters[16];
+    uint32_t i = 0;
+
+    /*The letter starting before `len` is decoded entirely*/
+    uint32_t cnt = lv_text_encoded_decode(txt, &i, 9, letters, NULL, 16);
+    TEST_ASSERT_EQUAL_UINT32(9, cnt);
+    TEST_ASSERT_EQUAL_UINT32(0x4F60, letters[8]);
+    TEST_ASSERT_EQUAL_UINT32(11, i);
+
+    /*Unknown length: decode till the end*/
+    i = 0;
+    cnt = lv_text_encoded_decode(txt, &i, LV_TEXT_LEN_MAX, letters, NULL, 16);
+    TEST_ASSERT_EQUAL_UINT32(10, cnt);
+    TEST_ASSERT_EQUAL_UINT32(0x597D, letters[9]);
+    TEST_ASSERT_EQUAL_UINT32(14, i);
+}
+
+void test_txt_decoder_should_iterate_and_seek(void)
+{
+    /*Longer than a block of the decoder*/
+    const char * txt = "The quick brown fox jumps over the lazy dog. 敏捷的棕色狐狸跳过了懒狗。";
+    lv_text_decoder_t dec;
+    lv_text_decoder_init(&dec, txt, 20);   /*After `len` the letters are decoded too*/
+
+    uint32_t j = 0;
+    uint32_t n = 0;
+    while(txt[j] != '\0') {
+        TEST_ASSERT_EQUAL_UINT32(j, lv_text_decoder_get_pos(&dec));
+        uint32_t letter = lv_text_encoded_next(txt, &j);
+        TEST_ASSERT_EQUAL_UINT32(letter, lv_text_decoder_peek(&dec));
+        TEST_ASSERT_EQUAL_UINT32(letter, lv_text_decoder_next(&dec));
+        n++;
+    }
+    TEST_ASSERT_GREATER_THAN(LV_TEXT_DECODER_CNT, n);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_text_decoder_next(&dec));
+    TEST_ASSERT_EQUAL_UINT32(j, lv_text_decoder_get_pos(&dec));
+
+    /*Back to the first CJK letter, then to the start*/
+    lv_text_decoder_seek(&dec, 45);
+    TEST_ASSERT_EQUAL_UINT32(0x654F, lv_text_decoder_next(&dec));
+    TEST_ASSERT_EQUAL_UINT32(48, lv_text_decoder_get_pos(&dec));
+    lv_text_decoder_seek(&dec, 4);
+    TEST_ASSERT_EQUAL_UINT32('q', lv_text_decoder_next(&dec));
+    TEST_ASSERT_EQUAL_UINT32(5, lv_text_decoder_get_pos(&dec));
+}
+
 #endif
@@ -0,0 +1,124 @@
+/* Performance test for the animation core */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "unity/unity.h"
+
+#define ANIM_CNT 200
+
+static int32_t vars[ANIM_CNT];
+
+static void exec_cb(void * var, int32_t v)
+{
+    int32_t * var_i32 = var;
+    *var_i32 = v;
+}
+
+void tearDown(void)
+{
+    lv_anim_delete_all();
+}
+
+static void run_anims(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_tick_inc(1);
+        lv_anim_refr_now();
+    }
+}
+
+static void start_anims(lv_anim_path_cb_t path_cb)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_values(&a, 0, 10000);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_path_cb(&a, path_cb);
+
+    uint32_t i;
+    for(i = 0; i < ANIM_CNT; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_start(&a);
+    }
+}
+
+void test_anim_linear(void)
+{
+    start_anims(lv_anim_path_linear);
+    TEST_ASSERT_MAX_TIME(run_anims, 100, 1000);
+}
+
+void test_anim_ease_in_out(void)
+{
+    start_anims(lv_anim_path_ease_in_out);
+    TEST_ASSERT_MAX_TIME(run_anims, 200, 1000);
+}
+
+static void obj_x_cb(void * var, int32_t v)
+{
+    lv_obj_set_x(var, v);
+}
+
+static void obj_y_cb(void * var, int32_t v)
+{
+    lv_obj_set_y(var, v);
+}
+
+static void obj_width_cb(void * var, int32_t v)
+{
+    lv_obj_set_width(var, v);
+}
+
+static void obj_height_cb(void * var, int32_t v)
+{
+    lv_obj_set_height(var, v);
+}
+
+void test_anim_obj_props(void)
+{
+    /*Like sprites moving and resizing: the widget setters cost much more than the path and the bookkeeping*/
+    static const lv_anim_exec_xcb_t exec_cbs[] = {obj_x_cb, obj_y_cb, obj_width_cb, obj_height_cb};
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 10, 100);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+
+    uint32_t i;
+    for(i = 0; i < ANIM_CNT / 4; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        uint32_t j;
+        for(j = 0; j < 4; j++) {
+            lv_anim_set_var(&a, obj);
+            lv_anim_set_exec_cb(&a, exec_cbs[j]);
+            lv_anim_start(&a);
+        }
+    }
+
+    TEST_ASSERT_MAX_TIME(run_anims, 100, 200);
+
+    lv_anim_delete_all();
+    lv_obj_clean(lv_screen_active());
+}
+
+static void start_delete_anims(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        start_anims(lv_anim_path_linear);
+        /*Delete from the middle*/
+        uint32_t j;
+        for(j = 0; j < ANIM_CNT; j++) lv_anim_delete(&vars[(j * 7) % ANIM_CNT], exec_cb);
+    }
+}
+
+void test_anim_start_delete(void)
+{
+    TEST_ASSERT_MAX_TIME(start_delete_anims, 50, 20);
+}
+
+#endif
@@ -0,0 +1,65 @@
+/* Performance test for sending events to objects without a matching callback */
+#if LV_BUILD_TEST_PERF
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define OBJ_CNT 100
+
+static lv_obj_t * objs[OBJ_CNT];
+
+static void event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+}
+
+void setUp(void)
+{
+    /*Every object has 1-2 callbacks for codes which are not sent while drawing*/
+    uint32_t i;
+    for(i = 0; i < OBJ_CNT; i++) {
+        objs[i] = lv_obj_create(lv_screen_active());
+        lv_obj_set_pos(objs[i], (i % 10) * 36, (i / 10) * 36);
+        lv_obj_set_size(objs[i], 32, 32);
+        lv_obj_add_event_cb(objs[i], event_cb, LV_EVENT_CLICKED, NULL);
+        if(i & 1) lv_obj_add_event_cb(objs[i], event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    }
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void send_frame_events(uint32_t cnt)
+{
+    static const lv_event_code_t codes[] = {
+        LV_EVENT_COVER_CHECK, LV_EVENT_REFR_EXT_DRAW_SIZE, LV_EVENT_DRAW_MAIN_BEGIN, LV_EVENT_DRAW_MAIN,
+        LV_EVENT_DRAW_MAIN_END, LV_EVENT_DRAW_POST_BEGIN, LV_EVENT_DRAW_POST, LV_EVENT_DRAW_POST_END,
+        LV_EVENT_PRESSING, LV_EVENT_HIT_TEST,
+    };
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint32_t j;
+        for(j = 0; j < OBJ_CNT; j++) {
+            uint32_t k;
+            for(k = 0; k < sizeof(codes) / sizeof(codes[0]); k++) {
+                lv_event_t e = {0};
+                e.current_target = objs[j];
+                e.original_target = objs[j];
+                e.code = codes[k];
+                lv_event_send(&objs[j]->spec_attr->event_list, &e, true);
+                lv_event_send(&objs[j]->spec_attr->event_list, &e, false);
+            }
+        }
+    }
+}
+
+void test_event_send_unmatched_codes(void)
+{
+    TEST_ASSERT_MAX_TIME(send_frame_events, 100, 1000);
+}
+
+#endif
@@ -1,6 +1,7 @@
 /* Performance test for the lv_text and lv_font_* functions */
 #if LV_BUILD_TEST_PERF
 #include "unity/unity.h"
+#include "../../../src/misc/lv_text_private.h"
 
 static lv_obj_t * active_screen = NULL;
 static lv_obj_t * label = NULL;
@@ -17,4 +18,134 @@ void test_label(void)
                          "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Ut auctor sed dui interdum convallis. Proin in ante magna. Pellentesque placerat condimentum erat ac laoreet. Cras mi eros, convallis vitae massa ac, blandit sodales urna. Proin tincidunt fermentum leo a volutpat. Donec ut blandit tortor. Duis elementum nibh nec consequat sagittis. Lutrae sunt praeclarae");
 
 }
+
+void test_label_cjk(void)
+{
+    /*Most of the letters are in the last, sparse cmap of the font*/
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    TEST_ASSERT_MAX_TIME(lv_label_set_text, 0.5, label,
+                         "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，"
+                         "请直接告诉我。我会尽量用简单的话回答你的问题，也可以陪你聊天。请问还有什么可以帮你的吗？");
+}
+
+static void redraw_label(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_invalidate(label);
+        lv_refr_now(NULL);
+    }
+}
+
+void test_label_draw_cjk(void)
+{
+    /*The glyphs are decoded only at the first redraw if the bitmap cache is enabled*/
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    lv_obj_set_width(label, 300);
+    lv_label_set_text(label, "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，"
+                      "请直接告诉我。我会尽量用简单的话回答你的问题，也可以陪你聊天。请问还有什么可以帮你的吗？");
+    TEST_ASSERT_MAX_TIME(redraw_label, 100, 50);
+}
+
+void test_label_draw(void)
+{
+    lv_obj_set_width(label, 300);
+    lv_label_set_text(label,
+                      "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Ut auctor sed dui interdum convallis. "
+                      "Proin in ante magna. Pellentesque placerat condimentum erat ac laoreet. Cras mi eros, convallis "
+                      "vitae massa ac, blandit sodales urna. Proin tincidunt fermentum leo a volutpat. Donec ut "
+                      "blandit tortor. Duis elementum nibh nec consequat sagittis. Lutrae sunt praeclarae");
+    TEST_ASSERT_MAX_TIME(redraw_label, 100, 50);
+}
+
+void test_label_draw_cjk_reply(void)
+{
+    /*A reply of the maximal length of the app (192 letters)*/
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    lv_obj_set_width(label, 300);
+    lv_label_set_text(label, "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，"
+                      "请直接告诉我。我会尽量用简单的话回答你的问题，也可以陪你聊天。请问还有什么可以帮你的吗？"
+                      "你好！我是你的桌面助手。今天天气很好，适合出去走走。如果你想听音乐、查天气或者设置提醒，"
+                      "请直接告诉我。我会尽量用简单的话回答你的问题，也可以陪你聊天。请问还有什么可以帮你的吗？"
+                      "你好！我是你的桌面助手。今天天气");
+    TEST_ASSERT_MAX_TIME(redraw_label, 150, 50);
+}
+
+static void append_label(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, "我会尽量用简单的话回答你的问题。");
+        lv_refr_now(NULL);
+    }
+}
+
+static void get_wrapped_text_size(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_point_t size;
+        lv_text_get_size(&size,
+                         "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Ut auctor sed dui interdum convallis. "
+                         "Proin in ante magna. Pellentesque placerat condimentum erat ac laoreet. Cras mi eros, convallis "
+                         "vitae massa ac, blandit sodales urna. Proin tincidunt fermentum leo a volutpat. Donec ut "
+                         "blandit tortor. Duis elementum nibh nec consequat sagittis. Lutrae sunt praeclarae",
+                         &lv_font_montserrat_14, 0, 0, 200, LV_TEXT_FLAG_NONE);
+    }
+}
+
+void test_text_size_wrapped(void)
+{
+    /*With the glyph run cache the text is shaped only once and the glyphs are not looked up
+     *again for breaking the lines and measuring them*/
+    TEST_ASSERT_MAX_TIME(get_wrapped_text_size, 25, 100);
+}
+
+void test_label_append_cjk(void)
+{
+    /*With the line cache only the last lines are broken again when a streamed reply grows*/
+    lv_obj_set_style_text_font(label, &lv_font_source_han_sans_sc_14_cjk, 0);
+    lv_obj_set_width(label, 300);
+    lv_label_set_text(label, "");
+    TEST_ASSERT_MAX_TIME(append_label, 200, 100);
+}
+
+/*A reply mixing ASCII and CJK text as the assistant's replies do*/
+static const char * mixed_text =
+    "The weather in Beijing: 今天晴，最高气温 25°C，适合出去走走。"
+    "Reminder set for 7:30 AM. 我会在明天早上提醒你。"
+    "Playing \"Yesterday\" by The Beatles. 如果你想换一首歌，请直接告诉我。";
+
+static void decode_mixed_text(uint32_t cnt)
+{
+    uint32_t len = lv_strlen(mixed_text);
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_text_decoder_t dec;
+        lv_text_decoder_init(&dec, mixed_text, len);
+        uint32_t letter;
+        while((letter = lv_text_decoder_next(&dec)) != 0) sum += letter;
+    }
+    TEST_ASSERT_NOT_EQUAL(0, sum);
+}
+
+void test_text_decode_mixed(void)
+{
+    /*The ASCII runs are checked a word at a time and the CJK letters are decoded inline*/
+    TEST_ASSERT_MAX_TIME(decode_mixed_text, 40, 10000);
+}
+
+static void get_mixed_text_length(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, lv_text_get_encoded_length(mixed_text));
+    }
+}
+
+void test_text_length_mixed(void)
+{
+    TEST_ASSERT_MAX_TIME(get_mixed_text_length, 20, 10000);
+}
 #endif
@@ -0,0 +1,77 @@
+/* Performance test for updating the layout of long lists */
+#if LV_BUILD_TEST_PERF
+#include "unity/unity.h"
+
+#define ITEM_CNT 500
+
+static lv_obj_t * list = NULL;
+static lv_obj_t * labels[ITEM_CNT];
+
+void setUp(void)
+{
+    list = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(list, 360, 360);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < ITEM_CNT; i++) {
+        lv_obj_t * item = lv_obj_create(list);
+        lv_obj_set_size(item, LV_PCT(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(item, LV_FLEX_FLOW_ROW);
+        labels[i] = lv_label_create(item);
+        lv_label_set_text_fmt(labels[i], "Item %" LV_PRIu32, i);
+        lv_obj_t * detail = lv_label_create(item);
+        lv_label_set_text(detail, "detail");
+    }
+
+    lv_obj_update_layout(list);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void change_item_height(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_label_set_text(labels[ITEM_CNT / 2], i & 1 ? "Item\ntaller" : "Item");
+        lv_obj_update_layout(list);
+    }
+}
+
+static void change_list_height(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_set_height(list, i & 1 ? 300 : 340);
+        lv_obj_update_layout(list);
+    }
+}
+
+static void change_list_width(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_set_width(list, i & 1 ? 300 : 340);
+        lv_obj_update_layout(list);
+    }
+}
+
+void test_layout_item_height(void)
+{
+    TEST_ASSERT_MAX_TIME(change_item_height, 10, 20);
+}
+
+void test_layout_list_height(void)
+{
+    TEST_ASSERT_MAX_TIME(change_list_height, 50, 20);
+}
+
+void test_layout_list_width(void)
+{
+    TEST_ASSERT_MAX_TIME(change_list_width, 200, 20);
+}
+
+#endif
@@ -0,0 +1,72 @@
+/* Performance test for redrawing small areas of large object trees */
+#if LV_BUILD_TEST_PERF
+#include "unity/unity.h"
+
+static lv_obj_t * active_screen = NULL;
+static lv_obj_t * marker = NULL;
+
+void setUp(void)
+{
+    active_screen = lv_screen_active();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(active_screen);
+}
+
+static lv_obj_t * create_box(lv_obj_t * parent, int32_t x, int32_t y, int32_t size)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, size, size);
+    return obj;
+}
+
+static void redraw_marker(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_invalidate(marker);
+        lv_refr_now(NULL);
+    }
+}
+
+void test_refr_wide_tree(void)
+{
+    /*Many small siblings, only one of them is redrawn*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 480; y += 16) {
+        for(x = 0; x < 800; x += 16) {
+            lv_obj_t * obj = create_box(active_screen, x, y, 12);
+            if(x == 400 && y == 240) marker = obj;
+        }
+    }
+
+    TEST_ASSERT_MAX_TIME(redraw_marker, 100, 50);
+}
+
+void test_refr_deep_tree(void)
+{
+    /*Many columns of nested objects, only the deepest one of the last column is redrawn*/
+    int32_t x;
+    for(x = 0; x < 800; x += 20) {
+        lv_obj_t * parent = active_screen;
+        uint32_t i;
+        for(i = 0; i < 20; i++) {
+            parent = create_box(parent, i == 0 ? x : 0, i == 0 ? 0 : 20, 18);
+            lv_obj_set_height(parent, 460 - 20 * i);
+            lv_obj_set_style_bg_opa(parent, LV_OPA_TRANSP, 0);
+            lv_obj_remove_flag(parent, LV_OBJ_FLAG_SCROLLABLE);
+        }
+        marker = parent;
+    }
+
+    TEST_ASSERT_MAX_TIME(redraw_marker, 100, 50);
+}
+
+#endif
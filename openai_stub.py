@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+离线 OpenAI 替身：backend_server.py 在 OPENAI_STUB=1 时用它代替 openai.OpenAI。
+不联网、不需要 API Key，按设定的延迟返回固定结果，用于离线测量 STT → LLM → TTS 流水线（见 backend_bench.py）。
+
+延迟（毫秒，环境变量）：
+  STUB_STT_MS           Whisper 转写（默认 600）
+  STUB_LLM_FIRST_MS     LLM 首个 token（默认 400）
+  STUB_LLM_TOKEN_MS     之后每个 token（默认 30）
+  STUB_TTS_MS           TTS 每次请求的固定延迟（默认 500）
+  STUB_TTS_MS_PER_CHAR  TTS 每个字符的延迟（默认 10）
+STUB_USER_TEXT / STUB_REPLY 设置转写结果和 LLM 回复；TTS 返回的音频时长按每个字符 60ms 估算。
+"""
+import math
+import os
+import re
+import struct
+import time
+from types import SimpleNamespace
+
+DEFAULT_USER_TEXT = "Hey Dada, did you miss me today?"
+DEFAULT_REPLY = ("Woof, you are finally back! I waited by the door all day. "
+                 "The sofa was so lonely without you. Now throw the red ball, right now!")
+
+TTS_SAMPLE_RATE = 24000
+TTS_SEC_PER_CHAR = 0.06
+
+
+def _ms(name: str, default: int) -> float:
+    return float(os.environ.get(name, str(default))) / 1000.0
+
+
+class _Transcriptions:
+    def create(self, model=None, file=None, **kwargs):
+        time.sleep(_ms("STUB_STT_MS", 600))
+        return SimpleNamespace(text=os.environ.get("STUB_USER_TEXT", DEFAULT_USER_TEXT))
+
+
+class _Speech:
+    def create(self, model=None, voice=None, input="", response_format="pcm", **kwargs):
+        time.sleep(_ms("STUB_TTS_MS", 500) + _ms("STUB_TTS_MS_PER_CHAR", 10) * len(input))
+        # 440Hz 正弦波，16-bit PCM @ 24kHz 单声道（与 OpenAI 的 pcm 格式一致）
+        samples = int(len(input) * TTS_SEC_PER_CHAR * TTS_SAMPLE_RATE)
+        tone = [int(3000 * math.sin(2 * math.pi * 440 * i / TTS_SAMPLE_RATE)) for i in range(TTS_SAMPLE_RATE // 440)]
+        pcm = struct.pack(f"<{len(tone)}h", *tone) * (samples // len(tone) + 1)
+        return SimpleNamespace(content=pcm[:samples * 2])
+
+
+class _Completions:
+    def create(self, model=None, messages=None, stream=False, **kwargs):
+        reply = os.environ.get("STUB_REPLY", DEFAULT_REPLY)
+        if not stream:
+            time.sleep(_ms("STUB_LLM_FIRST_MS", 400) + _ms("STUB_LLM_TOKEN_MS", 30) * len(_tokens(reply)))
+            message = SimpleNamespace(content=reply)
+            return SimpleNamespace(choices=[SimpleNamespace(message=message)])
+        return self._stream(reply)
+
+    @staticmethod
+    def _stream(reply: str):
+        time.sleep(_ms("STUB_LLM_FIRST_MS", 400))
+        for i, token in enumerate(_tokens(reply)):
+            if i > 0:
+                time.sleep(_ms("STUB_LLM_TOKEN_MS", 30))
+            yield SimpleNamespace(choices=[SimpleNamespace(delta=SimpleNamespace(content=token))])
+
+
+def _tokens(text: str):
+    """粗略模拟 LLM 的 token：英文按词（连同前面的空格），其他字符逐个"""
+    return re.findall(r"\s*[A-Za-z0-9']+|\s*[^\sA-Za-z0-9']", text)
+
+
+class OpenAI:
+    """只实现 backend_server.py 用到的接口"""
+
+    def __init__(self, api_key=None, **kwargs):
+        self.chat = SimpleNamespace(completions=_Completions())
+        self.audio = SimpleNamespace(transcriptions=_Transcriptions(), speech=_Speech())
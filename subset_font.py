@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+生成字体分区用的子集化字体（fonts/reply_font.ttf），设备上由 main/flash_font.c 映射后交给 tiny_ttf 渲染。
+默认保留 ASCII、GB2312 全部汉字与符号、CJK 标点和全角字符；去掉 hinting 和排版特性（tiny_ttf 用不到）。
+  pip install fonttools
+  python3 subset_font.py SourceHanSansSC-Normal.otf [-o fonts/reply_font.ttf] [--text extra.txt]
+输出放在 fonts/reply_font.ttf 时 idf.py flash 会一并烧录到 "font" 分区；也可以单独烧录：
+  parttool.py write_partition --partition-name font --input fonts/reply_font.ttf
+"""
+import argparse
+import os
+import sys
+
+from fontTools import subset
+
+PARTITION_SIZE = 4 * 1024 * 1024  # 与 partitions.csv 中 font 分区一致
+
+
+def gb2312_chars():
+    """GB2312 的全部字符（01-09 区符号，16-87 区汉字）"""
+    chars = []
+    for hi in range(0xA1, 0xF8):
+        for lo in range(0xA1, 0xFF):
+            try:
+                chars.append(bytes([hi, lo]).decode("gb2312"))
+            except UnicodeDecodeError:
+                pass
+    return chars
+
+
+def default_unicodes():
+    cps = set(range(0x20, 0x7F))
+    cps.update(range(0x3000, 0x3040))   # CJK 标点
+    cps.update(range(0xFF00, 0xFFF0))   # 全角字符
+    cps.update(ord(c) for c in gb2312_chars())
+    return cps
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("font", help="源字体（TTF/OTF）")
+    ap.add_argument("-o", "--output", default=os.path.join("fonts", "reply_font.ttf"))
+    ap.add_argument("--text", help="额外保留的字符（UTF-8 文本文件）")
+    args = ap.parse_args()
+
+    unicodes = default_unicodes()
+    if args.text:
+        with open(args.text, encoding="utf-8") as f:
+            unicodes.update(ord(c) for c in f.read() if c.isprintable())
+
+    options = subset.Options()
+    options.hinting = False
+    options.layout_features = []
+    options.name_IDs = [1, 2]
+    options.notdef_outline = True
+    options.desubroutinize = True       # CFF 字体去掉子程序，tiny_ttf 解析更快
+
+    font = subset.load_font(args.font, options)
+    subsetter = subset.Subsetter(options)
+    subsetter.populate(unicodes=unicodes)
+    subsetter.subset(font)
+
+    os.makedirs(os.path.dirname(args.output) or ".", exist_ok=True)
+    subset.save_font(font, args.output, options)
+    size = os.path.getsize(args.output)
+    print(f"{args.output}: {len(font.getBestCmap())} chars, {size} bytes")
+    if size > PARTITION_SIZE:
+        print(f"error: larger than the font partition ({PARTITION_SIZE} bytes)", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())